@@ -203,7 +203,7 @@ iftImage *ovlayBorders
   #if IFT_OMP /*#############################################################*/
   #pragma omp parallel for
   #endif /*##################################################################*/
-  for(int p_idx = 0; p_idx < ovlay_img->n; ++p_idx)
+  for(iftIdx p_idx = 0; p_idx < ovlay_img->n; ++p_idx)
   {
     bool is_border;
     int i;
@@ -221,7 +221,7 @@ iftImage *ovlayBorders
 
       if(iftValidVoxel(ovlay_img, q_vxl))
       {
-        int q_idx;
+        iftIdx q_idx;
 
         q_idx = iftGetVoxelIndex(ovlay_img, q_vxl);
 
@@ -144,7 +144,7 @@ iftImage *calcPseudoLabel
   #if IFT_OMP //-------------------------------------------------------------//
   #pragma omp parallel for
   #endif //------------------------------------------------------------------//
-  for(int p = 0; p < pseudo_img->n; ++p)
+  for(iftIdx p = 0; p < pseudo_img->n; ++p)
   {
     int p_label;
     iftColor HSV, RGB, bkg_rgb, YCbCr;
@@ -10,14 +10,63 @@
 #include "iftArgs.h"
 #include "iftSICLE.h"
 
+/* STRUCTS *******************************************************************/
+typedef struct
+{
+	const char *EXT; // Output extension
+	char *basename; // Output path without its extension
+	bool is_video; // Whether each scale is written as a video folder
+} ScaleWriter;
+
 /* PROTOTYPES ****************************************************************/
 void readImgInputs
-(iftArgs *args, iftImage **img, iftImage **mask, iftImage **objsm, 
-	const char **path, bool *is_video);
+(iftArgs *args, iftImage **mask, iftImage **objsm, const char **path, 
+ bool *is_video);
 
 void readSICLEArgs
 (iftArgs *args, iftSICLEArgs **sargs);
 
+void readTileArgs
+(iftArgs *args, int *tile_size, int *tile_overlap);
+
+void readStreamArgs
+(iftArgs *args, bool *use_stream, float *change_thr);
+
+void readWindowArgs
+(iftArgs *args, int *window_size, int *window_overlap);
+
+void readQueryArgs
+(iftArgs *args, iftIntArray **query_nf);
+
+void readPlanArgs
+(iftArgs *args, char **calib_path, double *max_time, double *max_mem);
+
+void readCheckpointArgs
+(iftArgs *args, char **ckpt_path, int *ckpt_iter, bool *resume);
+
+void readCacheArgs
+(iftArgs *args, char **cache_dir);
+
+void readSweepArgs
+(iftArgs *args, int argc, char const *argv[], iftSICLEArgs ***sweep, 
+ int *num_sweep);
+
+void applyPreset
+(iftArgs *args, iftSICLEArgs *sargs);
+
+void planSICLE
+(const char *calib_path, iftSICLE *sicle, double max_time, double max_mem,
+ iftSICLEArgs *sargs);
+
+void writeScale
+(iftImage *label_img, int scale, int num_scales, void *user);
+
+void readShardArgs
+(iftArgs *args, int *shard, int *num_shards);
+
+void runBatch
+(iftArgs *args);
+
 void usage();
 
 char *remove_ext (const char* myStr, char extSep, char pathSep);
@@ -31,64 +80,313 @@ int main(int argc, char const *argv[])
 
 	args = iftCreateArgs(argc, argv);
 
-	has_req = iftExistArg(args, "img")  && iftExistArg(args, "out");
+	has_req = (iftExistArg(args, "img") || iftExistArg(args, "batch")) && 
+						iftExistArg(args, "out");
 	has_help = iftExistArg(args, "help");
 
 	if(!has_req || has_help)
 	{ usage(); iftDestroyArgs(&args); return EXIT_FAILURE; }
 	//-----------------------------------------------------------------------//
-	bool multiscale, is_video;
-	const char* OUT;
-	iftSICLEArgs *sargs;
+	bool multiscale, compact, is_video, use_stream, resume;
+	int tile_size, tile_overlap, window_size, window_overlap, num_sweep;
+	int ckpt_iter;
+	float change_thr;
+	double max_time, max_mem;
+	char *calib_path, *ckpt_path, *cache_dir;
+	const char *OUT, *IMG;
+	iftIntArray *query_nf;
+	iftSICLEArgs *sargs, **sweep;
 	iftSICLE *sicle;
-	iftImage *img, *objsm, *mask;
+	iftImage *objsm, *mask, *label_img;
 
 	multiscale = iftExistArg(args, "multiscale");
-	readImgInputs(args, &img, &mask, &objsm, &OUT, &is_video);
+	compact = iftExistArg(args, "compact");
+	if(compact == true && multiscale == false)
+	{ iftError("--compact requires --multiscale", "main"); }
+	if(iftExistArg(args, "batch") == true) // Many images, same parameters
+	{
+		if(multiscale || iftExistArg(args, "tile-size") || 
+			 iftExistArg(args, "window-size") || iftExistArg(args, "stream") ||
+			 iftExistArg(args, "sweep") || iftExistArg(args, "checkpoint") || 
+			 iftExistArg(args, "resume"))
+		{ 
+			iftError("Batches do not support --multiscale, --tile-size, "
+							 "--window-size, --stream, --sweep, --checkpoint or --resume", 
+							 "main"); 
+		}
+		runBatch(args);
+		iftDestroyArgs(&args);
+		return EXIT_SUCCESS;
+	}
+
+	readTileArgs(args, &tile_size, &tile_overlap);
+	if(tile_size > 0) // The image is read tile by tile
+	{
+		char *img_path, *out_path;
+
+		if(multiscale || iftExistArg(args, "mask") || iftExistArg(args, "objsm"))
+		{ iftError("Tiles do not support --multiscale, --mask or --objsm", "main"); }
+
+		img_path = iftCopyString(iftGetArg(args, "img"));
+		out_path = iftCopyString(iftGetArg(args, "out"));
+		readSICLEArgs(args, &sargs);
+		iftDestroyArgs(&args);
+
+		iftRunTiledSICLE(img_path, sargs, tile_size, tile_overlap, out_path);
+
+		iftDestroySICLEArgs(&sargs);
+		free(img_path); free(out_path);
+		return EXIT_SUCCESS;
+	}
+
+	readWindowArgs(args, &window_size, &window_overlap);
+	if(window_size > 0) // The video is read window by window
+	{
+		char *img_path, *out_path;
+
+		if(multiscale || iftExistArg(args, "mask") || iftExistArg(args, "objsm") ||
+			 iftExistArg(args, "stream"))
+		{ 
+			iftError("Windows do not support --multiscale, --mask, --objsm or "
+							 "--stream", "main"); 
+		}
+		if(iftDirExists(iftGetArg(args, "img")) == false)
+		{ iftError("Windows require a video folder as input", "main"); }
+
+		img_path = iftCopyString(iftGetArg(args, "img"));
+		out_path = iftCopyString(iftGetArg(args, "out"));
+		readSICLEArgs(args, &sargs);
+		iftDestroyArgs(&args);
+
+		iftRunSlidingSICLE(img_path, sargs, window_size, window_overlap, out_path);
+
+		iftDestroySICLEArgs(&sargs);
+		free(img_path); free(out_path);
+		return EXIT_SUCCESS;
+	}
+
+	readStreamArgs(args, &use_stream, &change_thr);
+	if(use_stream == true) // The video is read frame by frame
+	{
+		const char *EXT;
+		char *basename;
+		iftFileSet *files;
+		iftSICLEStream *stream;
+
+		if(multiscale || iftExistArg(args, "mask") || iftExistArg(args, "objsm"))
+		{ iftError("Streams do not support --multiscale, --mask or --objsm", "main"); }
+		if(iftDirExists(iftGetArg(args, "img")) == false)
+		{ iftError("Streams require a video folder as input", "main"); }
+
+		files = iftLoadFileSetFromDirOrCSV(iftGetArg(args, "img"), 0, true);
+		EXT = iftFileExt(iftGetArg(args, "out"));
+		basename = iftRemoveSuffix(iftGetArg(args, "out"), EXT);
+		readSICLEArgs(args, &sargs);
+		iftDestroyArgs(&args);
+
+		stream = iftCreateSICLEStream(sargs, change_thr);
+		for(long i = 0; i < files->n; ++i)
+		{
+			iftImage *segm;
+
+			sicle = iftReadSICLE(files->files[i]->path, NULL, NULL);
+			iftVerifySICLEArgs(sicle, sargs);
+			segm = iftRunSICLEStream(stream, sicle);
+			iftWriteImageByExt(segm, "%s%0*ld%s", basename, 
+												 IFT_VIDEO_FOLDER_FRAME_NZEROES, i, EXT);
+
+			iftDestroyImage(&segm);
+			iftDestroySICLE(&sicle);
+		}
+		iftDestroySICLEStream(&stream);
+
+		iftDestroySICLEArgs(&sargs);
+		iftDestroyFileSet(&files);
+		free(basename);
+		return EXIT_SUCCESS;
+	}
+
+	readQueryArgs(args, &query_nf);
+	if(query_nf != NULL && (multiscale || iftExistArg(args, "rag") || 
+													iftExistArg(args, "pyr-levels")))
+	{ iftError("Queries do not support --multiscale, --rag or --pyr-levels", "main"); }
+
+	readSweepArgs(args, argc, argv, &sweep, &num_sweep);
+	if(sweep != NULL && (multiscale || query_nf != NULL))
+	{ iftError("Sweeps do not support --multiscale or --query-nf", "main"); }
+	readCheckpointArgs(args, &ckpt_path, &ckpt_iter, &resume);
+	if(ckpt_path != NULL && (multiscale || query_nf != NULL || sweep != NULL))
+	{ 
+		iftError("Checkpoints do not support --multiscale, --query-nf or --sweep",
+						 "main"); 
+	}
+
+	readPlanArgs(args, &calib_path, &max_time, &max_mem);
+	readImgInputs(args, &mask, &objsm, &OUT, &is_video);
+	IMG = iftGetArg(args, "img");
+	readCacheArgs(args, &cache_dir);
 	readSICLEArgs(args, &sargs);
 	iftDestroyArgs(&args);
 	
-	sicle = iftCreateSICLE(img, objsm, mask);
-	iftDestroyImage(&img);
+	// The image is always decoded straight into features (see iftReadSICLE)
+	if(cache_dir != NULL) // Mapped from the cache, if computed before
+	{ sicle = iftReadCachedSICLE(IMG, objsm, mask, cache_dir); free(cache_dir); }
+	else if(sargs->ooc_path != NULL) // Never fully resident
+	{ sicle = iftReadOutOfCoreSICLE(IMG, objsm, mask, sargs->ooc_path); }
+	else { sicle = iftReadSICLE(IMG, objsm, mask); }
+	if(max_time > 0 || max_mem > 0) // N0 and iterations within the limits
+	{ planSICLE(calib_path, sicle, max_time, max_mem, sargs); }
+	if(calib_path != NULL) { free(calib_path); }
+	if(multiscale == true && compact == false && query_nf == NULL)
+	{
+		int xsize, ysize, zsize;
+
+		iftGetSICLEDomain(sicle, &xsize, &ysize, &zsize, NULL);
+		label_img = iftCreateImage(xsize, ysize, zsize); 
+	}
+	else { label_img = NULL; }
 	if(objsm != NULL) { iftDestroyImage(&objsm); }
 	if(mask != NULL) { iftDestroyImage(&mask); }
 
 	iftVerifySICLEArgs(sicle, sargs);
-	if(multiscale == false)
+	if(sweep != NULL) // The first forest is shared among the configurations
+	{
+		const char *EXT;
+		char *basename;
+		iftImage **segms;
+
+	  EXT = iftFileExt(OUT);
+	  basename = remove_ext(OUT,'.','/');
+		for(int i = 0; i < num_sweep; ++i) { iftVerifySICLEArgs(sicle, sweep[i]); }
+		segms = iftRunSICLESweep(sicle, sweep, num_sweep);
+		for(int i = 0; i < num_sweep; ++i)
+		{
+			if(is_video == false)
+			{ iftWriteImageByExt(segms[i], "%s_%d%s", basename, i + 1, EXT); }
+			else
+			{ 
+				char tmp[IFT_STR_DEFAULT_SIZE];
+
+				sprintf(tmp, "%s_%d/%s",basename,i + 1,EXT);
+				iftWriteVolumeAsSingleVideoFolder(segms[i], tmp); 
+			}
+			iftDestroyImage(&(segms[i]));
+			iftDestroySICLEArgs(&(sweep[i]));
+		}
+		free(segms);
+		free(sweep);
+		free(basename);
+	}
+	else if(query_nf != NULL) // A single run for every Nf
+	{
+		const char *EXT;
+		char *basename;
+		iftSICLEHierarchy *hier;
+
+	  EXT = iftFileExt(OUT);
+	  basename = remove_ext(OUT,'.','/');
+		hier = iftCreateSICLEHierarchy(sicle, sargs);
+		for(long i = 0; i < query_nf->n; ++i)
+		{
+			iftImage *segm;
+
+			segm = iftQuerySICLEHierarchy(hier, query_nf->val[i]);
+			if(is_video == false)
+			{ iftWriteImageByExt(segm, "%s_%d%s", basename, query_nf->val[i], EXT); }
+			else
+			{ 
+				char tmp[IFT_STR_DEFAULT_SIZE];
+
+				sprintf(tmp, "%s_%d/%s",basename,query_nf->val[i],EXT);
+				iftWriteVolumeAsSingleVideoFolder(segm, tmp); 
+			}
+			iftDestroyImage(&segm);
+		}
+		iftDestroySICLEHierarchy(&hier);
+		iftDestroyIntArray(&query_nf);
+		free(basename);
+	}
+	else if(ckpt_path != NULL) // The output is resumed from the checkpoint
 	{
 		iftImage *segm;
 
-		segm = iftRunSICLE(sicle, sargs);
+		if(resume == false) 
+		{ iftRunSICLEToCheckpoint(sicle, sargs, ckpt_iter, ckpt_path); }
+		segm = iftResumeSICLE(sicle, sargs, ckpt_path);
 		if(is_video == false)
 		{ iftWriteImageByExt(segm, OUT); }
 		else
 		{ iftWriteVolumeAsSingleVideoFolder(segm, OUT); }
 		iftDestroyImage(&segm);
+		free(ckpt_path);
 	}
-	else
+	else if(multiscale == false && is_video == false && sargs->ooc_path != NULL)
+	{ iftRunSICLEToFile(sicle, sargs, OUT); }
+	else if(multiscale == false)
+	{
+		int num_iters;
+		iftImage *segm;
+
+		segm = iftRunAnytimeSICLE(sicle, sargs, &num_iters);
+		if(sargs->time_budget > 0)
+		{ fprintf(stderr, "Stopped after %d iteration(s)\n", num_iters); }
+		if(is_video == false)
+		{ iftWriteImageByExt(segm, OUT); }
+		else
+		{ iftWriteVolumeAsSingleVideoFolder(segm, OUT); }
+		iftDestroyImage(&segm);
+	}
+	else if(compact == true) // Finest labels and the parent of each superspel
 	{
 		const char *EXT;
-		int num_scales;
 		char *basename;
-		iftImage **multisegm;
+		char tmp[IFT_STR_DEFAULT_SIZE];
+		FILE *fp;
+		iftSICLEMultiscale *msegm;
 
 	  EXT = iftFileExt(OUT);
 	  basename = remove_ext(OUT,'.','/');
-		multisegm = iftRunMultiscaleSICLE(sicle, sargs, &num_scales);
-		for(int i = 0; i < num_scales; ++i)
+		msegm = iftRunCompactMultiscaleSICLE(sicle, sargs);
+		if(is_video == false)
+		{ iftWriteImageByExt(msegm->label_img, "%s_1%s", basename, EXT); }
+		else
+		{ 
+			sprintf(tmp, "%s_1/%s",basename,EXT);
+			iftWriteVolumeAsSingleVideoFolder(msegm->label_img, tmp); 
+		}
+
+		sprintf(tmp, "%s_parents.csv", basename);
+		fp = fopen(tmp, "w");
+		if(fp == NULL) { iftError("Could not open %s", "main", tmp); }
+		for(int i = 0; i < msegm->num_scales - 1; ++i)
 		{
-			if(is_video == false)
-			{ iftWriteImageByExt(multisegm[i], "%s_%d%s", basename, i+1, EXT); }
-			else
+			for(long l = 1; l < msegm->parent[i]->n; ++l)
 			{ 
-				char tmp[IFT_STR_DEFAULT_SIZE];
-
-				sprintf(tmp, "%s_%d/%s",basename,i+1,EXT);
-				iftWriteVolumeAsSingleVideoFolder(multisegm[i], tmp); 
+				fprintf(fp, "%d%c", msegm->parent[i]->val[l], 
+								(l < msegm->parent[i]->n - 1) ? ',' : '\n'); 
+			}
+			if(msegm->not_nested->val[i+1] > 0)
+			{ 
+				fprintf(stderr, "Scale %d: %.2f%% of the spels were forced to nest\n", 
+								i + 2, 100.0 * msegm->not_nested->val[i+1]); 
 			}
-			iftDestroyImage(&(multisegm[i]));
 		}
-		free(multisegm);
+		fclose(fp);
+
+		iftDestroySICLEMultiscale(&msegm);
+		free(basename);
+	}
+	else // Each scale is written as soon as it is computed
+	{
+		ScaleWriter writer;
+
+	  writer.EXT = iftFileExt(OUT);
+	  writer.basename = remove_ext(OUT,'.','/');
+	  writer.is_video = is_video;
+		iftRunMultiscaleSICLEWithCallback(sicle, sargs, label_img, writeScale, 
+																			&writer);
+		iftDestroyImage(&label_img);
+		free(writer.basename);
 	}
 	iftDestroySICLE(&sicle);
 	iftDestroySICLEArgs(&sargs);
@@ -98,17 +396,15 @@ int main(int argc, char const *argv[])
 }
 /* METHODS********************************************************************/
 void readImgInputs
-(iftArgs *args, iftImage **img, iftImage **mask, iftImage **objsm, 
-	const char **path, bool *is_video)
+(iftArgs *args, iftImage **mask, iftImage **objsm, const char **path, 
+ bool *is_video)
 {
 	const char *VAL;
 	if(iftHasArgVal(args, "img") == true)
 	{
 		VAL = iftGetArg(args,"img");
-		if(iftIsImageFile(VAL) == true) 
-		{ (*img) = iftReadImageByExt(VAL); (*is_video) = false; }
-		else if(iftDirExists(VAL) == true)
-		{ (*img) = iftReadImageFolderAsVolume(VAL); (*is_video) = true;}
+		if(iftIsImageFile(VAL) == true) { (*is_video) = false; }
+		else if(iftDirExists(VAL) == true) { (*is_video) = true; }
 		else { iftError("Unknown image/video format", __func__); } 
 	}
 	else { iftError("No image path was given", __func__); }
@@ -126,8 +422,6 @@ void readImgInputs
 		else if(iftDirExists(VAL) == true)
 		{ (*mask) = iftReadImageFolderAsVolume(VAL); }
 		else { iftError("Unknown image/video format", __func__); }
-
-		iftVerifyImageDomains((*img), (*mask), __func__);
  	}
 	else { iftError("No mask path was given", __func__); }
 
@@ -140,8 +434,6 @@ void readImgInputs
 		else if(iftDirExists(VAL) == true)
 		{ (*objsm) = iftReadImageFolderAsVolume(VAL); } 
 		else { iftError("Unknown image/video format", __func__); }
-
-		iftVerifyImageDomains((*img), (*objsm), __func__);
 	}
 	else { iftError("No saliency map path was given", __func__); }
 }
@@ -150,9 +442,14 @@ void readSICLEArgs
 (iftArgs *args, iftSICLEArgs **sargs)
 {
 	(*sargs) = iftCreateSICLEArgs();
+	applyPreset(args, *sargs); // The remaining options override it
 
-	(*sargs)->use_diag = !iftExistArg(args, "no-diag");
+	if(iftExistArg(args, "no-diag") == true) 
+	{ (*sargs)->adjopt = IFT_SICLE_ADJ_AXIS; }
 	(*sargs)->use_dift = !iftExistArg(args, "no-dift");
+	(*sargs)->use_rag = iftExistArg(args, "rag");
+	(*sargs)->use_refine = !iftExistArg(args, "no-refine");
+	(*sargs)->use_fast_finish = !iftExistArg(args, "no-fast-finish");
 
 	if(iftExistArg(args, "max-iters") == true)
 	{
@@ -161,6 +458,41 @@ void readSICLEArgs
 		else { iftError("No maximum number of iterations was given", __func__); }
 	}
 
+	if(iftExistArg(args, "max-sweeps") == true)
+	{
+		if(iftHasArgVal(args, "max-sweeps") == true) 
+		{ (*sargs)->max_sweeps = atoi(iftGetArg(args, "max-sweeps")); }
+		else { iftError("No maximum number of sweeps was given", __func__); }
+	}
+
+	if(iftExistArg(args, "pyr-levels") == true)
+	{
+		if(iftHasArgVal(args, "pyr-levels") == true) 
+		{ (*sargs)->pyr_levels = atoi(iftGetArg(args, "pyr-levels")); }
+		else { iftError("No number of pyramid levels was given", __func__); }
+	}
+
+	if(iftExistArg(args, "ooc-path") == true)
+	{
+		if(iftHasArgVal(args, "ooc-path") == true) 
+		{ (*sargs)->ooc_path = iftCopyString(iftGetArg(args, "ooc-path")); }
+		else { iftError("No out-of-core directory was given", __func__); }
+	}
+
+	if(iftExistArg(args, "ooc-chunk") == true)
+	{
+		if(iftHasArgVal(args, "ooc-chunk") == true) 
+		{ (*sargs)->ooc_chunk = atoi(iftGetArg(args, "ooc-chunk")); }
+		else { iftError("No chunk size was given", __func__); }
+	}
+
+	if(iftExistArg(args, "ooc-budget") == true)
+	{
+		if(iftHasArgVal(args, "ooc-budget") == true) 
+		{ (*sargs)->ooc_budget = atoi(iftGetArg(args, "ooc-budget")); }
+		else { iftError("No memory budget was given", __func__); }
+	}
+
 	if(iftExistArg(args, "n0") == true)
 	{
 		if(iftHasArgVal(args, "n0") == true) 
@@ -196,6 +528,13 @@ void readSICLEArgs
 		else { iftError("No alpha fator was given", __func__); }
 	}
 
+	if(iftExistArg(args, "time-budget") == true)
+	{
+		if(iftHasArgVal(args, "time-budget") == true) 
+		{ (*sargs)->time_budget = atof(iftGetArg(args, "time-budget")); }
+		else { iftError("No time budget was given", __func__); }
+	}
+
 	if(iftExistArg(args, "sampl-opt") == true)
 	{
 		if(iftHasArgVal(args, "sampl-opt") == true)
@@ -213,6 +552,40 @@ void readSICLEArgs
 		else { iftError("No seed oversampling option was given", __func__); }	
 	}
 
+	if(iftExistArg(args, "adj-opt") == true)
+	{
+		if(iftHasArgVal(args, "adj-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "adj-opt");
+
+	    if(iftCompareStrings(VAL, "full"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_FULL; }
+			else if(iftCompareStrings(VAL, "axis"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_AXIS; }
+			else if(iftCompareStrings(VAL, "edge"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_EDGE; }
+			else if(iftCompareStrings(VAL, "st"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_ST; }
+	    else iftError("Unknown adjacency relation option", __func__);
+		}
+		else { iftError("No adjacency relation was given", __func__); }	
+	}
+
+	if(iftExistArg(args, "engine-opt") == true)
+	{
+		if(iftHasArgVal(args, "engine-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "engine-opt");
+
+	    if(iftCompareStrings(VAL, "heap"))
+	    { (*sargs)->engineopt = IFT_SICLE_ENGINE_HEAP; }
+		else if(iftCompareStrings(VAL, "raster"))
+	    { (*sargs)->engineopt = IFT_SICLE_ENGINE_RASTER; }
+	    else iftError("Unknown forest computation engine option", __func__);
+		}
+		else { iftError("No forest computation engine was given", __func__); }	
+	}
+
 	if(iftExistArg(args, "conn-opt") == true)
 	{
 		if(iftHasArgVal(args, "conn-opt") == true)
@@ -307,6 +680,390 @@ void readSICLEArgs
   
 }
 
+void readTileArgs
+(iftArgs *args, int *tile_size, int *tile_overlap)
+{
+	(*tile_size) = 0; (*tile_overlap) = 32;
+
+	if(iftExistArg(args, "tile-size") == true)
+	{
+		if(iftHasArgVal(args, "tile-size") == true) 
+		{ (*tile_size) = atoi(iftGetArg(args, "tile-size")); }
+		else { iftError("No tile size was given", __func__); }
+	}
+
+	if(iftExistArg(args, "tile-overlap") == true)
+	{
+		if(iftHasArgVal(args, "tile-overlap") == true) 
+		{ (*tile_overlap) = atoi(iftGetArg(args, "tile-overlap")); }
+		else { iftError("No tile overlap was given", __func__); }
+	}
+}
+
+void readStreamArgs
+(iftArgs *args, bool *use_stream, float *change_thr)
+{
+	(*use_stream) = iftExistArg(args, "stream"); (*change_thr) = 10.0;
+
+	if(iftExistArg(args, "change-thr") == true)
+	{
+		if(iftHasArgVal(args, "change-thr") == true) 
+		{ (*change_thr) = atof(iftGetArg(args, "change-thr")); }
+		else { iftError("No change threshold was given", __func__); }
+	}
+}
+
+void readWindowArgs
+(iftArgs *args, int *window_size, int *window_overlap)
+{
+	(*window_size) = 0; (*window_overlap) = 2;
+
+	if(iftExistArg(args, "window-size") == true)
+	{
+		if(iftHasArgVal(args, "window-size") == true) 
+		{ (*window_size) = atoi(iftGetArg(args, "window-size")); }
+		else { iftError("No window size was given", __func__); }
+	}
+
+	if(iftExistArg(args, "window-overlap") == true)
+	{
+		if(iftHasArgVal(args, "window-overlap") == true) 
+		{ (*window_overlap) = atoi(iftGetArg(args, "window-overlap")); }
+		else { iftError("No window overlap was given", __func__); }
+	}
+}
+
+void readQueryArgs
+(iftArgs *args, iftIntArray **query_nf)
+{
+	(*query_nf) = NULL;
+
+	if(iftExistArg(args, "query-nf") == true)
+	{
+		if(iftHasArgVal(args, "query-nf") == true)
+		{
+			char *tmp, *tok;
+			int i;
+			iftSet *vals;
+
+			vals = NULL;
+			tmp = iftCopyString(iftGetArg(args, "query-nf"));
+			tok = strtok(tmp, ",");
+
+			i = 0;
+			while(tok != NULL)
+			{
+				iftInsertSet(&vals, atoi(tok));
+				tok = strtok(NULL, ",");
+				++i;
+			}
+			free(tmp);
+			if(vals == NULL) { iftError("No list of Nf values was provided", __func__); }
+
+			(*query_nf) = iftCreateIntArray(i);
+			while(vals != NULL)
+			{ (*query_nf)->val[--i] = iftRemoveSet(&vals); }
+		}
+		else { iftError("No list of Nf values was provided", __func__); }
+	}
+}
+
+void readCacheArgs
+(iftArgs *args, char **cache_dir)
+{
+	(*cache_dir) = NULL;
+	if(iftExistArg(args, "cache") == true)
+	{
+		if(iftHasArgVal(args, "cache") == true) 
+		{ (*cache_dir) = iftCopyString(iftGetArg(args, "cache")); }
+		else { iftError("No cache directory was given", __func__); }
+	}
+}
+
+void readPlanArgs
+(iftArgs *args, char **calib_path, double *max_time, double *max_mem)
+{
+	(*calib_path) = NULL; (*max_time) = 0; (*max_mem) = 0;
+
+	if(iftExistArg(args, "calib") == true)
+	{
+		if(iftHasArgVal(args, "calib") == true) 
+		{ (*calib_path) = iftCopyString(iftGetArg(args, "calib")); }
+		else { iftError("No calibration file was given", __func__); }
+	}
+
+	if(iftExistArg(args, "max-time") == true)
+	{
+		if(iftHasArgVal(args, "max-time") == true) 
+		{ (*max_time) = atof(iftGetArg(args, "max-time")); }
+		else { iftError("No time limit was given", __func__); }
+	}
+
+	if(iftExistArg(args, "max-mem") == true)
+	{
+		if(iftHasArgVal(args, "max-mem") == true) 
+		{ (*max_mem) = atof(iftGetArg(args, "max-mem")); }
+		else { iftError("No memory limit was given", __func__); }
+	}
+	if((*max_time) < 0 || (*max_mem) < 0) 
+	{ iftError("The limits must be non-negative", __func__); }
+}
+
+void readCheckpointArgs
+(iftArgs *args, char **ckpt_path, int *ckpt_iter, bool *resume)
+{
+	(*ckpt_path) = NULL; (*ckpt_iter) = 1; (*resume) = false;
+
+	if(iftExistArg(args, "checkpoint") == true && iftExistArg(args, "resume"))
+	{ iftError("Either --checkpoint or --resume must be given", __func__); }
+
+	if(iftExistArg(args, "checkpoint") == true)
+	{
+		if(iftHasArgVal(args, "checkpoint") == true) 
+		{ (*ckpt_path) = iftCopyString(iftGetArg(args, "checkpoint")); }
+		else { iftError("No checkpoint file was given", __func__); }
+	}
+
+	if(iftExistArg(args, "resume") == true)
+	{
+		if(iftHasArgVal(args, "resume") == true) 
+		{ (*ckpt_path) = iftCopyString(iftGetArg(args, "resume")); }
+		else { iftError("No checkpoint file was given", __func__); }
+		(*resume) = true;
+	}
+
+	if(iftExistArg(args, "checkpoint-iter") == true)
+	{
+		if(iftHasArgVal(args, "checkpoint-iter") == true) 
+		{ (*ckpt_iter) = atoi(iftGetArg(args, "checkpoint-iter")); }
+		else { iftError("No checkpoint iteration was given", __func__); }
+	}
+}
+
+void runBatch
+(iftArgs *args)
+{
+	int num_threads, num_io_threads, shard, num_shards;
+	char manifest[IFT_STR_DEFAULT_SIZE];
+	const char *INPUT, *OUT, *MANIFEST;
+	iftSICLEArgs *sargs;
+	iftFileSet *files;
+	iftFloatArray *times;
+
+	if(iftExistArg(args, "mask") || iftExistArg(args, "objsm"))
+	{ iftError("Batches do not support --mask or --objsm", __func__); }
+	if(iftHasArgVal(args, "batch") == false) 
+	{ iftError("No directory or CSV file was given", __func__); }
+	if(iftHasArgVal(args, "out") == false) 
+	{ iftError("No output pattern was given", __func__); }
+	INPUT = iftGetArg(args, "batch");
+	OUT = iftGetArg(args, "out");
+
+	num_threads = 0;
+	if(iftExistArg(args, "threads") == true)
+	{
+		if(iftHasArgVal(args, "threads") == true) 
+		{ num_threads = atoi(iftGetArg(args, "threads")); }
+		else { iftError("No number of threads was given", __func__); }
+	}
+
+	num_io_threads = 1;
+	if(iftExistArg(args, "io-threads") == true)
+	{
+		if(iftHasArgVal(args, "io-threads") == true) 
+		{ num_io_threads = atoi(iftGetArg(args, "io-threads")); }
+		else { iftError("No number of I/O threads was given", __func__); }
+	}
+
+	readShardArgs(args, &shard, &num_shards);
+	MANIFEST = NULL;
+	if(iftExistArg(args, "manifest") == true)
+	{
+		if(iftHasArgVal(args, "manifest") == true) 
+		{ MANIFEST = iftGetArg(args, "manifest"); }
+		else { iftError("No manifest path was given", __func__); }
+	}
+	else if(num_shards > 1) // Next to the outputs, one per shard
+	{
+		const char *SEP;
+
+		SEP = strrchr(OUT, '/');
+		if(SEP == NULL) 
+		{ sprintf(manifest, "manifest_%dof%d.csv", shard + 1, num_shards); }
+		else
+		{ 
+			sprintf(manifest, "%.*s/manifest_%dof%d.csv", (int)(SEP - OUT), OUT,
+							shard + 1, num_shards); 
+		}
+		MANIFEST = manifest;
+	}
+
+	readSICLEArgs(args, &sargs);
+	times = iftRunShardedSICLEBatch(INPUT, sargs, OUT, shard, num_shards, 
+																	MANIFEST, num_io_threads, num_threads, 
+																	num_io_threads, &files);
+	for(long i = 0; i < files->n; ++i) // Per-image timing, as CSV
+	{ 
+		if(times->val[i] >= 0) // Otherwise, kept from a previous run
+		{ printf("%s,%.4f\n", files->files[i]->path, times->val[i]); }
+	}
+
+	iftDestroyFloatArray(&times);
+	iftDestroyFileSet(&files);
+	iftDestroySICLEArgs(&sargs);
+}
+
+void readSweepArgs
+(iftArgs *args, int argc, char const *argv[], iftSICLEArgs ***sweep, 
+ int *num_sweep)
+{
+	(*sweep) = NULL; (*num_sweep) = 0;
+
+	if(iftExistArg(args, "sweep") == true)
+	{
+		if(iftHasArgVal(args, "sweep") == true)
+		{
+			char line[IFT_STR_DEFAULT_SIZE];
+			FILE *fp;
+
+			fp = fopen(iftGetArg(args, "sweep"), "r");
+			if(fp == NULL) 
+			{ iftError("Could not open %s", __func__, iftGetArg(args, "sweep")); }
+
+			while(fgets(line, IFT_STR_DEFAULT_SIZE, fp) != NULL)
+			{
+				char *tok;
+				int line_argc;
+				const char **line_argv;
+				iftArgs *line_args;
+
+				// The line's options come first, for overriding the common ones
+				line_argv = malloc((argc + IFT_STR_DEFAULT_SIZE / 2) * sizeof(char*));
+				assert(line_argv != NULL);
+				line_argv[0] = argv[0]; line_argc = 1;
+				tok = strtok(line, " \t\r\n");
+				if(tok == NULL || tok[0] == '#') { free(line_argv); continue; }
+				while(tok != NULL)
+				{ line_argv[line_argc++] = tok; tok = strtok(NULL, " \t\r\n"); }
+				for(int i = 1; i < argc; ++i) { line_argv[line_argc++] = argv[i]; }
+
+				(*sweep) = realloc(*sweep, ((*num_sweep) + 1) * sizeof(iftSICLEArgs*));
+				assert((*sweep) != NULL);
+				line_args = iftCreateArgs(line_argc, line_argv);
+				readSICLEArgs(line_args, &((*sweep)[*num_sweep]));
+				++(*num_sweep);
+
+				iftDestroyArgs(&line_args);
+				free(line_argv);
+			}
+			fclose(fp);
+			if((*num_sweep) == 0) { iftError("No configuration was given", __func__); }
+		}
+		else { iftError("No sweep file was given", __func__); }
+	}
+}
+
+void applyPreset
+(iftArgs *args, iftSICLEArgs *sargs)
+{
+	if(iftExistArg(args, "preset") == true)
+	{
+		const char *VAL;
+		bool has_objsm;
+
+		if(iftHasArgVal(args, "preset") == false) 
+		{ iftError("No preset was given", __func__); }
+
+		// Same as the RunSICLEIRREG and RunSICLECOMP demos
+		VAL = iftGetArg(args, "preset");
+		has_objsm = iftExistArg(args, "objsm");
+		if(iftCompareStrings(VAL, "irreg"))
+		{
+			sargs->connopt = IFT_SICLE_CONN_FMAX;
+			sargs->critopt = IFT_SICLE_CRIT_MINSC;
+			sargs->alpha = has_objsm ? 2.0 : 0.0;
+			sargs->max_iters = has_objsm ? 2 : 5;
+			sargs->penopt = has_objsm ? IFT_SICLE_PEN_BORD : IFT_SICLE_PEN_NONE;
+		}
+		else if(iftCompareStrings(VAL, "comp"))
+		{
+			sargs->irreg = 0.12; sargs->adhr = 12;
+			sargs->connopt = IFT_SICLE_CONN_FSUM;
+			sargs->critopt = IFT_SICLE_CRIT_MAXSC;
+			sargs->alpha = has_objsm ? 2.0 : 0.0;
+			sargs->max_iters = has_objsm ? 2 : 7;
+			sargs->penopt = has_objsm ? IFT_SICLE_PEN_BOBS : IFT_SICLE_PEN_NONE;
+		}
+		else { iftError("Unknown preset: %s", __func__, VAL); }
+	}
+}
+
+void planSICLE
+(const char *calib_path, iftSICLE *sicle, double max_time, double max_mem,
+ iftSICLEArgs *sargs)
+{
+	bool fits;
+	int xsize, ysize, zsize, num_feats;
+	double time;
+	size_t memory;
+	iftSICLECalib calib;
+
+	if(calib_path != NULL && iftFileExists(calib_path) == true)
+	{ calib = iftReadSICLECalib(calib_path); }
+	else
+	{
+		calib = iftCalibrateSICLE();
+		if(calib_path != NULL) { iftWriteSICLECalib(&calib, calib_path); }
+	}
+
+	iftGetSICLEDomain(sicle, &xsize, &ysize, &zsize, &num_feats); // Lab or gray
+	fits = iftPlanSICLE(&calib, xsize, ysize, zsize, num_feats, max_time, 
+											(size_t)(max_mem * 1024 * 1024), sargs);
+	iftPredictSICLE(&calib, sargs, xsize, ysize, zsize, num_feats, &time, 
+									&memory);
+	fprintf(stderr, "Predicted %.2f s and %.1f MiB with N0 = %d and %d "
+					"iteration(s)%s\n", time, memory / (1024.0 * 1024.0), sargs->n0, 
+					sargs->max_iters, fits ? "" : " (exceeding the limits)");
+}
+
+void writeScale
+(iftImage *label_img, int scale, int num_scales, void *user)
+{
+	ScaleWriter *writer;
+
+	writer = (ScaleWriter*)user;
+	if(writer->is_video == false)
+	{ 
+		iftWriteImageByExt(label_img, "%s_%d%s", writer->basename, scale+1, 
+											 writer->EXT); 
+	}
+	else
+	{ 
+		char tmp[IFT_STR_DEFAULT_SIZE];
+
+		sprintf(tmp, "%s_%d/%s",writer->basename,scale+1,writer->EXT);
+		iftWriteVolumeAsSingleVideoFolder(label_img, tmp); 
+	}
+}
+
+void readShardArgs
+(iftArgs *args, int *shard, int *num_shards)
+{
+	(*shard) = 0; (*num_shards) = 1;
+
+	if(iftExistArg(args, "shard") == true)
+	{
+		if(iftHasArgVal(args, "shard") == true) 
+		{ 
+			if(sscanf(iftGetArg(args, "shard"), "%d/%d", shard, num_shards) != 2 ||
+				 (*num_shards) < 1 || (*shard) < 1 || (*shard) > (*num_shards))
+			{ iftError("The shard must be i/N, with i within [1,N]", __func__); }
+			--(*shard);
+		}
+		else { iftError("No shard was given", __func__); }
+	}
+}
+
 void usage()
 {
 	const int SKIP_IND = 15; // For indentation purposes
@@ -332,14 +1089,54 @@ void usage()
 	printf("%-*s %s\n", SKIP_IND, "--pen-opt",
 		"Seed relevance penalization. Options: "
 		"none, obj, bord, osb, bobs, custom. Default: none");
+	printf("%-*s %s\n", SKIP_IND, "--engine-opt",
+		"Forest computation engine. Options: "
+		"heap, raster. Default: heap");
+	printf("%-*s %s\n", SKIP_IND, "--adj-opt",
+		"Adjacency relation. Options: full (8/26), axis (4/6), edge (18, 3D), "
+		"st (8 spatial + 2 temporal, 3D). Default: full");
 
 	printf("\nOptional general parameters:\n");
 	printf("%-*s %s\n", SKIP_IND, "--multiscale",
 		"Generates a multiscale segmentation.");
+	printf("%-*s %s\n", SKIP_IND, "--compact",
+		"Writes the multiscale segmentation as its first scale and a CSV file "
+		"with, per line, the parent of each superspel at the next scale.");
 	printf("%-*s %s\n", SKIP_IND, "--no-diag",
-		"Disable diagonal neighborhood (i.e., 8- or 26-adjacency).");
+		"Disable diagonal neighborhood (i.e., same as --adj-opt axis).");
 	printf("%-*s %s\n", SKIP_IND, "--no-dift",
 		"Disable differential computation.");
+	printf("%-*s %s\n", SKIP_IND, "--rag",
+		"Merge regions of the first forest instead of recomputing it.");
+	printf("%-*s %s\n", SKIP_IND, "--no-refine",
+		"Disable the final forest of the merged regions. RAG only.");
+	printf("%-*s %s\n", SKIP_IND, "--time-budget",
+		"Wall-clock budget (seconds). Stops before an iteration predicted to "
+		"exceed it, merging the current superspels down to Nf. Default: 0 (none)");
+	printf("%-*s %s\n", SKIP_IND, "--no-fast-finish",
+		"Keep the current superspels when out of time, instead of merging them.");
+	printf("%-*s %s\n", SKIP_IND, "--preset",
+		"Starts from the parameters of RunSICLEIRREG or RunSICLECOMP, which the "
+		"other options override. Options: irreg, comp.");
+	printf("%-*s %s\n", SKIP_IND, "--sweep",
+		"File with one configuration (options as above) per line, the k-th "
+		"written as <out>_<k>. Shares the first forest among them.");
+	printf("%-*s %s\n", SKIP_IND, "--checkpoint",
+		"Writes the forest after --checkpoint-iter iterations to this file, "
+		"and resumes from it.");
+	printf("%-*s %s\n", SKIP_IND, "--checkpoint-iter",
+		"Iterations computed before the checkpoint. Default: 1");
+	printf("%-*s %s\n", SKIP_IND, "--resume",
+		"Resumes from a checkpoint of the same image, e.g., to another Nf.");
+	printf("%-*s %s\n", SKIP_IND, "--max-time",
+		"Time limit (seconds) for choosing N0 and the iterations by the cost "
+		"model. Default: 0 (none)");
+	printf("%-*s %s\n", SKIP_IND, "--max-mem",
+		"Memory limit (MiB) for choosing N0 and the iterations by the cost "
+		"model. Default: 0 (none)");
+	printf("%-*s %s\n", SKIP_IND, "--calib",
+		"Calibration file of the cost model. It is created if missing, "
+		"otherwise the machine is calibrated at every run.");
 	printf("%-*s %s\n", SKIP_IND, "--alpha",
 		"Saliency information importance. Default: 0.0");
 	printf("%-*s %s\n", SKIP_IND, "--irreg",
@@ -349,6 +1146,56 @@ void usage()
 	printf("%-*s %s\n", SKIP_IND, "--max-iters",
 		"Maximum number of iterations for segmentation. It is ignored when --ni"
 		" is provided. Default: 7");
+	printf("%-*s %s\n", SKIP_IND, "--max-sweeps",
+		"Maximum number of raster sweeps per iteration. Raster only. Default: 2");
+	printf("%-*s %s\n", SKIP_IND, "--pyr-levels",
+		"Number of coarse-to-fine pyramid levels (each halves the image). "
+		"Ignored by --multiscale. Default: 0");
+	printf("%-*s %s\n", SKIP_IND, "--ooc-path",
+		"Directory for keeping the features and forest out-of-core. The output "
+		"is written chunk by chunk (.scn or .pgm), except for --multiscale.");
+	printf("%-*s %s\n", SKIP_IND, "--ooc-chunk",
+		"Slices (or rows, if 2D) per out-of-core chunk. Default: 16");
+	printf("%-*s %s\n", SKIP_IND, "--ooc-budget",
+		"Memory budget (MiB) of the out-of-core chunks. The queue's order and "
+		"the seeds are kept in memory besides it. Default: 1024");
+	printf("%-*s %s\n", SKIP_IND, "--cache",
+		"Directory for caching the features of --img (and --objsm). Later runs "
+		"on the same contents map them instead of recomputing them.");
+	printf("%-*s %s\n", SKIP_IND, "--batch",
+		"Directory or CSV file of images, instead of --img. Then, --out is a "
+		"pattern with a %%s for each image's name (e.g., out/%%s.pgm).");
+	printf("%-*s %s\n", SKIP_IND, "--threads",
+		"Number of segmentation threads for --batch. Default: 0 (number of "
+		"cores)");
+	printf("%-*s %s\n", SKIP_IND, "--io-threads",
+		"Number of decoding and of encoding threads for --batch, overlapping "
+		"the segmentation. Default: 1");
+	printf("%-*s %s\n", SKIP_IND, "--shard",
+		"Segments only the i-th of N shards of --batch (e.g., 2/8), assigned by "
+		"the images' names. Default: 1/1");
+	printf("%-*s %s\n", SKIP_IND, "--manifest",
+		"CSV file listing the outputs of --batch. Those listed and unchanged are "
+		"kept when rerun. Default: <out dir>/manifest_<i>of<N>.csv if sharded");
+	printf("%-*s %s\n", SKIP_IND, "--tile-size",
+		"Segments a .pgm/.ppm image in tiles of this size (pixels), read from "
+		"disk and stitched. The output must be .scn or .pgm. Default: 0 (off)");
+	printf("%-*s %s\n", SKIP_IND, "--tile-overlap",
+		"Overlap (pixels) between adjacent tiles. Default: 32");
+	printf("%-*s %s\n", SKIP_IND, "--stream",
+		"Segments a video folder frame by frame, starting each frame from the "
+		"previous one's seeds. Labels are kept across frames.");
+	printf("%-*s %s\n", SKIP_IND, "--change-thr",
+		"Feature distance for a spel to be resampled as changed. Stream only. "
+		"Default: 10.0");
+	printf("%-*s %s\n", SKIP_IND, "--window-size",
+		"Segments a video folder in sliding windows of this many frames, "
+		"writing each frame once finalized. Default: 0 (off)");
+	printf("%-*s %s\n", SKIP_IND, "--window-overlap",
+		"Frames shared by consecutive windows. Default: 2");
+	printf("%-*s %s\n", SKIP_IND, "--query-nf",
+		"Comma-separated list of Nf values, all computed from a single run (one "
+		"output per value, suffixed by it). Values may be within [1,N0].");
 	printf("%-*s %s\n", SKIP_IND, "--n0",
 		"Desired initial number of seeds. Default: 3000");
 	printf("%-*s %s\n", SKIP_IND, "--nf",
@@ -0,0 +1,418 @@
+/*****************************************************************************\
+* RunSICLEClient.c
+*
+* AUTHOR  : Felipe Belem
+* DATE    : 2022-06-15
+* LICENSE : MIT License
+* EMAIL   : felipe.belem@ic.unicamp.br
+\*****************************************************************************/
+#include "ift.h"
+#include "iftArgs.h"
+#include "iftSICLE.h"
+
+/* PROTOTYPES ****************************************************************/
+void readSICLEArgs
+(iftArgs *args, iftSICLEArgs **sargs);
+
+void applyPreset
+(iftArgs *args, iftSICLEArgs *sargs);
+
+void readPriors
+(iftArgs *args, iftImage **objsm, iftImage **mask);
+
+void usage();
+
+/* MAIN **********************************************************************/
+int main(int argc, char const *argv[])
+{
+	//-----------------------------------------------------------------------//
+	bool has_req, has_help;
+	iftArgs *args;
+
+	args = iftCreateArgs(argc, argv);
+
+	has_req = iftExistArg(args, "socket") && (iftExistArg(args, "stop") ||
+						(iftExistArg(args, "img") && iftExistArg(args, "out")));
+	has_help = iftExistArg(args, "help");
+
+	if(!has_req || has_help)
+	{ usage(); iftDestroyArgs(&args); return EXIT_FAILURE; }
+	//-----------------------------------------------------------------------//
+	const char *SOCKET, *IMG, *OUT;
+	iftSICLEArgs *sargs;
+	iftImage *img, *objsm, *mask, *segm;
+
+	if(iftHasArgVal(args, "socket") == false)
+	{ iftError("No socket path was given", "main"); }
+	SOCKET = iftGetArg(args, "socket");
+
+	if(iftExistArg(args, "stop") == true) // Once the pending ones are served
+	{ iftStopSICLEDaemon(SOCKET); iftDestroyArgs(&args); return EXIT_SUCCESS; }
+
+	if(iftHasArgVal(args, "img") == false)
+	{ iftError("No image path was given", "main"); }
+	if(iftHasArgVal(args, "out") == false)
+	{ iftError("No output path was given", "main"); }
+	IMG = iftGetArg(args, "img"); OUT = iftGetArg(args, "out");
+	readSICLEArgs(args, &sargs);
+	readPriors(args, &objsm, &mask); // Always handed off
+
+	if(iftExistArg(args, "shm") == true) // Decoded here, handed off
+	{
+		img = iftReadImageByExt(IMG);
+		segm = iftRequestSICLEDaemon(SOCKET, NULL, img, objsm, mask, sargs);
+		iftDestroyImage(&img);
+	}
+	else { segm = iftRequestSICLEDaemon(SOCKET, IMG, NULL, objsm, mask, sargs); }
+	iftWriteImageByExt(segm, OUT);
+
+	if(objsm != NULL) { iftDestroyImage(&objsm); }
+	if(mask != NULL) { iftDestroyImage(&mask); }
+	iftDestroyImage(&segm);
+	iftDestroySICLEArgs(&sargs);
+	iftDestroyArgs(&args);
+
+	return EXIT_SUCCESS;
+}
+/* METHODS********************************************************************/
+void readSICLEArgs
+(iftArgs *args, iftSICLEArgs **sargs)
+{
+	(*sargs) = iftCreateSICLEArgs();
+	applyPreset(args, *sargs); // The remaining options override it
+
+	if(iftExistArg(args, "no-diag") == true) 
+	{ (*sargs)->adjopt = IFT_SICLE_ADJ_AXIS; }
+	(*sargs)->use_dift = !iftExistArg(args, "no-dift");
+	(*sargs)->use_rag = iftExistArg(args, "rag");
+	(*sargs)->use_refine = !iftExistArg(args, "no-refine");
+	(*sargs)->use_fast_finish = !iftExistArg(args, "no-fast-finish");
+
+	if(iftExistArg(args, "max-iters") == true)
+	{
+		if(iftHasArgVal(args, "max-iters") == true) 
+		{ (*sargs)->max_iters = atoi(iftGetArg(args, "max-iters")); }
+		else { iftError("No maximum number of iterations was given", __func__); }
+	}
+
+	if(iftExistArg(args, "max-sweeps") == true)
+	{
+		if(iftHasArgVal(args, "max-sweeps") == true) 
+		{ (*sargs)->max_sweeps = atoi(iftGetArg(args, "max-sweeps")); }
+		else { iftError("No maximum number of sweeps was given", __func__); }
+	}
+
+	if(iftExistArg(args, "n0") == true)
+	{
+		if(iftHasArgVal(args, "n0") == true) 
+		{ (*sargs)->n0 = atoi(iftGetArg(args, "n0")); }
+		else { iftError("No initial quantity of seeds was given", __func__); }
+	}
+
+	if(iftExistArg(args, "nf") == true)
+	{ 
+		if(iftHasArgVal(args, "nf") == true) 
+		{ (*sargs)->nf = atoi(iftGetArg(args, "nf")); }
+		else { iftError("No final quantity of superspels was given", __func__); }
+	}
+
+	if(iftExistArg(args, "irreg") == true)
+	{
+		if(iftHasArgVal(args, "irreg") == true) 
+		{ (*sargs)->irreg = atof(iftGetArg(args, "irreg")); }
+		else { iftError("No compacity factor was given", __func__); }
+	}
+
+	if(iftExistArg(args, "adhr") == true)
+	{
+		if(iftHasArgVal(args, "adhr") == true) 
+		{ (*sargs)->adhr = atoi(iftGetArg(args, "adhr")); }
+		else { iftError("No boundary adherence factor was given", __func__); }
+	}
+
+	if(iftExistArg(args, "alpha") == true)
+	{
+		if(iftHasArgVal(args, "alpha") == true) 
+		{ (*sargs)->alpha = atof(iftGetArg(args, "alpha")); }
+		else { iftError("No alpha fator was given", __func__); }
+	}
+
+	if(iftExistArg(args, "time-budget") == true)
+	{
+		if(iftHasArgVal(args, "time-budget") == true) 
+		{ (*sargs)->time_budget = atof(iftGetArg(args, "time-budget")); }
+		else { iftError("No time budget was given", __func__); }
+	}
+
+	if(iftExistArg(args, "sampl-opt") == true)
+	{
+		if(iftHasArgVal(args, "sampl-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "sampl-opt");
+
+	    if(iftCompareStrings(VAL, "grid"))
+	    { (*sargs)->samplopt = IFT_SICLE_SAMPL_GRID; }
+		else if(iftCompareStrings(VAL, "rnd"))
+	    { (*sargs)->samplopt = IFT_SICLE_SAMPL_RND; }
+		else if(iftCompareStrings(VAL, "custom"))
+	    { (*sargs)->samplopt = IFT_SICLE_SAMPL_CUSTOM; }
+	    else iftError("Unknown seed oversampling option", __func__);
+		}
+		else { iftError("No seed oversampling option was given", __func__); }	
+	}
+
+	if(iftExistArg(args, "adj-opt") == true)
+	{
+		if(iftHasArgVal(args, "adj-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "adj-opt");
+
+	    if(iftCompareStrings(VAL, "full"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_FULL; }
+			else if(iftCompareStrings(VAL, "axis"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_AXIS; }
+			else if(iftCompareStrings(VAL, "edge"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_EDGE; }
+			else if(iftCompareStrings(VAL, "st"))
+	    { (*sargs)->adjopt = IFT_SICLE_ADJ_ST; }
+	    else iftError("Unknown adjacency relation option", __func__);
+		}
+		else { iftError("No adjacency relation was given", __func__); }	
+	}
+
+	if(iftExistArg(args, "engine-opt") == true)
+	{
+		if(iftHasArgVal(args, "engine-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "engine-opt");
+
+	    if(iftCompareStrings(VAL, "heap"))
+	    { (*sargs)->engineopt = IFT_SICLE_ENGINE_HEAP; }
+		else if(iftCompareStrings(VAL, "raster"))
+	    { (*sargs)->engineopt = IFT_SICLE_ENGINE_RASTER; }
+	    else iftError("Unknown forest computation engine option", __func__);
+		}
+		else { iftError("No forest computation engine was given", __func__); }	
+	}
+
+	if(iftExistArg(args, "conn-opt") == true)
+	{
+		if(iftHasArgVal(args, "conn-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "conn-opt");
+
+	    if(iftCompareStrings(VAL, "fmax"))
+	    { (*sargs)->connopt = IFT_SICLE_CONN_FMAX; }
+		else if(iftCompareStrings(VAL, "fsum"))
+	    { (*sargs)->connopt = IFT_SICLE_CONN_FSUM; }
+		else if(iftCompareStrings(VAL, "custom"))
+	    { (*sargs)->connopt = IFT_SICLE_CONN_CUSTOM; }
+	    else iftError("Unknown IFT connectivity function option", __func__);
+		}
+		else { iftError("No IFT connectivity function was given", __func__); }	
+	}
+
+	if(iftExistArg(args, "crit-opt") == true)
+	{
+		if(iftHasArgVal(args, "crit-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "crit-opt");
+
+			if(iftCompareStrings(VAL, "size"))
+	    { (*sargs)->critopt = IFT_SICLE_CRIT_SIZE; }
+	    else if(iftCompareStrings(VAL, "minsc"))
+	    { (*sargs)->critopt = IFT_SICLE_CRIT_MINSC; }
+		  else if(iftCompareStrings(VAL, "maxsc"))
+	    { (*sargs)->critopt = IFT_SICLE_CRIT_MAXSC; }
+		  else if(iftCompareStrings(VAL, "spread"))
+	    { (*sargs)->critopt = IFT_SICLE_CRIT_SPREAD; }
+		  else if(iftCompareStrings(VAL, "custom"))
+	    { (*sargs)->critopt = IFT_SICLE_CRIT_CUSTOM; }
+	    else iftError("Unknown seed removal criterion", __func__);
+		}
+		else { iftError("No seed removal criterion was given", __func__); }	
+	}
+
+	if(iftExistArg(args, "pen-opt") == true)
+	{
+		if(iftHasArgVal(args, "pen-opt") == true)
+		{
+			const char *VAL = iftGetArg(args, "pen-opt");
+
+	    if(iftCompareStrings(VAL, "obj"))
+	    { (*sargs)->penopt = IFT_SICLE_PEN_OBJ; }
+		  else if(iftCompareStrings(VAL, "bord"))
+	    { (*sargs)->penopt = IFT_SICLE_PEN_BORD; }
+		  else if(iftCompareStrings(VAL, "none"))
+	    { (*sargs)->penopt = IFT_SICLE_PEN_NONE; }
+		  else if(iftCompareStrings(VAL, "osb"))
+	    { (*sargs)->penopt = IFT_SICLE_PEN_OSB; }
+		  else if(iftCompareStrings(VAL, "bobs"))
+	    { (*sargs)->penopt = IFT_SICLE_PEN_BOBS; }
+		  else if(iftCompareStrings(VAL, "custom"))
+	    { (*sargs)->penopt = IFT_SICLE_PEN_CUSTOM; }
+	    else iftError("Unknown seed removal criterion", __func__);
+		}
+		else { iftError("No seed removal criterion was given", __func__); }	
+	}
+	
+	if(iftExistArg(args, "ni") == true)
+  {
+    if(iftHasArgVal(args, "ni") == true)
+    {
+      const char *VAL;
+      char *tmp, *tok;
+      int i;
+      iftSet *vals;
+
+      vals = NULL;
+      VAL = iftGetArg(args, "ni");
+      tmp = iftCopyString(VAL);
+      tok = strtok(tmp, ",");
+
+      i = 0;
+      while(tok != NULL)
+      {
+        iftInsertSet(&vals, atoi(tok));
+        tok = strtok(NULL, ",");
+        ++i;
+     	}
+      free(tmp);
+      if(vals == NULL) { iftError("No list of Ni values was provided", __func__); }
+
+      (*sargs)->user_ni = iftCreateIntArray(i);
+      while(vals != NULL)
+      { (*sargs)->user_ni->val[--i] = iftRemoveSet(&vals);}
+    }
+    else { iftError("No list of Ni values was provided", __func__); }
+  }
+  
+}
+
+void applyPreset
+(iftArgs *args, iftSICLEArgs *sargs)
+{
+	if(iftExistArg(args, "preset") == true)
+	{
+		const char *VAL;
+		bool has_objsm;
+
+		if(iftHasArgVal(args, "preset") == false) 
+		{ iftError("No preset was given", __func__); }
+
+		// Same as the RunSICLEIRREG and RunSICLECOMP demos
+		VAL = iftGetArg(args, "preset");
+		has_objsm = iftExistArg(args, "objsm");
+		if(iftCompareStrings(VAL, "irreg"))
+		{
+			sargs->connopt = IFT_SICLE_CONN_FMAX;
+			sargs->critopt = IFT_SICLE_CRIT_MINSC;
+			sargs->alpha = has_objsm ? 2.0 : 0.0;
+			sargs->max_iters = has_objsm ? 2 : 5;
+			sargs->penopt = has_objsm ? IFT_SICLE_PEN_BORD : IFT_SICLE_PEN_NONE;
+		}
+		else if(iftCompareStrings(VAL, "comp"))
+		{
+			sargs->irreg = 0.12; sargs->adhr = 12;
+			sargs->connopt = IFT_SICLE_CONN_FSUM;
+			sargs->critopt = IFT_SICLE_CRIT_MAXSC;
+			sargs->alpha = has_objsm ? 2.0 : 0.0;
+			sargs->max_iters = has_objsm ? 2 : 7;
+			sargs->penopt = has_objsm ? IFT_SICLE_PEN_BOBS : IFT_SICLE_PEN_NONE;
+		}
+		else { iftError("Unknown preset: %s", __func__, VAL); }
+	}
+}
+
+void readPriors
+(iftArgs *args, iftImage **objsm, iftImage **mask)
+{
+	if(iftExistArg(args, "objsm") == false) { (*objsm) = NULL; }
+	else if(iftHasArgVal(args, "objsm") == true)
+	{ (*objsm) = iftReadImageByExt(iftGetArg(args, "objsm")); }
+	else { iftError("No saliency map path was given", __func__); }
+
+	if(iftExistArg(args, "mask") == false) { (*mask) = NULL; }
+	else if(iftHasArgVal(args, "mask") == true)
+	{ (*mask) = iftReadImageByExt(iftGetArg(args, "mask")); }
+	else { iftError("No mask path was given", __func__); }
+}
+
+void usage()
+{
+	const int SKIP_IND = 15; // For indentation purposes
+	printf("\nMandatory parameters:\n");
+	printf("%-*s %s\n", SKIP_IND, "--socket",
+		"Socket of a running RunSICLEDaemon");
+	printf("%-*s %s\n", SKIP_IND, "--img",
+		"Input image, read by the daemon");
+	printf("%-*s %s\n", SKIP_IND, "--out",
+		"Output label image");
+
+	printf("\nOptional files (read here, handed off through shared memory):\n");
+	printf("%-*s %s\n", SKIP_IND, "--mask",
+		"Mask image indicating the region of interest.");
+	printf("%-*s %s\n", SKIP_IND, "--objsm",
+		"Grayscale object saliency map, used by --pen-opt and --alpha.");
+
+	printf("\nSICLE configuration options:\n");
+	printf("%-*s %s\n", SKIP_IND, "--conn-opt",
+		"IFT connectivity function. Options: "
+		"fmax, fsum, custom. Default: fmax");
+	printf("%-*s %s\n", SKIP_IND, "--crit-opt",
+		"Seed removal criterion. Options: "
+		"size, minsc, maxsc, spread, custom. Default: minsc");
+	printf("%-*s %s\n", SKIP_IND, "--pen-opt",
+		"Seed relevance penalization. Options: "
+		"none, obj, bord, osb, bobs, custom. Default: none");
+	printf("%-*s %s\n", SKIP_IND, "--engine-opt",
+		"Forest computation engine. Options: "
+		"heap, raster. Default: heap");
+	printf("%-*s %s\n", SKIP_IND, "--adj-opt",
+		"Adjacency relation. Options: full (8/26), axis (4/6), edge (18, 3D), "
+		"st (8 spatial + 2 temporal, 3D). Default: full");
+
+	printf("\nOptional general parameters:\n");
+	printf("%-*s %s\n", SKIP_IND, "--shm",
+		"Decodes the image here and hands it off through shared memory.");
+	printf("%-*s %s\n", SKIP_IND, "--stop",
+		"Stops the daemon once its pending requests are served. Neither --img "
+		"nor --out are required.");
+	printf("%-*s %s\n", SKIP_IND, "--no-diag",
+		"Disable diagonal neighborhood (i.e., same as --adj-opt axis).");
+	printf("%-*s %s\n", SKIP_IND, "--no-dift",
+		"Disable differential computation.");
+	printf("%-*s %s\n", SKIP_IND, "--rag",
+		"Merge regions of the first forest instead of recomputing it.");
+	printf("%-*s %s\n", SKIP_IND, "--no-refine",
+		"Disable the final forest of the merged regions. RAG only.");
+	printf("%-*s %s\n", SKIP_IND, "--time-budget",
+		"Wall-clock budget (seconds). Stops before an iteration predicted to "
+		"exceed it, merging the current superspels down to Nf. Default: 0 (none)");
+	printf("%-*s %s\n", SKIP_IND, "--no-fast-finish",
+		"Keep the current superspels when out of time, instead of merging them.");
+	printf("%-*s %s\n", SKIP_IND, "--preset",
+		"Starts from the parameters of RunSICLEIRREG or RunSICLECOMP, which the "
+		"other options override. Options: irreg, comp.");
+	printf("%-*s %s\n", SKIP_IND, "--alpha",
+		"Saliency information importance. Default: 0.0");
+	printf("%-*s %s\n", SKIP_IND, "--irreg",
+		"Superspel irregularity factor. Fsum only. Default: 0.12");
+	printf("%-*s %s\n", SKIP_IND, "--adhr",
+		"Superspel boundary adherence factor. Fsum only. Default: 12");
+	printf("%-*s %s\n", SKIP_IND, "--max-iters",
+		"Maximum number of iterations for segmentation. It is ignored when --ni"
+		" is provided. Default: 7");
+	printf("%-*s %s\n", SKIP_IND, "--max-sweeps",
+		"Maximum number of raster sweeps per iteration. Raster only. Default: 2");
+	printf("%-*s %s\n", SKIP_IND, "--n0",
+		"Desired initial number of seeds. Default: 3000");
+	printf("%-*s %s\n", SKIP_IND, "--nf",
+		"Desired final number of superpixels. Default: 200");
+	printf("%-*s %s\n", SKIP_IND, "--ni",
+		"Comma-separated list of intermediary seed quantity.");
+	printf("%-*s %s\n", SKIP_IND, "--help",
+		"Prints this message");
+
+	printf("\n");
+}
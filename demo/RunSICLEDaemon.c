@@ -0,0 +1,69 @@
+/*****************************************************************************\
+* RunSICLEDaemon.c
+*
+* AUTHOR  : Felipe Belem
+* DATE    : 2022-06-15
+* LICENSE : MIT License
+* EMAIL   : felipe.belem@ic.unicamp.br
+\*****************************************************************************/
+#include "ift.h"
+#include "iftArgs.h"
+#include "iftSICLE.h"
+
+/* PROTOTYPES ****************************************************************/
+void usage();
+
+/* MAIN **********************************************************************/
+int main(int argc, char const *argv[])
+{
+	//-----------------------------------------------------------------------//
+	bool has_req, has_help;
+	iftArgs *args;
+
+	args = iftCreateArgs(argc, argv);
+
+	has_req = iftExistArg(args, "socket");
+	has_help = iftExistArg(args, "help");
+
+	if(!has_req || has_help)
+	{ usage(); iftDestroyArgs(&args); return EXIT_FAILURE; }
+	//-----------------------------------------------------------------------//
+	int num_threads;
+	char *socket_path;
+
+	socket_path = NULL;
+
+	if(iftHasArgVal(args, "socket") == true)
+	{ socket_path = iftCopyString(iftGetArg(args, "socket")); }
+	else { iftError("No socket path was given", "main"); }
+
+	num_threads = 0;
+	if(iftExistArg(args, "threads") == true)
+	{
+		if(iftHasArgVal(args, "threads") == true)
+		{ num_threads = atoi(iftGetArg(args, "threads")); }
+		else { iftError("No number of threads was given", "main"); }
+	}
+	iftDestroyArgs(&args);
+
+	iftRunSICLEDaemon(socket_path, num_threads); // Until RunSICLEClient --stop
+	free(socket_path);
+
+	return EXIT_SUCCESS;
+}
+/* METHODS********************************************************************/
+void usage()
+{
+	const int SKIP_IND = 15; // For indentation purposes
+	printf("\nMandatory parameters:\n");
+	printf("%-*s %s\n", SKIP_IND, "--socket",
+		"Path of the Unix domain socket to be served (e.g., /tmp/sicle.sock)");
+
+	printf("\nOptional general parameters:\n");
+	printf("%-*s %s\n", SKIP_IND, "--threads",
+		"Number of requests served at once. Default: 0 (number of cores)");
+	printf("%-*s %s\n", SKIP_IND, "--help",
+		"Prints this message");
+
+	printf("\n");
+}
@@ -18,6 +18,9 @@ void readImgInputs
 void readSICLEArgs
 (iftArgs *args, iftSICLEArgs **sargs);
 
+void runBatch
+(iftArgs *args);
+
 void usage();
 
 char *remove_ext (const char* myStr, char extSep, char pathSep);
@@ -31,7 +34,8 @@ int main(int argc, char const *argv[])
 
 	args = iftCreateArgs(argc, argv);
 
-	has_req = iftExistArg(args, "img")  && iftExistArg(args, "out");
+	has_req = (iftExistArg(args, "img") || iftExistArg(args, "batch")) && 
+						iftExistArg(args, "out");
 	has_help = iftExistArg(args, "help");
 
 	if(!has_req || has_help)
@@ -43,6 +47,9 @@ int main(int argc, char const *argv[])
 	iftSICLE *sicle;
 	iftImage *img, *objsm, *mask;
 
+	if(iftExistArg(args, "batch") == true) // Many images, same parameters
+	{ runBatch(args); iftDestroyArgs(&args); return EXIT_SUCCESS; }
+
 	readImgInputs(args, &img, &mask, &objsm, &OUT, &is_video);
 	readSICLEArgs(args, &sargs);
 	iftDestroyArgs(&args);
@@ -124,7 +131,7 @@ void readSICLEArgs
 {
 	(*sargs) = iftCreateSICLEArgs();
 
-	(*sargs)->use_diag = true;
+	(*sargs)->adjopt = IFT_SICLE_ADJ_FULL;
 	(*sargs)->use_dift = true;
 	(*sargs)->n0 = 3000;
 	(*sargs)->connopt = IFT_SICLE_CONN_FMAX;
@@ -182,6 +189,51 @@ void readSICLEArgs
 	} 
 }
 
+void runBatch
+(iftArgs *args)
+{
+	int num_threads, num_io_threads;
+	const char *INPUT, *OUT;
+	iftSICLEArgs *sargs;
+	iftFileSet *files;
+	iftFloatArray *times;
+
+	if(iftExistArg(args, "mask") || iftExistArg(args, "objsm"))
+	{ iftError("Batches do not support --mask or --objsm", __func__); }
+	if(iftHasArgVal(args, "batch") == false) 
+	{ iftError("No directory or CSV file was given", __func__); }
+	if(iftHasArgVal(args, "out") == false) 
+	{ iftError("No output pattern was given", __func__); }
+	INPUT = iftGetArg(args, "batch");
+	OUT = iftGetArg(args, "out");
+
+	num_threads = 0;
+	if(iftExistArg(args, "threads") == true)
+	{
+		if(iftHasArgVal(args, "threads") == true) 
+		{ num_threads = atoi(iftGetArg(args, "threads")); }
+		else { iftError("No number of threads was given", __func__); }
+	}
+
+	num_io_threads = 1;
+	if(iftExistArg(args, "io-threads") == true)
+	{
+		if(iftHasArgVal(args, "io-threads") == true) 
+		{ num_io_threads = atoi(iftGetArg(args, "io-threads")); }
+		else { iftError("No number of I/O threads was given", __func__); }
+	}
+
+	readSICLEArgs(args, &sargs);
+	times = iftRunSICLEBatch(INPUT, sargs, OUT, num_io_threads, num_threads, 
+													 num_io_threads, &files);
+	for(long i = 0; i < files->n; ++i) // Per-image timing, as CSV
+	{ printf("%s,%.4f\n", files->files[i]->path, times->val[i]); }
+
+	iftDestroyFloatArray(&times);
+	iftDestroyFileSet(&files);
+	iftDestroySICLEArgs(&sargs);
+}
+
 void usage()
 {
 	const int SKIP_IND = 15; // For indentation purposes
@@ -202,6 +254,15 @@ void usage()
 		"Desired final number of superpixels. Default: 200");
 	printf("%-*s %s\n", SKIP_IND, "--ni",
 		"Comma-separated list of intermediary seed quantity.");
+	printf("%-*s %s\n", SKIP_IND, "--batch",
+		"Directory or CSV file of images, instead of --img. Then, --out is a "
+		"pattern with a %%s for each image's name (e.g., out/%%s.pgm).");
+	printf("%-*s %s\n", SKIP_IND, "--threads",
+		"Number of segmentation threads for --batch. Default: 0 (number of "
+		"cores)");
+	printf("%-*s %s\n", SKIP_IND, "--io-threads",
+		"Number of decoding and of encoding threads for --batch, overlapping "
+		"the segmentation. Default: 1");
 	printf("%-*s %s\n", SKIP_IND, "--help",
 		"Prints this message");
 
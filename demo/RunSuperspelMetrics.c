@@ -9,10 +9,24 @@
 #include "ift.h"
 #include "iftArgs.h"
 #include "iftMetrics.h"
+#include "iftSICLE.h"
 
 void usage();
 void readImgInputs
 (const iftArgs *args, iftImage **label_img,  iftImage **img, iftImage **gt_img);
+void computeMetrics
+(const iftArgs *args, iftImage *label_img, iftImage *img, iftImage *gt_img,
+ bool as_csv, char *out_str);
+void readShardArgs
+(const iftArgs *args, int *shard, int *num_shards);
+char **readCSVRows
+(const char *path, int num_cols, long *num_rows, char **header);
+int compareRows
+(const void *a, const void *b);
+void runBatch
+(const iftArgs *args);
+void mergeCSVs
+(const iftArgs *args);
 
 int main(int argc, char const *argv[])
 {
@@ -22,7 +36,9 @@ int main(int argc, char const *argv[])
 
   args = iftCreateArgs(argc, argv);
 
-  has_req = iftExistArg(args, "labels");
+  has_req = iftExistArg(args, "labels") || 
+            ((iftExistArg(args, "batch") || iftExistArg(args, "merge")) &&
+             iftExistArg(args, "out"));
   has_help = iftExistArg(args, "help");
 
   if(has_req == false || has_help == true)
@@ -32,22 +48,40 @@ int main(int argc, char const *argv[])
     return EXIT_FAILURE;
   }
   //-------------------------------------------------------------------------//
-  bool as_csv;
-  int min_label, max_label, num_labels;
-  char out_str[IFT_STR_DEFAULT_SIZE], tmp_str[IFT_STR_DEFAULT_SIZE];
+  char out_str[IFT_STR_DEFAULT_SIZE];
   iftImage *label_img, *img, *gt_img;
 
+  if(iftExistArg(args, "merge") == true) // Per-shard CSVs into a single one
+  { mergeCSVs(args); iftDestroyArgs(&args); return EXIT_SUCCESS; }
+  if(iftExistArg(args, "batch") == true) // One CSV row per label image
+  { runBatch(args); iftDestroyArgs(&args); return EXIT_SUCCESS; }
+
   readImgInputs(args, &label_img, &img, &gt_img);
+  computeMetrics(args, label_img, img, gt_img, iftExistArg(args, "csv"), 
+                 out_str);
 
-  iftImage *relabel_img = iftRelabelImage(label_img);
+  iftDestroyArgs(&args);
   iftDestroyImage(&label_img);
-  label_img = relabel_img;
+  if(gt_img != NULL) iftDestroyImage(&gt_img);
+  if(img != NULL) iftDestroyImage(&img);
+
+  puts(out_str);
+  return EXIT_SUCCESS;
+}
+
+void computeMetrics
+(const iftArgs *args, iftImage *label_img, iftImage *img, iftImage *gt_img,
+ bool as_csv, char *out_str)
+{
+  int min_label, max_label, num_labels;
+  char tmp_str[IFT_STR_DEFAULT_SIZE];
+
+  label_img = iftRelabelImage(label_img);
 
   iftMinMaxValues(label_img, &min_label, &max_label);
   num_labels = max_label - min_label + 1;
 
   sprintf(out_str, "");
-  as_csv = iftExistArg(args, "csv");
   if(as_csv == false) sprintf(tmp_str, "K: %d\n", num_labels);
   else sprintf(tmp_str, "%d", num_labels);
   strcat(out_str, tmp_str);
@@ -108,13 +142,249 @@ int main(int argc, char const *argv[])
 		strcat(out_str, tmp_str);
 	}
 
-  iftDestroyArgs(&args);
   iftDestroyImage(&label_img);
-  if(gt_img != NULL) iftDestroyImage(&gt_img);
-  if(img != NULL) iftDestroyImage(&img);
+}
 
-  puts(out_str);
-  return EXIT_SUCCESS;
+void readShardArgs
+(const iftArgs *args, int *shard, int *num_shards)
+{
+  (*shard) = 0; (*num_shards) = 1;
+
+  if(iftExistArg(args, "shard") == true)
+  {
+    if(iftHasArgVal(args, "shard") == true) 
+    { 
+      if(sscanf(iftGetArg(args, "shard"), "%d/%d", shard, num_shards) != 2 ||
+         (*num_shards) < 1 || (*shard) < 1 || (*shard) > (*num_shards))
+      { iftError("The shard must be i/N, with i within [1,N]", __func__); }
+      --(*shard);
+    }
+    else iftError("No shard was given", __func__);
+  }
+}
+
+char **readCSVRows
+(const char *path, int num_cols, long *num_rows, char **header)
+{
+  char *line, **rows;
+  size_t line_size;
+  long capacity;
+  FILE *fp;
+
+  (*num_rows) = 0; (*header) = NULL;
+  fp = fopen(path, "r");
+  if(fp == NULL) return NULL;
+
+  capacity = 0; rows = NULL;
+  line = NULL; line_size = 0;
+  while(getline(&line, &line_size, fp) > 0)
+  {
+    int cols;
+
+    if(strchr(line, '\n') == NULL) continue; // Interrupted writing
+    iftRightTrim(line, '\n'); iftRightTrim(line, '\r');
+    if((*header) == NULL) { (*header) = iftCopyString(line); continue; }
+
+    cols = 1;
+    for(char *c = line; *c != '\0'; ++c) { if(*c == ',') ++cols; }
+    if(num_cols > 0 && cols != num_cols) continue; // Of another run
+
+    if((*num_rows) == capacity)
+    {
+      capacity = iftMax(64, 2 * capacity);
+      rows = realloc(rows, capacity * sizeof(char*));
+      assert(rows != NULL);
+    }
+    rows[(*num_rows)++] = iftCopyString(line);
+  }
+  free(line);
+  fclose(fp);
+
+  return rows;
+}
+
+int compareRows
+(const void *a, const void *b)
+{
+  return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+void runBatch
+(const iftArgs *args)
+{
+  int shard, num_shards, num_cols;
+  long num_rows;
+  char header[IFT_STR_DEFAULT_SIZE], out_str[IFT_STR_DEFAULT_SIZE];
+  char *old_header, **rows;
+  const char *OUT, *GT, *IMG;
+  FILE *fp;
+  iftFileSet *files;
+
+  if(iftHasArgVal(args, "batch") == false) 
+    iftError("No directory or CSV file was given", __func__);
+  if(iftHasArgVal(args, "out") == false) 
+    iftError("No output CSV file was given", __func__);
+  OUT = iftGetArg(args, "out");
+  GT = iftHasArgVal(args, "gt") ? iftGetArg(args, "gt") : NULL;
+  IMG = iftHasArgVal(args, "img") ? iftGetArg(args, "img") : NULL;
+
+  files = iftLoadFileSetFromDirOrCSV(iftGetArg(args, "batch"), 0, true);
+  readShardArgs(args, &shard, &num_shards);
+  if(num_shards > 1)
+  {
+    iftFileSet *all = files;
+
+    files = iftSelectSICLEShard(all, shard, num_shards);
+    iftDestroyFileSet(&all);
+  }
+
+  // Same columns as --csv, after the label image
+  strcpy(header, "labels,K");
+  if(iftExistArg(args, "all") || iftExistArg(args, "asa")) strcat(header, ",ASA");
+  if(iftExistArg(args, "all") || iftExistArg(args, "br")) strcat(header, ",BR");
+  if(iftExistArg(args, "all") || iftExistArg(args, "cd")) strcat(header, ",CD");
+  if(iftExistArg(args, "all") || iftExistArg(args, "co")) strcat(header, ",CO");
+  if(iftExistArg(args, "all") || iftExistArg(args, "ev")) strcat(header, ",EV");
+  if(iftExistArg(args, "all") || iftExistArg(args, "tex")) strcat(header, ",TEX");
+  if(iftExistArg(args, "all") || iftExistArg(args, "ue")) strcat(header, ",UE");
+  num_cols = 1;
+  for(char *c = header; *c != '\0'; ++c) { if(*c == ',') ++num_cols; }
+
+  // Resumed: the complete rows of a previous run are kept
+  rows = readCSVRows(OUT, num_cols, &num_rows, &old_header);
+  if(old_header != NULL && strcmp(old_header, header) != 0)
+    iftError("%s has other metrics: %s", __func__, OUT, old_header);
+  for(long i = 0; i < num_rows; ++i) { *strchr(rows[i], ',') = '\0'; }
+  if(num_rows > 0) qsort(rows, num_rows, sizeof(char*), compareRows);
+
+  fp = fopen(OUT, "a+");
+  if(fp == NULL) iftError("Could not open %s", __func__, OUT);
+  if(fseek(fp, -1, SEEK_END) != 0) fprintf(fp, "%s\n", header); // Empty
+  else if(fgetc(fp) != '\n') fputc('\n', fp); // Ends a killed run's row
+
+  for(long i = 0; i < files->n; ++i)
+  {
+    const char *PATH = files->files[i]->path;
+    char *name;
+    iftImage *label_img, *img, *gt_img;
+
+    if(iftIsImageFile(PATH) == false) continue; // E.g., RunSICLE's manifests
+    if(num_rows > 0 && 
+       bsearch(&PATH, rows, num_rows, sizeof(char*), compareRows) != NULL)
+      continue;
+
+    // The original and ground-truth images have the label image's name
+    name = iftFilename(PATH, iftFileExt(PATH));
+    label_img = iftReadImageByExt(PATH);
+    img = (IMG != NULL) ? iftReadImageByExt(IMG, name) : NULL;
+    gt_img = (GT != NULL) ? iftReadImageByExt(GT, name) : NULL;
+    if(img != NULL) iftVerifyImageDomains(img, label_img, __func__);
+    if(gt_img != NULL) iftVerifyImageDomains(gt_img, label_img, __func__);
+
+    computeMetrics(args, label_img, img, gt_img, true, out_str);
+    fprintf(fp, "%s,%s\n", PATH, out_str);
+    fflush(fp);
+
+    iftDestroyImage(&label_img);
+    if(gt_img != NULL) iftDestroyImage(&gt_img);
+    if(img != NULL) iftDestroyImage(&img);
+    free(name);
+  }
+  fclose(fp);
+
+  for(long i = 0; i < num_rows; ++i) free(rows[i]);
+  free(rows);
+  if(old_header != NULL) free(old_header);
+  iftDestroyFileSet(&files);
+}
+
+void mergeCSVs
+(const iftArgs *args)
+{
+  int num_cols;
+  long num_rows, num_unique;
+  char *header, **rows;
+  double *sum;
+  FILE *fp;
+  iftSList *paths;
+
+  if(iftHasArgVal(args, "merge") == false) 
+    iftError("No list of CSV files was given", __func__);
+  if(iftHasArgVal(args, "out") == false) 
+    iftError("No output CSV file was given", __func__);
+
+  paths = iftSplitString(iftGetArg(args, "merge"), ",");
+  header = NULL; rows = NULL; num_rows = 0; num_cols = 0;
+  while(iftIsSListEmpty(paths) == false)
+  {
+    char *path, *csv_header, **csv_rows;
+    long csv_num_rows;
+
+    path = iftRemoveSListHead(paths);
+    csv_rows = readCSVRows(path, num_cols, &csv_num_rows, &csv_header);
+    if(csv_header == NULL) iftError("%s is empty or missing", __func__, path);
+    if(header == NULL)
+    {
+      header = csv_header;
+      num_cols = 1;
+      for(char *c = header; *c != '\0'; ++c) { if(*c == ',') ++num_cols; }
+      // The first file's rows were read before knowing the columns
+      for(long i = 0; i < csv_num_rows; ++i)
+      {
+        int cols = 1;
+
+        for(char *c = csv_rows[i]; *c != '\0'; ++c) { if(*c == ',') ++cols; }
+        if(cols != num_cols) { free(csv_rows[i]); csv_rows[i] = NULL; }
+      }
+    }
+    else
+    {
+      if(strcmp(header, csv_header) != 0)
+        iftError("%s has other metrics: %s", __func__, path, csv_header);
+      free(csv_header);
+    }
+
+    rows = realloc(rows, (num_rows + csv_num_rows + 1) * sizeof(char*));
+    assert(rows != NULL);
+    for(long i = 0; i < csv_num_rows; ++i)
+    { if(csv_rows[i] != NULL) rows[num_rows++] = csv_rows[i]; }
+    free(csv_rows);
+    free(path);
+  }
+  iftDestroySList(&paths);
+
+  // Sorted by label image, each one once (e.g., if shards overlapped)
+  if(num_rows > 0) qsort(rows, num_rows, sizeof(char*), compareRows);
+  fp = fopen(iftGetArg(args, "out"), "w");
+  if(fp == NULL) iftError("Could not open %s", __func__, iftGetArg(args, "out"));
+  fprintf(fp, "%s\n", header);
+
+  sum = calloc(num_cols, sizeof(double));
+  assert(sum != NULL);
+  num_unique = 0;
+  for(long i = 0; i < num_rows; ++i)
+  {
+    size_t key_len = strchr(rows[i], ',') - rows[i];
+
+    if(i > 0 && strncmp(rows[i-1], rows[i], key_len + 1) == 0) continue;
+    fprintf(fp, "%s\n", rows[i]);
+    ++num_unique;
+
+    char *c = strchr(rows[i], ',');
+    for(int j = 1; j < num_cols; ++j) { sum[j] += strtod(c + 1, &c); }
+  }
+  fclose(fp);
+
+  // Mean of each metric, in the same format as --csv
+  printf("%ld", num_unique);
+  for(int j = 1; j < num_cols; ++j) 
+  { printf(",%f", (num_unique > 0) ? sum[j] / num_unique : 0.0); }
+  printf("\n");
+
+  for(long i = 0; i < num_rows; ++i) free(rows[i]);
+  free(rows);
+  free(sum);
+  free(header);
 }
 
 void usage()
@@ -134,6 +404,20 @@ void usage()
   printf("%-*s %s\n", SKIP_IND, "--help", 
          "Prints this message");
 
+  printf("\nThe batch parameters are:\n");
+  printf("%-*s %s\n", SKIP_IND, "--batch", 
+         "Directory or CSV file of label images, instead of --labels. Then, --gt"
+         " and --img are patterns with a %%s for each image's name.");
+  printf("%-*s %s\n", SKIP_IND, "--out", 
+         "Output CSV file, one row per label image. Rows already in it are "
+         "kept when rerun.");
+  printf("%-*s %s\n", SKIP_IND, "--shard", 
+         "Evaluates only the i-th of N shards of --batch (e.g., 2/8), as in "
+         "RunSICLE. Default: 1/1");
+  printf("%-*s %s\n", SKIP_IND, "--merge", 
+         "Comma-separated list of --batch CSV files, merged into --out. Prints "
+         "the number of images and the mean of each metric.");
+
   printf("\nThe evaluation metrics are:\n");
   printf("%-*s %s\n", SKIP_IND, "--all", 
          "Computes all metrics. Ground-truth and original image needed.");
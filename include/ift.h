@@ -43,6 +43,7 @@ extern "C" {
 #define IFT_ULONG_NIL IFT_INFINITY_ULONG
 
 typedef struct ift_int_array iftIntArray;
+typedef struct ift_idx_array iftIdxArray;
 typedef struct ift_matrix iftMatrix;
 
 typedef struct timeval timer;
@@ -55,6 +56,20 @@ typedef long long llong;
 typedef unsigned long long ullong;
 #endif
 
+// Spel index. Define IFT_LONG_INDEX (see Makefile) for images with more than 
+// 2^31 - 1 spels, at the cost of doubling the size of the index maps
+#ifdef IFT_LONG_INDEX
+typedef long iftIdx;
+typedef ldiv_t iftIdxDiv;
+#define IFT_IDX_MAX LONG_MAX
+#define iftDivIdx(a, b) ldiv((a), (b))
+#else
+typedef int iftIdx;
+typedef div_t iftIdxDiv;
+#define IFT_IDX_MAX INT_MAX
+#define iftDivIdx(a, b) div((a), (b))
+#endif
+
 typedef struct ift_band {
     float *val;
 } iftBand;
@@ -127,6 +142,14 @@ iftIntArray *iftCreateIntArray(long n);
 void iftDestroyIntArray(iftIntArray **iarr);
 void iftShuffleIntArray(int* array, int n);
 
+struct ift_idx_array {
+    long n;
+    iftIdx *val;
+};
+
+iftIdxArray *iftCreateIdxArray(long n);
+void iftDestroyIdxArray(iftIdxArray **iarr);
+
 // ---------- iftIntArray.h end
 // ---------- iftFloatArray.h start 
 
@@ -305,22 +328,22 @@ iftColor  iftHSVtoRGB(iftColor cin, int normalization_value);
 typedef struct ift_dheap {
     double *value;
     char  *color;
-    int   *node;
-    int   *pos;
-    int    last;
-    int    n;
+    iftIdx *node;
+    iftIdx *pos;
+    iftIdx  last;
+    iftIdx  n;
     char removal_policy;
 } iftDHeap;
 
-iftDHeap *iftCreateDHeap(int n, double *value);
+iftDHeap *iftCreateDHeap(iftIdx n, double *value);
 void      iftDestroyDHeap(iftDHeap **H);
 char      iftFullDHeap(iftDHeap *H);
 char      iftEmptyDHeap(iftDHeap *H);
-char      iftInsertDHeap(iftDHeap *H, int pixel);
-int       iftRemoveDHeap(iftDHeap *H);
-void      iftRemoveDHeapElem(iftDHeap *H, int pixel);
-void      iftGoUpDHeap(iftDHeap *H, int i);
-void      iftGoDownDHeap(iftDHeap *H, int i);
+char      iftInsertDHeap(iftDHeap *H, iftIdx pixel);
+iftIdx    iftRemoveDHeap(iftDHeap *H);
+void      iftRemoveDHeapElem(iftDHeap *H, iftIdx pixel);
+void      iftGoUpDHeap(iftDHeap *H, iftIdx i);
+void      iftGoDownDHeap(iftDHeap *H, iftIdx i);
 void      iftResetDHeap(iftDHeap *H);
 
 // ---------- iftDHeap.h end
@@ -367,16 +390,19 @@ typedef struct ift_bounding_box {
 
 typedef struct ift_bitmap {
     char *val;
-    int nbytes;
-    int n;
+    iftIdx nbytes;
+    iftIdx n;
 } iftBMap;
 
-iftBMap *iftCreateBMap(int n);
+iftBMap *iftCreateBMap(iftIdx n);
 void iftDestroyBMap(iftBMap **bmap);
-inline void iftBMapSet1(iftBMap *bmap, int b) {
+inline void iftBMapSet1(iftBMap *bmap, iftIdx b) {
     bmap->val[b >> 3] |= (1 << (b & 0x07));
 }
-inline bool iftBMapValue(const iftBMap *bmap, int b) {
+inline void iftBMapSet0(iftBMap *bmap, iftIdx b) {
+    bmap->val[b >> 3] &= ~(1 << (b & 0x07));
+}
+inline bool iftBMapValue(const iftBMap *bmap, iftIdx b) {
     return ((bmap->val[b >> 3] & (1 << (b & 0x07))) != 0);
 }
 
@@ -409,8 +435,8 @@ typedef struct ift_image {
     float dx;
     float dy;
     float dz;
-    int *tby, *tbz;
-    int n;
+    iftIdx *tby, *tbz;
+    iftIdx n;
 } iftImage;
 
 iftImage *iftReadImageByExt(const char *filename, ...);
@@ -426,7 +452,7 @@ int iftMinimumValue(const iftImage *img);
 static inline bool iftIs3DImage(const iftImage *img) {
     return (img->zsize > 1);
 }
-iftVoxel iftGetVoxelCoord(const iftImage *img, int p);
+iftVoxel iftGetVoxelCoord(const iftImage *img, iftIdx p);
 iftImage *iftSelectImageDomain(int xsize, int ysize, int zsize);
 iftBoundingBox iftMinBoundingBox(const iftImage *img, iftVoxel *gc_out);
 iftImage *iftReadImage(const char *filename, ...);
@@ -463,7 +489,7 @@ iftBMap *iftBinImageToBMap(const iftImage *bin_img);
 // ---------- iftMatrix.h start 
 
 typedef struct ift_matrix {
-    int nrows;
+    iftIdx nrows;
     int ncols;
     long n;
     float *val;
@@ -471,7 +497,7 @@ typedef struct ift_matrix {
     bool allocated;
 } iftMatrix;
 
-iftMatrix *iftCreateMatrix(int ncols, int nrows);
+iftMatrix *iftCreateMatrix(int ncols, iftIdx nrows);
 iftMatrix *iftCopyMatrix(const iftMatrix *A);
 void iftDestroyMatrix(iftMatrix **M);
 
@@ -489,8 +515,9 @@ typedef struct ift_mimage {
     float **val;
     int xsize,ysize,zsize;
     float dx,dy,dz; 
-    int *tby, *tbz;
-    int n,m;
+    iftIdx *tby, *tbz;
+    iftIdx n;
+    int m;
 } iftMImage;
 
 #define iftMGetVoxelIndex(s,v) ((v.x)+(s)->tby[(v.y)]+(s)->tbz[(v.z)])
@@ -502,7 +529,7 @@ iftImage *iftMImageToImage(const iftMImage *img, int Imax, int band);
 static inline bool iftIs3DMImage(const iftMImage *img) {
     return (img->zsize > 1);
 }
-iftVoxel    iftMGetVoxelCoord(const iftMImage *img, int p);
+iftVoxel    iftMGetVoxelCoord(const iftMImage *img, iftIdx p);
 char iftMValidVoxel(const iftMImage *img, iftVoxel v);
 float iftMMaximumValue(const iftMImage *img, int band);
 
@@ -542,22 +569,22 @@ iftImage *iftBorderImage(const iftImage *label, bool get_margins);
 // ---------- iftSet.h start 
 
 typedef struct ift_set {
-    int elem;
+    iftIdx elem;
     struct ift_set *next;
 } iftSet;
 
-void iftInsertSet(iftSet **S, int elem);
-int iftRemoveSet(iftSet **S);
-void    iftRemoveSetElem(iftSet **S, int elem);
+void iftInsertSet(iftSet **S, iftIdx elem);
+iftIdx iftRemoveSet(iftSet **S);
+void    iftRemoveSetElem(iftSet **S, iftIdx elem);
 void    iftDestroySet(iftSet **S);
 iftSet* iftSetUnion(iftSet *S1,iftSet *S2);
 iftSet* iftSetConcat(iftSet *S1,iftSet *S2);
-char    iftUnionSetElem(iftSet **S, int elem);
+char    iftUnionSetElem(iftSet **S, iftIdx elem);
 void    iftInvertSet(iftSet **S);
 int 	iftSetSize(const iftSet* S);
 iftSet* iftSetCopy(iftSet* S);
-int     iftSetHasElement(iftSet *S, int elem);
-iftIntArray *iftSetToArray(iftSet *S);
+int     iftSetHasElement(iftSet *S, iftIdx elem);
+iftIdxArray *iftSetToArray(iftSet *S);
 
 // ---------- iftSet.h end
 // ---------- iftSList.h start
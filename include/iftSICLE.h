@@ -53,25 +53,121 @@ typedef enum ift_sicle_crit
 	IFT_SICLE_CRIT_CUSTOM, // Custom relevance function
 } iftSICLECrit;
 
+typedef enum ift_sicle_engine
+{
+  IFT_SICLE_ENGINE_HEAP, // Exact priority queue-based IFT
+  IFT_SICLE_ENGINE_RASTER, // Approximate forward/backward raster sweeps
+} iftSICLEEngine;
+
+typedef enum ift_sicle_adj
+{
+  IFT_SICLE_ADJ_FULL, // 8- (2D) or 26-neighborhood (3D)
+  IFT_SICLE_ADJ_AXIS, // 4- (2D) or 6-neighborhood (3D)
+  IFT_SICLE_ADJ_EDGE, // 18-neighborhood (3D only)
+  IFT_SICLE_ADJ_ST, // 8 spatial and 2 temporal (z-axis) neighbors (3D only)
+} iftSICLEAdj;
+
+typedef enum ift_sicle_dtype
+{
+  IFT_SICLE_DTYPE_UINT8, // 8-bit unsigned values
+  IFT_SICLE_DTYPE_UINT16, // 16-bit unsigned values
+  IFT_SICLE_DTYPE_INT32, // 32-bit signed values (labels only)
+  IFT_SICLE_DTYPE_FLOAT32, // 32-bit floating values, within [0,1] (except Lab)
+} iftSICLEDType;
+
+typedef enum ift_sicle_cspace
+{
+  IFT_SICLE_CSPACE_GRAY, // Single channel (also of labels)
+  IFT_SICLE_CSPACE_RGB, // Red, green and blue channels, in this order
+  IFT_SICLE_CSPACE_BGR, // Blue, green and red channels, in this order
+  IFT_SICLE_CSPACE_LAB, // CIELAB channels, with L within [0,100] (float only)
+} iftSICLECSpace;
+
+/*
+ * Polled during the computation. Returns true for cancelling it.
+ */
+typedef bool (*iftSICLECancel)
+(void *user);
+
 typedef struct ift_sicle_args
 {
-	bool use_diag; // Flag: use 8- or 26-neighborhood. Default: true
+	bool use_diag; // Deprecated: unset for the axial adjacency. Default: true
   bool use_dift; // Flag: use differential computation. Default: true
+  bool use_rag; // Flag: merge regions after the first forest. Default: false
+  bool use_refine; // RAG: Flag: refine the merged regions. Default: true
+  bool use_fast_finish; // Anytime: Flag: merge if out of time. Default: true
 	int n0; // Initial quantity of seeds. Default: 3000
 	int nf; // Final quantity of superspels. Default: 200
 	int max_iters; // Maximum number of iterations for segmentation. Default: 5
 	int adhr; // Fsum: Boundary adherence factor. Default: 12
+  int max_sweeps; // Raster: Maximum number of sweeps per iteration. Default: 2
+  int pyr_levels; // Pyramid: Number of halving levels (0 = none). Default: 0
+  int ooc_chunk; // Out-of-core: Slices (rows, if 2D) per chunk. Default: 16
+  int ooc_budget; // Out-of-core: Memory budget of the chunks (MiB). Default: 1024
   float irreg; // Fsum: Irregularity factor. Default: 0.12
   float alpha; // Saliency information importance. Default: 0
+  float time_budget; // Anytime: Wall-clock budget (s), 0 if none. Default: 0
   iftIntArray *user_ni; // User-defined intermediary quantity of seeds.
+  char *ooc_path; // Out-of-core: Directory for the mapped files. Default: NULL
+  iftSICLECancel cancel; // Anytime: Cancellation callback. Default: NULL
+  void *cancel_data; // Anytime: Data given to the callback. Default: NULL
   iftSICLESampl samplopt; // Option: Seed oversampling option: Default RND
 	iftSICLEConn connopt; // Option: IFT connectivity function. Default: FMAX
 	iftSICLECrit critopt; // Option: Seed removal criterion. Default: MINSC
   iftSICLEPen penopt; // Option: Seed relevance penalization. Default: NONE
+  iftSICLEEngine engineopt; // Option: Forest computation engine. Default: HEAP
+  iftSICLEAdj adjopt; // Option: Adjacency relation. Default: FULL
 } iftSICLEArgs;
 
+/*
+ * Caller-owned buffer of interleaved channels, which is neither copied nor
+ * freed. The strides allow for padded rows, extra channels (e.g., alpha) and
+ * views of larger buffers.
+ */
+typedef struct ift_sicle_buffer
+{
+  void *data; // First channel of the first spel
+  int xsize, ysize, zsize; // Domain (zsize = 1 if 2D)
+  long pixel_stride; // Bytes between consecutive spels of a row
+  long row_stride; // Bytes between consecutive rows of a slice
+  long slice_stride; // Bytes between consecutive slices
+  iftSICLEDType dtype; // Type of each channel
+  iftSICLECSpace cspace; // Channels of each spel
+} iftSICLEBuffer;
+
+typedef struct ift_sicle_calib
+{
+  double arc_time; // Time (s) per arc evaluated in the IFT, per log2 of spels
+  double feat_time; // Time (s) per arc, per log2 of spels, per spel feature
+  double dift_factor; // Cost of the DIFT relative to the IFT per removed fraction
+  double stats_time; // Time (s) per arc for computing the tree statistics
+  double pair_time; // Time (s) per tree for computing its relevance
+} iftSICLECalib;
+
+typedef struct ift_sicle_multiscale
+{
+  int num_scales; // Number of scales, from the first iteration to the last
+  iftImage *label_img; // Labels of the first (i.e., finest) scale
+  iftIntArray **parent; // Label at scale s+1 of each label at scale s
+  iftFloatArray *not_nested; // Fraction of spels not nested at each scale
+} iftSICLEMultiscale;
+
+/*
+ * Receives the label image of a scale (i.e., iteration) as soon as it is 
+ * computed. The buffer is overwritten by the next scale, and it must be 
+ * copied for being kept.
+ */
+typedef void (*iftSICLEScaleCallback)
+(iftImage *label_img, int scale, int num_scales, void *user);
+
 typedef struct ift_sicle_alg iftSICLE;
 
+typedef struct ift_sicle_stream iftSICLEStream;
+
+typedef struct ift_sicle_session iftSICLESession;
+
+typedef struct ift_sicle_hier iftSICLEHierarchy;
+
 //############################################################################|
 // 
 //	PUBLIC METHODS
@@ -101,6 +197,60 @@ iftSICLEArgs *iftCreateSICLEArgs();
 iftSICLE *iftCreateSICLE
 (iftImage *img, iftImage *objsm, iftImage *mask);
 
+/*
+ * Creates an instance by reading the image file. Binary PGM/PPM files are 
+ * decoded straight into the spel features, by blocks of rows, with no 
+ * intermediate image; any other format (or video folder) is read by 
+ * iftReadImageByExt (or iftReadImageFolderAsVolume). Colors are thus not 
+ * rounded to YCbCr, and the features may slightly differ from the ones of 
+ * iftCreateSICLE.
+ *
+ * PARAMETERS:
+ *	img_path[in] - REQUIRED: Path of the image (or video folder) to be segmented
+ *	objsm[in] - OPTIONAL: Grayscale object saliency map
+ *	mask[in] - OPTIONAL: Binary mask indication the region of interest
+ *
+ * RETURNS: SICLE prototype
+ */
+iftSICLE *iftReadSICLE
+(const char *img_path, iftImage *objsm, iftImage *mask);
+
+/*
+ * Creates an instance as iftReadSICLE does, but for out-of-core runs (see 
+ * iftRunSICLEToFile). Binary PGM/PPM files are decoded straight into a 
+ * memory mapped file within the out-of-core directory, by blocks of rows 
+ * which are evicted once decoded, thus the whole image is never resident. 
+ * Other formats are read as in iftReadSICLE, and then moved to disk. 
+ *
+ * PARAMETERS:
+ *	img_path[in] - REQUIRED: Path of the image (or video folder) to be segmented
+ *	objsm[in] - OPTIONAL: Grayscale object saliency map
+ *	mask[in] - OPTIONAL: Binary mask indication the region of interest
+ *	ooc_path[in] - REQUIRED: Existing out-of-core directory
+ *
+ * RETURNS: SICLE prototype
+ */
+iftSICLE *iftReadOutOfCoreSICLE
+(const char *img_path, iftImage *objsm, iftImage *mask, const char *ooc_path);
+
+/*
+ * Creates an instance as iftReadSICLE does, but keeping the spel features and
+ * the normalized saliency within a cache directory. Their file is named after
+ * a hash of the image's (or frames') contents and of the saliency map, and it
+ * is memory-mapped with no copy by later calls on the same inputs. Any change
+ * on them leads to a new file, and stale files are never removed.
+ *
+ * PARAMETERS:
+ *	img_path[in] - REQUIRED: Path of the image (or video folder) to be segmented
+ *	objsm[in] - OPTIONAL: Grayscale object saliency map
+ *	mask[in] - OPTIONAL: Binary mask indication the region of interest
+ *	cache_dir[in] - REQUIRED: Existing directory of the cached features
+ *
+ * RETURNS: SICLE prototype
+ */
+iftSICLE *iftReadCachedSICLE
+(const char *img_path, iftImage *objsm, iftImage *mask, const char *cache_dir);
+
 /*
  * Deallocates the respective object 
  *
@@ -119,9 +269,111 @@ void iftDestroySICLEArgs
 void iftDestroySICLE
 (iftSICLE **sicle);
 
+/*
+ * Creates a stream for segmenting the frames of a video one by one, in which
+ * each frame is initialized from the final seeds of the previous one. The
+ * arguments are not copied, and must outlive the stream.
+ *
+ * PARAMETERS:
+ *	args[in] - OPTIONAL: SICLE arguments
+ *	change_thr[in] - REQUIRED: Minimum feature distance (>= 0) between 
+ *		consecutive frames for a spel to be considered as changed
+ *
+ * RETURNS: Empty stream
+ */
+iftSICLEStream *iftCreateSICLEStream
+(iftSICLEArgs *args, float change_thr);
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *	stream[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftDestroySICLEStream
+(iftSICLEStream **stream);
+
+/*
+ * Creates an editing session, running the SICLE algorithm with the prototype
+ * and arguments provided. Its forest is kept for being edited seed by seed,
+ * in which each edit is computed by the differential IFT (regardless of the
+ * engine chosen). Neither the prototype nor the arguments are copied, and
+ * they must outlive the session. The initial labels are within [1,Nf], and
+ * new superspels receive labels greater than every previous one. Each edit
+ * returns the bounding box containing every spel whose label may have 
+ * changed (an empty box has its beginning after its end). Pyramid runs are 
+ * not supported.
+ *
+ * PARAMETERS:
+ *	sicle[in] - REQUIRED: SICLE prototype
+ *	args[in] - OPTIONAL: SICLE arguments
+ *
+ * RETURNS: Editing session with the final forest
+ */
+iftSICLESession *iftCreateSICLESession
+(iftSICLE *sicle, iftSICLEArgs *args);
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *	session[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftDestroySICLESession
+(iftSICLESession **session);
+
+/*
+ * Creates a superspel hierarchy, running the SICLE algorithm once with the
+ * prototype and arguments provided while recording the order in which the
+ * seeds are removed. Any number of superspels within [1,N0] may be queried
+ * afterwards, each computed by a single differential IFT from the previous 
+ * query's forest. The seed sets are nested, and a seed keeps its label in
+ * every query. Neither the prototype nor the arguments are copied, and they 
+ * must outlive the hierarchy. Neither the RAG merging nor the pyramid are 
+ * supported.
+ *
+ * PARAMETERS:
+ *	sicle[in] - REQUIRED: SICLE prototype
+ *	args[in] - OPTIONAL: SICLE arguments
+ *
+ * RETURNS: Hierarchy with the forest of Nf seeds
+ */
+iftSICLEHierarchy *iftCreateSICLEHierarchy
+(iftSICLE *sicle, iftSICLEArgs *args);
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *	hier[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftDestroySICLEHierarchy
+(iftSICLEHierarchy **hier);
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *	msegm[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftDestroySICLEMultiscale
+(iftSICLEMultiscale **msegm);
+
 //============================================================================|
 // Runner
 //============================================================================|
+/*
+ * Gets the domain of the SICLE prototype and its number of features per spel
+ * (i.e., 3 for Lab or 1 for gray), e.g., for planning its run.
+ *
+ * PARAMETERS
+ * 	sicle[in] - REQUIRED: SICLE prototype
+ * 	xsize, ysize, zsize[out] - REQUIRED: Image dimensions
+ * 	num_feats[out] - OPTIONAL: Number of features per spel
+ */
+void iftGetSICLEDomain
+(iftSICLE *sicle, int *xsize, int *ysize, int *zsize, int *num_feats);
+
 /*
  * Verifies whether the arguments are valid with respect to the SICLE prototype
  * provided. If yes, nothing happens; otherwise, an error is thrown. A set of
@@ -133,6 +385,11 @@ void iftDestroySICLE
  *  5) Adherence (Fsum) >= 0 ;
  *  6) Alpha >= 0 ;
  *  7) Penalization should be none when no saliency is provided ;
+ *  8) Maximum number of sweeps (Raster) >= 1 ;
+ *  9) Pyramid levels >= 0, with N0 below the quantity of coarse spels ;
+ * 10) Out-of-core directory exists, with chunk size and budget >= 1 ;
+ * 11) Edge and spatio-temporal adjacencies only for 3D images ;
+ * 12) Time budget >= 0 ;
  * 
  * PARAMETERS
  * 	sicle[in] - REQUIRED: SICLE prototype
@@ -144,7 +401,12 @@ void iftVerifySICLEArgs
 /*
  * Runs the SICLE algorithm with the prototype and arguments provided, and 
  * returns a label image whose values are within [1,Nf], or [0,Nf] if a mask
- * was provided.
+ * was provided. If pyramid levels are set, the seed removal runs on the 
+ * downsampled image, and only the boundary bands of the projected superspels
+ * are computed in the original resolution. In every mode, the superspels are
+ * connected within the chosen adjacency (e.g., 8-connected by default), 
+ * unless a piece is isolated by the mask. For the pyramid, each piece cut 
+ * off from its seed is absorbed by the adjacent superspel it touches most.
  * 
  * PARAMETERS:
  *  sicle[in] - REQUIRED: SICLE prototype
@@ -156,6 +418,118 @@ void iftVerifySICLEArgs
 iftImage *iftRunSICLE
 (iftSICLE *sicle, iftSICLEArgs *args);
 
+/*
+ * Runs the SICLE algorithm as iftRunSICLE, but within the time budget and 
+ * the cancellation callback of the arguments, which are ignored by every 
+ * other runner. Between iterations, if another one is predicted to exceed the
+ * budget, the current forest is either merged down to Nf superspels (i.e., 
+ * fast finish) or returned as is. The cancellation callback is polled within
+ * the IFT itself, and nothing is returned if it was cancelled. Neither is
+ * supported by the pyramid.
+ * 
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - OPTIONAL: SICLE arguments
+ *  num_iters[out] - OPTIONAL: Number of iterations whose forest was computed
+ *
+ * RETURNS: Superspel segmentation whose labels are within [1,Nf] or [0,Nf]
+ * 	if a mask was provided (or [1,Ni] if the current scale was kept); NULL if
+ * 	it was cancelled
+ */
+iftImage *iftRunAnytimeSICLE
+(iftSICLE *sicle, iftSICLEArgs *args, int *num_iters);
+
+/*
+ * Runs the SICLE algorithm as iftRunSICLE, but writes the label image to the
+ * path provided chunk by chunk, instead of creating it. If an out-of-core 
+ * directory is set, the features, the saliency, the region of interest, the
+ * forest maps and the queue's colors are kept in memory mapped files within
+ * it, and only the most recently used chunks of them are kept resident, 
+ * given the memory budget. Every access is registered to the chunks, thus 
+ * the budget bounds their resident size. The queue's order and a table of 
+ * the seeds are kept in memory instead, whose sizes are proportional to the
+ * largest frontier of an IFT and to N0. The output equals the in-core one.
+ * For bounding the peak memory, the prototype should be created by 
+ * iftReadOutOfCoreSICLE. Only .scn and .pgm (2D) outputs are supported.
+ * 
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - OPTIONAL: SICLE arguments
+ *  path[in] - REQUIRED: Output label image path
+ */
+void iftRunSICLEToFile
+(iftSICLE *sicle, iftSICLEArgs *args, const char *path);
+
+/*
+ * Runs the SICLE algorithm over overlapping square tiles of a 2D binary PNM 
+ * (P5 or P6) image, which are read from disk and segmented in parallel, and
+ * writes the stitched label image to the path provided, row by row. Each 
+ * tile receives quantities of seeds proportional to its area, and the
+ * superspels crossing its left and top seams are merged with the ones of 
+ * its neighbors when they agree within the overlap band. Pieces cut off at
+ * the seams are then absorbed by adjacent superspels, ensuring connectivity.
+ * The identifiers of the whole image are kept in a memory mapped file within
+ * the out-of-core directory (or the output's one, if not set). Thus, the 
+ * resident memory is bounded by the tiles being segmented. The output labels
+ * are within [1,N], where N approximates Nf. Only .scn and .pgm outputs are
+ * supported, and custom Ni values are ignored. With random oversampling, 
+ * the seeds depend on the order in which the tiles are run in parallel.
+ * 
+ * PARAMETERS:
+ *  img_path[in] - REQUIRED: Input image path (.pgm or .ppm)
+ *  args[in] - OPTIONAL: SICLE arguments for the whole image
+ *  tile_size[in] - REQUIRED: Tile width and height (without the overlap)
+ *  overlap[in] - REQUIRED: Overlap width, in pixels, at each side
+ *  path[in] - REQUIRED: Output label image path
+ */
+void iftRunTiledSICLE
+(const char *img_path, iftSICLEArgs *args, int tile_size, int overlap, 
+ const char *path);
+
+/*
+ * Runs the SICLE algorithm on the next frame of the stream. The first frame 
+ * (or one whose dimensions differ from the previous) runs the whole cascade.
+ * The remaining ones start from the previous frame's final seeds, each moved
+ * to the best matching spel (by patch) within a small window around it, plus
+ * seeds sampled among the spels whose features have changed (up to N0 - Nf, 
+ * if all did), and run a single seed removal step before the final IFT. The
+ * labels are persistent identifiers, being kept by the superspels whose 
+ * seeds survive, and never reused otherwise. Thus, they may exceed Nf.
+ * 
+ * PARAMETERS:
+ *  stream[in/out] - REQUIRED: Stream of the previous frames
+ *  sicle[in] - REQUIRED: SICLE prototype of the current frame
+ *
+ * RETURNS: Superspel segmentation whose labels are the persistent 
+ *  identifiers, or 0 outside the mask
+ */
+iftImage *iftRunSICLEStream
+(iftSICLEStream *stream, iftSICLE *sicle);
+
+/*
+ * Runs the SICLE algorithm over a sliding temporal window of a video folder,
+ * which is read window by window, and writes the label image of each frame
+ * once finalized (i.e., as iftWriteVolumeAsSingleVideoFolder, with the 
+ * frame's index appended to the output's basename). Each window of frames is
+ * segmented into supervoxels, and its first frames are the last ones of the
+ * previous window. A supervoxel carries the identifier of the previous one
+ * with which it agrees within those frames (intersection over union above
+ * 0.5), and receives a fresh identifier otherwise. Thus, the resident memory
+ * is bounded by the window length, regardless of the number of frames. The
+ * N0 and Nf values are per window, being proportionally reduced for the 
+ * last one if it is shorter.
+ * 
+ * PARAMETERS:
+ *  folder[in] - REQUIRED: Video folder (or CSV) whose frames are 2D images
+ *  args[in] - OPTIONAL: SICLE arguments for each window
+ *  window[in] - REQUIRED: Window length, in frames (>= 2)
+ *  overlap[in] - REQUIRED: Frames shared by consecutive windows (< window)
+ *  path[in] - REQUIRED: Output label frame path (e.g., out/label.pgm)
+ */
+void iftRunSlidingSICLE
+(const char *folder, iftSICLEArgs *args, int window, int overlap, 
+ const char *path);
+
 /*
  * Runs the SICLE algorithm with the prototype and arguments provided, and 
  * returns a multiscale label image whose values are within [1,Nf], or [0,Nf] 
@@ -173,6 +547,468 @@ iftImage *iftRunSICLE
 iftImage **iftRunMultiscaleSICLE
 (iftSICLE *sicle, iftSICLEArgs *args, int *num_scales);
 
+/*
+ * Runs the SICLE algorithm with the prototype and arguments provided, and 
+ * hands the label image of each scale to the callback as soon as its 
+ * iteration finishes, from the first scale to the last. The labels are 
+ * written within the caller's buffer, whose values are within [1,Ni], or 
+ * [0,Ni] if a mask was provided. Thus, a single label image is kept in 
+ * memory, regardless of the number of scales.
+ * 
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - OPTIONAL: SICLE arguments
+ *  label_img[out] - REQUIRED: Label buffer of the prototype's domain
+ *  callback[in] - REQUIRED: Function receiving each scale
+ *  user[in/out] - OPTIONAL: Data given to the callback
+ *
+ * RETURNS: Number of scales generated
+ */
+int iftRunMultiscaleSICLEWithCallback
+(iftSICLE *sicle, iftSICLEArgs *args, iftImage *label_img, 
+ iftSICLEScaleCallback callback, void *user);
+
+/*
+ * Runs the SICLE algorithm with the prototype and arguments provided, and 
+ * returns a compact multiscale segmentation: the label image of the first
+ * scale, and the parent of each superspel at the next scale. A superspel's 
+ * parent is the one containing its seed, which enforces the scales to nest.
+ * The fraction of spels whose label differs from their nested one is kept for
+ * each scale (0 at the first one). Besides the forest, only two label maps
+ * are kept in memory during the execution.
+ * 
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - OPTIONAL: SICLE arguments
+ *
+ * RETURNS: Compact multiscale superspel segmentation
+ */
+iftSICLEMultiscale *iftRunCompactMultiscaleSICLE
+(iftSICLE *sicle, iftSICLEArgs *args);
+
+/*
+ * Creates the nested label image of a scale of the compact multiscale 
+ * segmentation, whose labels are within [1,Ni], or [0,Ni] if a mask was 
+ * provided.
+ * 
+ * PARAMETERS:
+ *  msegm[in] - REQUIRED: Compact multiscale segmentation
+ *  scale[in] - REQUIRED: Scale index, within [0,num_scales-1]
+ *
+ * RETURNS: Superspel segmentation of the scale
+ */
+iftImage *iftGetSICLEMultiscaleLabels
+(iftSICLEMultiscale *msegm, int scale);
+
+//============================================================================|
+// Session
+//============================================================================|
+/*
+ * Creates a label image of the current forest of the session, whose labels
+ * are within [1,N], or [0,N] if a mask was provided. 
+ *
+ * PARAMETERS:
+ *  session[in] - REQUIRED: Editing session
+ *
+ * RETURNS: Superspel segmentation of the current forest
+ */
+iftImage *iftGetSICLESessionLabels
+(iftSICLESession *session);
+
+/*
+ * Copies the labels of the current forest of the session within the bounding
+ * box to the label image provided (e.g., the region changed by an edit). 
+ *
+ * PARAMETERS:
+ *  session[in] - REQUIRED: Editing session
+ *  bb[in] - REQUIRED: Bounding box to be copied
+ *  label_img[in/out] - REQUIRED: Label image of the session's domain
+ */
+void iftCopySICLESessionLabels
+(iftSICLESession *session, iftBoundingBox bb, iftImage *label_img);
+
+/*
+ * Adds a seed at the given voxel, whose tree competes with the existing ones.
+ *
+ * PARAMETERS:
+ *  session[in/out] - REQUIRED: Editing session
+ *  v_voxel[in] - REQUIRED: Voxel of the new seed, within the mask
+ *  changed[out] - OPTIONAL: Bounding box of the changed region
+ *
+ * RETURNS: Label of the new superspel
+ */
+int iftAddSICLESeed
+(iftSICLESession *session, iftVoxel v_voxel, iftBoundingBox *changed);
+
+/*
+ * Removes the seeds of a superspel, whose spels are conquered by the 
+ * adjacent ones. The last superspel cannot be removed.
+ *
+ * PARAMETERS:
+ *  session[in/out] - REQUIRED: Editing session
+ *  label[in] - REQUIRED: Superspel label
+ *  changed[out] - OPTIONAL: Bounding box of the changed region
+ */
+void iftRemoveSICLESuperspel
+(iftSICLESession *session, int label, iftBoundingBox *changed);
+
+/*
+ * Moves the seeds of a superspel to a single seed at the given voxel, keeping
+ * its label.
+ *
+ * PARAMETERS:
+ *  session[in/out] - REQUIRED: Editing session
+ *  label[in] - REQUIRED: Superspel label
+ *  v_voxel[in] - REQUIRED: Voxel of the new seed, within the mask
+ *  changed[out] - OPTIONAL: Bounding box of the changed region
+ */
+void iftMoveSICLESeed
+(iftSICLESession *session, int label, iftVoxel v_voxel, 
+ iftBoundingBox *changed);
+
+/*
+ * Splits a superspel by adding a seed at the given voxel within it. As any
+ * new seed, it may also conquer spels of the adjacent superspels.
+ *
+ * PARAMETERS:
+ *  session[in/out] - REQUIRED: Editing session
+ *  label[in] - REQUIRED: Superspel label
+ *  v_voxel[in] - REQUIRED: Voxel of the new seed, within the superspel
+ *  changed[out] - OPTIONAL: Bounding box of the changed region
+ *
+ * RETURNS: Label of the new superspel
+ */
+int iftSplitSICLESuperspel
+(iftSICLESession *session, int label, iftVoxel v_voxel, 
+ iftBoundingBox *changed);
+
+/*
+ * Merges a superspel into another, which then has the seeds of both. No tree
+ * is recomputed.
+ *
+ * PARAMETERS:
+ *  session[in/out] - REQUIRED: Editing session
+ *  label[in] - REQUIRED: Label of the merged superspel
+ *  other[in] - REQUIRED: Label of the superspel being merged (then removed)
+ *  changed[out] - OPTIONAL: Bounding box of the changed region
+ */
+void iftMergeSICLESuperspels
+(iftSICLESession *session, int label, int other, iftBoundingBox *changed);
+
+//============================================================================|
+// Hierarchy
+//============================================================================|
+/*
+ * Gets the maximum number of superspels which may be queried (i.e., N0).
+ *
+ * PARAMETERS:
+ *  hier[in] - REQUIRED: Superspel hierarchy
+ *
+ * RETURNS: Number of initial seeds
+ */
+long iftGetSICLEHierarchyMaxNf
+(iftSICLEHierarchy *hier);
+
+/*
+ * Computes the segmentation of the hierarchy with the given number of 
+ * superspels, whose labels are within [1,Nf], or [0,Nf] if a mask was 
+ * provided. Querying the current number again requires no IFT.
+ *
+ * PARAMETERS:
+ *  hier[in/out] - REQUIRED: Superspel hierarchy
+ *  nf[in] - REQUIRED: Number of superspels, within [1,N0]
+ *
+ * RETURNS: Superspel segmentation with Nf superspels
+ */
+iftImage *iftQuerySICLEHierarchy
+(iftSICLEHierarchy *hier, long nf);
+
+//============================================================================|
+// Planner
+//============================================================================|
+/*
+ * Calibrates the cost model of SICLE on this machine by running a short 
+ * synthetic benchmark (a fraction of a second).
+ *
+ * RETURNS: Machine's calibration
+ */
+iftSICLECalib iftCalibrateSICLE
+();
+
+/*
+ * Reads a calibration saved by iftWriteSICLECalib.
+ *
+ * PARAMETERS:
+ *  path[in] - REQUIRED: Path to the calibration file
+ *
+ * RETURNS: Machine's calibration
+ */
+iftSICLECalib iftReadSICLECalib
+(const char *path);
+
+/*
+ * Writes the calibration as a text file of "key value" lines.
+ *
+ * PARAMETERS:
+ *  calib[in] - REQUIRED: Machine's calibration
+ *  path[in] - REQUIRED: Path to the calibration file
+ */
+void iftWriteSICLECalib
+(iftSICLECalib *calib, const char *path);
+
+/*
+ * Predicts the wall-clock time and the peak memory of running SICLE on an 
+ * image with the given dimensions. The time model assumes the heap engine, 
+ * while the memory is estimated analytically from the data structures.
+ *
+ * PARAMETERS:
+ *  calib[in] - REQUIRED: Machine's calibration
+ *  args[in] - REQUIRED: SICLE arguments
+ *  xsize[in] - REQUIRED: Image width
+ *  ysize[in] - REQUIRED: Image height
+ *  zsize[in] - REQUIRED: Image depth (1, if 2D)
+ *  num_feats[in] - REQUIRED: Number of features per spel (e.g., 3 for Lab)
+ *  time[out] - OPTIONAL: Predicted time (in seconds)
+ *  memory[out] - OPTIONAL: Predicted peak memory (in bytes)
+ */
+void iftPredictSICLE
+(iftSICLECalib *calib, iftSICLEArgs *args, int xsize, int ysize, int zsize,
+ int num_feats, double *time, size_t *memory);
+
+/*
+ * Chooses the largest N0 and, then, the most iterations for which SICLE is 
+ * predicted to fit within the limits, and overwrites them in the arguments 
+ * (removing any user-defined schedule). If none fits, the cheapest 
+ * candidate is kept.
+ *
+ * PARAMETERS:
+ *  calib[in] - REQUIRED: Machine's calibration
+ *  xsize[in] - REQUIRED: Image width
+ *  ysize[in] - REQUIRED: Image height
+ *  zsize[in] - REQUIRED: Image depth (1, if 2D)
+ *  num_feats[in] - REQUIRED: Number of features per spel
+ *  max_time[in] - REQUIRED: Time limit (in seconds), or 0 if none
+ *  max_memory[in] - REQUIRED: Memory limit (in bytes), or 0 if none
+ *  args[in/out] - REQUIRED: SICLE arguments to be planned
+ *
+ * RETURNS: Whether the limits are predicted to be met
+ */
+bool iftPlanSICLE
+(iftSICLECalib *calib, int xsize, int ysize, int zsize, int num_feats, 
+ double max_time, size_t max_memory, iftSICLEArgs *args);
+
+//============================================================================|
+// Sweep
+//============================================================================|
+/*
+ * Runs SICLE with each parametrization on the same prototype. The seeds and
+ * the first forest are computed once for the parametrizations agreeing on 
+ * them (i.e., same N0, sampling, connectivity, adjacency and engine), and 
+ * each one continues from a copy of it, in parallel if OpenMP is enabled. 
+ * Thus, such parametrizations share the same random seeds, which are drawn 
+ * from the generator's default seed, as in a standalone run. Pyramid runs 
+ * are computed on their own, and out-of-core runs are not supported.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - REQUIRED: Array of SICLE arguments
+ *  num_args[in] - REQUIRED: Number of SICLE arguments
+ *
+ * RETURNS: Array of superspel segmentations, one per parametrization (NULL
+ *		if its run was cancelled)
+ */
+iftImage **iftRunSICLESweep
+(iftSICLE *sicle, iftSICLEArgs **args, int num_args);
+
+//============================================================================|
+// Checkpoint
+//============================================================================|
+/*
+ * Runs the schedule of SICLE until the given iteration, and writes its seeds
+ * and forest as a binary checkpoint, which is mapped in place when resumed.
+ * Out-of-core and pyramid runs are not supported.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - OPTIONAL: SICLE arguments
+ *  num_iters[in] - REQUIRED: Iterations to be computed (1 = first forest)
+ *  path[in] - REQUIRED: Path to the checkpoint file
+ */
+void iftRunSICLEToCheckpoint
+(iftSICLE *sicle, iftSICLEArgs *args, int num_iters, const char *path);
+
+/*
+ * Resumes SICLE from a checkpoint of the same prototype and connectivity 
+ * parameters. If the schedule of the arguments passes by the checkpoint, it
+ * is continued (thus, the result is the same as of an uninterrupted run); 
+ * otherwise, a new schedule goes from the checkpoint's seeds to Nf. An error
+ * is raised if the checkpoint was computed from other features, saliency or
+ * mask, with another adjacency, connectivity function, irregularity, 
+ * adherence or alpha, or if its seeds or forest are out of range.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - OPTIONAL: SICLE arguments, with Nf up to the checkpoint's seeds
+ *  path[in] - REQUIRED: Path to the checkpoint file
+ *
+ * RETURNS: Superspel segmentation, or NULL if it was cancelled
+ */
+iftImage *iftResumeSICLE
+(iftSICLE *sicle, iftSICLEArgs *args, const char *path);
+
+//============================================================================|
+// Batch
+//============================================================================|
+/*
+ * Segments every image of a directory or CSV file through a pipeline of 
+ * three stages (decoding, segmentation and encoding), each one on its own
+ * threads and linked by bounded queues, so the I/O of some images overlaps 
+ * the segmentation of others. Each segmentation thread reuses its maps for
+ * images of the same (or smaller) size. The seeds are sampled as in a 
+ * single run, thus the outputs do not depend on the number of threads. 
+ * Out-of-core and pyramid runs are not supported.
+ *
+ * PARAMETERS:
+ *  input[in] - REQUIRED: Directory or CSV file of the images
+ *  args[in] - OPTIONAL: SICLE arguments shared by every image
+ *  out_pattern[in] - REQUIRED: Output path with a single %s, replaced by the
+ *		image's filename without extension (e.g., "out/%s.pgm")
+ *  num_readers[in] - REQUIRED: Number of decoding threads (at least 1)
+ *  num_threads[in] - REQUIRED: Number of segmentation threads (0 = cores)
+ *  num_writers[in] - REQUIRED: Number of encoding threads (at least 1)
+ *  files[out] - OPTIONAL: Images, in the order of the times
+ *
+ * RETURNS: Wall-clock time (in seconds) of each image, from its decoding to
+ *		its writing, or -1 if it could not be read or segmented (e.g., too 
+ *		small for the arguments), which is warned without stopping the batch
+ */
+iftFloatArray *iftRunSICLEBatch
+(const char *input, iftSICLEArgs *args, const char *out_pattern, 
+ int num_readers, int num_threads, int num_writers, iftFileSet **files);
+
+/*
+ * Selects the files of a shard, for splitting a dataset among processes 
+ * (e.g., nodes of a cluster). A file belongs to the shard of its name's 
+ * hash (without extension), thus the assignment is the same in every 
+ * process, whatever the mount point, and new files do not move the others
+ * among shards. An image and its label image fall in the same shard.
+ *
+ * PARAMETERS:
+ *  files[in] - REQUIRED: Files of the whole dataset
+ *  shard[in] - REQUIRED: Index of the shard, within [0,num_shards[
+ *  num_shards[in] - REQUIRED: Number of shards (at least 1)
+ *
+ * RETURNS: Copy of the shard's files, in the given order
+ */
+iftFileSet *iftSelectSICLEShard
+(const iftFileSet *files, int shard, int num_shards);
+
+/*
+ * Same as iftRunSICLEBatch, on a shard of the images (see 
+ * iftSelectSICLEShard), listing each written output in a manifest. If the
+ * manifest exists, the images whose outputs match their entry (i.e., size
+ * and hash) are skipped, thus a failed run is resumed by repeating it.
+ *
+ * PARAMETERS:
+ *  input[in] - REQUIRED: Directory or CSV file of the images
+ *  args[in] - OPTIONAL: SICLE arguments shared by every image
+ *  out_pattern[in] - REQUIRED: Output path with a single %s, replaced by the
+ *		image's filename without extension (e.g., "out/%s.pgm")
+ *  shard[in] - REQUIRED: Index of the shard, within [0,num_shards[
+ *  num_shards[in] - REQUIRED: Number of shards (1 = every image)
+ *  manifest[in] - OPTIONAL: CSV file of the written outputs, with lines 
+ *		"input,output,bytes,hash,time", which is appended
+ *  num_readers[in] - REQUIRED: Number of decoding threads (at least 1)
+ *  num_threads[in] - REQUIRED: Number of segmentation threads (0 = cores)
+ *  num_writers[in] - REQUIRED: Number of encoding threads (at least 1)
+ *  files[out] - OPTIONAL: Images of the shard, in the order of the times
+ *
+ * RETURNS: Wall-clock time (in seconds) of each image, from its decoding to
+ *		its writing, or -1 if it was skipped or failed (see iftRunSICLEBatch)
+ */
+iftFloatArray *iftRunShardedSICLEBatch
+(const char *input, iftSICLEArgs *args, const char *out_pattern, int shard, 
+ int num_shards, const char *manifest, int num_readers, int num_threads, 
+ int num_writers, iftFileSet **files);
+
+//============================================================================|
+// Daemon
+//============================================================================|
+/*
+ * Serves SICLE requests on a Unix domain socket until a stop request (see
+ * iftStopSICLEDaemon), avoiding the start-up of a process per image. Each 
+ * worker thread keeps its maps warm across requests, and the seeds are 
+ * sampled as in a single run. An invalid request is answered with an error,
+ * without stopping the daemon. The arguments are received as raw structs,
+ * thus clients must be built against the same version of SICLE. The socket
+ * is created with mode 0600, thus only its owner may send requests.
+ *
+ * PARAMETERS:
+ *  socket_path[in] - REQUIRED: Path of the socket to be created
+ *  num_threads[in] - REQUIRED: Number of worker threads (0 = cores)
+ */
+void iftRunSICLEDaemon
+(const char *socket_path, int num_threads);
+
+/*
+ * Requests a segmentation to a SICLE daemon, either of an image file (read
+ * by the daemon) or of an image handed off through shared memory (i.e., 
+ * without encoding it). The saliency map and the mask, if any, are always 
+ * handed off through shared memory, and must have the image's domain. The 
+ * labels are returned through shared memory as well. Out-of-core, pyramid 
+ * and cancellable runs are not supported.
+ *
+ * PARAMETERS:
+ *  socket_path[in] - REQUIRED: Path of the daemon's socket
+ *  img_path[in] - OPTIONAL: Path to the image (if img is NULL)
+ *  img[in] - OPTIONAL: Image to be handed off (if img_path is NULL)
+ *  objsm[in] - OPTIONAL: Grayscale object saliency map
+ *  mask[in] - OPTIONAL: Binary mask indicating the region of interest
+ *  args[in] - OPTIONAL: SICLE arguments
+ *
+ * RETURNS: Superspel segmentation
+ */
+iftImage *iftRequestSICLEDaemon
+(const char *socket_path, const char *img_path, iftImage *img, 
+ iftImage *objsm, iftImage *mask, iftSICLEArgs *args);
+
+/*
+ * Stops a SICLE daemon once its pending requests are served.
+ *
+ * PARAMETERS:
+ *  socket_path[in] - REQUIRED: Path of the daemon's socket
+ */
+void iftStopSICLEDaemon
+(const char *socket_path);
+
+//============================================================================|
+// Buffer
+//============================================================================|
+/*
+ * Runs SICLE on a caller-owned buffer, writing the labels (within [1,N]) 
+ * into another one. The spel features are computed straight from the 
+ * buffer, without an intermediate image (thus, color spels are converted 
+ * from RGB to Lab without YCbCr), and the forest is labeled straight into 
+ * the output. Gray spels keep their values (floats are scaled to 255). 
+ * Out-of-core runs are not supported. Since it is meant for embedding, 
+ * invalid buffers or arguments are reported to the caller instead of 
+ * aborting the process.
+ *
+ * PARAMETERS:
+ *  in[in] - REQUIRED: Gray, RGB, BGR or Lab (float only) spels
+ *  args[in] - OPTIONAL: SICLE arguments
+ *  labels[out] - REQUIRED: Gray INT32 or UINT16 buffer of the same domain
+ *  msg[out] - OPTIONAL: Buffer of IFT_STR_DEFAULT_SIZE chars for the reason 
+ *                       of a failure (e.g., an invalid argument, or 
+ *                       "Cancelled")
+ *
+ * RETURNS: Whether the labels were written (i.e., the buffers and arguments
+ *          are valid, and the run was not cancelled)
+ */
+bool iftRunSICLEOnBuffer
+(const iftSICLEBuffer *in, iftSICLEArgs *args, iftSICLEBuffer *labels, 
+ char *msg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -198,6 +198,30 @@ void iftShuffleIntArray(int* array, int n)
     }
 }
 
+iftIdxArray *iftCreateIdxArray(long n) 
+{
+    iftIdxArray *iarr = (iftIdxArray*) iftAlloc(1, sizeof(iftIdxArray));
+    
+    iarr->n = n;
+    iarr->val = (iftIdx*) iftAlloc(n, sizeof(iftIdx));
+    if (iarr->val == NULL && n > 0)
+        iftError(MSG_MEMORY_ALLOC_ERROR, "iftCreateIdxArray");
+    
+    return iarr;
+}
+
+void iftDestroyIdxArray(iftIdxArray **iarr) 
+{
+    if (iarr != NULL && *iarr != NULL) {
+        iftIdxArray *iarr_aux = *iarr;
+        
+        if (iarr_aux->val != NULL)
+            iftFree(iarr_aux->val);
+        iftFree(iarr_aux);
+        *iarr = NULL;
+    }
+}
+
 // ---------- iftIntArray.c end
 // ---------- iftFloatArray.c start
 
@@ -846,10 +870,10 @@ iftColor iftHSVtoRGB(iftColor cin, int normalization_value)
 // ---------- iftColor.c end
 // ---------- iftDHeap.c start
 
-iftDHeap *iftCreateDHeap(int n, double *value) 
+iftDHeap *iftCreateDHeap(iftIdx n, double *value) 
 {
     iftDHeap *H = NULL;
-    int i;
+    iftIdx i;
     
     if (value == NULL) {
         iftError("Cannot create heap without priority value map", "iftCreateDHeap");
@@ -860,8 +884,8 @@ iftDHeap *iftCreateDHeap(int n, double *value)
         H->n       = n;
         H->value   = value;
         H->color   = (char *) iftAlloc(sizeof(char), n);
-        H->node    = (int *) iftAlloc(sizeof(int), n);
-        H->pos     = (int *) iftAlloc(sizeof(int), n);
+        H->node    = (iftIdx *) iftAlloc(sizeof(iftIdx), n);
+        H->pos     = (iftIdx *) iftAlloc(sizeof(iftIdx), n);
         H->last    = -1;
         H->removal_policy = MINVALUE;
         if (H->color == NULL || H->pos == NULL || H->node == NULL)
@@ -907,7 +931,7 @@ char iftEmptyDHeap(iftDHeap *H)
     }
 }
 
-char iftInsertDHeap(iftDHeap *H, int node) 
+char iftInsertDHeap(iftDHeap *H, iftIdx node) 
 {
     
     if (!iftFullDHeap(H)) {
@@ -924,9 +948,9 @@ char iftInsertDHeap(iftDHeap *H, int node)
     
 }
 
-int iftRemoveDHeap(iftDHeap *H) 
+iftIdx iftRemoveDHeap(iftDHeap *H) 
 {
-    int node= IFT_NIL;
+    iftIdx node= IFT_NIL;
     
     if (!iftEmptyDHeap(H)) {
         node = H->node[0];
@@ -945,7 +969,7 @@ int iftRemoveDHeap(iftDHeap *H)
     
 }
 
-void    iftRemoveDHeapElem(iftDHeap *H, int pixel)
+void    iftRemoveDHeapElem(iftDHeap *H, iftIdx pixel)
 {
     
     if(H->pos[pixel] == -1)
@@ -966,9 +990,9 @@ void    iftRemoveDHeapElem(iftDHeap *H, int pixel)
     
 }
 
-void  iftGoUpDHeap(iftDHeap *H, int i) 
+void  iftGoUpDHeap(iftDHeap *H, iftIdx i) 
 {
-    int j = iftDad(i);
+    iftIdx j = iftDad(i);
     
     if(H->removal_policy == MINVALUE){
         
@@ -992,9 +1016,9 @@ void  iftGoUpDHeap(iftDHeap *H, int i)
     }
 }
 
-void iftGoDownDHeap(iftDHeap *H, int i) 
+void iftGoDownDHeap(iftDHeap *H, iftIdx i) 
 {
-    int j, left = iftLeftSon(i), right = iftRightSon(i);
+    iftIdx j, left = iftLeftSon(i), right = iftRightSon(i);
     
     j = i;
     if(H->removal_policy == MINVALUE){
@@ -1026,7 +1050,7 @@ void iftGoDownDHeap(iftDHeap *H, int i)
 
 void iftResetDHeap(iftDHeap *H)
 {
-    int i;
+    iftIdx i;
     
     for (i=0; i < H->n; i++) {
         H->color[i] = IFT_WHITE;
@@ -1199,7 +1223,7 @@ iftFile *iftCopyFile(const iftFile* file) {
 // ---------- iftFile.c end
 // ---------- iftBMap.c start
 
-iftBMap *iftCreateBMap(int n) 
+iftBMap *iftCreateBMap(iftIdx n) 
 {
     iftBMap *b;
     b= (iftBMap *) iftAlloc(1,sizeof(iftBMap));
@@ -1278,7 +1302,7 @@ iftImage *iftReadImageByExt(const char *format, ...)
 
 iftImage  *iftCreateImage(int xsize,int ysize,int zsize) 
 {
-    int *val = iftAllocIntArray(xsize*ysize*zsize);
+    int *val = iftAllocIntArray((long)xsize*ysize*zsize);
 
     return iftCreateImageFromBuffer(xsize, ysize, zsize, val);
 }
@@ -1381,14 +1405,14 @@ int iftMinimumValue(const iftImage *img)
 {
     int img_min_val = IFT_INFINITY_INT;
 
-    for (int p = 0; p < img->n; p++)
+    for (iftIdx p = 0; p < img->n; p++)
         if (img_min_val > img->val[p])
             img_min_val = img->val[p];
 
     return img_min_val;
 }
 
-inline iftVoxel iftGetVoxelCoord(const iftImage *img, int p)
+inline iftVoxel iftGetVoxelCoord(const iftImage *img, iftIdx p)
 {
     /* old
      * u.x = (((p) % (((img)->xsize)*((img)->ysize))) % (img)->xsize)
@@ -1396,8 +1420,8 @@ inline iftVoxel iftGetVoxelCoord(const iftImage *img, int p)
      * u.z = ((p) / (((img)->xsize)*((img)->ysize)))
      */
     iftVoxel u;
-    div_t res1 = div(p, img->xsize * img->ysize);
-    div_t res2 = div(res1.rem, img->xsize);
+    iftIdxDiv res1 = iftDivIdx(p, (iftIdx)img->xsize * img->ysize);
+    iftIdxDiv res2 = iftDivIdx(res1.rem, img->xsize);
 
     u.x = res2.rem;
     u.y = res2.quot;
@@ -1468,7 +1492,8 @@ iftImage *iftReadImage(const char *format, ...)
     ushort   *data16 = NULL;
     int      *data32 = NULL;
     char     type[10];
-    int      p, v, xsize, ysize, zsize;
+    iftIdx   p;
+    int      v, xsize, ysize, zsize;
 
     va_list args;
     char    filename[IFT_STR_DEFAULT_SIZE];
@@ -1502,21 +1527,21 @@ iftImage *iftReadImage(const char *format, ...)
 
         if (v == 8) {
             data8 = iftAllocUCharArray(img->n);
-            if (fread(data8, sizeof(uchar), img->n, fp) != (uint)img->n)
+            if (fread(data8, sizeof(uchar), img->n, fp) != (size_t)img->n)
                 iftError("Reading error", "iftReadImage");
             for (p = 0; p < img->n; p++)
                 img->val[p] = (int) data8[p];
             iftFree(data8);
         } else if (v == 16) {
             data16 = iftAllocUShortArray(img->n);
-            if (fread(data16, sizeof(ushort), img->n, fp) != (uint)img->n)
+            if (fread(data16, sizeof(ushort), img->n, fp) != (size_t)img->n)
                 iftError("Reading error 16 bits", "iftReadImage");
             for (p = 0; p < img->n; p++)
                 img->val[p] = (int) data16[p];
             iftFree(data16);
         } else if (v == 32) {
             data32 = iftAllocIntArray(img->n);
-            if (fread(data32, sizeof(int), img->n, fp) != (uint)img->n)
+            if (fread(data32, sizeof(int), img->n, fp) != (size_t)img->n)
                 iftError("Reading error", "iftReadImage");
             for (p = 0; p < img->n; p++)
                 img->val[p] = data32[p];
@@ -1628,7 +1653,7 @@ iftImage* iftReadImagePNG(const char* format, ...)
 
     int x, y;
 
-    int p = 0;
+    iftIdx p = 0;
 
     if(color_type==PNG_COLOR_TYPE_GRAY)//gray image
     {
@@ -2008,7 +2033,8 @@ iftImage *iftReadImageP5(const char *format, ...)
     uchar    *data8  = NULL;
     ushort   *data16 = NULL;
     char     type[10];
-    int      p, v, xsize, ysize, zsize, hi, lo;
+    iftIdx   p;
+    int      v, xsize, ysize, zsize, hi, lo;
 
     va_list args;
     char    filename[IFT_STR_DEFAULT_SIZE];
@@ -2045,7 +2071,7 @@ iftImage *iftReadImageP5(const char *format, ...)
         if ((v <= 255) && (v > 0)) {
             data8 = iftAllocUCharArray(img->n);
 
-            if (fread(data8, sizeof(uchar), img->n, fp) != (uint)img->n)
+            if (fread(data8, sizeof(uchar), img->n, fp) != (size_t)img->n)
                 iftError("Reading error", "iftReadImageP5");
 
             for (p = 0; p < img->n; p++)
@@ -2086,7 +2112,8 @@ iftImage *iftReadImageP6(const char *format, ...)
     iftImage  *img=NULL;
     FILE    *fp=NULL;
     char    type[10];
-    int     p,v,xsize,ysize,zsize;
+    iftIdx  p;
+    int     v,xsize,ysize,zsize;
     ushort rgb16[3];
     iftColor RGB,YCbCr;
 
@@ -2174,7 +2201,8 @@ iftImage *iftReadImageP2(const char *format, ...)
     iftImage *img = NULL;
     FILE     *fp  = NULL;
     char     type[10];
-    int      p, v, xsize, ysize, zsize;
+    iftIdx   p;
+    int      v, xsize, ysize, zsize;
 
     va_list args;
     char    filename[IFT_STR_DEFAULT_SIZE];
@@ -2221,7 +2249,8 @@ iftImage *iftReadImageP2(const char *format, ...)
 iftImage *iftCreateImageFromBuffer(int xsize, int ysize, int zsize, int *val) 
 {
     iftImage *img = NULL;
-    int      y, z, xysize;
+    int      y, z;
+    iftIdx   xysize;
 
     img = (iftImage *) iftAlloc(1, sizeof(iftImage));
     if (img == NULL) {
@@ -2237,9 +2266,9 @@ iftImage *iftCreateImageFromBuffer(int xsize, int ysize, int zsize, int *val)
     img->dx    = 1.0;
     img->dy    = 1.0;
     img->dz    = 1.0;
-    img->tby   = iftAllocIntArray(ysize);
-    img->tbz   = iftAllocIntArray(zsize);
-    img->n     = xsize * ysize * zsize;
+    img->tby   = (iftIdx *) iftAlloc(ysize, sizeof(iftIdx));
+    img->tbz   = (iftIdx *) iftAlloc(zsize, sizeof(iftIdx));
+    img->n     = (iftIdx) xsize * ysize * zsize;
 
     if (img->val == NULL || img->tbz == NULL || img->tby == NULL) {
         iftError(MSG_MEMORY_ALLOC_ERROR, "iftCreateImage");
@@ -2250,7 +2279,7 @@ iftImage *iftCreateImageFromBuffer(int xsize, int ysize, int zsize, int *val)
         img->tby[y] = img->tby[y - 1] + xsize;
 
     img->tbz[0] = 0;
-    xysize = xsize * ysize;
+    xysize = (iftIdx) xsize * ysize;
     for (z = 1; z < zsize; z++)
         img->tbz[z] = img->tbz[z - 1] + xysize;
 
@@ -2259,7 +2288,7 @@ iftImage *iftCreateImageFromBuffer(int xsize, int ysize, int zsize, int *val)
 
 void iftCopyImageInplace(const iftImage *src, iftImage *dest) 
 {
-    int p;
+    iftIdx p;
 
     iftVerifyImageDomains(src, dest, "iftCopyImageInplace");
 
@@ -2283,7 +2312,7 @@ void iftCopyImageInplace(const iftImage *src, iftImage *dest)
 void iftWriteImage(const iftImage *img, const char *format, ...) 
 {
     FILE   *fp     = NULL;
-    int    p;
+    iftIdx p;
     uchar  *data8  = NULL;
     ushort *data16 = NULL;
     int    *data32 = NULL;
@@ -2347,7 +2376,8 @@ void iftWriteImage(const iftImage *img, const char *format, ...)
 void iftWriteImageP5(const iftImage *img, const char *format, ...) 
 {
     FILE   *fp     = NULL;
-    int    p, hi, lo;
+    iftIdx p;
+    int    hi, lo;
     uchar  *data8  = NULL;
     ushort *data16 = NULL;
 
@@ -2404,7 +2434,7 @@ void iftWriteImageP5(const iftImage *img, const char *format, ...)
 void iftWriteImageP6(const iftImage *img, const char *format, ...) 
 {
     FILE     *fp = NULL;
-    int      p;
+    iftIdx   p;
     ushort   rgb16[3];
     iftColor YCbCr, RGB;
 
@@ -2479,7 +2509,7 @@ void iftWriteImageP6(const iftImage *img, const char *format, ...)
 void iftWriteImageP2(const iftImage *img, const char *format, ...) 
 {
     FILE *fp = NULL;
-    int  p;
+    iftIdx p;
 
     va_list args;
     char    filename[IFT_STR_DEFAULT_SIZE];
@@ -2619,7 +2649,7 @@ void iftWriteImagePNG(const iftImage* img, const char* format, ...)
         row_pointers[y] = (png_byte*) iftAlloc(width, numberOfChannels*byteshift);
 
     if(color_type == PNG_COLOR_TYPE_GRAY){
-        int p = 0;
+        iftIdx p = 0;
         for (int y = 0; y < height; ++y) {
             png_byte* row = row_pointers[y];
             for (int x=0; x<width; x++) {
@@ -2636,7 +2666,7 @@ void iftWriteImagePNG(const iftImage* img, const char* format, ...)
             }
         }
     }else if(color_type == PNG_COLOR_TYPE_GRAY_ALPHA){
-        int p = 0;
+        iftIdx p = 0;
         for (int y = 0; y < height; ++y) {
             png_byte* row = row_pointers[y];
             for (int x=0; x<width; x++) {
@@ -2661,7 +2691,7 @@ void iftWriteImagePNG(const iftImage* img, const char* format, ...)
         }
     }else if(color_type == PNG_COLOR_TYPE_RGB){
         iftColor rgb, ycbcr;
-        int p = 0;
+        iftIdx p = 0;
         for (int y = 0; y < height; ++y) {
             png_byte* row = row_pointers[y];
             for (int x=0; x<width; x++) {
@@ -2693,7 +2723,7 @@ void iftWriteImagePNG(const iftImage* img, const char* format, ...)
 
     }else if(color_type == PNG_COLOR_TYPE_RGB_ALPHA){
         iftColor rgb, ycbcr;
-        int p = 0;
+        iftIdx p = 0;
         for (int y = 0; y < height; ++y) {
             png_byte* row = row_pointers[y];
             for (int x=0; x<width; x++) {
@@ -2892,7 +2922,7 @@ int iftMaximumValueInRegion(const iftImage *img, iftBoundingBox bb)
     for (v.z = bb.begin.z; v.z <= bb.end.z; v.z++) {
         for (v.y = bb.begin.y; v.y <= bb.end.y; v.y++) {
             for (v.x = bb.begin.x; v.x <= bb.end.x; v.x++) {
-                int p = iftGetVoxelIndex(img, v);
+                iftIdx p = iftGetVoxelIndex(img, v);
                 if (img_max_val < img->val[p]) {
                     img_max_val = img->val[p];
                 }
@@ -2905,13 +2935,13 @@ int iftMaximumValueInRegion(const iftImage *img, iftBoundingBox bb)
 
 void iftSetImage(iftImage *img, int value) 
 {
-    for (int p = 0; p < img->n; p++)
+    for (iftIdx p = 0; p < img->n; p++)
         img->val[p] = value;
 }
 
 void  iftSetAlpha(iftImage *img, ushort value)
 {
-    int p;
+    iftIdx p;
     if(img->alpha == NULL){
         img->alpha = iftAllocUShortArray(img->n);
     }
@@ -2923,7 +2953,7 @@ void  iftSetAlpha(iftImage *img, ushort value)
 
 void    iftSetCbCr(iftImage *img, ushort value)
 {
-    int p;
+    iftIdx p;
 
     if (!iftIsColorImage(img)){
         img->Cb = iftAllocUShortArray(img->n);
@@ -2965,7 +2995,7 @@ void iftMinMaxValues(const iftImage *img, int *min, int *max)
 {
     *min = *max = img->val[0];
 
-    for (int p = 1; p < img->n; p++) {
+    for (iftIdx p = 1; p < img->n; p++) {
         if (img->val[p] < *min)
             *min = img->val[p];
         else if (img->val[p] > *max)
@@ -3003,7 +3033,7 @@ iftImage  *iftCreateColorImage(int xsize,int ysize,int zsize, int depth)
 void iftPutXYSlice(iftImage *img, const iftImage *slice, int zcoord)
 {
     iftVoxel  u;
-    int       p,q;
+    iftIdx    p,q;
 
     if ( (zcoord < 0) || (zcoord >= img->zsize))
         iftError("Invalid z coordinate", "iftPutXYSlice");
@@ -3035,7 +3065,7 @@ iftImage *iftGetXYSlice(const iftImage *img, int zcoord)
 {
     iftImage *slice;
     iftVoxel  u;
-    int       p,q;
+    iftIdx    p,q;
 
     if ( (zcoord < 0) || (zcoord >= img->zsize))
         iftError("Invalid z coordinate", "iftGetXYSlice");
@@ -3072,16 +3102,16 @@ iftImage *iftBMapToBinImage(const iftBMap *bmap, int xsize, int ysize, int zsize
     if (bmap == NULL)
         iftError("Bin Map is NULL", "iftBMapToBinImage");
 
-    int n = xsize * ysize * zsize;
+    iftIdx n = (iftIdx) xsize * ysize * zsize;
 
     if (bmap->n != n)
         iftError("Image Domain is != of the Bin Map Size\n" \
-                 "Img Domain: (%d, %d, %d) = %d spels\nBin Map: %d elems", "iftBMapToBinImage",
-                 xsize, ysize, zsize, n, bmap->n);
+                 "Img Domain: (%d, %d, %d) = %ld spels\nBin Map: %ld elems", "iftBMapToBinImage",
+                 xsize, ysize, zsize, (long)n, (long)bmap->n);
 
     iftImage *bin = iftCreateImage(xsize, ysize, zsize);
 
-    for (int p = 0; p < bmap->n; p++)
+    for (iftIdx p = 0; p < bmap->n; p++)
         bin->val[p] = iftBMapValue(bmap, p)*255;
 
     return bin;
@@ -3094,7 +3124,7 @@ iftBMap *iftBinImageToBMap(const iftImage *bin_img) {
 
     iftBMap *bmap = iftCreateBMap(bin_img->n);
 
-    for (int i = 0; i < bin_img->n; i++)
+    for (iftIdx i = 0; i < bin_img->n; i++)
         if (bin_img->val[i])
             iftBMapSet1(bmap, i);
 
@@ -3104,7 +3134,7 @@ iftBMap *iftBinImageToBMap(const iftImage *bin_img) {
 // ---------- iftImage.c end 
 // ---------- iftMatrix.c start 
 
-iftMatrix *iftCreateMatrix(int ncols, int nrows) 
+iftMatrix *iftCreateMatrix(int ncols, iftIdx nrows) 
 {
     iftMatrix *M = (iftMatrix *) iftAlloc(1, sizeof(iftMatrix));
     
@@ -3157,14 +3187,16 @@ void iftDestroyMatrix(iftMatrix **M)
 iftMImage * iftCreateMImage(int xsize,int ysize,int zsize, int nbands)
 {
   iftMImage *img=NULL;
-  int        i,y,z,xysize;
+  iftIdx     i;
+  int        y,z;
+  iftIdx     xysize;
 
   img = (iftMImage *) iftAlloc(1,sizeof(iftMImage));
   if (img == NULL){
       iftError(MSG_MEMORY_ALLOC_ERROR, "iftCreateMImage");
   }
 
-  img->n       = xsize*ysize*zsize;
+  img->n       = (iftIdx)xsize*ysize*zsize;
   img->m       = nbands;
   img->data    = iftCreateMatrix(img->m, img->n);
   img->val     = iftAlloc(img->n, sizeof *img->val);
@@ -3176,14 +3208,14 @@ iftMImage * iftCreateMImage(int xsize,int ysize,int zsize, int nbands)
   img->dx      = 1.0;
   img->dy      = 1.0;
   img->dz      = 1.0;
-  img->tby     = iftAllocIntArray(ysize);
-  img->tbz     = iftAllocIntArray(zsize);
+  img->tby     = (iftIdx *) iftAlloc(ysize, sizeof(iftIdx));
+  img->tbz     = (iftIdx *) iftAlloc(zsize, sizeof(iftIdx));
 
   img->tby[0]=0;
   for (y=1; y < ysize; y++)
     img->tby[y]=img->tby[y-1] + xsize;
 
-  img->tbz[0]=0; xysize = xsize*ysize;
+  img->tbz[0]=0; xysize = (iftIdx)xsize*ysize;
   for (z=1; z < zsize; z++)
     img->tbz[z]=img->tbz[z-1] + xysize;
 
@@ -3221,7 +3253,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       img2->val[p][0]=((float)img1->val[p]);
       img2->val[p][1]=((float)img1->Cb[p]);
       img2->val[p][2]=((float)img1->Cr[p]);
@@ -3235,7 +3267,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       img2->val[p][0]=((float)img1->val[p])/(float)normalization_value;
       img2->val[p][1]=((float)img1->Cb[p])/(float)normalization_value;
       img2->val[p][2]=((float)img1->Cr[p])/(float)normalization_value;
@@ -3249,7 +3281,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       iftColor  YCbCr,RGB;
       iftFColor Lab;
       YCbCr.val[0] = img1->val[p];
@@ -3270,7 +3302,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-      for (int p=0; p < img2->n; p++) {
+      for (iftIdx p=0; p < img2->n; p++) {
         iftColor  YCbCr,RGB;
         iftFColor Lab;
         YCbCr.val[0] = img1->val[p];
@@ -3291,7 +3323,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       iftColor  YCbCr,RGB;
       iftFColor LabNorm;
       YCbCr.val[0] = img1->val[p];
@@ -3312,7 +3344,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       iftColor YCbCr,RGB;
       YCbCr.val[0] = img1->val[p];
       YCbCr.val[1] = img1->Cb[p];
@@ -3331,7 +3363,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       iftColor YCbCr,RGB;
       YCbCr.val[0] = img1->val[p];
       YCbCr.val[1] = img1->Cb[p];
@@ -3350,7 +3382,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       img2->val[p][0]=((float)img1->val[p]);
     }
     break;
@@ -3362,7 +3394,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       img2->val[p][0]=((float)img1->val[p])/(float)normalization_value;
     }
 
@@ -3376,7 +3408,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       img2->val[p][0]=(0.2/2.2)*((float)img1->val[p]/(float)normalization_value);
       img2->val[p][1]=(1.0/2.2)*((float)img1->Cb[p]/(float)normalization_value);
       img2->val[p][2]=(1.0/2.2)*((float)img1->Cr[p]/(float)normalization_value);
@@ -3390,7 +3422,7 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 #if IFT_OMP
 #pragma omp parallel for shared(img1, img2, normalization_value)
 #endif
-    for (int p=0; p < img2->n; p++) {
+    for (iftIdx p=0; p < img2->n; p++) {
       iftColor  YCbCr,RGB;
       iftColor HSV;
       YCbCr.val[0] = img1->val[p];
@@ -3419,7 +3451,8 @@ iftMImage * iftImageToMImage(const iftImage *img1, char color_space)
 iftImage * iftMImageToImage(const iftMImage *img1, int Imax, int band)
 {
   iftImage *img2=iftCreateImage(img1->xsize,img1->ysize,img1->zsize);
-  int p,b=band;
+  iftIdx p;
+  int b=band;
   double min = IFT_INFINITY_FLT, max = IFT_INFINITY_FLT_NEG;
 
   if ((band < 0)||(band >= img1->m))
@@ -3451,7 +3484,7 @@ iftImage * iftMImageToImage(const iftMImage *img1, int Imax, int band)
   return(img2);
 }
 
-inline iftVoxel iftMGetVoxelCoord(const iftMImage *img, int p)
+inline iftVoxel iftMGetVoxelCoord(const iftMImage *img, iftIdx p)
 {
     /* old
      * u.x = (((p) % (((img)->xsize)*((img)->ysize))) % (img)->xsize)
@@ -3459,8 +3492,8 @@ inline iftVoxel iftMGetVoxelCoord(const iftMImage *img, int p)
      * u.z = ((p) / (((img)->xsize)*((img)->ysize)))
      */
     iftVoxel u;
-    div_t res1 = div(p, img->xsize * img->ysize);
-    div_t res2 = div(res1.rem, img->xsize);
+    iftIdxDiv res1 = iftDivIdx(p, (iftIdx)img->xsize * img->ysize);
+    iftIdxDiv res2 = iftDivIdx(res1.rem, img->xsize);
 
     u.x = res2.rem;
     u.y = res2.quot;
@@ -3480,7 +3513,8 @@ inline char iftMValidVoxel(const iftMImage *img, iftVoxel v)
 }
 
 float iftMMaximumValue(const iftMImage *img, int band) {
-  int b, i;
+  int b;
+  iftIdx i;
   float max_val = IFT_INFINITY_FLT_NEG;
 
   if(band < 0) {
@@ -3662,7 +3696,7 @@ iftImage *iftThreshold(const iftImage *img, int lowest, int highest, int value)
 {
     iftImage *bin = iftCreateImageFromImage(img);
 
-    for (int p = 0; p < img->n; p++) 
+    for (iftIdx p = 0; p < img->n; p++) 
         if ((img->val[p] >= lowest) && (img->val[p] <= highest))
             bin->val[p] = value;
         else bin->val[p] = 0;
@@ -3674,7 +3708,8 @@ iftImage *iftBorderImage(const iftImage *label, bool get_margins)
 {
  iftAdjRel *A;
  iftImage  *border = iftCreateImage(label->xsize,label->ysize,label->zsize);
- int        p,q,i; 
+ iftIdx     p,q;
+ int        i; 
  iftVoxel   u, v;
     
   if (iftIs3DImage(label))
@@ -3721,7 +3756,7 @@ iftImage *iftBorderImage(const iftImage *label, bool get_margins)
 // ---------- iftSegmentation.c end
 // ---------- iftSet.c start 
 
-void iftInsertSet(iftSet **S, int elem)
+void iftInsertSet(iftSet **S, iftIdx elem)
 {
     iftSet *p=NULL;
     
@@ -3737,10 +3772,10 @@ void iftInsertSet(iftSet **S, int elem)
     *S = p;
 }
 
-int iftRemoveSet(iftSet **S)
+iftIdx iftRemoveSet(iftSet **S)
 {
     iftSet *p;
-    int elem = IFT_NIL;
+    iftIdx elem = IFT_NIL;
     
     if (*S != NULL){
         p    =  *S;
@@ -3752,7 +3787,7 @@ int iftRemoveSet(iftSet **S)
     return(elem);
 }
 
-void iftRemoveSetElem(iftSet **S, int elem)
+void iftRemoveSetElem(iftSet **S, iftIdx elem)
 {
     if (S == NULL || *S == NULL)
         return;
@@ -3822,7 +3857,7 @@ iftSet* iftSetConcat(iftSet *S1,iftSet *S2)
     return S;
 }
 
-char iftUnionSetElem(iftSet **S, int elem)
+char iftUnionSetElem(iftSet **S, iftIdx elem)
 {
     iftSet *aux=*S;
     
@@ -3863,7 +3898,7 @@ iftSet* iftSetCopy(iftSet* S)
     return iftSetUnion(S,0);
 }
 
-int iftSetHasElement(iftSet *S, int elem)
+int iftSetHasElement(iftSet *S, iftIdx elem)
 {
     iftSet *s = S;
     while(s){
@@ -3876,12 +3911,12 @@ int iftSetHasElement(iftSet *S, int elem)
     return 0;
 }
 
-iftIntArray *iftSetToArray(iftSet *S) {
+iftIdxArray *iftSetToArray(iftSet *S) {
     int n_elems = iftSetSize(S);
-    iftIntArray *array = iftCreateIntArray(n_elems);
+    iftIdxArray *array = iftCreateIdxArray(n_elems);
     
     iftSet *sp = S;
-    int i      = 0;
+    long i     = 0;
     while (sp != NULL) {
         array->val[i++] = sp->elem;
         sp = sp->next;
@@ -5424,7 +5459,7 @@ void iftConvertNewBitDepth(iftImage **img, int new_depth)
     #if IFT_OMP
     #pragma omp parallel for
     #endif
-    for(int p = 0; p < (*img)->n; ++p)
+    for(iftIdx p = 0; p < (*img)->n; ++p)
     {
         iftColor rgb, new_ycbcr;
 
@@ -5492,7 +5527,7 @@ iftBMap *iftGetBorderMap
   #if IFT_OMP //-------------------------------------------------------------//
   #pragma omp parallel for
   #endif //------------------------------------------------------------------//
-  for(int p = 0; p < label_img->n; ++p)
+  for(iftIdx p = 0; p < label_img->n; ++p)
   {
     bool is_border;
     int i;
@@ -5510,7 +5545,7 @@ iftBMap *iftGetBorderMap
 
       if(iftValidVoxel(label_img, adj_vxl) == true)
       {
-        int adj_idx;
+        iftIdx adj_idx;
 
         adj_idx = iftGetVoxelIndex(label_img, adj_vxl);
 
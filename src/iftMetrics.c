@@ -46,7 +46,7 @@ int **iftMetrics_CalcLabelGTIntersec
     assert(inter[i] != NULL);
   }
 
-  for(int p = 0; p < label_img->n; ++p)
+  for(iftIdx p = 0; p < label_img->n; ++p)
   {
     int label, gt;
 
@@ -87,14 +87,14 @@ iftImage *iftRelabelImage
   queue = NULL;
   visited = iftCreateBMap(label_img->n);
 
-  for(int p = 0; p < label_img->n; ++p)
+  for(iftIdx p = 0; p < label_img->n; ++p)
   {
     if(!iftBMapValue(visited, p))  
     {
       iftInsertSet(&queue, p); ++new_label;
       while(queue != NULL)
       {
-        int x;
+        iftIdx x;
         iftVoxel x_vxl;
 
         x = iftRemoveSet(&queue);
@@ -110,7 +110,7 @@ iftImage *iftRelabelImage
 
           if(iftValidVoxel(label_img, y_vxl))
           {
-            int y;
+            iftIdx y;
 
             y = iftGetVoxelIndex(label_img, y_vxl);
 
@@ -156,7 +156,7 @@ float iftEvalCO
   else
   { A = iftCircular(sqrtf(2.0)); }
 	
-  for(int p = 0; p < label_img->n; ++p)
+  for(iftIdx p = 0; p < label_img->n; ++p)
   {
     bool is_border;
     int p_label;
@@ -227,7 +227,7 @@ float iftEvalCD
   #ifdef IFT_OMP //-----------------------------------------------------------|
   #pragma omp parallel for reduction(+:count_borders)
   #endif //-------------------------------------------------------------------|
-  for(int p = 0; p < label_img->n; ++p)
+  for(iftIdx p = 0; p < label_img->n; ++p)
   {
     bool is_border;
     iftVoxel p_vxl;
@@ -292,7 +292,7 @@ float iftEvalEV
     assert(mean_sup[i] != NULL);  
   }
 
-  for(int p = 0; p < orig_img->n; ++p)
+  for(iftIdx p = 0; p < orig_img->n; ++p)
   {
     int p_label;
 
@@ -323,7 +323,7 @@ float iftEvalEV
   #ifdef IFT_OMP //-----------------------------------------------------------|
   #pragma omp parallel for reduction(+:img_diff)
   #endif //-------------------------------------------------------------------|
-  for(int p = 0; p < orig_img->n; ++p)
+  for(iftIdx p = 0; p < orig_img->n; ++p)
   {
     float dist;
 
@@ -479,7 +479,7 @@ float iftEvalBR
   #ifdef IFT_OMP //-----------------------------------------------------------|
   #pragma omp parallel for reduction(+:tp, fn)
   #endif //-------------------------------------------------------------------|
-  for(int p = 0; p < label_img->n; ++p)
+  for(iftIdx p = 0; p < label_img->n; ++p)
   {
     bool is_label_border, is_gt_border;
     iftVoxel p_vxl;
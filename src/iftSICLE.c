@@ -8,6 +8,17 @@
 \*****************************************************************************/
 #include "iftSICLE.h"
 
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
 //############################################################################|
 // 
 //	MACROS
@@ -16,10 +27,25 @@
 #define IFTSICLE_NIL IFT_INFINITY_INT_NEG // Temporary nil predecessor
 #define IFTSICLE_BKGCOST IFT_INFINITY_DBL_NEG // Impede conquering
 #define IFTSICLE_TMPCOST IFT_INFINITY_DBL // Temporary cost
+#define IFTSICLE_TRACK_RADIUS 3.0 // Stream: Seed search radius (in spels)
+#define IFTSICLE_POLL_PERIOD 65536 // Anytime: Spels between cancellation polls
+#define IFTSICLE_BENCH_SIZE 256 // Planner: Side of the benchmark image
+#define IFTSICLE_CKPT_MAGIC "SICLECKP" // Checkpoint: File signature
+#define IFTSICLE_CKPT_VERSION 2 // Checkpoint: File format version
+#define IFTSICLE_DAEMON_MAGIC "SICLERQ2" // Daemon: Request signature
+#define IFTSICLE_DAEMON_BACKLOG 64 // Daemon: Pending connections
+#define IFTSICLE_DAEMON_MAX_NI 4096 // Daemon: Ni values per request
+#define IFTSICLE_DECODE_ROWS 64 // Decode: Rows read at once
+#define IFTSICLE_CACHE_MAGIC "SICLEFTC" // Cache: File signature
+#define IFTSICLE_CACHE_VERSION 1 // Cache: File format (and features) version
+#define IFTSICLE_FAULT_AROUND 65536 // Out-of-core: Window mapped per page fault
 
 // Encapsulate for readability
 #define iftSICLE_InROI(sicle,v_index) \
 	((sicle)->roi == NULL || iftBMapValue((sicle)->roi, (v_index)))
+// Computed on the fly, since the row tables are released out-of-core
+#define iftSICLE_GetFeats(sicle,v_index) \
+	((sicle)->mimg->data->val + (long)(v_index) * (sicle)->mimg->m)
 // Exploit the unused seed's predecessor for storing its label (2's complement)
 #define iftSICLE_GetRootLabel(data,v_index) \
 	(-(((data)->pred_map[(data)->root_map[(v_index)]]) + 1))
@@ -29,23 +55,185 @@
 //	STRUCTS, ENUMS, UNIONS & TYPEDEFS
 //
 //############################################################################|
+typedef struct _iftsicle_mmap
+{
+	int fd; // Descriptor of the (unlinked) backing file
+	size_t elem_size; // Size of each spel's element (in bytes)
+	size_t bytes; // Mapped length (in bytes)
+	void *addr; // Mapped address
+} iftSICLE_MMap;
+
+typedef struct _iftsicle_qnode
+{
+	double key; // Path cost when queued
+	iftIdx v_index; // Queued spel
+	long slot; // Its slot within the position table
+} iftSICLE_QNode;
+
+typedef struct _iftsicle_qslot
+{
+	iftIdx v_index; // Queued spel, or IFT_NIL if the slot is empty
+	long pos; // Its position within the queue
+} iftSICLE_QSlot;
+
+typedef struct _iftsicle_pager
+{
+	int num_chunks; // Number of chunks
+	int max_resident; // Maximum number of resident chunks (memory budget)
+	int num_resident; // Number of resident chunks
+	int last_chunk; // Most recently touched chunk
+	int num_feats; // Number of features per spel
+	long chunk_vtx; // Number of spels per chunk
+	long chunk_bytes; // Size of a chunk over every mapping (in bytes)
+	long clock; // Logical clock for the least-recently used policy
+	long *last_use; // Chunk's last use, or 0 if not resident
+	iftSICLE_MMap *root_mmap, *pred_mmap, *cost_mmap; // Owned
+	iftSICLE_MMap *color_mmap; // Owned: Colors of the heap
+	iftSICLE_MMap *comp_mmap; // Owned: Components, for enforcing connectivity
+	iftSICLE_MMap *stamp_mmap; // Raster: Owned sweep stamps, NULL otherwise
+	iftSICLE_MMap *feats_mmap, *sal_mmap, *roi_mmap; // Borrowed from SICLE
+	iftDHeap *heap; // Colors are mapped, and its order is kept by the queue
+	int table_bits; // Base-2 logarithm of the position table's size
+	long queue_cap; // Capacity of the queue
+	iftSICLE_QNode *queue; // Binary heap of the queued spels (in-core)
+	iftSICLE_QSlot *table; // Position of the queued spels (open addressing)
+	long num_seeds; // Seed table: Quantity of roots
+	iftIdx *seed_idx; // Seed table: Roots in ascending order
+	int *seed_label; // Seed table: Their labels
+	float *seed_feats, *seed_sal; // Seed table: Their features and saliency
+} iftSICLE_Pager;
+
 struct ift_sicle_alg
 {
 	float *sal; // Spel saliency 
 	iftMImage *mimg; // Spel features
 	iftBMap *roi; // Bit-map region of interest (ROI)
+	iftSICLE_MMap *feats_mmap; // Out-of-core: Mapped features
+	iftSICLE_MMap *sal_mmap; // Out-of-core: Mapped saliency
+	iftSICLE_MMap *roi_mmap; // Out-of-core: Mapped ROI bit-map
 };
 
+typedef struct _iftsicle_workspace
+{
+	long capacity; // Number of spels the maps may hold
+	iftIdx *root_map, *pred_map; // Reusable root and predecessor maps
+	double *cost_map; // Reusable cost map
+} iftSICLE_Workspace;
+
 typedef struct _iftsicle_iftdata
 {
-	int num_vtx; // Number of vertices
-	int *root_map; // Root map
-	int *pred_map; // "Predecessor and label" map for memory efficiency.
+	iftIdx num_vtx; // Number of vertices
+	iftIdx *root_map; // Root map
+	iftIdx *pred_map; // "Predecessor and label" map for memory efficiency.
 	double *cost_map; // Cost map
-	iftIntArray *seeds; // Seeds at current iteration 
+	iftIdxArray *seeds; // Seeds at current iteration 
 	iftAdjRel *A; // Adjacency relation
+	iftSICLE_Pager *pager; // Out-of-core: Chunk cache of the mapped maps
+	void *ckpt_addr; // Checkpoint: Private mapping of the maps, NULL if none
+	iftSICLE_Workspace *ws; // Batch: Workspace lending the maps, NULL if none
+	size_t ckpt_bytes; // Checkpoint: Mapped length (in bytes)
+	bool cancelled; // Anytime: Whether the computation was cancelled
+	int num_iters; // Anytime: Number of iterations whose forest was computed
+	double deadline; // Anytime: Wall-clock deadline (in seconds), 0 if none
+	iftSICLECancel cancel; // Anytime: Cancellation callback, NULL if none
+	void *cancel_data; // Anytime: Data given to the cancellation callback
 } iftSICLE_IFTData;
 
+typedef struct _iftsicle_queue
+{
+	int capacity; // Maximum number of queued items
+	int head; // Position of the oldest item
+	int num_items; // Number of queued items
+	int num_producers; // Producers which may still push items
+	void **items; // Circular buffer of items
+	pthread_mutex_t lock; // Guards the whole queue
+	pthread_cond_t not_empty, not_full; // Signaled once it changes
+} iftSICLE_Queue;
+
+typedef struct _iftsicle_batch_job
+{
+	long file_id; // Index of the image within the batch
+	double start; // Wall-clock time (in seconds) at which it was read
+	iftSICLE *sicle; // Decoded prototype, until segmented
+	iftImage *segm; // Superspel segmentation, until written
+} iftSICLE_BatchJob;
+
+typedef struct _iftsicle_manifest_entry
+{
+	char *out_path; // Path of the written output
+	long num_bytes; // Size (in bytes) of the output once written
+	ullong hash; // FNV-1a hash of the output's bytes once written
+} iftSICLE_ManifestEntry;
+
+typedef struct _iftsicle_batch
+{
+	long next; // Next image to be read
+	iftFileSet *files; // Input images
+	iftSICLEArgs *args; // Arguments shared by every image
+	const char *out_pattern; // Output path, with a %s for the image's name
+	iftFloatArray *times; // Wall-clock time (in seconds) of each image
+	iftSICLE_Queue *decoded; // Images read, to be segmented
+	iftSICLE_Queue *segmented; // Segmentations, to be written
+	FILE *manifest; // Manifest of the written outputs, NULL if none
+	long num_done; // Resume: Number of entries of the previous manifest
+	iftSICLE_ManifestEntry *done; // Resume: Its entries, sorted by output
+	pthread_mutex_t lock; // Guards the next image, the random generator and 
+	                      // the manifest
+} iftSICLE_Batch;
+
+typedef struct _iftsicle_ckpt_header
+{
+	char magic[8]; // File signature (without null terminator)
+	int version; // File format version
+	int idx_size; // Size of the indexes (in bytes)
+	int xsize, ysize, zsize; // Image domain
+	int num_iters; // Number of iterations whose forest was computed
+	long num_vtx; // Number of vertices
+	long num_seeds; // Number of seeds of the forest
+	long num_init; // Number of initial seeds (i.e., the schedule's N0)
+	ullong input_hash; // Hash of the features, saliency and ROI
+	int adjopt, connopt; // Adjacency relation and connectivity function
+	int adhr; // Boundary adherence factor
+	float irreg, alpha; // Irregularity factor and saliency importance
+	char padding[12]; // Up to 96 bytes, for aligning the arrays
+} iftSICLE_CkptHeader;
+
+typedef enum _iftsicle_req_kind
+{
+	IFTSICLE_REQ_PATH, // Segment the image file of the given path
+	IFTSICLE_REQ_SHM, // Segment the image in the given shared memory object
+	IFTSICLE_REQ_STOP // Stop the daemon once the pending requests are served
+} iftSICLE_ReqKind;
+
+typedef struct _iftsicle_request
+{
+	char magic[8]; // Request signature (without null terminator)
+	int kind; // Kind of request (see iftSICLE_ReqKind)
+	int args_size; // Size of the arguments, for rejecting other builds
+	int num_ni; // Number of user-defined Ni values sent after the request
+	int xsize, ysize, zsize; // Shared memory: Domain of the image and priors
+	bool is_color; // Shared memory: Whether the Cb and Cr follow the Y
+	char name[IFT_STR_DEFAULT_SIZE]; // Image path or shared memory name
+	char objsm_name[IFT_STR_DEFAULT_SIZE]; // Saliency's shared memory, if any
+	char mask_name[IFT_STR_DEFAULT_SIZE]; // Mask's shared memory, if any
+	iftSICLEArgs args; // SICLE arguments, whose pointers are meaningless
+} iftSICLE_Request;
+
+typedef struct _iftsicle_response
+{
+	bool ok; // Whether the image was segmented
+	int xsize, ysize, zsize; // Domain of the label image
+	char name[IFT_STR_DEFAULT_SIZE]; // Labels' shared memory name, or error
+} iftSICLE_Response;
+
+typedef struct _iftsicle_daemon
+{
+	int listen_fd; // Listening socket
+	bool stopping; // Whether a stop request was received
+	iftSICLE_Queue *conns; // Accepted connections, to be served
+	pthread_mutex_t lock; // Guards the stopping flag and the random generator
+} iftSICLE_Daemon;
+
 typedef struct _iftsicle_tstats
 {
   int num_trees; // Number of trees/superspels
@@ -55,9 +243,111 @@ typedef struct _iftsicle_tstats
   float *sal; // Tree's/superspel's mean saliency
   float **feats; // Tree's/superspel's mean features
   float **centr; // Tree's/superspel's centroid
-  iftBMap **adj; // Tree's/superspel's adjacents
+  int **adj; // Tree's/superspel's adjacents
+  int *num_adj; // Number of adjacents of the tree/superspel
+  int *max_adj; // Capacity of the respective list of adjacents
 } iftSICLE_TStats;
 
+typedef struct _iftsicle_rag
+{
+	int num_alive; // Number of regions not absorbed
+	int *parent; // Region absorbing the respective one (itself, if alive)
+	int *mark; // Region marked while gathering the adjacents (IFT_NIL, if none)
+	iftIdxArray *seeds; // Seeds of the initial trees
+	iftSICLE_TStats *tstats; // Region statistics and adjacency
+} iftSICLE_RAG;
+
+typedef struct _iftsicle_pnm
+{
+	char *path; // File path
+	bool is_color; // Whether it is a P6 (i.e., color) file
+	int xsize, ysize; // Image dimensions
+	int max_val; // Maximum sample value
+	int val_bytes; // Bytes per sample
+	long offset; // Offset of the first sample (in bytes)
+} iftSICLE_PNM;
+
+typedef struct _iftsicle_cache_header
+{
+	char magic[8]; // File signature
+	int version; // File format version
+	int xsize, ysize, zsize; // Image dimensions
+	int num_feats; // Number of features per spel
+	int has_sal; // Whether the saliency follows the features
+	ullong key; // Hash of the inputs
+	long feats_offset, sal_offset; // Page-aligned offsets (in bytes)
+} iftSICLE_CacheHeader;
+
+typedef struct _iftsicle_lablut
+{
+	int norm_val; // Maximum channel value
+	float *xyz; // White-normalized XYZ of each (channel, value); NULL if 16-bit
+} iftSICLE_LabLUT;
+
+typedef struct _iftsicle_tile
+{
+	int x0, y0, xsize, ysize; // Extended region (i.e., with the overlap)
+	int cx0, cy0, cxsize, cysize; // Core region (i.e., its own spels)
+	int id; // Index of the tile, in raster order
+	int num_labels; // Number of superspels of the tile
+	int *left, *top; // Identifiers within the left and top overlap bands
+} iftSICLE_Tile;
+
+/*
+ * Visits the forest computed at a scale of the multiscale segmentation (i.e., 
+ * at the end of an iteration), before its seeds are removed.
+ */
+typedef void (*iftSICLE_ScaleFunc)
+(iftSICLE *sicle, iftSICLE_IFTData *data, int scale, int num_scales, void *ctx);
+
+typedef struct _iftsicle_callback
+{
+	iftImage *label_img; // Label buffer owned by the caller
+	iftSICLEScaleCallback callback; // User's callback
+	void *user; // User's data
+} iftSICLE_Callback;
+
+typedef struct _iftsicle_compact
+{
+	int *nest_label; // Nested label of each spel at the previous scale
+	iftIdxArray *prev_seeds; // Previous seeds, whose labels are their ids + 1
+	iftSICLEMultiscale *msegm; // Compact segmentation being built
+} iftSICLE_Compact;
+
+struct ift_sicle_stream
+{
+	bool own_args; // Whether the arguments were created by the stream
+	float change_thr; // Minimum feature distance of a changed spel
+	int next_id; // Next persistent identifier to be assigned
+	int xsize, ysize, zsize; // Dimensions of the previous frame
+	float *prev_feats; // Spel features of the previous frame
+	iftSICLEArgs *args; // SICLE arguments
+	iftIdxArray *seeds; // Final seeds of the previous frame
+	iftIntArray *ids; // Persistent identifier of each seed
+};
+
+struct ift_sicle_session
+{
+	bool own_args; // Whether the arguments were created by the session
+	int next_label; // Next label to be assigned
+	iftSICLE *sicle; // SICLE prototype (borrowed)
+	iftSICLEArgs *args; // SICLE arguments
+	iftIntArray *labels; // Label of each seed
+	iftDHeap *heap; // Priority queue reused by every edit
+	iftSICLE_IFTData *data; // Current forest
+};
+
+struct ift_sicle_hier
+{
+	bool own_args; // Whether the arguments were created by the hierarchy
+	long cur_nf; // Number of seeds of the current forest
+	iftSICLE *sicle; // SICLE prototype (borrowed)
+	iftSICLEArgs *args; // SICLE arguments
+	iftIdxArray *order; // Initial seeds, from the first removed to the last one
+	iftDHeap *heap; // Priority queue reused by every query
+	iftSICLE_IFTData *data; // Current forest
+};
+
 //############################################################################|
 // 
 //	PRIVATE METHODS
@@ -73,17 +363,17 @@ typedef struct _iftsicle_tstats
  *
  * PARAMETERS:
  *  args[in] - REQUIRED: SICLE arguments
+ *  real_n0[in] - REQUIRED: Number of seeds actually sampled
  *
  * RETURNS: Array containing the values of Nf throughout the execution
  */
 iftIntArray *iftSICLE_CreateNiArray
-(iftSICLEArgs *args, iftSICLE_IFTData *data)
+(iftSICLEArgs *args, int real_n0)
 {
-	int num_iters, real_n0;
+	int num_iters;
 	float omega;
 	iftIntArray *ni;
 
-	real_n0 = data->seeds->n;
 	omega = 1.0/((float)args->max_iters - 1); // Exponential decay
 
 	if(args->user_ni == NULL)
@@ -114,9 +404,356 @@ iftIntArray *iftSICLE_CreateNiArray
 	return ni;
 }
 
+/*
+ * Gets the adjacency option in effect, given that the deprecated flag of 
+ * diagonal neighbors, once unset, replaces the full adjacency by the axial.
+ *
+ * PARAMETERS:
+ *  args[in] - REQUIRED: SICLE arguments
+ *
+ * RETURNS: Adjacency option
+ */
+iftSICLEAdj iftSICLE_GetAdjOpt
+(iftSICLEArgs *args)
+{
+	if(args->adjopt == IFT_SICLE_ADJ_FULL && args->use_diag == false)
+	{ return IFT_SICLE_ADJ_AXIS; }
+	
+	return args->adjopt;
+}
+
+/*
+ * Creates the adjacency relation of the IFT, given the image dimension and
+ * the option set in the arguments. The central spel is always the first.
+ *
+ * PARAMETERS:
+ *  args[in] - REQUIRED: SICLE arguments
+ *  is_3d[in] - REQUIRED: Whether the image is 3D
+ *
+ * RETURNS: Adjacency relation
+ */
+iftAdjRel *iftSICLE_CreateAdjRel
+(iftSICLEArgs *args, bool is_3d)
+{
+	iftSICLEAdj adjopt;
+	iftAdjRel *A;
+
+	A = NULL;
+	adjopt = iftSICLE_GetAdjOpt(args);
+	if(adjopt == IFT_SICLE_ADJ_FULL)
+	{
+		if(is_3d == true) { A = iftSpheric(sqrtf(3.0)); }
+		else { A = iftCircular(sqrtf(2.0)); }
+	}
+	else if(adjopt == IFT_SICLE_ADJ_AXIS)
+	{
+		if(is_3d == true) { A = iftSpheric(1.0); }
+		else { A = iftCircular(1.0); }
+	}
+	else if(adjopt == IFT_SICLE_ADJ_EDGE && is_3d == true)
+	{ A = iftSpheric(sqrtf(2.0)); }
+	else if(adjopt == IFT_SICLE_ADJ_ST && is_3d == true)
+	{
+		iftAdjRel *B;
+
+		B = iftCircular(sqrtf(2.0)); // Spatial neighbors, within the frame
+		A = iftCreateAdjRel(B->n + 2);
+		for(int i = 0; i < B->n; ++i)
+		{ A->dx[i] = B->dx[i]; A->dy[i] = B->dy[i]; A->dz[i] = 0; }
+		A->dx[B->n] = A->dy[B->n] = 0; A->dz[B->n] = -1; // Previous frame
+		A->dx[B->n + 1] = A->dy[B->n + 1] = 0; A->dz[B->n + 1] = 1; // Next frame
+		iftDestroyAdjRel(&B);
+	}
+	else { iftError("Unknown or unsupported adjacency option", __func__); }
+
+	return A;
+}
+
+/*
+ * Gets the current wall-clock time from a monotonic clock.
+ *
+ * RETURNS: Time in seconds
+ */
+double iftSICLE_GetWallTime
+()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Polls the cancellation callback of the IFT data once every poll period. 
+ * If the cancellation is requested, the IFT data is marked as cancelled.
+ *
+ * PARAMETERS:
+ *  data[in/out] - REQUIRED: IFT auxiliary data
+ *  num_spels[in/out] - REQUIRED: Spels processed since the last poll
+ *  num_new[in] - REQUIRED: Spels processed since the last call
+ *
+ * RETURNS: Whether the computation was cancelled
+ */
+bool iftSICLE_PollCancel
+(iftSICLE_IFTData *data, long *num_spels, long num_new)
+{
+	if(data->cancel == NULL) { return false; }
+
+	(*num_spels) += num_new;
+	if((*num_spels) >= IFTSICLE_POLL_PERIOD)
+	{
+		(*num_spels) = 0;
+		if(data->cancel(data->cancel_data) == true) { data->cancelled = true; }
+	}
+
+	return data->cancelled;
+}
+
+/*
+ * Predicts whether the next iteration would exceed the deadline of the IFT
+ * data, assuming it takes the average time of the previous ones (the first
+ * iteration, which is not differential, makes it conservative).
+ *
+ * PARAMETERS:
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  start[in] - REQUIRED: Wall-clock time at which the iterations started
+ *
+ * RETURNS: Whether there is no time for another iteration
+ */
+bool iftSICLE_IsOutOfTime
+(iftSICLE_IFTData *data, double start)
+{
+	double elapsed;
+
+	if(data->deadline <= 0 || data->num_iters == 0) { return false; }
+
+	elapsed = iftSICLE_GetWallTime() - start;
+
+	return start + elapsed + elapsed / data->num_iters > data->deadline;
+}
+
+/*
+ * Expands the bounding box in order to contain the given voxel. An empty box
+ * has its beginning after its end.
+ *
+ * PARAMETERS:
+ *  bb[in/out] - REQUIRED: Bounding box to be expanded
+ *  v_voxel[in] - REQUIRED: Voxel to be contained
+ */
+void iftSICLE_ExpandBBox
+(iftBoundingBox *bb, iftVoxel v_voxel)
+{
+	bb->begin.x = iftMin(bb->begin.x, v_voxel.x);
+	bb->begin.y = iftMin(bb->begin.y, v_voxel.y);
+	bb->begin.z = iftMin(bb->begin.z, v_voxel.z);
+	bb->end.x = iftMax(bb->end.x, v_voxel.x);
+	bb->end.y = iftMax(bb->end.y, v_voxel.y);
+	bb->end.z = iftMax(bb->end.z, v_voxel.z);
+}
+
+/*
+ * Verifies the SICLE arguments (see iftVerifySICLEArgs), without aborting.
+ *
+ * PARAMETERS:
+ * 	sicle[in] - REQUIRED: SICLE prototype
+ * 	args[in] - REQUIRED: SICLE arguments
+ *  msg[out] - REQUIRED: Buffer of IFT_STR_DEFAULT_SIZE chars for the error
+ *
+ * RETURNS: Whether an invalid argument was found
+ */
+bool iftSICLE_FindArgsError
+(iftSICLE *sicle, iftSICLEArgs *args, char *msg)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL); assert(args != NULL); assert(msg != NULL);
+	#endif //-------------------------------------------------------------------|
+	const int SIZE = IFT_STR_DEFAULT_SIZE;
+	iftIdx num_vtx;
+
+	// Options from untrusted sources (e.g., the daemon) may be out of range
+	if((int)args->samplopt < IFT_SICLE_SAMPL_RND || 
+		 (int)args->samplopt > IFT_SICLE_SAMPL_CUSTOM ||
+		 (int)args->connopt < IFT_SICLE_CONN_FMAX || 
+		 (int)args->connopt > IFT_SICLE_CONN_CUSTOM ||
+		 (int)args->critopt < IFT_SICLE_CRIT_SIZE || 
+		 (int)args->critopt > IFT_SICLE_CRIT_CUSTOM ||
+		 (int)args->penopt < IFT_SICLE_PEN_NONE || 
+		 (int)args->penopt > IFT_SICLE_PEN_CUSTOM ||
+		 (int)args->engineopt < IFT_SICLE_ENGINE_HEAP || 
+		 (int)args->engineopt > IFT_SICLE_ENGINE_RASTER ||
+		 (int)args->adjopt < IFT_SICLE_ADJ_FULL || 
+		 (int)args->adjopt > IFT_SICLE_ADJ_ST)
+	{
+		snprintf(msg, SIZE, "Unknown sampling, connectivity, criterion, "
+						 "penalization, engine or adjacency option\n");
+		return true;
+	}
+
+	if(sicle->roi == NULL) { num_vtx = sicle->mimg->n; }
+	else
+	{
+		num_vtx = 0;
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for
+		#endif //-----------------------------------------------------------------|
+		for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+		{ if(iftBMapValue(sicle->roi, v_index) == true) { num_vtx++; } }
+	}
+
+	if(args->n0 >= num_vtx || args->n0 <= 2)
+	{ 
+		snprintf(msg, SIZE, "Invalid N0 value of %d. It must be within ]2,%ld[\n",
+						 args->n0, (long)num_vtx); 
+		return true;
+	}
+
+	if(args->nf >= args->n0)
+	{ 
+		snprintf(msg, SIZE, "Invalid Nf value of %d. It must be within [2,%d[\n",
+						 args->nf, args->n0); 
+		return true;
+	}
+
+	if(args->max_iters < 2)
+	{
+		snprintf(msg, SIZE, "Invalid quantity of %d iterations. It must be >= 2\n",
+						 args->max_iters); 	
+		return true;
+	}
+
+	if(args->irreg < 0.0)
+	{
+		snprintf(msg, SIZE, "Invalid irregularity value of %f. It must be >= 0\n",
+						 args->irreg); 	
+		return true;
+	}
+
+	if(args->adhr < 0)
+	{
+		snprintf(msg, SIZE, "Invalid boundary adherence value of %d. It must be "
+						 ">= 0\n", args->adhr); 	
+		return true;
+	}
+
+	if(args->alpha < 0.0)
+	{
+		snprintf(msg, SIZE, "Invalid boosting factor of %f. It must be within "
+						 "[0,1]\n", args->alpha); 	
+		return true;
+	}
+
+	if(args->user_ni != NULL)
+	{
+		if(args->user_ni->val[0] >= args->n0 || 
+			args->user_ni->val[args->user_ni->n - 1] <= args->nf)
+		{
+			snprintf(msg, SIZE, "intermediary values must be within "
+							 "]N0,...,Ni,...,Nf[\n");	
+			return true;
+		}
+		for(long i = 1; i < args->user_ni->n; ++i)
+		{
+			if(args->user_ni->val[i-1] <= args->user_ni->val[i])
+			{
+				snprintf(msg, SIZE, "Ni values must be strictly decreasing\n");
+				return true;
+			}
+		}
+	}
+	if(sicle->sal == NULL && args->penopt != IFT_SICLE_PEN_NONE)
+	{
+		snprintf(msg, SIZE, "Penalization cannot be used without a saliency "
+						 "map\n"); 	
+		return true;
+	}
+
+	if(args->engineopt == IFT_SICLE_ENGINE_RASTER && args->max_sweeps < 1)
+	{
+		snprintf(msg, SIZE, "Invalid quantity of %d sweeps. It must be >= 1\n",
+						 args->max_sweeps);
+		return true;
+	}
+
+	if(args->ooc_path != NULL)
+	{
+		if(iftDirExists(args->ooc_path) == false)
+		{ 
+			snprintf(msg, SIZE, "Directory %s does not exist\n", args->ooc_path); 
+			return true;
+		}
+		if(args->ooc_chunk < 1 || args->ooc_budget < 1)
+		{
+			snprintf(msg, SIZE, "Invalid chunk size of %d or memory budget of %d "
+							 "MiB. They must be >= 1\n", args->ooc_chunk, args->ooc_budget);
+			return true;
+		}
+	}
+
+	if((args->adjopt == IFT_SICLE_ADJ_EDGE || args->adjopt == IFT_SICLE_ADJ_ST) &&
+		 iftIs3DMImage(sicle->mimg) == false)
+	{
+		snprintf(msg, SIZE, "Edge and spatio-temporal adjacencies require a 3D "
+						 "image\n");
+		return true;
+	}
+
+	if(args->time_budget < 0.0)
+	{
+		snprintf(msg, SIZE, "Invalid time budget of %f s. It must be >= 0\n",
+						 args->time_budget);
+		return true;
+	}
+
+	if(args->pyr_levels < 0)
+	{
+		snprintf(msg, SIZE, "Invalid quantity of %d pyramid levels. It must be "
+						 ">= 0\n", args->pyr_levels);
+		return true;
+	}
+	else if(args->pyr_levels > 0)
+	{
+		iftIdx num_blocks;
+
+		num_blocks = num_vtx >> (args->pyr_levels * 2);
+		if(iftIs3DMImage(sicle->mimg) == true) { num_blocks >>= args->pyr_levels; }
+		if(args->n0 >= num_blocks)
+		{
+			snprintf(msg, SIZE, "Invalid N0 value of %d for %d pyramid levels. It "
+							 "must be < %ld\n", args->n0, args->pyr_levels, (long)num_blocks);
+			return true;
+		}
+	}
+
+	return false;
+}
+
 //============================================================================|
 // Output
 //============================================================================|
+/* 
+ * Writes the labels of the forest within an existing label image, whose 
+ * labels are within [1,N], or 0 outside the region of interest
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  label_img[out] - REQUIRED: Label image of the SICLE domain
+ */
+void iftSICLE_WriteLabels
+(iftSICLE *sicle, iftSICLE_IFTData *data, iftImage *label_img)
+{
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		if(iftSICLE_InROI(sicle, v_index))
+		{ label_img->val[v_index] = iftSICLE_GetRootLabel(data, v_index) + 1; }
+		else { label_img->val[v_index] = 0; }
+	}
+}
+
 /* 
  * Creates a label image from the IFT root map whose labels are within [1,N],
  * if no mask was provided; or [0,N] otherwise, being 0 for the background
@@ -134,14 +771,8 @@ iftImage *iftSICLE_CreateLabelImage
 
 	label_img = iftCreateImage(sicle->mimg->xsize, sicle->mimg->ysize, 
 															sicle->mimg->zsize);
-	#ifdef IFT_OMP //-----------------------------------------------------------|
-	#pragma omp parallel for
-	#endif //-------------------------------------------------------------------|
-	for(int v_index = 0; v_index < sicle->mimg->n; ++v_index)
-	{
-		if(iftSICLE_InROI(sicle, v_index))
-		{ label_img->val[v_index] = iftSICLE_GetRootLabel(data, v_index) + 1; }
-	}
+	iftSICLE_WriteLabels(sicle, data, label_img);
+
 	return label_img;
 }
 
@@ -169,7 +800,7 @@ iftImage *iftSICLE_CreateSeedImage
 	#endif //-------------------------------------------------------------------|
 	for(int s_id = 0; s_id < data->seeds->n; ++s_id)
 	{
-		int s_index;
+		iftIdx s_index;
 
 		s_index = data->seeds->val[s_id];
 		// Add +1 because 0 is for non-seed spels
@@ -192,14 +823,14 @@ iftImage *iftSICLE_CreateSeedImage
  *
  * RETURNS: Array of N0 seed spel indexes
  */
-iftIntArray *iftSICLE_GridOversampl
+iftIdxArray *iftSICLE_GridOversampl
 (iftSICLE *sicle, iftSICLEArgs *args)
 {
 	bool is3d;
   int x0, xf, y0, yf, z0, zf, all_length;
   float xstride, ystride, zstride, c, p_x, p_y, p_z;
   iftSet *tmp_seeds;
-  iftIntArray *seeds;
+  iftIdxArray *seeds;
 
   all_length = sicle->mimg->xsize + sicle->mimg->ysize + sicle->mimg->zsize;
   p_x = sicle->mimg->xsize / (float)all_length;
@@ -230,7 +861,7 @@ iftIntArray *iftSICLE_GridOversampl
 	  {
 	    for(int x = x0; x <= xf; x = (int)(x + xstride))
 	    {
-	      int s_index;
+	      iftIdx s_index;
       	iftVoxel s_voxel;
 
       	s_voxel.x = x; s_voxel.y = y; s_voxel.z = z;
@@ -249,6 +880,28 @@ iftIntArray *iftSICLE_GridOversampl
   return seeds;
 }
 
+/*
+ * Draws a random spel index within the given range, as iftRandomInteger does.
+ * Ranges beyond the ones of int (i.e., with IFT_LONG_INDEX) combine two draws.
+ *
+ * PARAMETERS:
+ *  low[in] - REQUIRED: Lowest index
+ *  high[in] - REQUIRED: Highest index
+ *
+ * RETURNS: Random index within [low,high]
+ */
+iftIdx iftSICLE_RandomIdx
+(iftIdx low, iftIdx high)
+{
+	double d;
+
+	if(high - low < RAND_MAX) { return iftRandomInteger(low, high); }
+
+	d = ((double)rand() * ((double)RAND_MAX + 1.0) + (double)rand()) / 
+			(((double)RAND_MAX + 1.0) * ((double)RAND_MAX + 1.0));
+	return iftMin((iftIdx)(d * (high - low + 1.0)) + low, high);
+}
+
 /* 
  * Selects N0 random seeds throughout the image or limited to the area 
  * delimited by the provided mask.
@@ -259,22 +912,22 @@ iftIntArray *iftSICLE_GridOversampl
  *
  * RETURNS: Array of N0 seed spel indexes
  */
-iftIntArray *iftSICLE_RndOversampl
+iftIdxArray *iftSICLE_RndOversampl
 (iftSICLE *sicle, iftSICLEArgs *args)
 {
 	int num_sampled;
 	iftBMap *marked;
-	iftIntArray *seeds;
+	iftIdxArray *seeds;
 
-	seeds = iftCreateIntArray(args->n0);
+	seeds = iftCreateIdxArray(args->n0);
 	marked = iftCreateBMap(sicle->mimg->n);
 
 	num_sampled = 0;
 	while(num_sampled < args->n0)
 	{
-		int s_index;
+		iftIdx s_index;
 
-		s_index = iftRandomInteger(0, sicle->mimg->n - 1);
+		s_index = iftSICLE_RandomIdx(0, sicle->mimg->n - 1);
 		if(!iftBMapValue(marked, s_index) && iftSICLE_InROI(sicle, s_index))
 		{ // Was not selected and is non-masked?
 		  seeds->val[num_sampled] = s_index;
@@ -288,1132 +941,9549 @@ iftIntArray *iftSICLE_RndOversampl
 }
 
 //============================================================================|
-// iftSICLE_IFTData
+// Out-of-core
 //============================================================================|
 /*
- * Creates and allocates memory for an IFT data instance
+ * Creates a shared memory mapping of a zero-filled file, within the given 
+ * directory, with enough space for the elements of every spel. The file is 
+ * unlinked right away, being removed once unmapped.
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  args[in] - REQUIRED: SICLE arguments
+ *  dir[in] - REQUIRED: Directory of the backing file
+ *  num_elems[in] - REQUIRED: Number of elements
+ *  elem_size[in] - REQUIRED: Size of each element (in bytes)
  *
  * RETURNS: Instance of the object
  */
-iftSICLE_IFTData *iftSICLE_CreateIFTData
-(iftSICLE *sicle, iftSICLEArgs *args)
+iftSICLE_MMap *iftSICLE_CreateMMap
+(const char *dir, long num_elems, size_t elem_size)
 {
-	iftSICLE_IFTData *data;
+	char *path;
+	iftSICLE_MMap *mmap_data;
+
+	mmap_data = malloc(sizeof(iftSICLE_MMap));
+	assert(mmap_data != NULL);
+
+	path = iftCopyString("%s/sicle_XXXXXX", dir);
+	mmap_data->fd = mkstemp(path);
+	if(mmap_data->fd < 0)
+	{ iftError("Could not create a mapped file within %s", __func__, dir); }
+	unlink(path);
+	free(path);
+
+	mmap_data->elem_size = elem_size;
+	mmap_data->bytes = num_elems * elem_size;
+	if(ftruncate(mmap_data->fd, mmap_data->bytes) != 0)
+	{ iftError("Could not allocate %lu bytes within %s", __func__, 
+						 mmap_data->bytes, dir); }
+
+	mmap_data->addr = mmap(NULL, mmap_data->bytes, PROT_READ | PROT_WRITE, 
+												 MAP_SHARED, mmap_data->fd, 0);
+	if(mmap_data->addr == MAP_FAILED)
+	{ iftError("Could not map %lu bytes within %s", __func__, 
+						 mmap_data->bytes, dir); }
+
+	return mmap_data;
+}
 
-	data = malloc(sizeof(iftSICLE_IFTData));
-	assert(data != NULL);
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		mmap_data[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyMMap
+(iftSICLE_MMap **mmap_data)
+{
+	munmap((*mmap_data)->addr, (*mmap_data)->bytes);
+	close((*mmap_data)->fd);
 
-	data->num_vtx = sicle->mimg->n;
-	data->root_map = calloc(sicle->mimg->n, sizeof(int));
-	assert(data->root_map != NULL);
-	data->pred_map = calloc(sicle->mimg->n, sizeof(int));
-	assert(data->pred_map != NULL);
-	data->cost_map = calloc(sicle->mimg->n, sizeof(double));
-	assert(data->cost_map != NULL);
-	
-	if(args->use_diag == true) 
-	{
-		if(iftIs3DMImage(sicle->mimg) == true) 
-		{ data->A = iftSpheric(sqrtf(3.0)); }
-		else { data->A = iftCircular(sqrtf(2.0)); }
-	}
-	else
-	{
-		if(iftIs3DMImage(sicle->mimg) == true) { data->A = iftSpheric(1.0); }
-		else { data->A = iftCircular(1.0); }
-	}
+	free(*mmap_data);
+	(*mmap_data) = NULL;
+}
 
-	if(args->samplopt == IFT_SICLE_SAMPL_RND)
-	{ data->seeds = iftSICLE_RndOversampl(sicle, args); }
-	else if(args->samplopt == IFT_SICLE_SAMPL_GRID)
-	{ data->seeds = iftSICLE_GridOversampl(sicle, args); }
-	else if(args->samplopt == IFT_SICLE_SAMPL_CUSTOM)
-	{ 
-  	/* 
-			You may write here your own seed oversampling method for testing possible
-			new functionalities for SICLE. For using that, add "--sampl-opt custom"
-			in the command-line
-		*/
-		data->seeds = iftSICLE_RndOversampl(sicle, args); 
-	}
-	else
-	{ iftError("Unknown seed sampling option", __func__); }
+/*
+ * Zero-fills a memory mapping by truncating its file, which also releases 
+ * its pages without touching them.
+ *
+ * PARAMETERS:
+ *  mmap_data[in/out] - REQUIRED: Memory mapping
+ */
+void iftSICLE_ClearMMap
+(iftSICLE_MMap *mmap_data)
+{
+	if(ftruncate(mmap_data->fd, 0) != 0 || 
+		 ftruncate(mmap_data->fd, mmap_data->bytes) != 0)
+	{ iftError("Could not clear a mapped file", __func__); }
+}
 
-	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	fprintf(stderr, "DEBUG (%s): %ld seeds sampled\n", __func__, data->seeds->n);
-	#endif //-------------------------------------------------------------------|	
+/*
+ * Writes back and unmaps the pages holding the elements of a range of spels,
+ * which are then reclaimable by the kernel. Since a read fault also maps the
+ * cached pages around the faulting one (within aligned windows), those of the
+ * windows overlapping the range are unmapped as well. Thus, elements of the
+ * adjacent ranges may be released, which only costs a later page fault.
+ *
+ * PARAMETERS:
+ *  mmap_data[in/out] - REQUIRED: Memory mapping
+ *  first[in] - REQUIRED: First spel of the range
+ *  num_vtx[in] - REQUIRED: Number of spels in the range
+ */
+void iftSICLE_EvictMMap
+(iftSICLE_MMap *mmap_data, long first, long num_vtx)
+{
+	size_t base, begin, end;
+
+	base = (size_t)mmap_data->addr; // Windows are aligned in the address space
+	begin = (base + first * mmap_data->elem_size);
+	begin = begin / IFTSICLE_FAULT_AROUND * IFTSICLE_FAULT_AROUND;
+	begin = (begin < base) ? 0 : begin - base;
+	end = base + (first + num_vtx) * mmap_data->elem_size;
+	end = (end + IFTSICLE_FAULT_AROUND - 1) / IFTSICLE_FAULT_AROUND * 
+				IFTSICLE_FAULT_AROUND;
+	end = iftMin(end - base, mmap_data->bytes);
+
+	if(begin < end)
+	{
+		char *addr;
 
-	return data;
+		addr = (char*)mmap_data->addr + begin;
+		msync(addr, end - begin, MS_ASYNC); // Schedules the write back
+		madvise(addr, end - begin, MADV_DONTNEED);
+	}
 }
 
 /*
- * Deallocates the respective object 
+ * Releases the row tables of a multiband image, whose rows are then computed
+ * on the fly (see iftSICLE_GetFeats). Nothing happens if already released.
  *
  * PARAMETERS:
- *		args[in/out] - REQUIRED: Pointer to the object to be free'd
+ *  mimg[in/out] - REQUIRED: Multiband image
  */
-void iftSICLE_DestroyIFTData
-(iftSICLE_IFTData **data)
+void iftSICLE_ReleaseRowTables
+(iftMImage *mimg)
 {
-	free((*data)->root_map);
-	free((*data)->pred_map);
-	free((*data)->cost_map);
-	iftDestroyIntArray(&((*data)->seeds));
-	iftDestroyAdjRel(&((*data)->A));
-
-	free(*data);
-	(*data) = NULL;
+	if(mimg->val != NULL) { free(mimg->val); mimg->val = NULL; }
+	if(mimg->data->tbrow != NULL) 
+	{ free(mimg->data->tbrow); mimg->data->tbrow = NULL; }
 }
 
 /*
- * Resets the IFT data to a pre-IFT state: assigns temporary costs and 
- * predecessors, and reassigns labels to seeds and background spels.
+ * Moves the features, the saliency and the region of interest of the SICLE 
+ * data to memory mapped files within the given directory, and releases the
+ * row tables of the features. Those already moved are kept.
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  sicle[in/out] - REQUIRED: SICLE auxiliary data
+ *  dir[in] - REQUIRED: Directory of the backing files
  */
-void iftSICLE_ResetIFTData
-(iftSICLE *sicle, iftSICLE_IFTData **data)
+void iftSICLE_MoveToDisk
+(iftSICLE *sicle, const char *dir)
 {
-	#ifdef IFT_OMP //-----------------------------------------------------------|
-	#pragma omp parallel for
-	#endif //-------------------------------------------------------------------|
-	for(int v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	if(sicle->feats_mmap == NULL)
 	{
-		(*data)->pred_map[v_index] = IFTSICLE_NIL;
-		(*data)->root_map[v_index] = IFTSICLE_NIL;
-
-		if(!iftSICLE_InROI(sicle,v_index)) // Won't be conquered
-		{ (*data)->cost_map[v_index] = IFTSICLE_BKGCOST; } 
-		else 
-		{ (*data)->cost_map[v_index] = IFTSICLE_TMPCOST; }
+		iftMatrix *feats;
+
+		feats = sicle->mimg->data;
+		sicle->feats_mmap = iftSICLE_CreateMMap(dir, feats->n, sizeof(float));
+		memcpy(sicle->feats_mmap->addr, feats->val, feats->n * sizeof(float));
+		free(feats->val);
+		feats->val = sicle->feats_mmap->addr;
+		feats->allocated = false; // Must not be free'd by iftDestroyMatrix
+		iftSICLE_EvictMMap(sicle->feats_mmap, 0, feats->n);
 	}
+	iftSICLE_ReleaseRowTables(sicle->mimg);
 
-	#ifdef IFT_OMP //-----------------------------------------------------------|
-	#pragma omp parallel for
-	#endif //-------------------------------------------------------------------|
-	for(int s_id = 0; s_id < (*data)->seeds->n; ++s_id)
+	if(sicle->sal != NULL && sicle->sal_mmap == NULL)
 	{
-		int s_index;
+		sicle->sal_mmap = iftSICLE_CreateMMap(dir, sicle->mimg->n, sizeof(float));
+		memcpy(sicle->sal_mmap->addr, sicle->sal, sicle->mimg->n * sizeof(float));
+		free(sicle->sal);
+		sicle->sal = sicle->sal_mmap->addr;
+		iftSICLE_EvictMMap(sicle->sal_mmap, 0, sicle->mimg->n);
+	}
 
-		s_index = (*data)->seeds->val[s_id];
-		(*data)->root_map[s_index] = s_index;
-		(*data)->pred_map[s_index] = -(s_id + 1); // 2's complement
-		(*data)->cost_map[s_index] = 0;
+	if(sicle->roi != NULL && sicle->roi_mmap == NULL)
+	{
+		sicle->roi_mmap = iftSICLE_CreateMMap(dir, sicle->roi->nbytes, 1);
+		memcpy(sicle->roi_mmap->addr, sicle->roi->val, sicle->roi->nbytes);
+		free(sicle->roi->val);
+		sicle->roi->val = sicle->roi_mmap->addr;
+		iftSICLE_EvictMMap(sicle->roi_mmap, 0, sicle->roi->nbytes);
 	}
 }
 
 /*
- * Removes the trees of the irrelevant seeds, marked to be removed, and 
- * returns the spels at the frontier to be inserted for the differential 
- * computation.
+ * Creates the memory mapped forest maps and the chunk cache which bounds 
+ * their resident size (and the one of the SICLE data) to the memory budget.
+ * Chunks are made of consecutive slices (or rows, for 2D images).
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
- *  irre_seeds[in/out] - REQUIRED: Irrelevant seeds to be removed
+ *  sicle[in] - REQUIRED: SICLE auxiliary data, moved to disk previously
+ *  args[in] - REQUIRED: SICLE arguments
  *
- * RETURNS: Spels at the frontier of the removed trees
+ * RETURNS: Instance of the object
  */
-iftSet *iftSICLE_RemoveTrees
-(iftSICLE *sicle, iftSICLE_IFTData **data, iftSet **irre_seeds)
+iftSICLE_Pager *iftSICLE_CreatePager
+(iftSICLE *sicle, iftSICLEArgs *args)
 {
-	iftBMap *marked;
-  iftSet *frontier, *remove;
+	int num_mmaps;
+	long chunk_bytes;
+	iftSICLE_Pager *pager;
+
+	pager = malloc(sizeof(iftSICLE_Pager));
+	assert(pager != NULL);
+
+	if(iftIs3DMImage(sicle->mimg) == true)
+	{ pager->chunk_vtx = (long)args->ooc_chunk * sicle->mimg->xsize * sicle->mimg->ysize; }
+	else { pager->chunk_vtx = (long)args->ooc_chunk * sicle->mimg->xsize; }
+	pager->chunk_vtx = iftMin(pager->chunk_vtx, (long)sicle->mimg->n);
+	pager->num_chunks = (sicle->mimg->n + pager->chunk_vtx - 1) / pager->chunk_vtx;
+	pager->num_feats = sicle->mimg->m;
+
+	pager->root_mmap = iftSICLE_CreateMMap(args->ooc_path, sicle->mimg->n, 
+																				 sizeof(iftIdx));
+	pager->pred_mmap = iftSICLE_CreateMMap(args->ooc_path, sicle->mimg->n, 
+																				 sizeof(iftIdx));
+	pager->cost_mmap = iftSICLE_CreateMMap(args->ooc_path, sicle->mimg->n, 
+																				 sizeof(double));
+	pager->feats_mmap = sicle->feats_mmap;
+	pager->sal_mmap = sicle->sal_mmap;
+	pager->roi_mmap = sicle->roi_mmap;
+
+	// Zero-filled, thus every spel is white (i.e., never queued)
+	pager->color_mmap = iftSICLE_CreateMMap(args->ooc_path, sicle->mimg->n, 
+																					sizeof(char));
+	pager->comp_mmap = iftSICLE_CreateMMap(args->ooc_path, sicle->mimg->n, 
+																				 sizeof(iftIdx));
+	// Only its colors are per spel, since the order of the queued spels would
+	// touch every chunk of the frontier
+	pager->heap = iftAlloc(1, sizeof(iftDHeap));
+	assert(pager->heap != NULL);
+	pager->heap->n = sicle->mimg->n;
+	pager->heap->value = pager->cost_mmap->addr;
+	pager->heap->color = pager->color_mmap->addr;
+	pager->heap->pos = pager->heap->node = NULL;
+	pager->heap->last = -1;
+	pager->heap->removal_policy = MINVALUE;
+
+	pager->queue_cap = 1024; pager->table_bits = 11; // Half-filled, at most
+	pager->queue = malloc(pager->queue_cap * sizeof(iftSICLE_QNode));
+	pager->table = malloc((1L << pager->table_bits) * sizeof(iftSICLE_QSlot));
+	assert(pager->queue != NULL && pager->table != NULL);
+	for(long slot = 0; slot < (1L << pager->table_bits); ++slot)
+	{ pager->table[slot].v_index = IFT_NIL; }
+
+	pager->num_seeds = 0;
+	pager->seed_idx = NULL; pager->seed_label = NULL;
+	pager->seed_feats = pager->seed_sal = NULL;
+
+	if(args->engineopt == IFT_SICLE_ENGINE_RASTER)
+	{ 
+		pager->stamp_mmap = iftSICLE_CreateMMap(args->ooc_path, sicle->mimg->n, 
+																						sizeof(int)); 
+	}
+	else { pager->stamp_mmap = NULL; }
+
+	chunk_bytes = pager->chunk_vtx * (3*sizeof(iftIdx) + sizeof(double) + 
+																		sizeof(char) + 
+																		sicle->mimg->m * sizeof(float));
+	if(sicle->sal != NULL) { chunk_bytes += pager->chunk_vtx * sizeof(float); }
+	if(sicle->roi != NULL) { chunk_bytes += pager->chunk_vtx / 8 + 1; }
+	if(pager->stamp_mmap != NULL) 
+	{ chunk_bytes += pager->chunk_vtx * sizeof(int); }
+	// Windows around each mapping's range (see iftSICLE_EvictMMap)
+	num_mmaps = 6 + (sicle->sal != NULL) + (sicle->roi != NULL) + 
+							(pager->stamp_mmap != NULL);
+	chunk_bytes += num_mmaps * 2 * IFTSICLE_FAULT_AROUND;
+	pager->chunk_bytes = chunk_bytes;
+
+	// At least the chunks of a spel and of its adjacents
+	pager->max_resident = ((long)args->ooc_budget << 20) / chunk_bytes;
+	pager->max_resident = iftMax(pager->max_resident, 3);
+
+	pager->last_use = calloc(pager->num_chunks, sizeof(long));
+	assert(pager->last_use != NULL);
+	pager->num_resident = 0; pager->clock = 0; pager->last_chunk = IFT_NIL;
+
+	return pager;
+}
 
-  marked = iftCreateBMap((*data)->num_vtx);
+/*
+ * Deallocates the respective object and its owned memory mappings
+ *
+ * PARAMETERS:
+ *		pager[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyPager
+(iftSICLE_Pager **pager)
+{
+	iftSICLE_DestroyMMap(&((*pager)->root_mmap));
+	iftSICLE_DestroyMMap(&((*pager)->pred_mmap));
+	iftSICLE_DestroyMMap(&((*pager)->cost_mmap));
+	iftSICLE_DestroyMMap(&((*pager)->color_mmap));
+	iftSICLE_DestroyMMap(&((*pager)->comp_mmap));
+	if((*pager)->stamp_mmap != NULL) 
+	{ iftSICLE_DestroyMMap(&((*pager)->stamp_mmap)); }
+	iftFree((*pager)->heap); // Its colors were mapped
+	free((*pager)->queue); free((*pager)->table);
+	free((*pager)->seed_idx); free((*pager)->seed_label);
+	free((*pager)->seed_feats); free((*pager)->seed_sal);
+	free((*pager)->last_use);
+
+	free(*pager);
+	(*pager) = NULL;
+}
 
-  remove = NULL;
-  while((*irre_seeds) != NULL)
-  {
-  	int s_index;
+/*
+ * Writes back and releases the given chunk of every mapping
+ *
+ * PARAMETERS:
+ *  pager[in/out] - REQUIRED: Chunk cache
+ *  chunk[in] - REQUIRED: Chunk to be evicted
+ */
+void iftSICLE_EvictChunk
+(iftSICLE_Pager *pager, int chunk)
+{
+	long first;
+
+	first = chunk * pager->chunk_vtx;
+	iftSICLE_EvictMMap(pager->root_mmap, first, pager->chunk_vtx);
+	iftSICLE_EvictMMap(pager->pred_mmap, first, pager->chunk_vtx);
+	iftSICLE_EvictMMap(pager->cost_mmap, first, pager->chunk_vtx);
+	iftSICLE_EvictMMap(pager->color_mmap, first, pager->chunk_vtx);
+	iftSICLE_EvictMMap(pager->comp_mmap, first, pager->chunk_vtx);
+	iftSICLE_EvictMMap(pager->feats_mmap, first * pager->num_feats, 
+										 pager->chunk_vtx * pager->num_feats); // Floats
+	if(pager->sal_mmap != NULL)
+	{ iftSICLE_EvictMMap(pager->sal_mmap, first, pager->chunk_vtx); }
+	if(pager->roi_mmap != NULL) // Bytes of the bit-map
+	{ iftSICLE_EvictMMap(pager->roi_mmap, first / 8, pager->chunk_vtx / 8 + 1); }
+	if(pager->stamp_mmap != NULL)
+	{ iftSICLE_EvictMMap(pager->stamp_mmap, first, pager->chunk_vtx); }
+
+	if(pager->last_use[chunk] != 0) { pager->num_resident--; }
+	pager->last_use[chunk] = 0;
+}
 
-  	s_index = iftRemoveSet(irre_seeds);
-		(*data)->pred_map[s_index] = IFTSICLE_NIL; // Temporary predecessor		
-    (*data)->root_map[s_index] = IFTSICLE_NIL; // Temporary root
-    (*data)->cost_map[s_index] = IFTSICLE_TMPCOST; // Temporary cost
-    iftInsertSet(&remove, s_index); // Add for BFS removal
-  }
+/*
+ * Registers an access to the chunk of the given spel and to its neighboring
+ * chunks, which hold its adjacents, evicting the least recently used chunks
+ * whenever the budget is exceeded. Thus, the spel and its adjacents may be 
+ * accessed until another chunk is touched.
+ *
+ * PARAMETERS:
+ *  pager[in/out] - REQUIRED: Chunk cache
+ *  v_index[in] - REQUIRED: Spel being accessed
+ */
+void iftSICLE_TouchPager
+(iftSICLE_Pager *pager, iftIdx v_index)
+{
+	int chunk, first, last;
 
-  frontier = NULL;
-  while(remove != NULL)
-  {
-  	int vi_index;
-  	iftVoxel vi_voxel;
+	chunk = v_index / pager->chunk_vtx;
+	if(chunk == pager->last_chunk) { return; } // Most common case
 
-  	vi_index = iftRemoveSet(&remove);
-  	vi_voxel = iftMGetVoxelCoord(sicle->mimg, vi_index);
+	pager->last_chunk = chunk;
+	first = iftMax(chunk - 1, 0);
+	last = iftMin(chunk + 1, pager->num_chunks - 1);
+	for(int c = first; c <= last; ++c) // Resident ones are not to be evicted
+	{ if(pager->last_use[c] != 0) { pager->last_use[c] = ++(pager->clock); } }
 
-  	for(int j = 1; j < (*data)->A->n; ++j)
-  	{
-  		iftVoxel vj_voxel;
+	for(int c = first; c <= last; ++c)
+	{
+		if(pager->last_use[c] != 0) { continue; }
 
-  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+		if(pager->num_resident == pager->max_resident)
+		{
+			int lru;
 
-  		if(iftMValidVoxel(sicle->mimg, vj_voxel))
-  		{
-  			int vj_index, vj_root;
+			lru = IFT_NIL;
+			for(int k = 0; k < pager->num_chunks; ++k)
+			{
+				if(pager->last_use[k] != 0 && 
+					 (lru == IFT_NIL || pager->last_use[k] < pager->last_use[lru]))
+				{ lru = k; }
+			}
+			iftSICLE_EvictChunk(pager, lru);
+		}
+		pager->num_resident++;
+		pager->last_use[c] = ++(pager->clock);
+	}
+}
 
-  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
-  			vj_root = (*data)->root_map[vj_index];
+#ifdef IFT_DEBUG //-----------------------------------------------------------|
+/*
+ * Verifies whether the resident size of the mappings, as reported by the 
+ * kernel, is within the memory budget. Otherwise, some spels were accessed 
+ * without being registered.
+ *
+ * PARAMETERS:
+ *  pager[in] - REQUIRED: Chunk cache
+ */
+void iftSICLE_CheckResidency
+(iftSICLE_Pager *pager)
+{
+	bool counted;
+	char line[IFT_STR_DEFAULT_SIZE];
+	long resident, allowed;
+	iftSICLE_MMap *mmaps[9];
+	FILE *fp;
+
+	fp = fopen("/proc/self/smaps", "r");
+	if(fp == NULL) { return; } // Unavailable
+
+	mmaps[0] = pager->root_mmap; mmaps[1] = pager->pred_mmap;
+	mmaps[2] = pager->cost_mmap; mmaps[3] = pager->color_mmap;
+	mmaps[4] = pager->comp_mmap; mmaps[5] = pager->stamp_mmap;
+	mmaps[6] = pager->feats_mmap; mmaps[7] = pager->sal_mmap;
+	mmaps[8] = pager->roi_mmap;
+
+	resident = 0; counted = false;
+	while(fgets(line, IFT_STR_DEFAULT_SIZE, fp) != NULL)
+	{
+		long kbytes;
+		unsigned long begin, end;
 
-  			if((*data)->cost_map[vj_index] != IFTSICLE_BKGCOST) // If not in bkg
-  			{
-  				// If belongs to the subtree being removed at moment
-  				if((*data)->pred_map[vj_index] == vi_index)
-  				{
-  					(*data)->pred_map[vj_index] = IFTSICLE_NIL; //Temporary predecessor
-				    (*data)->root_map[vj_index] = IFTSICLE_NIL; // Temporary root
-				    (*data)->cost_map[vj_index] = IFTSICLE_TMPCOST; // Temporary cost
-				    iftInsertSet(&remove, vj_index); // Add for BFS removal
-  				}
-  				else if(vj_root != IFTSICLE_NIL && // If it wasnt removed
-  							 	(*data)->root_map[vj_root] != IFTSICLE_NIL && // If relevant
-  							 	!iftBMapValue(marked, vj_index)) //If it wasnt yet visited
-					{ 
-						iftBMapSet1(marked, vj_index); // Visited
-						iftInsertSet(&frontier, vj_index); // Frontier of removed tree
-					}
-  			}
-  		}
-  	}
-  }
-  iftDestroyBMap(&marked);
+		if(sscanf(line, "%lx-%lx ", &begin, &end) == 2) // Mapping's header
+		{
+			counted = false;
+			for(int i = 0; i < 9; ++i)
+			{ 
+				if(mmaps[i] != NULL && (unsigned long)mmaps[i]->addr == begin) 
+				{ counted = true; }
+			}
+		}
+		else if(counted == true && sscanf(line, "Rss: %ld kB", &kbytes) == 1)
+		{ resident += kbytes << 10; }
+	}
+	fclose(fp);
 
-  return frontier;
+	allowed = pager->max_resident * pager->chunk_bytes;
+	if(resident > allowed)
+	{
+		iftWarning("Resident size of %ld KiB exceeds the budget of %ld KiB",
+							 __func__, resident >> 10, allowed >> 10);
+	}
 }
+#endif //---------------------------------------------------------------------|
 
 /*
- * Removes the subtree of the given vertex and updates those spels at the 
- * frontier for a new competition in the differential computation.
+ * Releases every chunk and drops their pages from the page cache. Since 
+ * every access is registered, it only shrinks the page cache between the
+ * iterations.
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  v_index[in] - REQUIRED: "Root" of the subtree to be removed
- *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
- *  heap[in/out] - REQUIRED: Priority queue of the current IFT execution to
- *													 be updated.
+ *  pager[in/out] - REQUIRED: Chunk cache
  */
-void iftSICLE_RemoveSubtree
-(iftSICLE *sicle, int v_index, iftSICLE_IFTData **data, iftDHeap **heap)
+void iftSICLE_TrimPager
+(iftSICLE_Pager *pager)
 {
-	iftBMap *marked;
-  iftSet *remove, *frontier;
-
-  marked = iftCreateBMap((*data)->num_vtx);
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	iftSICLE_CheckResidency(pager);
+	#endif //-------------------------------------------------------------------|
 
-  remove = frontier = NULL;
-  iftInsertSet(&remove, v_index);
-  while(remove != NULL)
-  {
-  	int vi_index;
-  	iftVoxel vi_voxel;
+	for(int c = 0; c < pager->num_chunks; ++c) { iftSICLE_EvictChunk(pager, c); }
+	pager->num_resident = 0; pager->last_chunk = IFT_NIL;
+
+	// Drops the clean pages from the page cache as well
+	posix_fadvise(pager->root_mmap->fd, 0, 0, POSIX_FADV_DONTNEED);
+	posix_fadvise(pager->pred_mmap->fd, 0, 0, POSIX_FADV_DONTNEED);
+	posix_fadvise(pager->cost_mmap->fd, 0, 0, POSIX_FADV_DONTNEED);
+	posix_fadvise(pager->color_mmap->fd, 0, 0, POSIX_FADV_DONTNEED);
+	posix_fadvise(pager->comp_mmap->fd, 0, 0, POSIX_FADV_DONTNEED);
+	posix_fadvise(pager->feats_mmap->fd, 0, 0, POSIX_FADV_DONTNEED);
+	if(pager->sal_mmap != NULL)
+	{ posix_fadvise(pager->sal_mmap->fd, 0, 0, POSIX_FADV_DONTNEED); }
+	if(pager->roi_mmap != NULL)
+	{ posix_fadvise(pager->roi_mmap->fd, 0, 0, POSIX_FADV_DONTNEED); }
+	if(pager->stamp_mmap != NULL)
+	{ posix_fadvise(pager->stamp_mmap->fd, 0, 0, POSIX_FADV_DONTNEED); }
+}
 
-  	vi_index = iftRemoveSet(&remove);
-  	vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
+/*
+ * Returns the home slot of a spel within the position table of the queue
+ * (i.e., Fibonacci hashing)
+ *
+ * PARAMETERS:
+ *  pager[in] - REQUIRED: Chunk cache
+ *  v_index[in] - REQUIRED: Queued spel
+ *
+ * RETURNS: Slot to start probing from
+ */
+long iftSICLE_HashSpel
+(iftSICLE_Pager *pager, iftIdx v_index)
+{
+	return (long)(((uint64_t)v_index * 11400714819323198485ULL) >> 
+								(64 - pager->table_bits));
+}
 
-    (*data)->root_map[vi_index] = IFTSICLE_NIL; // Temporary root
-    (*data)->pred_map[vi_index] = IFTSICLE_NIL; // Temporary predecessor
-    (*data)->cost_map[vi_index] = IFTSICLE_TMPCOST; // Temporary cost
+/*
+ * Returns the slot of a queued spel within the position table
+ *
+ * PARAMETERS:
+ *  pager[in] - REQUIRED: Chunk cache
+ *  v_index[in] - REQUIRED: Queued spel
+ *
+ * RETURNS: Slot of the spel
+ */
+long iftSICLE_FindSlot
+(iftSICLE_Pager *pager, iftIdx v_index)
+{
+	long slot, mask;
 
-    if((*heap)->color[vi_index] == IFT_GRAY)
-    { iftRemoveDHeapElem((*heap), vi_index); } // Remove if exists in queue
-  	else { (*heap)->color[vi_index] = IFT_WHITE; } // Clear its status
+	mask = (1L << pager->table_bits) - 1;
+	slot = iftSICLE_HashSpel(pager, v_index);
+	while(pager->table[slot].v_index != v_index) { slot = (slot + 1) & mask; }
 
-  	for(int j = 1; j < (*data)->A->n; ++j)
-  	{
-  		iftVoxel vj_voxel;
+	return slot;
+}
 
-  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+/*
+ * Stores the position of a spel being queued within the position table
+ *
+ * PARAMETERS:
+ *  pager[in/out] - REQUIRED: Chunk cache
+ *  v_index[in] - REQUIRED: Spel being queued
+ *  pos[in] - REQUIRED: Its position within the queue
+ *
+ * RETURNS: Slot of the spel
+ */
+long iftSICLE_InsertSlot
+(iftSICLE_Pager *pager, iftIdx v_index, long pos)
+{
+	long slot, mask;
 
-  		if(iftMValidVoxel(sicle->mimg, vj_voxel) == true)
-  		{
-  			int vj_index;
+	mask = (1L << pager->table_bits) - 1;
+	slot = iftSICLE_HashSpel(pager, v_index);
+	while(pager->table[slot].v_index != IFT_NIL) { slot = (slot + 1) & mask; }
+	pager->table[slot].v_index = v_index;
+	pager->table[slot].pos = pos;
 
-  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
-  			
-	  		if((*data)->pred_map[vj_index] == vi_index) // If belongs to subtree
-				{ iftInsertSet(&remove, vj_index); } // Add to BFS removal
-				else if((*data)->cost_map[vj_index] != IFTSICLE_BKGCOST && // Not bkg
-								(*data)->cost_map[vj_index] != IFTSICLE_TMPCOST && // Reached
-								 !iftBMapValue(marked, vj_index)) // Visited
-				{ 
-					iftBMapSet1(marked, vj_index); // Visited
-					iftInsertSet(&frontier, vj_index); // Probable frontier
-				}
-  		}
-  	}
-  }
-	iftDestroyBMap(&marked);
+	return slot;
+}
 
-  while(frontier != NULL)
-  {
-  	int vi_index;
+/*
+ * Empties a slot of the position table. The following entries of its probing
+ * sequence are shifted backwards, thus no tombstone is required.
+ *
+ * PARAMETERS:
+ *  pager[in/out] - REQUIRED: Chunk cache
+ *  slot[in] - REQUIRED: Slot to be emptied
+ */
+void iftSICLE_FreeSlot
+(iftSICLE_Pager *pager, long slot)
+{
+	long mask, next;
 
-  	vi_index = iftRemoveSet(&frontier);
+	mask = (1L << pager->table_bits) - 1;
+	next = (slot + 1) & mask;
+	while(pager->table[next].v_index != IFT_NIL)
+	{
+		long home;
 
-  	if((*heap)->color[vi_index] == IFT_GRAY) // Already in heap?
-		{ iftRemoveDHeapElem((*heap), vi_index); } // Remove for update
-		iftInsertDHeap((*heap), vi_index); // Add/update
-  }
+		home = iftSICLE_HashSpel(pager, pager->table[next].v_index);
+		if(((next - home) & mask) >= ((next - slot) & mask)) // Reachable
+		{
+			pager->table[slot] = pager->table[next];
+			pager->queue[pager->table[slot].pos].slot = slot;
+			slot = next;
+		}
+		next = (next + 1) & mask;
+	}
+	pager->table[slot].v_index = IFT_NIL;
 }
 
-//============================================================================|
-// iftSICLE_TStats
-//============================================================================|
 /*
- * Creates and allocates memory for an Tree statistics instance
+ * Doubles the capacity of the queue and the size of the position table
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  args[in] - REQUIRED: SICLE arguments
- *  data[in] - REQUIRED: IFT auxiliary data
- *
- * RETURNS: Instance of the object
+ *  pager[in/out] - REQUIRED: Chunk cache
  */
-iftSICLE_TStats *iftSICLE_CreateTStats
-(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+void iftSICLE_GrowQueue
+(iftSICLE_Pager *pager)
 {
-	iftSICLE_TStats *tstats;
-
-  tstats = malloc(sizeof(iftSICLE_TStats));
-  assert(tstats != NULL);
+	pager->queue_cap *= 2; pager->table_bits++;
+	pager->queue = realloc(pager->queue, 
+												 pager->queue_cap * sizeof(iftSICLE_QNode));
+	free(pager->table);
+	pager->table = malloc((1L << pager->table_bits) * sizeof(iftSICLE_QSlot));
+	assert(pager->queue != NULL && pager->table != NULL);
+
+	for(long slot = 0; slot < (1L << pager->table_bits); ++slot)
+	{ pager->table[slot].v_index = IFT_NIL; }
+	for(long pos = 0; pos <= pager->heap->last; ++pos)
+	{ 
+		pager->queue[pos].slot = 
+			iftSICLE_InsertSlot(pager, pager->queue[pos].v_index, pos); 
+	}
+}
 
-  tstats->num_trees = data->seeds->n;
-  tstats->num_feats = sicle->mimg->m;
-  tstats->num_dims = 3;
+/*
+ * Swaps two positions of the queue, updating the position table
+ *
+ * PARAMETERS:
+ *  pager[in/out] - REQUIRED: Chunk cache
+ *  i, j[in] - REQUIRED: Positions within the queue
+ */
+void iftSICLE_SwapQueue
+(iftSICLE_Pager *pager, long i, long j)
+{
+	iftSICLE_QNode aux;
 
-  tstats->size = calloc(data->seeds->n, sizeof(int));
-  assert(tstats->size != NULL);
+	aux = pager->queue[i]; 
+	pager->queue[i] = pager->queue[j]; 
+	pager->queue[j] = aux;
+	pager->table[pager->queue[i].slot].pos = i;
+	pager->table[pager->queue[j].slot].pos = j;
+}
 
-  tstats->adj = calloc(data->seeds->n, sizeof(iftBMap*));
-  assert(tstats->adj != NULL);
+/*
+ * Moves a position of the queue up, as iftGoUpDHeap (i.e., same order)
+ *
+ * PARAMETERS:
+ *  pager[in/out] - REQUIRED: Chunk cache
+ *  i[in] - REQUIRED: Position within the queue
+ */
+void iftSICLE_GoUpQueue
+(iftSICLE_Pager *pager, long i)
+{
+	long j;
 
-  tstats->feats = calloc(data->seeds->n, sizeof(float*));
-  assert(tstats->feats != NULL);
+	j = iftDad(i);
+	while(j >= 0 && pager->queue[j].key > pager->queue[i].key)
+	{
+		iftSICLE_SwapQueue(pager, i, j);
+		i = j;
+		j = iftDad(i);
+	}
+}
 
-  tstats->centr = calloc(data->seeds->n, sizeof(float*));
-  assert(tstats->centr != NULL);
+/*
+ * Moves a position of the queue down, as iftGoDownDHeap (i.e., same order)
+ *
+ * PARAMETERS:
+ *  pager[in/out] - REQUIRED: Chunk cache
+ *  i[in] - REQUIRED: Position within the queue
+ */
+void iftSICLE_GoDownQueue
+(iftSICLE_Pager *pager, long i)
+{
+	while(true)
+	{
+		long j, left, right;
 
-  if(sicle->sal == NULL) { tstats->sal = NULL; }
-  else
-  {
-  	tstats->sal = calloc(data->seeds->n, sizeof(float));
-	  assert(tstats->sal != NULL);
-  }
+		left = iftLeftSon(i); right = iftRightSon(i); j = i;
+		if(left <= pager->heap->last && 
+			 pager->queue[left].key < pager->queue[i].key) { j = left; }
+		if(right <= pager->heap->last && 
+			 pager->queue[right].key < pager->queue[j].key) { j = right; }
+		if(j == i) { break; }
 
-  for(long s_id = 0; s_id < data->seeds->n; ++s_id)
-  { 
-	  tstats->adj[s_id] = iftCreateBMap(tstats->num_trees);
+		iftSICLE_SwapQueue(pager, i, j);
+		i = j;
+	}
+}
 
-    tstats->feats[s_id] = calloc(tstats->num_feats, sizeof(float));
-    assert(tstats->feats[s_id] != NULL);
+/*
+ * Creates the priority queue of an IFT on the cost map of the IFT data. 
+ * Out-of-core, the queue of the chunk cache is cleared and lent instead, 
+ * whose colors are mapped and evicted along with the chunks. Its order is
+ * kept in-core, for not touching the chunks of the whole frontier.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *
+ * RETURNS: Empty priority queue, removing the minimum cost first
+ */
+iftDHeap *iftSICLE_CreateHeap
+(iftSICLE *sicle, iftSICLE_IFTData *data)
+{
+	iftDHeap *heap;
 
-    tstats->centr[s_id] = calloc(tstats->num_dims, sizeof(float));
-    assert(tstats->centr[s_id] != NULL);
-  }
+	if(data->pager != NULL)
+	{
+		heap = data->pager->heap;
+		iftSICLE_ClearMMap(data->pager->color_mmap);
+		for(long slot = 0; slot < (1L << data->pager->table_bits); ++slot)
+		{ data->pager->table[slot].v_index = IFT_NIL; }
+		heap->last = -1;
+	}
+	else
+	{
+		heap = iftCreateDHeap(sicle->mimg->n, data->cost_map);
+		iftSetRemovalPolicyDHeap(heap, MINVALUE);
+	}
 
-  return tstats;
+	return heap;
 }
 
 /*
- * Deallocates the respective object 
+ * Empties a priority queue created by iftSICLE_CreateHeap, whitening every 
+ * spel. Out-of-core, the whole queue is never touched.
  *
  * PARAMETERS:
- *		args[in/out] - REQUIRED: Pointer to the object to be free'd
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  heap[in/out] - REQUIRED: Priority queue
  */
-void iftSICLE_DestroyTStats
-(iftSICLE_TStats **tstats)
+void iftSICLE_ResetHeap
+(iftSICLE_IFTData *data, iftDHeap *heap)
 {
-  free((*tstats)->size);
-  if((*tstats)->sal != NULL) { free((*tstats)->sal); }
-  for(int i = 0; i < (*tstats)->num_trees; ++i)
-  {
-    iftDestroyBMap(&((*tstats)->adj[i]));
-    free((*tstats)->feats[i]);
-    free((*tstats)->centr[i]);
-  }
-  free((*tstats)->adj);
-  free((*tstats)->feats);
-  free((*tstats)->centr);
-
-  free(*tstats);
-  (*tstats) = NULL;
+	if(data->pager != NULL)
+	{
+		iftSICLE_ClearMMap(data->pager->color_mmap);
+		for(long slot = 0; slot < (1L << data->pager->table_bits); ++slot)
+		{ data->pager->table[slot].v_index = IFT_NIL; }
+		heap->last = -1;
+	}
+	else { iftResetDHeap(heap); }
 }
 
 /*
- * Calculates the tree statistics of the root map and seed array of the 
- * current IFT execution
+ * Deallocates a priority queue created by iftSICLE_CreateHeap. Out-of-core,
+ * it is kept by the chunk cache.
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  args[in] - REQUIRED: SICLE arguments
  *  data[in] - REQUIRED: IFT auxiliary data
+ *  heap[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyHeap
+(iftSICLE_IFTData *data, iftDHeap **heap)
+{
+	if(data->pager == NULL) { iftDestroyDHeap(heap); }
+	else { (*heap) = NULL; }
+}
+
+/*
+ * Inserts a spel into a priority queue created by iftSICLE_CreateHeap, given
+ * its current path cost
  *
- * RETURNS: Extracted tree statistics of the current IFT execution
+ * PARAMETERS:
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  heap[in/out] - REQUIRED: Priority queue
+ *  v_index[in] - REQUIRED: Spel to be inserted
  */
-iftSICLE_TStats *iftSICLE_CalcTStats
-(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+void iftSICLE_PushHeap
+(iftSICLE_IFTData *data, iftDHeap *heap, iftIdx v_index)
 {
-  iftSICLE_TStats *tstats;
+	if(data->pager != NULL)
+	{
+		iftSICLE_Pager *pager;
+
+		pager = data->pager;
+		if(heap->last + 1 == pager->queue_cap) { iftSICLE_GrowQueue(pager); }
+
+		heap->last++;
+		pager->queue[heap->last].key = data->cost_map[v_index];
+		pager->queue[heap->last].v_index = v_index;
+		pager->queue[heap->last].slot = 
+			iftSICLE_InsertSlot(pager, v_index, heap->last);
+		heap->color[v_index] = IFT_GRAY;
+		iftSICLE_GoUpQueue(pager, heap->last);
+	}
+	else { iftInsertDHeap(heap, v_index); }
+}
 
-  tstats = iftSICLE_CreateTStats(sicle, args, data);
+/*
+ * Removes the spel of minimum cost from a priority queue created by 
+ * iftSICLE_CreateHeap
+ *
+ * PARAMETERS:
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  heap[in/out] - REQUIRED: Non-empty priority queue
+ *
+ * RETURNS: Removed spel
+ */
+iftIdx iftSICLE_PopHeap
+(iftSICLE_IFTData *data, iftDHeap *heap)
+{
+	iftIdx v_index;
 
-  for(int vi_index = 0; vi_index < sicle->mimg->n; ++vi_index)
-  {
-    if(data->cost_map[vi_index] != IFTSICLE_BKGCOST)
-    {
-    	int vi_label, vi_root;
-    	iftVoxel vi_voxel;
+	if(data->pager != NULL)
+	{
+		iftSICLE_Pager *pager;
 
-    	vi_label = iftSICLE_GetRootLabel(data,vi_index);
-    	vi_root = data->root_map[vi_index];
-	  	vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
-      
-      tstats->size[vi_label]++;
-      if(sicle->sal != NULL) // Has saliency?
-      { tstats->sal[vi_label] += sicle->sal[vi_index]; }
+		pager = data->pager;
+		v_index = pager->queue[0].v_index;
+		heap->color[v_index] = IFT_BLACK;
+		iftSICLE_FreeSlot(pager, pager->queue[0].slot);
 
-    	tstats->centr[vi_label][0] += vi_voxel.x;
-    	tstats->centr[vi_label][1] += vi_voxel.y;
-    	tstats->centr[vi_label][2] += vi_voxel.z;
+		pager->queue[0] = pager->queue[heap->last];
+		heap->last--;
+		if(heap->last >= 0)
+		{
+			pager->table[pager->queue[0].slot].pos = 0;
+			iftSICLE_GoDownQueue(pager, 0);
+		}
+	}
+	else { v_index = iftRemoveDHeap(heap); }
 
-      for(int f = 0; f < tstats->num_feats; ++f) 
-      { tstats->feats[vi_label][f] += sicle->mimg->val[vi_index][f]; }
+	return v_index;
+}
 
-    	for(int j = 1; j < data->A->n; ++j)
-    	{
-    		iftVoxel vj_voxel;
+/*
+ * Removes a queued spel from a priority queue created by iftSICLE_CreateHeap,
+ * whitening it
+ *
+ * PARAMETERS:
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  heap[in/out] - REQUIRED: Priority queue
+ *  v_index[in] - REQUIRED: Queued spel to be removed
+ */
+void iftSICLE_RemoveHeapElem
+(iftSICLE_IFTData *data, iftDHeap *heap, iftIdx v_index)
+{
+	if(data->pager != NULL)
+	{
+		long pos;
 
-    		vj_voxel = iftGetAdjacentVoxel(data->A, vi_voxel, j);
+		pos = data->pager->table[iftSICLE_FindSlot(data->pager, v_index)].pos;
+		data->pager->queue[pos].key = IFT_INFINITY_DBL_NEG; // To the top
+		iftSICLE_GoUpQueue(data->pager, pos);
+		iftSICLE_PopHeap(data, heap);
+		heap->color[v_index] = IFT_WHITE;
+	}
+	else { iftRemoveDHeapElem(heap, v_index); }
+}
 
-    		if(iftMValidVoxel(sicle->mimg, vj_voxel))
-    		{
-    			int vj_index, vj_root, vj_label;
+/*
+ * Comparison function for sorting integers in ascending order
+ */
+int iftSICLE_CmpIndex
+(const void *a, const void *b)
+{
+	return (*(const iftIdx*)a > *(const iftIdx*)b) - (*(const iftIdx*)a < *(const iftIdx*)b);
+}
 
-    			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
-    			vj_label = iftSICLE_GetRootLabel(data, vj_index);
-    			vj_root = data->root_map[vj_index];
+/*
+ * Comparison function for sorting pairs of indexes lexicographically
+ */
+int iftSICLE_CmpIdxPair
+(const void *a, const void *b)
+{
+	const iftIdx *A = a, *B = b;
 
-    			// If it is not on the bkg and has different label
-    			if(data->cost_map[vj_index] != IFTSICLE_BKGCOST && vi_root!=vj_root)
-    			{ iftBMapSet1(tstats->adj[vi_label], vj_label);}
-    		}
-    	}
-    }
-  }
+	if(A[0] != B[0]) { return (A[0] > B[0]) - (A[0] < B[0]); }
+	return (A[1] > B[1]) - (A[1] < B[1]);
+}
 
-  #ifdef IFT_OMP //-----------------------------------------------------------|
-	#pragma omp parallel for
-	#endif //-------------------------------------------------------------------|
-  for(int t_index = 0; t_index < tstats->num_trees; ++t_index) // Compute avg
-  {
-  	for(int d = 0; d < tstats->num_dims; ++d) 
-    { tstats->centr[t_index][d] /= (float)tstats->size[t_index]; }
+/*
+ * Out-of-core: plants the given roots, visiting them in the chunks' order, 
+ * and keeps their labels, features and saliency within the seed table of the
+ * chunk cache. Thus, the root of a spel is never touched while conquering it,
+ * nor for labeling it.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in/out] - REQUIRED: IFT auxiliary data, with a chunk cache
+ *  roots[in] - REQUIRED: Roots of the forest
+ *  label[in] - OPTIONAL: Label of each root. If NULL, its position
+ *  is_reset[in] - REQUIRED: Whether their roots and costs are assigned too
+ */
+void iftSICLE_TabulateSeeds
+(iftSICLE *sicle, iftSICLE_IFTData *data, iftIdxArray *roots, int *label,
+ bool is_reset)
+{
+	int m;
+	iftIdx *pairs;
+	iftSICLE_Pager *pager;
+
+	pager = data->pager; m = sicle->mimg->m;
+	pairs = malloc(iftMax(1, 2 * roots->n) * sizeof(iftIdx));
+	assert(pairs != NULL);
+	for(long s_id = 0; s_id < roots->n; ++s_id) // (Index, label) pairs
+	{
+		pairs[2*s_id] = roots->val[s_id];
+		pairs[2*s_id + 1] = (label == NULL) ? s_id : label[s_id];
+	}
+	qsort(pairs, roots->n, 2 * sizeof(iftIdx), iftSICLE_CmpIdxPair);
+
+	free(pager->seed_idx); free(pager->seed_label);
+	free(pager->seed_feats); free(pager->seed_sal);
+	pager->num_seeds = roots->n;
+	pager->seed_idx = malloc(iftMax(1, roots->n) * sizeof(iftIdx));
+	pager->seed_label = malloc(iftMax(1, roots->n) * sizeof(int));
+	pager->seed_feats = malloc(iftMax(1, roots->n) * m * sizeof(float));
+	assert(pager->seed_idx != NULL && pager->seed_label != NULL && 
+				 pager->seed_feats != NULL);
+	if(sicle->sal != NULL)
+	{ 
+		pager->seed_sal = malloc(iftMax(1, roots->n) * sizeof(float));
+		assert(pager->seed_sal != NULL);
+	}
+	else { pager->seed_sal = NULL; }
 
-    for(int j = 0; j < tstats->num_feats; ++j) 
-    { tstats->feats[t_index][j] /= (float)tstats->size[t_index]; }
+	for(long i = 0; i < roots->n; ++i)
+	{
+		iftIdx s_index;
 
-    if(sicle->sal != NULL) // Has saliency?
-    { tstats->sal[t_index] /= (float)tstats->size[t_index]; }
-  }
+		s_index = pairs[2*i];
+		iftSICLE_TouchPager(pager, s_index);
+		if(is_reset == true)
+		{
+			data->root_map[s_index] = s_index;
+			data->cost_map[s_index] = 0;
+		}
+		data->pred_map[s_index] = -(pairs[2*i + 1] + 1); // 2's complement
 
-  return tstats;
+		pager->seed_idx[i] = s_index;
+		pager->seed_label[i] = pairs[2*i + 1];
+		memcpy(pager->seed_feats + i * m, iftSICLE_GetFeats(sicle, s_index),
+					 m * sizeof(float));
+		if(sicle->sal != NULL) { pager->seed_sal[i] = sicle->sal[s_index]; }
+	}
+	free(pairs);
 }
 
-//============================================================================|
-// Image Foresting Transform
-//============================================================================|
 /*
- * Computes the connectivity cost between two vertices vi and vj
+ * Out-of-core: searches for a root within the seed table
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  args[in] - REQUIRED: SICLE arguments
- *  data[in] - REQUIRED: IFT auxiliary data
- *  vi_index[in] - REQUIRED: Path's terminus
- *  vj_index[in] - REQUIRED: Vertex to be conquered
+ *  pager[in] - REQUIRED: Chunk cache
+ *  s_index[in] - REQUIRED: Spel to be searched
  *
- * RETURNS: Connectivity cost between vi and vj
+ * RETURNS: Its position within the table, or IFT_NIL if it is not a root
  */
-float iftSICLE_ConnFunction
-(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data, int vi_index, 
-	int vj_index)
+long iftSICLE_FindSeed
+(iftSICLE_Pager *pager, iftIdx s_index)
 {
-	int vi_root;
-	iftVoxel vi_voxel, vj_voxel;
-	float *vi_root_feats, *vj_feats;
-	double root_feat_dist, spat_dist, sal_dist, arccost, pathcost;
+	iftIdx *found;
 
-	vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
-	vi_root = data->root_map[vi_index]; 
-	vi_root_feats = sicle->mimg->val[vi_root];
-	
-	vj_voxel = iftMGetVoxelCoord(sicle->mimg,vj_index);
-	vj_feats = sicle->mimg->val[vj_index];
-	
-	root_feat_dist = iftEuclDistance(vi_root_feats, vj_feats, sicle->mimg->m);
-	spat_dist = iftVoxelDistance(vi_voxel, vj_voxel);
-	
-	if(sicle->sal != NULL) // Has saliency?
-	{ sal_dist = fabs(sicle->sal[vi_root] - sicle->sal[vj_index]); }
-	else { sal_dist = 0.0; }
+	found = bsearch(&s_index, pager->seed_idx, pager->num_seeds, sizeof(iftIdx),
+									iftSICLE_CmpIndex);
+	if(found == NULL) { return IFT_NIL; }
 
-	pathcost = data->cost_map[vi_index];
-	if(args->connopt == IFT_SICLE_CONN_FMAX) // fmax + wroot
-	{ 
-		arccost = pow(root_feat_dist, 1.0 + args->alpha*sal_dist);
-		pathcost = iftMax(pathcost, arccost);
-	}
-	else if(args->connopt == IFT_SICLE_CONN_FSUM) // fsum + wsum
+	return found - pager->seed_idx;
+}
+
+/*
+ * Returns the label of the tree of a reached spel (i.e., 0-based). 
+ * Out-of-core, it is found within the seed table, instead of touching the 
+ * chunk of its root.
+ *
+ * PARAMETERS:
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  v_index[in] - REQUIRED: Reached spel
+ *
+ * RETURNS: Label of its tree
+ */
+int iftSICLE_GetLabel
+(iftSICLE_IFTData *data, iftIdx v_index)
+{
+	if(data->pager != NULL)
 	{ 
-		arccost = (args->irreg + args->alpha*sal_dist) * root_feat_dist;
-		arccost = iftFastNatPow(arccost, args->adhr) + spat_dist;
-		pathcost += arccost;
+		return data->pager->seed_label[
+			iftSICLE_FindSeed(data->pager, data->root_map[v_index])]; 
 	}
-	else if(args->connopt == IFT_SICLE_CONN_CUSTOM)
-	{
-		/* 
-			You may write here your own connectivity function for testing possible
-			new functionalities for SICLE. For using that, add "--conn-opt custom"
-			in the command-line
-		*/
-		pathcost += 1;
-	}
-	else
-	{ iftError("Unknown connectivity function", __func__); }	
 
-	return pathcost;
+	return iftSICLE_GetRootLabel(data, v_index);
 }
 
 /*
- * Executes one sequential IFT with the seeds defined in the IFT data provided,
- * which is modified and updated in-place
+ * Creates a label image file and writes its header. The depth is chosen as 
+ * the smallest one supporting the given quantity of labels. Only the .scn 
+ * and the .pgm (2D) formats are supported.
  *
  * PARAMETERS:
- *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  args[in] - REQUIRED: SICLE arguments
- *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  path[in] - REQUIRED: Output label image path
+ *  xsize, ysize, zsize[in] - REQUIRED: Image dimensions
+ *  dx, dy, dz[in] - REQUIRED: Voxel sizes (.scn only)
+ *  num_labels[in] - REQUIRED: Quantity of labels (excluding the background)
+ *  depth[out] - REQUIRED: Bits per label
+ *  is_scn[out] - REQUIRED: Whether the file is a .scn one
+ *
+ * RETURNS: File opened for writing the labels, in raster order
  */
-void iftSICLE_RunSeedIFT
-(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data)
+FILE *iftSICLE_OpenLabelFile
+(const char *path, int xsize, int ysize, int zsize, float dx, float dy, 
+ float dz, long num_labels, int *depth, bool *is_scn)
 {
-	iftDHeap *heap;
+	char *ext;
+	FILE *fp;
 
-	heap = iftCreateDHeap(sicle->mimg->n, (*data)->cost_map);
-	iftSetRemovalPolicyDHeap(heap, MINVALUE);
+	ext = iftLowerString(iftFileExt(path));
+	(*is_scn) = iftCompareStrings(ext, ".scn");
+	if(!(*is_scn) && !(iftCompareStrings(ext, ".pgm") && zsize == 1))
+	{ iftError("Chunked writing only supports .scn, or .pgm for 2D images", 
+						 __func__); }
+	free(ext);
 
-	iftSICLE_ResetIFTData(sicle, data); // Prepare data for the sequential IFT
-	for(int s_id = 0; s_id < (*data)->seeds->n; ++s_id) 
-	{ iftInsertDHeap(heap, (*data)->seeds->val[s_id]); } // Add seeds
+	if(num_labels < 256) { (*depth) = 8; }
+	else if(num_labels < 65536) { (*depth) = 16; }
+	else { (*depth) = 32; }
 
-	while(!iftEmptyDHeap(heap))
+	if((*depth) == 32 && (*is_scn) == false)
+	{ iftError("Too many labels for a .pgm file", __func__); }
+
+	fp = fopen(path, "wb");
+	if(fp == NULL) { iftError(MSG_FILE_OPEN_ERROR, __func__, path); }
+
+	if((*is_scn) == true)
 	{
-		int vi_index, vi_root;
-		iftVoxel vi_voxel;
+		fprintf(fp, "SCN\n%d %d %d\n", xsize, ysize, zsize);
+		fprintf(fp, "%f %f %f\n%d\n", dx, dy, dz, (*depth));
+	}
+	else
+	{ fprintf(fp, "P5\n%d %d\n%d\n", xsize, ysize, ((*depth) == 8) ? 255 : 65535); }
 
-		vi_index = iftRemoveDHeap(heap);
-		vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
-		vi_root = (*data)->root_map[vi_index]; 
+	return fp;
+}
 
-		for(int j = 1; j < (*data)->A->n; ++j)
-  	{
-  		iftVoxel vj_voxel;
+/*
+ * Stores a label within a buffer of labels to be written, given the depth
+ * and the format of the label file.
+ *
+ * PARAMETERS:
+ *  buffer[in/out] - REQUIRED: Label buffer
+ *  i[in] - REQUIRED: Position within the buffer
+ *  label[in] - REQUIRED: Label to be stored
+ *  depth[in] - REQUIRED: Bits per label
+ *  is_scn[in] - REQUIRED: Whether the file is a .scn one
+ */
+void iftSICLE_PackLabel
+(unsigned char *buffer, long i, int label, int depth, bool is_scn)
+{
+	if(depth == 8) { buffer[i] = (unsigned char)label; }
+	else if(depth == 32) { ((int*)buffer)[i] = label; }
+	else if(is_scn == true) { ((unsigned short*)buffer)[i] = label; }
+	else // PGM is big-endian
+	{ buffer[2*i] = (label >> 8) & 0xFF; buffer[2*i + 1] = label & 0xFF; }
+}
 
-  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+/*
+ * Writes the label map of the forest chunk by chunk, without creating the 
+ * label image. Labels are within [1,N] if no mask was provided; or [0,N] 
+ * otherwise, being 0 for the background. Only the .scn and the .pgm (2D)
+ * formats are supported.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  chunk_vtx[in] - REQUIRED: Number of spels per chunk
+ *  path[in] - REQUIRED: Output label image path
+ */
+void iftSICLE_WriteLabelFile
+(iftSICLE *sicle, iftSICLE_IFTData *data, long chunk_vtx, const char *path)
+{
+	bool is_scn;
+	int depth;
+	unsigned char *buffer;
+	FILE *fp;
 
-  		if(iftMValidVoxel(sicle->mimg, vj_voxel))
-  		{
-  			int vj_index;
+	fp = iftSICLE_OpenLabelFile(path, sicle->mimg->xsize, sicle->mimg->ysize,
+															sicle->mimg->zsize, sicle->mimg->dx, 
+															sicle->mimg->dy, sicle->mimg->dz, 
+															data->seeds->n, &depth, &is_scn);
 
-  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
-  			if(heap->color[vj_index] != IFT_BLACK) // Out of the heap?
-  			{
-  				double pathcost;
+	buffer = malloc(chunk_vtx * (depth/8));
+	assert(buffer != NULL);
 
-  				pathcost = iftSICLE_ConnFunction(sicle, args, *data, vi_index, vj_index);
+	for(long first = 0; first < sicle->mimg->n; first += chunk_vtx)
+	{
+		long num_vtx;
 
-					if(pathcost < (*data)->cost_map[vj_index]) // Lesser path-cost?
-					{
-						if(heap->color[vj_index] == IFT_GRAY) // Already within the heap?
-						{ iftRemoveDHeapElem(heap, vj_index); } // Remove for update
+		num_vtx = iftMin(chunk_vtx, sicle->mimg->n - first);
+		if(data->pager != NULL) { iftSICLE_TouchPager(data->pager, first); }
 
-						(*data)->root_map[vj_index] = vi_root; // 
-						(*data)->pred_map[vj_index] = vi_index;// Mark as conquered
-						(*data)->cost_map[vj_index] = pathcost;//
-						iftInsertDHeap(heap, vj_index);
-					}
-  			}
-  		}
-  	}
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for
+		#endif //-----------------------------------------------------------------|
+		for(long i = 0; i < num_vtx; ++i)
+		{
+			int label;
+
+			if(iftSICLE_InROI(sicle, first + i))
+			{ label = iftSICLE_GetLabel(data, first + i) + 1; }
+			else { label = 0; }
+
+			iftSICLE_PackLabel(buffer, i, label, depth, is_scn);
+		}
+
+		if(fwrite(buffer, depth/8, num_vtx, fp) != (size_t)num_vtx)
+		{ iftError("Could not write to %s", __func__, path); }
 	}
-	iftDestroyDHeap(&heap);
+
+	free(buffer);
+	fclose(fp);
 }
 
+//============================================================================|
+// iftSICLE_IFTData
+//============================================================================|
 /*
- * Executes one differential IFT with the seeds defined in the IFT data 
- * provided, which is modified and updated in-place
+ * Allocates memory for an IFT data instance, without sampling its seeds. If
+ * a workspace is given, its maps are lent (and grown, if needed) instead.
  *
  * PARAMETERS:
  *  sicle[in] - REQUIRED: SICLE auxiliary data
  *  args[in] - REQUIRED: SICLE arguments
- *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
- *  irre_seeds[in/out] - REQUIRED: Irrelevant seeds to be removed
+ *  ws[in/out] - OPTIONAL: In-core workspace lending the maps
+ *
+ * RETURNS: Instance of the object
  */
-void iftSICLE_RunSeedDIFT
-(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
-	iftSet **irre_seeds)
+iftSICLE_IFTData *iftSICLE_AllocIFTData
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_Workspace *ws)
 {
-	iftSet *frontier;
-	iftDHeap *heap;
+	iftSICLE_IFTData *data;
 
-	frontier = iftSICLE_RemoveTrees(sicle, data, irre_seeds);//Remove irrelevants
-	heap = iftCreateDHeap(sicle->mimg->n, (*data)->cost_map);
-	iftSetRemovalPolicyDHeap(heap, MINVALUE);
+	data = malloc(sizeof(iftSICLE_IFTData));
+	assert(data != NULL);
 
-	#ifdef IFT_OMP //-----------------------------------------------------------|
-	#pragma omp parallel for
-	#endif //-------------------------------------------------------------------|
-	for(int s_id = 0; s_id < (*data)->seeds->n; ++s_id) // Update labels
-	{ (*data)->pred_map[(*data)->seeds->val[s_id]] = -(s_id + 1); } // 2's compl
+	data->num_vtx = sicle->mimg->n;
+	data->ws = ws;
+	if(ws != NULL) // Every map is reset before the first IFT
+	{
+		if(ws->capacity < sicle->mimg->n)
+		{
+			free(ws->root_map); free(ws->pred_map); free(ws->cost_map);
+			ws->capacity = sicle->mimg->n;
+			ws->root_map = malloc(ws->capacity * sizeof(iftIdx));
+			ws->pred_map = malloc(ws->capacity * sizeof(iftIdx));
+			ws->cost_map = malloc(ws->capacity * sizeof(double));
+			assert(ws->root_map != NULL && ws->pred_map != NULL);
+			assert(ws->cost_map != NULL);
+		}
+		data->pager = NULL;
+		data->root_map = ws->root_map;
+		data->pred_map = ws->pred_map;
+		data->cost_map = ws->cost_map;
+	}
+	else if(args->ooc_path == NULL)
+	{
+		data->pager = NULL;
+		data->root_map = calloc(sicle->mimg->n, sizeof(iftIdx));
+		assert(data->root_map != NULL);
+		data->pred_map = calloc(sicle->mimg->n, sizeof(iftIdx));
+		assert(data->pred_map != NULL);
+		data->cost_map = calloc(sicle->mimg->n, sizeof(double));
+		assert(data->cost_map != NULL);
+	}
+	else
+	{
+		iftSICLE_MoveToDisk(sicle, args->ooc_path);
+		data->pager = iftSICLE_CreatePager(sicle, args);
+		data->root_map = data->pager->root_mmap->addr;
+		data->pred_map = data->pager->pred_mmap->addr;
+		data->cost_map = data->pager->cost_mmap->addr;
+	}
+	
+	data->A = iftSICLE_CreateAdjRel(args, iftIs3DMImage(sicle->mimg));
+	data->seeds = NULL;
+	data->ckpt_addr = NULL; data->ckpt_bytes = 0;
 
-	while(frontier != NULL)
-	{ iftInsertDHeap(heap, iftRemoveSet(&frontier)); }
+	data->cancelled = false; data->num_iters = 0; data->deadline = 0;
+	data->cancel = NULL; data->cancel_data = NULL;
 
-	while(iftEmptyDHeap(heap) == false)
-	{
-		int vi_index, vi_root;
-		iftVoxel vi_voxel;
+	return data;
+}
 
-		vi_index = iftRemoveDHeap(heap);
-		vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
-		vi_root = (*data)->root_map[vi_index]; 
+/*
+ * Samples the initial seeds of an IFT data instance, by the oversampling 
+ * option of the arguments
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data without seeds
+ */
+void iftSICLE_SampleSeeds
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+{
+	if(args->samplopt == IFT_SICLE_SAMPL_RND)
+	{ data->seeds = iftSICLE_RndOversampl(sicle, args); }
+	else if(args->samplopt == IFT_SICLE_SAMPL_GRID)
+	{ data->seeds = iftSICLE_GridOversampl(sicle, args); }
+	else if(args->samplopt == IFT_SICLE_SAMPL_CUSTOM)
+	{ 
+  	/* 
+			You may write here your own seed oversampling method for testing possible
+			new functionalities for SICLE. For using that, add "--sampl-opt custom"
+			in the command-line
+		*/
+		data->seeds = iftSICLE_RndOversampl(sicle, args); 
+	}
+	else
+	{ iftError("Unknown seed sampling option", __func__); }
 
-		for(int j = 1; j < (*data)->A->n; ++j)
-  	{
-  		iftVoxel vj_voxel;
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	fprintf(stderr, "DEBUG (%s): %ld seeds sampled\n", __func__, data->seeds->n);
+	#endif //-------------------------------------------------------------------|	
+}
 
-  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+/*
+ * Creates and allocates memory for an IFT data instance
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_IFTData *iftSICLE_CreateIFTData
+(iftSICLE *sicle, iftSICLEArgs *args)
+{
+	iftSICLE_IFTData *data;
 
-  		if(iftMValidVoxel(sicle->mimg, vj_voxel))
-  		{
-  			int vj_index;
+	data = iftSICLE_AllocIFTData(sicle, args, NULL);
+	iftSICLE_SampleSeeds(sicle, args, data);
 
-  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
-  			if(heap->color[vj_index] != IFT_BLACK) // Out of the heap?
-  			{
-  				double pathcost;
-		
-  				pathcost = iftSICLE_ConnFunction(sicle, args, *data, vi_index, vj_index);
+	return data;
+}
 
-					if(pathcost < (*data)->cost_map[vj_index]) // Lesser path-cost?
-					{
-						if(heap->color[vj_index] == IFT_GRAY) // Already within the heap?
-						{ iftRemoveDHeapElem(heap, vj_index); } // Remove for update
+/*
+ * Creates an IFT data instance whose seeds are drawn from the random 
+ * sequence of the given seed, regardless of any concurrent caller (e.g., the
+ * tiles run in parallel).
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  seed[in] - REQUIRED: Seed of the random generator
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_IFTData *iftSICLE_CreateSeededIFTData
+(iftSICLE *sicle, iftSICLEArgs *args, int seed)
+{
+	iftSICLE_IFTData *data;
 
-						(*data)->root_map[vj_index] = vi_root; //
-						(*data)->pred_map[vj_index] = vi_index;// Mark as conquered
-						(*data)->cost_map[vj_index] = pathcost;//
-						iftInsertDHeap(heap, vj_index);
-					}
-					else if(vi_index == (*data)->pred_map[vj_index])
-					{
-						if(pathcost > (*data)->cost_map[vj_index] || 
-							 vi_root != (*data)->root_map[vj_index])
-							//Inconsistency -> Remove and Compete again
-						{ iftSICLE_RemoveSubtree(sicle, vj_index, data, &heap);}
-					}
-  			}
-  		}
-  	}
+	data = iftSICLE_AllocIFTData(sicle, args, NULL);
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp critical(iftsicle_seeding)
+	#endif //-------------------------------------------------------------------|
+	{
+		iftRandomSeed(seed);
+		iftSICLE_SampleSeeds(sicle, args, data);
 	}
-	iftDestroyDHeap(&heap);
+
+	return data;
 }
 
-//============================================================================|
-// Seed Removal
-//============================================================================|
 /*
- * Calculate the priority/relevance of the seeds based on the predefined 
- * criterion and penalization. 
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		args[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyIFTData
+(iftSICLE_IFTData **data)
+{
+	if((*data)->ckpt_addr != NULL) 
+	{ munmap((*data)->ckpt_addr, (*data)->ckpt_bytes); }
+	else if((*data)->pager != NULL) 
+	{ iftSICLE_DestroyPager(&((*data)->pager)); }
+	else if((*data)->ws == NULL) // Otherwise, kept by the workspace
+	{
+		free((*data)->root_map);
+		free((*data)->pred_map);
+		free((*data)->cost_map);
+	}
+	iftDestroyIdxArray(&((*data)->seeds));
+	iftDestroyAdjRel(&((*data)->A));
+
+	free(*data);
+	(*data) = NULL;
+}
+
+/*
+ * Copies the forest and seeds of an in-core IFT data, for further iterations
+ * independent from the original ones.
  *
  * PARAMETERS:
  *  sicle[in] - REQUIRED: SICLE auxiliary data
  *  args[in] - REQUIRED: SICLE arguments
- *  data[in] - REQUIRED: IFT auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data to be copied
  *
- * RETURNS: Double |S|-sized array of seeds' priority/relevance
+ * RETURNS: Copy of the IFT data
  */
-double *iftSICLE_CalcSeedPrio
+iftSICLE_IFTData *iftSICLE_CopyIFTData
 (iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
 {
-  double *prio;
-  iftSICLE_TStats *tstats;
-
-  prio = calloc(data->seeds->n, sizeof(double));
-  tstats = iftSICLE_CalcTStats(sicle, args, data);
-	
-  #ifdef IFT_OMP //-----------------------------------------------------------|
-	#pragma omp parallel for
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(data->pager == NULL);
 	#endif //-------------------------------------------------------------------|
-  for(long ti_index = 0; ti_index < tstats->num_trees; ++ti_index)
-  {
-    double size_perc, min_color_grad, max_sal_grad, min_dist, num_adjs,
-    			 max_color_grad, dist_perc;
+	iftSICLE_IFTData *copy;
 
-    size_perc = tstats->size[ti_index]/(float)sicle->mimg->n; 
-
-    max_sal_grad = max_color_grad = 0.0;
-    min_color_grad = min_dist = IFT_INFINITY_DBL;
-    num_adjs = 0;
-  	for(long tj_index = 0; tj_index < tstats->num_trees; ++tj_index)
-    {
-    	if(iftBMapValue(tstats->adj[ti_index],tj_index))
-    	{
-    		double sal_grad, grad, dist;
-	     	
-	     	num_adjs++; 
-	      grad= iftEuclDistance(tstats->feats[ti_index], tstats->feats[tj_index],
-	                             tstats->num_feats);
-	      dist= iftEuclDistance(tstats->centr[ti_index], tstats->centr[tj_index],
-	      											 tstats->num_dims);
-
-	      if(grad < min_color_grad) { min_color_grad = grad; }
-	      if(grad > max_color_grad) { max_color_grad = grad; }
-	      if(dist < min_dist) { min_dist = dist; }
-
-	      if(sicle->sal != NULL) // Has saliency?
-	      { 
-	      	sal_grad = fabs(tstats->sal[ti_index] - tstats->sal[tj_index]); 
-	      	if(sal_grad > max_sal_grad) { max_sal_grad = sal_grad; }
-	      }
-    	}
-    }
-	dist_perc = min_dist/iftDiagonalSize(sicle->mimg);
-
-		if(args->critopt == IFT_SICLE_CRIT_SIZE)
-    { prio[ti_index] = size_perc; }
-    else if(args->critopt == IFT_SICLE_CRIT_MINSC)
-    { prio[ti_index] = size_perc * min_color_grad; }
-    else if(args->critopt == IFT_SICLE_CRIT_MAXSC)
-    { prio[ti_index] = size_perc * max_color_grad; }
-  	else if(args->critopt == IFT_SICLE_CRIT_SPREAD)
-    { prio[ti_index] = size_perc * min_dist; }
-		else if(args->critopt == IFT_SICLE_CRIT_CUSTOM)
-    {
-    	/* 
-				You may write here your own criterion function for testing possible
-				new functionalities for SICLE. For using that, add "--crit-opt custom"
-				in the command-line
-			*/
-    	prio[ti_index] = size_perc*1.0/min_dist;
-    }
-    else 
-    { iftError("Unknown seed removal criterion fuction", __func__); }
-
-    if(args->penopt == IFT_SICLE_PEN_OBJ)
-  	{ prio[ti_index]*= iftMax(tstats->sal[ti_index], max_sal_grad); }
-  	else if(args->penopt == IFT_SICLE_PEN_BORD)
-  	{ prio[ti_index]*= max_sal_grad; }
-  	else if(args->penopt == IFT_SICLE_PEN_OSB)
-  	{
-  	  float bkg_relevance;
+	copy = iftSICLE_AllocIFTData(sicle, args, NULL);
+	memcpy(copy->root_map, data->root_map, data->num_vtx * sizeof(iftIdx));
+	memcpy(copy->pred_map, data->pred_map, data->num_vtx * sizeof(iftIdx));
+	memcpy(copy->cost_map, data->cost_map, data->num_vtx * sizeof(double));
 
-  	  bkg_relevance = (1.0 - tstats->sal[ti_index])*dist_perc;
-  	  prio[ti_index]*= iftMax(tstats->sal[ti_index],bkg_relevance);
-  	}
-  	else if(args->penopt == IFT_SICLE_PEN_BOBS)
-  	{
-  	  float bkg_relevance, obj_relevance;
-			
-			obj_relevance = tstats->sal[ti_index]*max_sal_grad;
-  	  bkg_relevance = (1.0 - tstats->sal[ti_index])*dist_perc;
-  	  prio[ti_index]*= iftMax(obj_relevance,bkg_relevance);
-  	}
-  	else if(args->penopt == IFT_SICLE_PEN_CUSTOM)
-  	{
-    	/* 
-				You may write here your own penalization function for testing possible
-				new functionalities for SICLE. For using that, add "--pen-opt custom"
-				in the command-line
-			*/
-  	  prio[ti_index]*= 1;
-  	}
-  	else if(args->penopt != IFT_SICLE_PEN_NONE)
-		{ iftError("Unknown seed relevance penalization", __func__); }
-  }
-  iftSICLE_DestroyTStats(&tstats);
+	copy->seeds = iftCreateIdxArray(data->seeds->n);
+	memcpy(copy->seeds->val, data->seeds->val, data->seeds->n * sizeof(iftIdx));
+	copy->num_iters = data->num_iters;
 
-  return prio;
+	return copy;
 }
 
 /*
- * Removes Ni irrelevant seeds for the next IFT execution
+ * Resets the IFT data to a pre-IFT state: assigns temporary costs and 
+ * predecessors, and reassigns labels to seeds and background spels.
  *
  * PARAMETERS:
  *  sicle[in] - REQUIRED: SICLE auxiliary data
- *  num_maint[in] - REQUIRED: Number of seeds to be maintained
- *  args[in] - REQUIRED: SICLE arguments
  *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
- *  irre_seeds[in/out] - REQUIRED: Irrelevant seeds selected to be removed
  */
-void iftSICLE_RemSeeds
-(iftSICLE *sicle, int num_maint, iftSICLEArgs *args, iftSICLE_IFTData **data,
- iftSet **irre_seeds)
+void iftSICLE_ResetIFTData
+(iftSICLE *sicle, iftSICLE_IFTData **data)
 {
-  double *prio;
-  iftIntArray *new_seeds;
-  iftDHeap *heap;
-
-  prio = iftSICLE_CalcSeedPrio(sicle, args, (*data));
-  heap = iftCreateDHeap((*data)->seeds->n, prio);
-  iftSetRemovalPolicyDHeap(heap, MAXVALUE);
+	long chunk_vtx;
 
-  new_seeds = iftCreateIntArray(num_maint); // Empty array
+	if((*data)->pager != NULL) { chunk_vtx = (*data)->pager->chunk_vtx; }
+	else { chunk_vtx = sicle->mimg->n; }
 
-  for(long s_id = 0; s_id < (*data)->seeds->n; ++s_id) // Add all for ordering
-  { iftInsertDHeap(heap, s_id); } 
+	for(iftIdx first = 0; first < sicle->mimg->n; first += chunk_vtx)
+	{
+		iftIdx last;
 
-  for(long i = 0; i < num_maint; ++i) // Add relevants
-  { new_seeds->val[i] = (*data)->seeds->val[iftRemoveDHeap(heap)]; }
+		last = iftMin(first + chunk_vtx, sicle->mimg->n);
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, first); }
 
-	(*irre_seeds) = NULL;
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for
+		#endif //-----------------------------------------------------------------|
+		for(iftIdx v_index = first; v_index < last; ++v_index)
+		{
+			(*data)->pred_map[v_index] = IFTSICLE_NIL;
+			(*data)->root_map[v_index] = IFTSICLE_NIL;
+
+			if(!iftSICLE_InROI(sicle,v_index)) // Won't be conquered
+			{ (*data)->cost_map[v_index] = IFTSICLE_BKGCOST; } 
+			else 
+			{ (*data)->cost_map[v_index] = IFTSICLE_TMPCOST; }
+		}
+	}
+
+	if((*data)->pager != NULL) // In the chunks' order
+	{ iftSICLE_TabulateSeeds(sicle, *data, (*data)->seeds, NULL, true); }
+	else
+	{
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for
+		#endif //-----------------------------------------------------------------|
+		for(int s_id = 0; s_id < (*data)->seeds->n; ++s_id)
+		{
+			iftIdx s_index;
+
+			s_index = (*data)->seeds->val[s_id];
+			(*data)->root_map[s_index] = s_index;
+			(*data)->pred_map[s_index] = -(s_id + 1); // 2's complement
+			(*data)->cost_map[s_index] = 0;
+		}
+	}
+}
+
+/*
+ * Removes the trees of the irrelevant seeds, marked to be removed, and 
+ * returns the spels at the frontier to be inserted for the differential 
+ * computation. Out-of-core, the labels of the current seeds must have been 
+ * updated, since the seed table defines the relevant ones.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  irre_seeds[in/out] - REQUIRED: Irrelevant seeds to be removed
+ *
+ * RETURNS: Spels at the frontier of the removed trees
+ */
+iftSet *iftSICLE_RemoveTrees
+(iftSICLE *sicle, iftSICLE_IFTData **data, iftSet **irre_seeds)
+{
+	iftBMap *marked;
+  iftSet *frontier, *remove;
+
+  marked = iftCreateBMap((*data)->num_vtx);
+
+  remove = NULL;
+  while((*irre_seeds) != NULL)
+  {
+  	iftIdx s_index;
+
+  	s_index = iftRemoveSet(irre_seeds);
+  	if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, s_index); }
+		(*data)->pred_map[s_index] = IFTSICLE_NIL; // Temporary predecessor		
+    (*data)->root_map[s_index] = IFTSICLE_NIL; // Temporary root
+    (*data)->cost_map[s_index] = IFTSICLE_TMPCOST; // Temporary cost
+    iftInsertSet(&remove, s_index); // Add for BFS removal
+  }
+
+  frontier = NULL;
+  while(remove != NULL)
+  {
+  	iftIdx vi_index;
+  	iftVoxel vi_voxel;
+
+  	vi_index = iftRemoveSet(&remove);
+  	if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, vi_index); }
+  	vi_voxel = iftMGetVoxelCoord(sicle->mimg, vi_index);
+
+  	for(int j = 1; j < (*data)->A->n; ++j)
+  	{
+  		iftVoxel vj_voxel;
+
+  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+
+  		if(iftMValidVoxel(sicle->mimg, vj_voxel))
+  		{
+  			bool is_relevant;
+  			iftIdx vj_index, vj_root;
+
+  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+  			vj_root = (*data)->root_map[vj_index];
+  			if(vj_root == IFTSICLE_NIL) { is_relevant = false; } // Removed
+  			else if((*data)->pager != NULL) // Without touching its root
+  			{ is_relevant = iftSICLE_FindSeed((*data)->pager, vj_root) != IFT_NIL; }
+  			else { is_relevant = (*data)->root_map[vj_root] != IFTSICLE_NIL; }
+
+  			if((*data)->cost_map[vj_index] != IFTSICLE_BKGCOST) // If not in bkg
+  			{
+  				// If belongs to the subtree being removed at moment
+  				if((*data)->pred_map[vj_index] == vi_index)
+  				{
+  					(*data)->pred_map[vj_index] = IFTSICLE_NIL; //Temporary predecessor
+				    (*data)->root_map[vj_index] = IFTSICLE_NIL; // Temporary root
+				    (*data)->cost_map[vj_index] = IFTSICLE_TMPCOST; // Temporary cost
+				    iftInsertSet(&remove, vj_index); // Add for BFS removal
+  				}
+  				else if(is_relevant == true && // If relevant and not removed
+  							 	!iftBMapValue(marked, vj_index)) //If it wasnt yet visited
+					{ 
+						iftBMapSet1(marked, vj_index); // Visited
+						iftInsertSet(&frontier, vj_index); // Frontier of removed tree
+					}
+  			}
+  		}
+  	}
+  }
+  iftDestroyBMap(&marked);
+
+  return frontier;
+}
+
+/*
+ * Reassigns the labels of the current seeds with respect to their position
+ * within the seed array, after some of them were removed.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ */
+void iftSICLE_UpdateSeedLabels
+(iftSICLE *sicle, iftSICLE_IFTData **data)
+{
+	if((*data)->pager != NULL) // In the chunks' order
+	{ iftSICLE_TabulateSeeds(sicle, *data, (*data)->seeds, NULL, false); }
+	else
+	{
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for
+		#endif //-----------------------------------------------------------------|
+		for(int s_id = 0; s_id < (*data)->seeds->n; ++s_id)
+		{ (*data)->pred_map[(*data)->seeds->val[s_id]] = -(s_id + 1); } // 2's c.
+	}
+}
+
+/*
+ * Removes the subtree of the given vertex and updates those spels at the 
+ * frontier for a new competition in the differential computation.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  v_index[in] - REQUIRED: "Root" of the subtree to be removed
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  heap[in/out] - REQUIRED: Priority queue of the current IFT execution to
+ *													 be updated.
+ */
+void iftSICLE_RemoveSubtree
+(iftSICLE *sicle, iftIdx v_index, iftSICLE_IFTData **data, iftDHeap **heap)
+{
+	iftBMap *marked;
+  iftSet *remove, *frontier;
+
+  marked = iftCreateBMap((*data)->num_vtx);
+
+  remove = frontier = NULL;
+  iftInsertSet(&remove, v_index);
+  while(remove != NULL)
+  {
+  	iftIdx vi_index;
+  	iftVoxel vi_voxel;
+
+  	vi_index = iftRemoveSet(&remove);
+  	if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, vi_index); }
+  	vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
+
+    (*data)->root_map[vi_index] = IFTSICLE_NIL; // Temporary root
+    (*data)->pred_map[vi_index] = IFTSICLE_NIL; // Temporary predecessor
+    (*data)->cost_map[vi_index] = IFTSICLE_TMPCOST; // Temporary cost
+
+    if((*heap)->color[vi_index] == IFT_GRAY)
+    { iftSICLE_RemoveHeapElem(*data, *heap, vi_index); } // Remove if queued
+  	else { (*heap)->color[vi_index] = IFT_WHITE; } // Clear its status
+
+  	for(int j = 1; j < (*data)->A->n; ++j)
+  	{
+  		iftVoxel vj_voxel;
+
+  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+
+  		if(iftMValidVoxel(sicle->mimg, vj_voxel) == true)
+  		{
+  			iftIdx vj_index;
+
+  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+  			
+	  		if((*data)->pred_map[vj_index] == vi_index) // If belongs to subtree
+				{ iftInsertSet(&remove, vj_index); } // Add to BFS removal
+				else if((*data)->cost_map[vj_index] != IFTSICLE_BKGCOST && // Not bkg
+								(*data)->cost_map[vj_index] != IFTSICLE_TMPCOST && // Reached
+								 !iftBMapValue(marked, vj_index)) // Visited
+				{ 
+					iftBMapSet1(marked, vj_index); // Visited
+					iftInsertSet(&frontier, vj_index); // Probable frontier
+				}
+  		}
+  	}
+  }
+	iftDestroyBMap(&marked);
+
+  while(frontier != NULL)
+  {
+  	iftIdx vi_index;
+
+  	vi_index = iftRemoveSet(&frontier);
+  	if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, vi_index); }
+
+  	if((*heap)->color[vi_index] == IFT_GRAY) // Already in heap?
+		{ iftSICLE_RemoveHeapElem(*data, *heap, vi_index); } // Remove for update
+		iftSICLE_PushHeap(*data, *heap, vi_index); // Add/update
+  }
+}
+
+//============================================================================|
+// iftSICLE_TStats
+//============================================================================|
+/*
+ * Creates and allocates memory for an Tree statistics instance
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_TStats *iftSICLE_CreateTStats
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+{
+	iftSICLE_TStats *tstats;
+
+  tstats = malloc(sizeof(iftSICLE_TStats));
+  assert(tstats != NULL);
+
+  tstats->num_trees = data->seeds->n;
+  tstats->num_feats = sicle->mimg->m;
+  tstats->num_dims = 3;
+
+  tstats->size = calloc(data->seeds->n, sizeof(int));
+  assert(tstats->size != NULL);
+
+  tstats->adj = calloc(data->seeds->n, sizeof(int*));
+  assert(tstats->adj != NULL);
+
+  tstats->num_adj = calloc(data->seeds->n, sizeof(int));
+  assert(tstats->num_adj != NULL);
+
+  tstats->max_adj = calloc(data->seeds->n, sizeof(int));
+  assert(tstats->max_adj != NULL);
+
+  tstats->feats = calloc(data->seeds->n, sizeof(float*));
+  assert(tstats->feats != NULL);
+
+  tstats->centr = calloc(data->seeds->n, sizeof(float*));
+  assert(tstats->centr != NULL);
+
+  if(sicle->sal == NULL) { tstats->sal = NULL; }
+  else
+  {
+  	tstats->sal = calloc(data->seeds->n, sizeof(float));
+	  assert(tstats->sal != NULL);
+  }
+
+  for(long s_id = 0; s_id < data->seeds->n; ++s_id)
+  { 
+	  tstats->max_adj[s_id] = 8; // Grown on demand
+	  tstats->adj[s_id] = malloc(tstats->max_adj[s_id] * sizeof(int));
+	  assert(tstats->adj[s_id] != NULL);
+
+    tstats->feats[s_id] = calloc(tstats->num_feats, sizeof(float));
+    assert(tstats->feats[s_id] != NULL);
+
+    tstats->centr[s_id] = calloc(tstats->num_dims, sizeof(float));
+    assert(tstats->centr[s_id] != NULL);
+  }
+
+  return tstats;
+}
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		args[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyTStats
+(iftSICLE_TStats **tstats)
+{
+  free((*tstats)->size);
+  if((*tstats)->sal != NULL) { free((*tstats)->sal); }
+  for(int i = 0; i < (*tstats)->num_trees; ++i)
+  {
+    free((*tstats)->adj[i]);
+    free((*tstats)->feats[i]);
+    free((*tstats)->centr[i]);
+  }
+  free((*tstats)->adj);
+  free((*tstats)->num_adj);
+  free((*tstats)->max_adj);
+  free((*tstats)->feats);
+  free((*tstats)->centr);
+
+  free(*tstats);
+  (*tstats) = NULL;
+}
+
+/*
+ * Appends a tree to the list of adjacents of another, growing the list if 
+ * required. It is not verified whether the former is already there.
+ *
+ * PARAMETERS:
+ *  tstats[in/out] - REQUIRED: Tree statistics
+ *  ti_index[in] - REQUIRED: Tree whose list is extended
+ *  tj_index[in] - REQUIRED: Adjacent tree
+ */
+void iftSICLE_AppendTStatsAdj
+(iftSICLE_TStats *tstats, int ti_index, int tj_index)
+{
+	if(tstats->num_adj[ti_index] == tstats->max_adj[ti_index])
+	{
+		tstats->max_adj[ti_index] *= 2;
+		tstats->adj[ti_index] = realloc(tstats->adj[ti_index], 
+																		tstats->max_adj[ti_index] * sizeof(int));
+		assert(tstats->adj[ti_index] != NULL);
+	}
+	tstats->adj[ti_index][tstats->num_adj[ti_index]++] = tj_index;
+}
+
+/*
+ * Verifies whether a tree is within the list of adjacents of another.
+ *
+ * PARAMETERS:
+ *  tstats[in] - REQUIRED: Tree statistics
+ *  ti_index[in] - REQUIRED: Tree whose list is scanned
+ *  tj_index[in] - REQUIRED: Tree to be found
+ *
+ * RETURNS: Whether they are adjacent
+ */
+bool iftSICLE_HasTStatsAdj
+(iftSICLE_TStats *tstats, int ti_index, int tj_index)
+{
+	for(int k = tstats->num_adj[ti_index] - 1; k >= 0; --k) // Latest first
+	{ if(tstats->adj[ti_index][k] == tj_index) { return true; } }
+
+	return false;
+}
+
+/*
+ * Calculates the tree statistics of the root map and seed array of the 
+ * current IFT execution
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *
+ * RETURNS: Extracted tree statistics of the current IFT execution
+ */
+iftSICLE_TStats *iftSICLE_CalcTStats
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+{
+  iftSICLE_TStats *tstats;
+
+  tstats = iftSICLE_CreateTStats(sicle, args, data);
+
+  for(iftIdx vi_index = 0; vi_index < sicle->mimg->n; ++vi_index)
+  {
+  	if(data->pager != NULL) { iftSICLE_TouchPager(data->pager, vi_index); }
+    if(data->cost_map[vi_index] != IFTSICLE_BKGCOST)
+    {
+    	iftIdx vi_root;
+    	int vi_label;
+    	iftVoxel vi_voxel;
+
+    	vi_label = iftSICLE_GetLabel(data, vi_index);
+    	vi_root = data->root_map[vi_index];
+	  	vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
+      
+      tstats->size[vi_label]++;
+      if(sicle->sal != NULL) // Has saliency?
+      { tstats->sal[vi_label] += sicle->sal[vi_index]; }
+
+    	tstats->centr[vi_label][0] += vi_voxel.x;
+    	tstats->centr[vi_label][1] += vi_voxel.y;
+    	tstats->centr[vi_label][2] += vi_voxel.z;
+
+      for(int f = 0; f < tstats->num_feats; ++f) 
+      { tstats->feats[vi_label][f] += iftSICLE_GetFeats(sicle, vi_index)[f]; }
+
+    	for(int j = 1; j < data->A->n; ++j)
+    	{
+    		iftVoxel vj_voxel;
+
+    		vj_voxel = iftGetAdjacentVoxel(data->A, vi_voxel, j);
+
+    		if(iftMValidVoxel(sicle->mimg, vj_voxel))
+    		{
+    			iftIdx vj_index, vj_root;
+
+    			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+    			vj_root = data->root_map[vj_index];
+
+    			// If it is not on the bkg and has different label
+    			if(data->cost_map[vj_index] != IFTSICLE_BKGCOST && vi_root!=vj_root)
+    			{ 
+    				int vj_label;
+
+    				vj_label = iftSICLE_GetLabel(data, vj_index);
+    				if(!iftSICLE_HasTStatsAdj(tstats, vi_label, vj_label))
+    				{ iftSICLE_AppendTStatsAdj(tstats, vi_label, vj_label); }
+    			}
+    		}
+    	}
+    }
+  }
+
+  #ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+  for(int t_index = 0; t_index < tstats->num_trees; ++t_index) // Compute avg
+  {
+  	for(int d = 0; d < tstats->num_dims; ++d) 
+    { tstats->centr[t_index][d] /= (float)tstats->size[t_index]; }
+
+    for(int j = 0; j < tstats->num_feats; ++j) 
+    { tstats->feats[t_index][j] /= (float)tstats->size[t_index]; }
+
+    if(sicle->sal != NULL) // Has saliency?
+    { tstats->sal[t_index] /= (float)tstats->size[t_index]; }
+  }
+
+  return tstats;
+}
+
+//============================================================================|
+// Image Foresting Transform
+//============================================================================|
+/*
+ * Computes the cost of extending a path to a vertex vj, given its terminus 
+ * and its root (i.e., the connectivity function itself)
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  pathcost[in] - REQUIRED: Cost of the path
+ *  vi_voxel[in] - REQUIRED: Path's terminus
+ *  root_feats[in] - REQUIRED: Features of the path's root
+ *  root_sal[in] - REQUIRED: Saliency of the path's root, if any
+ *  vj_index[in] - REQUIRED: Vertex to be conquered
+ *
+ * RETURNS: Connectivity cost of the extended path
+ */
+double iftSICLE_ExtendPath
+(iftSICLE *sicle, iftSICLEArgs *args, double pathcost, iftVoxel vi_voxel, 
+ float *root_feats, float root_sal, iftIdx vj_index)
+{
+	iftVoxel vj_voxel;
+	float *vj_feats;
+	double root_feat_dist, spat_dist, sal_dist, arccost;
+
+	vj_voxel = iftMGetVoxelCoord(sicle->mimg,vj_index);
+	vj_feats = iftSICLE_GetFeats(sicle, vj_index);
+	
+	root_feat_dist = iftEuclDistance(root_feats, vj_feats, sicle->mimg->m);
+	spat_dist = iftVoxelDistance(vi_voxel, vj_voxel);
+	
+	if(sicle->sal != NULL) // Has saliency?
+	{ sal_dist = fabs(root_sal - sicle->sal[vj_index]); }
+	else { sal_dist = 0.0; }
+
+	if(args->connopt == IFT_SICLE_CONN_FMAX) // fmax + wroot
+	{ 
+		arccost = pow(root_feat_dist, 1.0 + args->alpha*sal_dist);
+		pathcost = iftMax(pathcost, arccost);
+	}
+	else if(args->connopt == IFT_SICLE_CONN_FSUM) // fsum + wsum
+	{ 
+		arccost = (args->irreg + args->alpha*sal_dist) * root_feat_dist;
+		arccost = iftFastNatPow(arccost, args->adhr) + spat_dist;
+		pathcost += arccost;
+	}
+	else if(args->connopt == IFT_SICLE_CONN_CUSTOM)
+	{
+		/* 
+			You may write here your own connectivity function for testing possible
+			new functionalities for SICLE. For using that, add "--conn-opt custom"
+			in the command-line
+		*/
+		pathcost += 1;
+	}
+	else
+	{ iftError("Unknown connectivity function", __func__); }	
+
+	return pathcost;
+}
+
+/*
+ * Gathers the features and the saliency of a root. Out-of-core, they are 
+ * found within the seed table, instead of touching the chunk of the root.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  s_index[in] - REQUIRED: Root
+ *  root_sal[out] - REQUIRED: Its saliency, or 0 if there is none
+ *
+ * RETURNS: Its features
+ */
+float *iftSICLE_GetRootData
+(iftSICLE *sicle, iftSICLE_IFTData *data, iftIdx s_index, float *root_sal)
+{
+	float *root_feats;
+
+	(*root_sal) = 0;
+	if(data->pager != NULL)
+	{
+		long pos;
+
+		pos = iftSICLE_FindSeed(data->pager, s_index);
+		root_feats = data->pager->seed_feats + pos * sicle->mimg->m;
+		if(sicle->sal != NULL) { (*root_sal) = data->pager->seed_sal[pos]; }
+	}
+	else
+	{
+		root_feats = iftSICLE_GetFeats(sicle, s_index);
+		if(sicle->sal != NULL) { (*root_sal) = sicle->sal[s_index]; }
+	}
+
+	return root_feats;
+}
+
+/*
+ * Computes the connectivity cost between two vertices vi and vj
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  vi_index[in] - REQUIRED: Path's terminus
+ *  vj_index[in] - REQUIRED: Vertex to be conquered
+ *
+ * RETURNS: Connectivity cost between vi and vj
+ */
+float iftSICLE_ConnFunction
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data, iftIdx vi_index, 
+	iftIdx vj_index)
+{
+	float root_sal;
+	float *root_feats;
+
+	root_feats = iftSICLE_GetRootData(sicle, data, data->root_map[vi_index], 
+																		&root_sal);
+
+	return iftSICLE_ExtendPath(sicle, args, data->cost_map[vi_index],
+														 iftMGetVoxelCoord(sicle->mimg, vi_index), 
+														 root_feats, root_sal, vj_index);
+}
+
+/*
+ * Computes the connectivity cost of a direct arc from a root to a vertex vj
+ * (i.e., as iftSICLE_ConnFunction from the root), without touching the root.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  s_index[in] - REQUIRED: Root, whose path cost is 0
+ *  vj_index[in] - REQUIRED: Vertex to be conquered
+ *
+ * RETURNS: Connectivity cost of the direct arc
+ */
+float iftSICLE_DirectArcCost
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data, iftIdx s_index, 
+	iftIdx vj_index)
+{
+	float root_sal;
+	float *root_feats;
+
+	root_feats = iftSICLE_GetRootData(sicle, data, s_index, &root_sal);
+
+	return iftSICLE_ExtendPath(sicle, args, 0, 
+														 iftMGetVoxelCoord(sicle->mimg, s_index), 
+														 root_feats, root_sal, vj_index);
+}
+
+/*
+ * Executes one sequential IFT with the seeds defined in the IFT data provided,
+ * which is modified and updated in-place
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ */
+void iftSICLE_RunSeedIFT
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data)
+{
+	long num_spels;
+	iftDHeap *heap;
+
+	heap = iftSICLE_CreateHeap(sicle, *data);
+
+	iftSICLE_ResetIFTData(sicle, data); // Prepare data for the sequential IFT
+	for(int s_id = 0; s_id < (*data)->seeds->n; ++s_id) // Add seeds
+	{ 
+		if((*data)->pager != NULL) 
+		{ iftSICLE_TouchPager((*data)->pager, (*data)->seeds->val[s_id]); }
+		iftSICLE_PushHeap(*data, heap, (*data)->seeds->val[s_id]); 
+	}
+
+	num_spels = 0;
+	while(!iftEmptyDHeap(heap))
+	{
+		iftIdx vi_index, vi_root;
+		iftVoxel vi_voxel;
+
+		if(iftSICLE_PollCancel(*data, &num_spels, 1) == true) { break; }
+
+		vi_index = iftSICLE_PopHeap(*data, heap);
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, vi_index); }
+		vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
+		vi_root = (*data)->root_map[vi_index]; 
+
+		for(int j = 1; j < (*data)->A->n; ++j)
+  	{
+  		iftVoxel vj_voxel;
+
+  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+
+  		if(iftMValidVoxel(sicle->mimg, vj_voxel))
+  		{
+  			iftIdx vj_index;
+
+  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+  			if(heap->color[vj_index] != IFT_BLACK) // Out of the heap?
+  			{
+  				double pathcost;
+
+  				pathcost = iftSICLE_ConnFunction(sicle, args, *data, vi_index, vj_index);
+
+					if(pathcost < (*data)->cost_map[vj_index]) // Lesser path-cost?
+					{
+						if(heap->color[vj_index] == IFT_GRAY) // Already within the heap?
+						{ iftSICLE_RemoveHeapElem(*data, heap, vj_index); } // For update
+
+						(*data)->root_map[vj_index] = vi_root; // 
+						(*data)->pred_map[vj_index] = vi_index;// Mark as conquered
+						(*data)->cost_map[vj_index] = pathcost;//
+						iftSICLE_PushHeap(*data, heap, vj_index);
+					}
+  			}
+  		}
+  	}
+	}
+	iftSICLE_DestroyHeap(*data, &heap);
+}
+
+/*
+ * Propagates the paths from the spels within the priority queue, which must
+ * index the cost map of the IFT data, until it is empty. Inconsistent 
+ * subtrees (i.e., whose predecessor's path changed) are removed and compete
+ * again, as in the differential IFT. If cancelled, the queue is emptied.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  heap[in/out] - REQUIRED: Priority queue with the spels to be propagated
+ *  bb[in/out] - OPTIONAL: Bounding box expanded to every spel removed from 
+ *		the queue
+ */
+void iftSICLE_PropagateDIFT
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
+	iftDHeap **heap, iftBoundingBox *bb)
+{
+	long num_spels;
+
+	num_spels = 0;
+	while(iftEmptyDHeap(*heap) == false)
+	{
+		iftIdx vi_index, vi_root;
+		iftVoxel vi_voxel;
+
+		if(iftSICLE_PollCancel(*data, &num_spels, 1) == true) 
+		{ iftSICLE_ResetHeap(*data, *heap); break; }
+
+		vi_index = iftSICLE_PopHeap(*data, *heap);
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, vi_index); }
+		vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
+		vi_root = (*data)->root_map[vi_index]; 
+		if(bb != NULL) { iftSICLE_ExpandBBox(bb, vi_voxel); }
+
+		for(int j = 1; j < (*data)->A->n; ++j)
+  	{
+  		iftVoxel vj_voxel;
+
+  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+
+  		if(iftMValidVoxel(sicle->mimg, vj_voxel))
+  		{
+  			iftIdx vj_index;
+
+  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+  			if((*heap)->color[vj_index] != IFT_BLACK) // Out of the heap?
+  			{
+  				double pathcost;
+		
+  				pathcost = iftSICLE_ConnFunction(sicle, args, *data, vi_index, vj_index);
+
+					if(pathcost < (*data)->cost_map[vj_index]) // Lesser path-cost?
+					{
+						if((*heap)->color[vj_index] == IFT_GRAY) // Already within the heap?
+						{ iftSICLE_RemoveHeapElem(*data, *heap, vj_index); } // For update
+
+						(*data)->root_map[vj_index] = vi_root; //
+						(*data)->pred_map[vj_index] = vi_index;// Mark as conquered
+						(*data)->cost_map[vj_index] = pathcost;//
+						iftSICLE_PushHeap(*data, *heap, vj_index);
+					}
+					else if(vi_index == (*data)->pred_map[vj_index])
+					{
+						if(pathcost > (*data)->cost_map[vj_index] || 
+							 vi_root != (*data)->root_map[vj_index])
+							//Inconsistency -> Remove and Compete again
+						{ iftSICLE_RemoveSubtree(sicle, vj_index, data, heap);}
+					}
+  			}
+  		}
+  	}
+	}
+}
+
+/*
+ * Executes one differential IFT with the seeds defined in the IFT data 
+ * provided, which is modified and updated in-place
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  irre_seeds[in/out] - REQUIRED: Irrelevant seeds to be removed
+ */
+void iftSICLE_RunSeedDIFT
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
+	iftSet **irre_seeds)
+{
+	iftSet *frontier;
+	iftDHeap *heap;
+
+	iftSICLE_UpdateSeedLabels(sicle, data);
+	frontier = iftSICLE_RemoveTrees(sicle, data, irre_seeds);//Remove irrelevants
+	heap = iftSICLE_CreateHeap(sicle, *data);
+
+	while(frontier != NULL)
+	{ 
+		iftIdx v_index;
+
+		v_index = iftRemoveSet(&frontier);
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, v_index); }
+		iftSICLE_PushHeap(*data, heap, v_index); 
+	}
+
+	iftSICLE_PropagateDIFT(sicle, args, data, &heap, NULL);
+	iftSICLE_DestroyHeap(*data, &heap);
+}
+
+/*
+ * Reassigns the root of every reached spel by following its predecessors 
+ * until a seed is found. It is required whenever the predecessor map was
+ * updated without propagating the new roots to the respective subtrees.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  stamp[in/out] - OPTIONAL: Spel's last update. Assigns "sweep" if changed
+ *  sweep[in] - OPTIONAL: Current sweep
+ */
+void iftSICLE_UpdateRootMap
+(iftSICLE *sicle, iftSICLE_IFTData **data, int *stamp, int sweep)
+{
+	iftBMap *done;
+
+	done = iftCreateBMap((*data)->num_vtx);
+
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		iftIdx u_index;
+		iftIdx root;
+
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, v_index); }
+		if((*data)->cost_map[v_index] == IFTSICLE_BKGCOST ||
+			 (*data)->cost_map[v_index] == IFTSICLE_TMPCOST) { continue; }
+
+		u_index = v_index; // Climb until a seed or an updated spel
+		while((*data)->pred_map[u_index] >= 0 && !iftBMapValue(done, u_index))
+		{ 
+			u_index = (*data)->pred_map[u_index]; 
+			if((*data)->pager != NULL) 
+			{ iftSICLE_TouchPager((*data)->pager, u_index); }
+		}
+		
+		if((*data)->pred_map[u_index] < 0) { root = u_index; } // Seed
+		else { root = (*data)->root_map[u_index]; }
+
+		u_index = v_index; // Climb again for updating the path
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, u_index); }
+		while((*data)->pred_map[u_index] >= 0 && !iftBMapValue(done, u_index))
+		{ 
+			if(stamp != NULL && (*data)->root_map[u_index] != root) 
+			{ stamp[u_index] = sweep; }
+			(*data)->root_map[u_index] = root;
+			iftBMapSet1(done, u_index);
+			u_index = (*data)->pred_map[u_index]; 
+			if((*data)->pager != NULL) 
+			{ iftSICLE_TouchPager((*data)->pager, u_index); }
+		}
+	}
+	iftDestroyBMap(&done);
+}
+
+/*
+ * Propagates the paths of the current forest through alternating forward and
+ * backward raster sweeps, until no spel is updated or the maximum number of
+ * sweeps is reached. Within a sweep, each spel only evaluates the adjacents
+ * already visited, similarly to a chamfer distance transform. Thus, the 
+ * resulting forest approximates the one computed by the IFT. The sweeps 
+ * continue beyond the maximum while there are reachable spels not conquered.
+ *
+ * For avoiding unnecessary evaluations, a path is only extended from a spel
+ * updated within the current or the previous sweep. Initially, only the 
+ * active spels are considered as updated.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  active[in/out] - OPTIONAL: Spels to start from. If NULL, all spels.
+ */
+void iftSICLE_RunRasterSweeps
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
+	iftSet **active)
+{
+	bool changed;
+	int num_prev, num_unreached, sweep;
+	long num_spels;
+	int *prev_adj, *stamp;
+
+	// Adjacents which precede the spel in the (forward) raster order
+	prev_adj = calloc((*data)->A->n, sizeof(int));
+	assert(prev_adj != NULL);
+
+	num_prev = 0;
+	for(int j = 1; j < (*data)->A->n; ++j)
+	{
+		int dx, dy, dz;
+
+		dx = (*data)->A->dx[j]; dy = (*data)->A->dy[j]; dz = (*data)->A->dz[j];
+		if(dz < 0 || (dz == 0 && dy < 0) || (dz == 0 && dy == 0 && dx < 0))
+		{ prev_adj[num_prev++] = j; }
+	}
+
+	if((*data)->pager != NULL) // Out-of-core: evicted along with the chunks
+	{ 
+		stamp = (*data)->pager->stamp_mmap->addr;
+		iftSICLE_ClearMMap((*data)->pager->stamp_mmap);
+	}
+	else
+	{
+		stamp = calloc(sicle->mimg->n, sizeof(int));
+		assert(stamp != NULL);
+	}
+
+	num_unreached = 0;
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{ 
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, v_index); }
+		if((*data)->cost_map[v_index] == IFTSICLE_TMPCOST) { num_unreached++; } 
+		if(active != NULL) { stamp[v_index] = IFT_INFINITY_INT_NEG; }
+	}
+
+	if(active != NULL)
+	{
+		for(iftSet *node = (*active); node != NULL; node = node->next)
+		{ 
+			if((*data)->pager != NULL) 
+			{ iftSICLE_TouchPager((*data)->pager, node->elem); }
+			stamp[node->elem] = 0; 
+		}
+		iftDestroySet(active);
+	}
+
+	sweep = 1; changed = true; num_spels = 0;
+	while(changed == true && (sweep <= args->max_sweeps || num_unreached > 0) &&
+				(*data)->cancelled == false)
+	{
+		int dir;
+
+		dir = (sweep % 2 == 1) ? 1 : -1; // Forward or backward sweep
+		changed = false;
+		for(int z = 0; z < sicle->mimg->zsize && !(*data)->cancelled; ++z)
+		{
+			for(int y = 0; y < sicle->mimg->ysize; ++y)
+			{
+				if(iftSICLE_PollCancel(*data, &num_spels, sicle->mimg->xsize))
+				{ break; }
+
+				for(int x = 0; x < sicle->mimg->xsize; ++x)
+				{
+					iftIdx vj_index;
+					iftVoxel vj_voxel;
+
+					if(dir > 0) { vj_voxel.x = x; vj_voxel.y = y; vj_voxel.z = z; }
+					else
+					{
+						vj_voxel.x = sicle->mimg->xsize - 1 - x;
+						vj_voxel.y = sicle->mimg->ysize - 1 - y;
+						vj_voxel.z = sicle->mimg->zsize - 1 - z;
+					}
+					vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+					if((*data)->pager != NULL) 
+					{ iftSICLE_TouchPager((*data)->pager, vj_index); }
+
+					if((*data)->cost_map[vj_index] == IFTSICLE_BKGCOST) { continue; }
+
+					for(int k = 0; k < num_prev; ++k)
+					{
+						iftVoxel vi_voxel;
+
+						vi_voxel.x = vj_voxel.x + dir * (*data)->A->dx[prev_adj[k]];
+						vi_voxel.y = vj_voxel.y + dir * (*data)->A->dy[prev_adj[k]];
+						vi_voxel.z = vj_voxel.z + dir * (*data)->A->dz[prev_adj[k]];
+
+						if(iftMValidVoxel(sicle->mimg, vi_voxel))
+						{
+							iftIdx vi_index;
+							double pathcost;
+
+							vi_index = iftMGetVoxelIndex(sicle->mimg, vi_voxel);
+							if(stamp[vi_index] < sweep - 1 || // Not recently updated
+								 (*data)->cost_map[vi_index] == IFTSICLE_BKGCOST || 
+								 (*data)->cost_map[vi_index] == IFTSICLE_TMPCOST) // Unreached
+							{ continue; }
+
+							pathcost = iftSICLE_ConnFunction(sicle, args, *data, vi_index, 
+																							 vj_index);
+
+							if(pathcost < (*data)->cost_map[vj_index]) // Lesser path-cost?
+							{
+								if((*data)->cost_map[vj_index] == IFTSICLE_TMPCOST)
+								{ num_unreached--; }
+
+								(*data)->root_map[vj_index] = (*data)->root_map[vi_index];
+								(*data)->pred_map[vj_index] = vi_index;
+								(*data)->cost_map[vj_index] = pathcost;
+								stamp[vj_index] = sweep;
+								changed = true;
+							}
+						}
+					}
+				}
+			}
+		}
+		// Subtrees may have been reassigned to other roots
+		if(changed == true) { iftSICLE_UpdateRootMap(sicle, data, stamp, sweep); }
+		sweep++;
+	}
+	free(prev_adj);
+	if((*data)->pager == NULL) { free(stamp); }
+}
+
+/*
+ * Executes one raster-scan approximation of the IFT with the seeds defined in
+ * the IFT data provided, which is modified and updated in-place. If 
+ * irrelevant seeds are given, only their trees are recomputed.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  irre_seeds[in/out] - OPTIONAL: Irrelevant seeds to be removed
+ */
+void iftSICLE_RunSeedRaster
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
+	iftSet **irre_seeds)
+{
+	if(irre_seeds == NULL) // Sequential?
+	{ 
+		iftSICLE_ResetIFTData(sicle, data); 
+		iftSICLE_RunRasterSweeps(sicle, args, data, NULL);
+	}
+	else
+	{
+		iftSet *frontier;
+
+		iftSICLE_UpdateSeedLabels(sicle, data);
+		frontier = iftSICLE_RemoveTrees(sicle, data, irre_seeds);
+		iftSICLE_RunRasterSweeps(sicle, args, data, &frontier);
+	}
+}
+
+/*
+ * Computes the forest of the current iteration through the engine and the
+ * (differential) computation defined in the arguments.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  irre_seeds[in/out] - REQUIRED: Irrelevant seeds of the previous iteration
+ *  is_first[in] - REQUIRED: Flag indicating the first iteration
+ */
+void iftSICLE_RunIteration
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
+	iftSet **irre_seeds, bool is_first)
+{
+	bool is_diff;
+
+	is_diff = args->use_dift == true && is_first == false;
+	if(is_diff == false) { iftDestroySet(irre_seeds); } // Not needed
+
+	if(args->engineopt == IFT_SICLE_ENGINE_HEAP)
+	{
+		if(is_diff == false) { iftSICLE_RunSeedIFT(sicle, args, data); }
+		else { iftSICLE_RunSeedDIFT(sicle, args, data, irre_seeds); }
+	}
+	else if(args->engineopt == IFT_SICLE_ENGINE_RASTER)
+	{
+		if(is_diff == false) { iftSICLE_RunSeedRaster(sicle, args, data, NULL); }
+		else { iftSICLE_RunSeedRaster(sicle, args, data, irre_seeds); }
+	}
+	else
+	{ iftError("Unknown forest computation engine", __func__); }
+
+	if((*data)->pager != NULL) { iftSICLE_TrimPager((*data)->pager); }
+}
+
+//============================================================================|
+// Seed Removal
+//============================================================================|
+/*
+ * Calculate the priority/relevance of a single tree based on the predefined 
+ * criterion and penalization, given its statistics and its adjacents.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  tstats[in] - REQUIRED: Tree statistics
+ *  ti_index[in] - REQUIRED: Tree identifier
+ *
+ * RETURNS: Tree's priority/relevance
+ */
+double iftSICLE_CalcSingleTreePrio
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_TStats *tstats, int ti_index)
+{
+  double prio, size_perc, min_color_grad, max_sal_grad, min_dist, num_adjs,
+  			 max_color_grad, dist_perc;
+
+  size_perc = tstats->size[ti_index]/(float)sicle->mimg->n; 
+
+  prio = max_sal_grad = max_color_grad = 0.0;
+  min_color_grad = min_dist = IFT_INFINITY_DBL;
+  num_adjs = 0;
+  for(int k = 0; k < tstats->num_adj[ti_index]; ++k)
+  {
+  	int tj_index;
+  	double sal_grad, grad, dist;
+
+  	tj_index = tstats->adj[ti_index][k];
+  	num_adjs++; 
+    grad= iftEuclDistance(tstats->feats[ti_index], tstats->feats[tj_index],
+                           tstats->num_feats);
+    dist= iftEuclDistance(tstats->centr[ti_index], tstats->centr[tj_index],
+    											 tstats->num_dims);
+
+    if(grad < min_color_grad) { min_color_grad = grad; }
+    if(grad > max_color_grad) { max_color_grad = grad; }
+    if(dist < min_dist) { min_dist = dist; }
+
+    if(sicle->sal != NULL) // Has saliency?
+    { 
+    	sal_grad = fabs(tstats->sal[ti_index] - tstats->sal[tj_index]); 
+    	if(sal_grad > max_sal_grad) { max_sal_grad = sal_grad; }
+    }
+  }
+  dist_perc = min_dist/iftDiagonalSize(sicle->mimg);
+
+  if(args->critopt == IFT_SICLE_CRIT_SIZE)
+  { prio = size_perc; }
+  else if(args->critopt == IFT_SICLE_CRIT_MINSC)
+  { prio = size_perc * min_color_grad; }
+  else if(args->critopt == IFT_SICLE_CRIT_MAXSC)
+  { prio = size_perc * max_color_grad; }
+  else if(args->critopt == IFT_SICLE_CRIT_SPREAD)
+  { prio = size_perc * min_dist; }
+  else if(args->critopt == IFT_SICLE_CRIT_CUSTOM)
+  {
+  	/* 
+				You may write here your own criterion function for testing possible
+				new functionalities for SICLE. For using that, add "--crit-opt custom"
+				in the command-line
+			*/
+  	prio = size_perc*1.0/min_dist;
+  }
+  else 
+  { iftError("Unknown seed removal criterion fuction", __func__); }
+
+  if(args->penopt == IFT_SICLE_PEN_OBJ)
+	{ prio*= iftMax(tstats->sal[ti_index], max_sal_grad); }
+	else if(args->penopt == IFT_SICLE_PEN_BORD)
+	{ prio*= max_sal_grad; }
+	else if(args->penopt == IFT_SICLE_PEN_OSB)
+	{
+	  float bkg_relevance;
+
+	  bkg_relevance = (1.0 - tstats->sal[ti_index])*dist_perc;
+	  prio*= iftMax(tstats->sal[ti_index],bkg_relevance);
+	}
+	else if(args->penopt == IFT_SICLE_PEN_BOBS)
+	{
+	  float bkg_relevance, obj_relevance;
+			
+			obj_relevance = tstats->sal[ti_index]*max_sal_grad;
+	  bkg_relevance = (1.0 - tstats->sal[ti_index])*dist_perc;
+	  prio*= iftMax(obj_relevance,bkg_relevance);
+	}
+	else if(args->penopt == IFT_SICLE_PEN_CUSTOM)
+	{
+  	/* 
+				You may write here your own penalization function for testing possible
+				new functionalities for SICLE. For using that, add "--pen-opt custom"
+				in the command-line
+			*/
+	  prio*= 1;
+	}
+	else if(args->penopt != IFT_SICLE_PEN_NONE)
+		{ iftError("Unknown seed relevance penalization", __func__); }
+
+  return prio;
+}
+
+/*
+ * Calculate the priority/relevance of the trees based on the predefined 
+ * criterion and penalization, given their statistics.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  tstats[in] - REQUIRED: Tree statistics
+ *
+ * RETURNS: Double |T|-sized array of trees' priority/relevance
+ */
+double *iftSICLE_CalcTreePrio
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_TStats *tstats)
+{
+  double *prio;
+
+  prio = calloc(tstats->num_trees, sizeof(double));
+  assert(prio != NULL);
+	
+  #ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+  for(long ti_index = 0; ti_index < tstats->num_trees; ++ti_index)
+  { prio[ti_index] = iftSICLE_CalcSingleTreePrio(sicle,args,tstats,ti_index); }
+
+  return prio;
+}
+
+/*
+ * Calculate the priority/relevance of the seeds based on the predefined 
+ * criterion and penalization. 
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *
+ * RETURNS: Double |S|-sized array of seeds' priority/relevance
+ */
+double *iftSICLE_CalcSeedPrio
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+{
+  double *prio;
+  iftSICLE_TStats *tstats;
+
+  tstats = iftSICLE_CalcTStats(sicle, args, data);
+  prio = iftSICLE_CalcTreePrio(sicle, args, tstats);
+  iftSICLE_DestroyTStats(&tstats);
+
+  return prio;
+}
+
+/*
+ * Removes Ni irrelevant seeds for the next IFT execution
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  num_maint[in] - REQUIRED: Number of seeds to be maintained
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  irre_seeds[in/out] - REQUIRED: Irrelevant seeds selected to be removed
+ */
+void iftSICLE_RemSeeds
+(iftSICLE *sicle, int num_maint, iftSICLEArgs *args, iftSICLE_IFTData **data,
+ iftSet **irre_seeds)
+{
+  double *prio;
+  iftIdxArray *new_seeds;
+  iftDHeap *heap;
+
+  prio = iftSICLE_CalcSeedPrio(sicle, args, (*data));
+  heap = iftCreateDHeap((*data)->seeds->n, prio);
+  iftSetRemovalPolicyDHeap(heap, MAXVALUE);
+
+  new_seeds = iftCreateIdxArray(num_maint); // Empty array
+
+  for(long s_id = 0; s_id < (*data)->seeds->n; ++s_id) // Add all for ordering
+  { iftInsertDHeap(heap, s_id); } 
+
+  for(long i = 0; i < num_maint; ++i) // Add relevants
+  { new_seeds->val[i] = (*data)->seeds->val[iftRemoveDHeap(heap)]; }
+
+	(*irre_seeds) = NULL;
   while(!iftEmptyDHeap(heap)) // Add irrelevants for removal
   { iftInsertSet(irre_seeds, (*data)->seeds->val[iftRemoveDHeap(heap)]); }
-	iftDestroyIntArray(&((*data)->seeds));
+	iftDestroyIdxArray(&((*data)->seeds));
+	(*data)->seeds = new_seeds;
+
+  free(prio);
+  iftDestroyDHeap(&heap);
+}
+
+//============================================================================|
+// iftSICLE_RAG
+//============================================================================|
+/*
+ * Creates the region adjacency graph of the trees of the current forest, in
+ * which each region is initially represented by a single tree.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_RAG *iftSICLE_CreateRAG
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+{
+	iftSICLE_RAG *rag;
+
+	rag = malloc(sizeof(iftSICLE_RAG));
+	assert(rag != NULL);
+
+	rag->tstats = iftSICLE_CalcTStats(sicle, args, data);
+	rag->num_alive = rag->tstats->num_trees;
+
+	rag->seeds = iftCreateIdxArray(data->seeds->n);
+	memcpy(rag->seeds->val, data->seeds->val, data->seeds->n * sizeof(iftIdx));
+
+	rag->parent = calloc(rag->tstats->num_trees, sizeof(int));
+	assert(rag->parent != NULL);
+
+	rag->mark = calloc(rag->tstats->num_trees, sizeof(int));
+	assert(rag->mark != NULL);
+
+	for(int r = 0; r < rag->tstats->num_trees; ++r) 
+	{ rag->parent[r] = r; rag->mark[r] = IFT_NIL; }
+
+	return rag;
+}
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		rag[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyRAG
+(iftSICLE_RAG **rag)
+{
+	iftSICLE_DestroyTStats(&((*rag)->tstats));
+	iftDestroyIdxArray(&((*rag)->seeds));
+	free((*rag)->parent);
+	free((*rag)->mark);
+
+	free(*rag);
+	(*rag) = NULL;
+}
+
+/*
+ * Finds the alive region which absorbed the given one, while compressing the
+ * path for later queries.
+ *
+ * PARAMETERS:
+ *  rag[in/out] - REQUIRED: Region adjacency graph
+ *  r[in] - REQUIRED: Region (i.e., initial tree) identifier
+ *
+ * RETURNS: Alive region's identifier
+ */
+int iftSICLE_FindRAG
+(iftSICLE_RAG *rag, int r)
+{
+	int root;
+
+	root = r;
+	while(rag->parent[root] != root) { root = rag->parent[root]; }
+
+	while(rag->parent[r] != root) // Path compression
+	{
+		int next;
+
+		next = rag->parent[r];
+		rag->parent[r] = root;
+		r = next;
+	}
+
+	return root;
+}
+
+/*
+ * Computes the arc cost between two adjacent regions given their mean 
+ * features and saliency, analogously to the connectivity function.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  rag[in] - REQUIRED: Region adjacency graph
+ *  ri[in] - REQUIRED: First region
+ *  rj[in] - REQUIRED: Second region
+ *
+ * RETURNS: Arc cost between the regions
+ */
+double iftSICLE_RAGArcCost
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_RAG *rag, int ri, int rj)
+{
+	double feat_dist, sal_dist, arccost;
+
+	feat_dist = iftEuclDistance(rag->tstats->feats[ri], rag->tstats->feats[rj], 
+															rag->tstats->num_feats);
+
+	if(sicle->sal != NULL) // Has saliency?
+	{ sal_dist = fabs(rag->tstats->sal[ri] - rag->tstats->sal[rj]); }
+	else { sal_dist = 0.0; }
+
+	if(args->connopt == IFT_SICLE_CONN_FMAX)
+	{ arccost = pow(feat_dist, 1.0 + args->alpha*sal_dist); }
+	else if(args->connopt == IFT_SICLE_CONN_FSUM)
+	{ 
+		arccost = (args->irreg + args->alpha*sal_dist) * feat_dist;
+		arccost = iftFastNatPow(arccost, args->adhr);
+	}
+	else { arccost = feat_dist; } // Custom
+
+	return arccost;
+}
+
+/*
+ * Gathers the alive adjacents of a region, by replacing each absorbed one in
+ * its list by the region which absorbed it, and by removing the repeated 
+ * ones and the region itself. Thus, it costs linear time on the list's size.
+ *
+ * PARAMETERS:
+ *  rag[in/out] - REQUIRED: Region adjacency graph
+ *  r[in] - REQUIRED: Alive region
+ */
+void iftSICLE_GatherRAGAdj
+(iftSICLE_RAG *rag, int r)
+{
+	int num_alive;
+	iftSICLE_TStats *tstats;
+
+	tstats = rag->tstats;
+	num_alive = 0;
+	for(int k = 0; k < tstats->num_adj[r]; ++k)
+	{
+		int rk;
+
+		rk = iftSICLE_FindRAG(rag, tstats->adj[r][k]);
+		if(rk != r && rag->mark[rk] != r)
+		{ rag->mark[rk] = r; tstats->adj[r][num_alive++] = rk; }
+	}
+	tstats->num_adj[r] = num_alive;
+
+	for(int k = 0; k < num_alive; ++k) { rag->mark[tstats->adj[r][k]] = IFT_NIL; }
+}
+
+/*
+ * Absorbs the second region into the first one, by merging their statistics
+ * and appending the adjacents of the latter to the ones of the former. The
+ * adjacents are kept as they were, and are resolved once gathered.
+ *
+ * PARAMETERS:
+ *  rag[in/out] - REQUIRED: Region adjacency graph
+ *  ri[in] - REQUIRED: Region absorbing
+ *  rj[in] - REQUIRED: Region being absorbed
+ */
+void iftSICLE_MergeRAG
+(iftSICLE_RAG *rag, int ri, int rj)
+{
+	float wi, wj;
+	iftSICLE_TStats *tstats;
+
+	tstats = rag->tstats;
+	wi = tstats->size[ri] / (float)(tstats->size[ri] + tstats->size[rj]);
+	wj = 1.0 - wi;
+
+	for(int f = 0; f < tstats->num_feats; ++f)
+	{ tstats->feats[ri][f] = wi*tstats->feats[ri][f] + wj*tstats->feats[rj][f]; }
+	for(int d = 0; d < tstats->num_dims; ++d)
+	{ tstats->centr[ri][d] = wi*tstats->centr[ri][d] + wj*tstats->centr[rj][d]; }
+	if(tstats->sal != NULL)
+	{ tstats->sal[ri] = wi*tstats->sal[ri] + wj*tstats->sal[rj]; }
+	tstats->size[ri] += tstats->size[rj];
+
+	for(int k = 0; k < tstats->num_adj[rj]; ++k)
+	{ iftSICLE_AppendTStatsAdj(tstats, ri, tstats->adj[rj][k]); }
+	tstats->num_adj[rj] = 0;
+
+	rag->parent[rj] = ri;
+	rag->num_alive--;
+}
+
+/*
+ * Contracts the region adjacency graph until Ni regions remain, by absorbing
+ * the least relevant ones into their adjacent with the lowest arc cost. Then,
+ * the seeds and the labels of the IFT data are updated accordingly, and the
+ * absorbed seeds are added to the irrelevant ones.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  num_maint[in] - REQUIRED: Number of regions to be maintained
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  rag[in/out] - REQUIRED: Region adjacency graph
+ *  irre_seeds[in/out] - REQUIRED: Absorbed seeds so far
+ */
+void iftSICLE_ContractRAG
+(iftSICLE *sicle, int num_maint, iftSICLEArgs *args, iftSICLE_IFTData **data,
+ iftSICLE_RAG *rag, iftSet **irre_seeds)
+{
+	int num_trees;
+	int *new_label;
+	double *prio;
+	iftIdxArray *new_seeds;
+	iftDHeap *heap;
+
+	num_trees = rag->tstats->num_trees;
+	for(int r = 0; r < num_trees; ++r) // Resolve the previous contractions
+	{ if(rag->parent[r] == r) { iftSICLE_GatherRAGAdj(rag, r); } }
+	prio = iftSICLE_CalcTreePrio(sicle, args, rag->tstats);
+	heap = iftCreateDHeap(num_trees, prio);
+	iftSetRemovalPolicyDHeap(heap, MINVALUE);
+
+	for(int r = 0; r < num_trees; ++r) // Add alive ones for ordering
+	{ if(rag->parent[r] == r) { iftInsertDHeap(heap, r); } }
+
+	while(rag->num_alive > num_maint && !iftEmptyDHeap(heap))
+	{
+		int ri, best_r;
+		double best_cost;
+
+		ri = iftRemoveDHeap(heap);
+		iftSICLE_GatherRAGAdj(rag, ri);
+		best_r = IFT_NIL; best_cost = IFT_INFINITY_DBL;
+		for(int k = 0; k < rag->tstats->num_adj[ri]; ++k)
+		{
+			int rj;
+			double arccost;
+
+			rj = rag->tstats->adj[ri][k];
+			arccost = iftSICLE_RAGArcCost(sicle, args, rag, ri, rj);
+			if(arccost < best_cost || (arccost == best_cost && rj < best_r))
+			{ best_cost = arccost; best_r = rj; } // Lowest identifier on ties
+		}
+
+		if(best_r != IFT_NIL) // Isolated regions are kept
+		{ 
+			iftSICLE_MergeRAG(rag, best_r, ri); 
+			iftInsertSet(irre_seeds, rag->seeds->val[ri]);
+
+			// Its statistics changed, thus its priority is updated
+			iftSICLE_GatherRAGAdj(rag, best_r);
+			iftRemoveDHeapElem(heap, best_r);
+			prio[best_r] = iftSICLE_CalcSingleTreePrio(sicle, args, rag->tstats, 
+																								 best_r);
+			iftInsertDHeap(heap, best_r);
+		}
+	}
+	free(prio);
+	iftDestroyDHeap(&heap);
+
+	new_label = calloc(num_trees, sizeof(int));
+	assert(new_label != NULL);
+
+	new_seeds = iftCreateIdxArray(rag->num_alive);
+	for(int r = 0, s_id = 0; r < num_trees; ++r)
+	{
+		if(rag->parent[r] == r)
+		{
+			new_seeds->val[s_id] = rag->seeds->val[r];
+			new_label[r] = s_id++;
+		}
+	}
+	iftDestroyIdxArray(&((*data)->seeds));
 	(*data)->seeds = new_seeds;
 
-  free(prio);
-  iftDestroyDHeap(&heap);
+	// Store the label of the absorbing region within the absorbed seeds
+	for(int r = 0; r < num_trees; ++r) 
+	{ new_label[r] = new_label[iftSICLE_FindRAG(rag, r)]; } // Kept if alive
+	if((*data)->pager != NULL) // In the chunks' order
+	{ iftSICLE_TabulateSeeds(sicle, *data, rag->seeds, new_label, false); }
+	else
+	{
+		for(int r = 0; r < num_trees; ++r)
+		{ (*data)->pred_map[rag->seeds->val[r]] = -(new_label[r] + 1); } // 2's c.
+	}
+	free(new_label);
+}
+
+/*
+ * Finishes the region merging. If required, the regions are refined by
+ * computing the forest of the remaining seeds; otherwise, the labels of 
+ * the absorbed trees are kept.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  rag[in/out] - REQUIRED: Region adjacency graph to be free'd
+ *  irre_seeds[in/out] - REQUIRED: Absorbed seeds
+ */
+void iftSICLE_FinishRAG
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
+	iftSICLE_RAG **rag, iftSet **irre_seeds)
+{
+	if(args->use_refine == true)
+	{ iftSICLE_RunIteration(sicle, args, data, irre_seeds, false); }
+	else { iftDestroySet(irre_seeds); }
+
+	iftSICLE_DestroyRAG(rag);
+}
+
+//============================================================================|
+// Runner
+//============================================================================|
+/*
+ * Runs the seed removal schedule from the seeds of the IFT data to Nf seeds,
+ * computing the final forest. If the IFT data has a deadline, the schedule
+ * stops once another iteration is predicted to exceed it, and the current
+ * forest is either merged down to Nf superspels (without refinement) or kept,
+ * as defined by the fast finish flag. If it is cancelled, the schedule stops
+ * immediately and the forest is incomplete. The deadline is ignored when the
+ * removal order is requested. If the IFT data has already an iteration, its 
+ * forest is taken as the first one.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data, with its initial seeds
+ *  order[out] - OPTIONAL: Initial seeds sorted from the first removed to the
+ *		most relevant final one (sized as the initial number of seeds)
+ */
+void iftSICLE_RunSchedule
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, iftIdx *order)
+{
+	bool out_of_time, has_first;
+	long num_rem;
+	double start;
+	iftSICLE_RAG *rag;
+	iftSet *irre_seeds;
+	iftIntArray *ni;
+
+	ni = iftSICLE_CreateNiArray(args, (*data)->seeds->n);
+	if(order != NULL) { (*data)->deadline = 0; }
+	has_first = (*data)->num_iters > 0; // e.g., shared by a sweep
+
+	irre_seeds = NULL; rag = NULL; num_rem = 0; out_of_time = false;
+	start = iftSICLE_GetWallTime();
+  for(int it = 1; it < ni->n; ++it)
+  {
+  	#ifdef IFT_DEBUG //-------------------------------------------------------|
+		fprintf(stderr, "DEBUG (%s): Iteration %d\n", __func__, it);
+		#endif //-----------------------------------------------------------------|	
+		if(rag == NULL && (it > 1 || has_first == false)) // Not merged previously
+		{ iftSICLE_RunIteration(sicle, args, data, &irre_seeds, it == 1); }
+		if((*data)->cancelled == true) { break; }
+		(*data)->num_iters = it;
+
+		#ifdef IFT_DEBUG //-------------------------------------------------------|
+		if((*data)->pager == NULL) // Out-of-core, they would touch every chunk
+		{
+			iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, *data);
+			iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", it, ni->val[it-1]);
+			iftDestroyImage(&seed_img);
+			iftImage *segm_img = iftSICLE_CreateLabelImage(sicle, *data);
+			iftWriteImageByExt(segm_img, "debug/segm_%d_%d.pgm", it, ni->val[it-1]);
+			iftDestroyImage(&segm_img);
+		}
+		fprintf(stderr, "DEBUG (%s): Ni = %d\n", __func__, ni->val[it]);
+		#endif //-----------------------------------------------------------------|		
+		
+		out_of_time = iftSICLE_IsOutOfTime(*data, start);
+		if(out_of_time == true) { break; }
+
+		if(args->use_rag == true && rag == NULL) // Merge from now on?
+		{ rag = iftSICLE_CreateRAG(sicle, args, *data); }
+
+		if(rag == NULL) 
+		{ iftSICLE_RemSeeds(sicle, ni->val[it], args, data, &irre_seeds); }
+		else
+		{ iftSICLE_ContractRAG(sicle, ni->val[it], args, data, rag, &irre_seeds); }
+		if((*data)->pager != NULL) { iftSICLE_TrimPager((*data)->pager); }
+
+		if(order != NULL) // The least relevant seed is at the head
+		{ 
+			for(iftSet *node = irre_seeds; node != NULL; node = node->next)
+			{ order[num_rem++] = node->elem; }
+		}
+  }
+	if((*data)->cancelled == true) // The forest is discarded
+	{
+		iftDestroySet(&irre_seeds);
+		if(rag != NULL) { iftSICLE_DestroyRAG(&rag); }
+		iftDestroyIntArray(&ni);
+		return;
+	}
+
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	fprintf(stderr, "DEBUG (%s): Last iteration\n", __func__);
+	#endif //-------------------------------------------------------------------|	
+	if(out_of_time == true && args->use_fast_finish == true)
+	{
+		iftSICLEArgs fast_args;
+
+		// Merging is much cheaper than another IFT
+		fast_args = (*args); // Shallow copy
+		fast_args.use_refine = false;
+		if(rag == NULL) { rag = iftSICLE_CreateRAG(sicle, args, *data); }
+		iftSICLE_ContractRAG(sicle, args->nf, &fast_args, data, rag, &irre_seeds);
+		iftSICLE_FinishRAG(sicle, &fast_args, data, &rag, &irre_seeds);
+	}
+	else if(out_of_time == true) // The current scale is kept
+	{ 
+		iftDestroySet(&irre_seeds);
+		if(rag != NULL) { iftSICLE_DestroyRAG(&rag); } 
+	}
+	else // Segmentation with Nf seeds
+	{
+		if(rag == NULL && (ni->n > 1 || has_first == false)) 
+		{ iftSICLE_RunIteration(sicle, args, data, &irre_seeds, ni->n == 1); }
+		else if(rag != NULL) 
+		{ iftSICLE_FinishRAG(sicle, args, data, &rag, &irre_seeds); }
+		if((*data)->cancelled == false) { (*data)->num_iters = ni->n; }
+	}
+
+	if(order != NULL) // Sorted by decreasing relevance
+	{
+		for(long s_id = (*data)->seeds->n - 1; s_id >= 0; --s_id)
+		{ order[num_rem++] = (*data)->seeds->val[s_id]; }
+	}
+	
+  #ifdef IFT_DEBUG //---------------------------------------------------------|
+	iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, *data);
+	iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", ni->n, args->nf);
+	iftDestroyImage(&seed_img);
+	iftImage *segm_img = iftSICLE_CreateLabelImage(sicle, *data);
+	iftWriteImageByExt(segm_img, "debug/segm_%d_%d.pgm", ni->n, args->nf);
+	iftDestroyImage(&segm_img);
+	#endif //-------------------------------------------------------------------|
+
+	iftDestroyIntArray(&ni);
+}
+
+/*
+ * Runs the whole seed removal cascade, from N0 to Nf seeds, and returns the 
+ * final forest
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *
+ * RETURNS: IFT data of the forest with Nf seeds
+ */
+iftSICLE_IFTData *iftSICLE_RunCascade
+(iftSICLE *sicle, iftSICLEArgs *args)
+{
+	iftSICLE_IFTData *data;
+
+	data = iftSICLE_CreateIFTData(sicle, args);
+	iftSICLE_RunSchedule(sicle, args, &data, NULL);
+
+	return data;
+}
+
+/*
+ * Runs the whole seed removal cascade, from N0 to Nf seeds, while visiting
+ * the forest of each scale (i.e., iteration), from the first to the last.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  func[in] - REQUIRED: Function visiting each scale
+ *  ctx[in/out] - OPTIONAL: Context given to the function
+ *
+ * RETURNS: Number of scales visited
+ */
+int iftSICLE_RunScales
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_ScaleFunc func, void *ctx)
+{
+	int num_scales;
+	iftSICLE_IFTData *data;
+	iftSICLE_RAG *rag;
+	iftSet *irre_seeds;
+	iftIntArray *ni;
+
+	data = iftSICLE_CreateIFTData(sicle, args);
+	ni = iftSICLE_CreateNiArray(args, data->seeds->n);
+	num_scales = ni->n;
+
+	irre_seeds = NULL; rag = NULL;
+  for(int it = 1; it < ni->n; ++it)
+  {
+  	#ifdef IFT_DEBUG //-------------------------------------------------------|
+		fprintf(stderr, "DEBUG (%s): Iteration %d\n", __func__, it);
+		#endif //-----------------------------------------------------------------|	
+		if(rag == NULL) // Otherwise, the regions were merged previously
+		{ iftSICLE_RunIteration(sicle, args, &data, &irre_seeds, it == 1); }
+		func(sicle, data, it - 1, num_scales, ctx);
+
+		#ifdef IFT_DEBUG //-------------------------------------------------------|
+		iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, data);
+		iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", it, ni->val[it-1]);
+		iftDestroyImage(&seed_img);
+		fprintf(stderr, "DEBUG (%s): Ni = %d\n", __func__, ni->val[it]);
+		#endif //-----------------------------------------------------------------|		
+		if(args->use_rag == true && rag == NULL) // Merge from now on?
+		{ rag = iftSICLE_CreateRAG(sicle, args, data); }
+
+		if(rag == NULL) 
+		{ iftSICLE_RemSeeds(sicle, ni->val[it], args,&data, &irre_seeds); }
+		else
+		{ iftSICLE_ContractRAG(sicle, ni->val[it], args, &data, rag, &irre_seeds); }
+		if(data->pager != NULL) { iftSICLE_TrimPager(data->pager); }
+  }
+
+	// Segmentation with Nf seeds
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	fprintf(stderr, "DEBUG (%s): Last iteration\n", __func__);
+	#endif //-------------------------------------------------------------------|	
+	if(rag == NULL) 
+	{ iftSICLE_RunIteration(sicle, args, &data, &irre_seeds, false); }
+	else { iftSICLE_FinishRAG(sicle, args, &data, &rag, &irre_seeds); }
+	func(sicle, data, num_scales - 1, num_scales, ctx);
+
+  #ifdef IFT_DEBUG //---------------------------------------------------------|
+	iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, data);
+	iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", ni->n, args->nf);
+	iftDestroyImage(&seed_img);
+	#endif //-------------------------------------------------------------------|
+
+	iftSICLE_DestroyIFTData(&data);
+	iftDestroyIntArray(&ni);
+
+	return num_scales;
+}
+
+/*
+ * Scale visitor which stores the label image of each scale within an array
+ * of label images, allocated at the first scale.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data of the scale
+ *  scale[in] - REQUIRED: Scale index
+ *  num_scales[in] - REQUIRED: Number of scales
+ *  ctx[in/out] - REQUIRED: Pointer to the array of label images
+ */
+void iftSICLE_StoreScale
+(iftSICLE *sicle, iftSICLE_IFTData *data, int scale, int num_scales, void *ctx)
+{
+	iftImage ***segm;
+
+	segm = (iftImage***)ctx;
+	if(scale == 0) 
+	{ 
+		(*segm) = calloc(num_scales, sizeof(iftImage*)); 
+		assert((*segm) != NULL);
+	}
+	(*segm)[scale] = iftSICLE_CreateLabelImage(sicle, data);
+}
+
+/*
+ * Scale visitor which writes the labels of each scale within the caller's 
+ * buffer and hands it to the caller's callback.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data of the scale
+ *  scale[in] - REQUIRED: Scale index
+ *  num_scales[in] - REQUIRED: Number of scales
+ *  ctx[in/out] - REQUIRED: Caller's buffer and callback
+ */
+void iftSICLE_CallbackScale
+(iftSICLE *sicle, iftSICLE_IFTData *data, int scale, int num_scales, void *ctx)
+{
+	iftSICLE_Callback *cb;
+
+	cb = (iftSICLE_Callback*)ctx;
+	iftSICLE_WriteLabels(sicle, data, cb->label_img);
+	cb->callback(cb->label_img, scale, num_scales, cb->user);
+}
+
+/*
+ * Scale visitor which builds the compact multiscale segmentation. The labels
+ * of the first scale are kept, and each previous superspel is mapped to the 
+ * superspel containing its seed at the current scale. The spels whose label
+ * differs from their mapped one are counted as not nested.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data of the scale
+ *  scale[in] - REQUIRED: Scale index
+ *  num_scales[in] - REQUIRED: Number of scales
+ *  ctx[in/out] - REQUIRED: Compact segmentation being built
+ */
+void iftSICLE_CompactScale
+(iftSICLE *sicle, iftSICLE_IFTData *data, int scale, int num_scales, void *ctx)
+{
+	iftSICLE_Compact *compact;
+	iftSICLEMultiscale *msegm;
+
+	compact = (iftSICLE_Compact*)ctx;
+	msegm = compact->msegm;
+
+	if(scale == 0)
+	{
+		msegm->num_scales = num_scales;
+		msegm->parent = calloc(num_scales, sizeof(iftIntArray*));
+		assert(msegm->parent != NULL);
+		msegm->not_nested = iftCreateFloatArray(num_scales);
+		msegm->label_img = iftSICLE_CreateLabelImage(sicle, data);
+
+		compact->nest_label = malloc(sicle->mimg->n * sizeof(int));
+		assert(compact->nest_label != NULL);
+		memcpy(compact->nest_label, msegm->label_img->val, 
+					 sicle->mimg->n * sizeof(int));
+	}
+	else
+	{
+		long num_roi, num_diff;
+		iftIntArray *parent;
+
+		parent = iftCreateIntArray(compact->prev_seeds->n + 1); // 0 is the bkg
+		for(long s_id = 0; s_id < compact->prev_seeds->n; ++s_id)
+		{ 
+			parent->val[s_id + 1] = 
+				iftSICLE_GetRootLabel(data, compact->prev_seeds->val[s_id]) + 1; 
+		}
+
+		num_roi = num_diff = 0;
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for reduction(+:num_roi,num_diff)
+		#endif //-----------------------------------------------------------------|
+		for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+		{
+			if(iftSICLE_InROI(sicle, v_index))
+			{
+				int label;
+
+				label = parent->val[compact->nest_label[v_index]];
+				if(label != iftSICLE_GetRootLabel(data, v_index) + 1) { num_diff++; }
+				compact->nest_label[v_index] = label;
+				num_roi++;
+			}
+		}
+		msegm->parent[scale - 1] = parent;
+		if(num_roi > 0) 
+		{ msegm->not_nested->val[scale] = num_diff / (float)num_roi; }
+		iftDestroyIdxArray(&(compact->prev_seeds));
+	}
+
+	if(scale < num_scales - 1)
+	{
+		compact->prev_seeds = iftCreateIdxArray(data->seeds->n);
+		memcpy(compact->prev_seeds->val, data->seeds->val, 
+					 data->seeds->n * sizeof(iftIdx));
+	}
+	else { free(compact->nest_label); compact->nest_label = NULL; }
+}
+
+//============================================================================|
+// Pyramid
+//============================================================================|
+/*
+ * Creates a downsampled copy of the SICLE auxiliary data, in which each
+ * coarse spel summarizes a block of factor^d spels: its features and its 
+ * saliency are the block's mean; and it is within the ROI if any spel of the
+ * block is.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  factor[in] - REQUIRED: Downsampling factor per (spatial) dimension
+ *
+ * RETURNS: Downsampled SICLE auxiliary data
+ */
+iftSICLE *iftSICLE_CreateCoarseSICLE
+(iftSICLE *sicle, int factor)
+{
+	int fz;
+	iftSICLE *coarse;
+	iftMImage *mimg;
+
+	mimg = sicle->mimg;
+	fz = (iftIs3DMImage(mimg) == true) ? factor : 1;
+
+	coarse = malloc(sizeof(iftSICLE));
+	assert(coarse != NULL);
+
+	coarse->mimg = iftCreateMImage((mimg->xsize + factor - 1)/factor, 
+																 (mimg->ysize + factor - 1)/factor,
+																 (mimg->zsize + fz - 1)/fz, mimg->m);
+	coarse->mimg->dx = mimg->dx * factor; 
+	coarse->mimg->dy = mimg->dy * factor; 
+	coarse->mimg->dz = mimg->dz * fz;
+
+	if(sicle->sal != NULL) 
+	{ 
+		coarse->sal = calloc(coarse->mimg->n, sizeof(float)); 
+		assert(coarse->sal != NULL);
+	}
+	else { coarse->sal = NULL; }
+
+	if(sicle->roi != NULL) { coarse->roi = iftCreateBMap(coarse->mimg->n); }
+	else { coarse->roi = NULL; }
+	coarse->feats_mmap = NULL; coarse->sal_mmap = NULL; 
+	coarse->roi_mmap = NULL;
+
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx c_index = 0; c_index < coarse->mimg->n; ++c_index)
+	{
+		int count;
+		bool in_roi;
+		iftVoxel c_voxel, v_voxel;
+
+		c_voxel = iftMGetVoxelCoord(coarse->mimg, c_index);
+		count = 0; in_roi = false;
+
+		for(v_voxel.z = c_voxel.z*fz; 
+				v_voxel.z < iftMin((c_voxel.z + 1)*fz, mimg->zsize); ++v_voxel.z)
+		for(v_voxel.y = c_voxel.y*factor; 
+				v_voxel.y < iftMin((c_voxel.y + 1)*factor, mimg->ysize); ++v_voxel.y)
+		for(v_voxel.x = c_voxel.x*factor; 
+				v_voxel.x < iftMin((c_voxel.x + 1)*factor, mimg->xsize); ++v_voxel.x)
+		{
+			iftIdx v_index;
+
+			v_index = iftMGetVoxelIndex(mimg, v_voxel);
+			for(int b = 0; b < mimg->m; ++b) 
+			{ 
+				iftSICLE_GetFeats(coarse, c_index)[b] += 
+					iftSICLE_GetFeats(sicle, v_index)[b]; 
+			}
+			if(sicle->sal != NULL) { coarse->sal[c_index] += sicle->sal[v_index]; }
+			in_roi = in_roi || iftSICLE_InROI(sicle, v_index);
+			count++;
+		}
+
+		for(int b = 0; b < mimg->m; ++b) 
+		{ iftSICLE_GetFeats(coarse, c_index)[b] /= count; }
+		if(sicle->sal != NULL) { coarse->sal[c_index] /= count; }
+		if(sicle->roi != NULL && in_roi == true) 
+		{ 
+			#ifdef IFT_OMP //-------------------------------------------------------|
+			#pragma omp critical
+			#endif //---------------------------------------------------------------|
+			iftBMapSet1(coarse->roi, c_index); // Bytes are shared between threads
+		}
+	}
+
+	return coarse;
+}
+
+/*
+ * Maps a spel to the coarse spel whose block contains it
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  coarse[in] - REQUIRED: Downsampled SICLE auxiliary data
+ *  factor[in] - REQUIRED: Downsampling factor per (spatial) dimension
+ *  v_index[in] - REQUIRED: Spel in the original resolution
+ *
+ * RETURNS: Index of the coarse spel
+ */
+iftIdx iftSICLE_GetCoarseIndex
+(iftSICLE *sicle, iftSICLE *coarse, int factor, iftIdx v_index)
+{
+	iftVoxel v_voxel;
+
+	v_voxel = iftMGetVoxelCoord(sicle->mimg, v_index);
+	v_voxel.x /= factor; v_voxel.y /= factor;
+	if(iftIs3DMImage(sicle->mimg) == true) { v_voxel.z /= factor; }
+
+	return iftMGetVoxelIndex(coarse->mimg, v_voxel);
+}
+
+/*
+ * Projects the seeds of the coarse forest to the original resolution. Each 
+ * seed is placed at the ROI spel of its block which is closest to the 
+ * block's center, preserving the seeds' order (i.e., their labels).
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  coarse[in] - REQUIRED: Downsampled SICLE auxiliary data
+ *  factor[in] - REQUIRED: Downsampling factor per (spatial) dimension
+ *  coarse_seeds[in] - REQUIRED: Seeds of the coarse forest
+ *
+ * RETURNS: Projected seeds
+ */
+iftIdxArray *iftSICLE_ProjectSeeds
+(iftSICLE *sicle, iftSICLE *coarse, int factor, iftIdxArray *coarse_seeds)
+{
+	int fz;
+	iftIdxArray *seeds;
+
+	fz = (iftIs3DMImage(sicle->mimg) == true) ? factor : 1;
+	seeds = iftCreateIdxArray(coarse_seeds->n);
+
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(int s_id = 0; s_id < coarse_seeds->n; ++s_id)
+	{
+		float best_dist;
+		iftVoxel c_voxel, center, v_voxel;
+
+		c_voxel = iftMGetVoxelCoord(coarse->mimg, coarse_seeds->val[s_id]);
+		center.x = iftMin(c_voxel.x*factor + factor/2, sicle->mimg->xsize - 1);
+		center.y = iftMin(c_voxel.y*factor + factor/2, sicle->mimg->ysize - 1);
+		center.z = iftMin(c_voxel.z*fz + fz/2, sicle->mimg->zsize - 1);
+
+		seeds->val[s_id] = IFT_NIL; best_dist = IFT_INFINITY_FLT;
+		for(v_voxel.z = c_voxel.z*fz; 
+				v_voxel.z < iftMin((c_voxel.z + 1)*fz, sicle->mimg->zsize); 
+				++v_voxel.z)
+		for(v_voxel.y = c_voxel.y*factor; 
+				v_voxel.y < iftMin((c_voxel.y + 1)*factor, sicle->mimg->ysize); 
+				++v_voxel.y)
+		for(v_voxel.x = c_voxel.x*factor; 
+				v_voxel.x < iftMin((c_voxel.x + 1)*factor, sicle->mimg->xsize); 
+				++v_voxel.x)
+		{
+			iftIdx v_index;
+			float dist;
+
+			v_index = iftMGetVoxelIndex(sicle->mimg, v_voxel);
+			dist = iftVoxelDistance(v_voxel, center);
+			if(iftSICLE_InROI(sicle, v_index) && dist < best_dist)
+			{ best_dist = dist; seeds->val[s_id] = v_index; }
+		}
+	}
+
+	return seeds;
+}
+
+/*
+ * Finds a root for a spel left unconquered, by taking the one of a conquered
+ * adjacent or, if none, of the nearest seed.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  v_index[in] - REQUIRED: Index of the unconquered spel
+ *
+ * RETURNS: Index of the root
+ */
+iftIdx iftSICLE_FindNearestRoot
+(iftSICLE *sicle, iftSICLE_IFTData *data, iftIdx v_index)
+{
+	float best_dist;
+	iftIdx root;
+	iftVoxel v_voxel;
+
+	v_voxel = iftMGetVoxelCoord(sicle->mimg, v_index);
+	for(int j = 1; j < data->A->n; ++j)
+	{
+		iftVoxel vj_voxel;
+
+		vj_voxel = iftGetAdjacentVoxel(data->A, v_voxel, j);
+		if(iftMValidVoxel(sicle->mimg, vj_voxel))
+		{
+			iftIdx vj_index;
+
+			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+			if(data->root_map[vj_index] != IFTSICLE_NIL) 
+			{ return data->root_map[vj_index]; }
+		}
+	}
+
+	root = data->seeds->val[0]; best_dist = IFT_INFINITY_FLT;
+	for(int s_id = 0; s_id < data->seeds->n; ++s_id)
+	{
+		float dist;
+		iftVoxel s_voxel;
+
+		s_voxel = iftMGetVoxelCoord(sicle->mimg, data->seeds->val[s_id]);
+		dist = iftVoxelDistance(v_voxel, s_voxel);
+		if(dist < best_dist) { best_dist = dist; root = data->seeds->val[s_id]; }
+	}
+
+	return root;
+}
+
+/*
+ * Computes the forest of the projected seeds in the original resolution. The
+ * spels whose block is far from the coarse boundaries keep the coarse label 
+ * and are conquered by a direct arc from their root, whereas the remaining
+ * ones (i.e., the boundary band, two coarse spels wide on each side) are 
+ * disputed by an IFT restricted to it.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  coarse[in] - REQUIRED: Downsampled SICLE auxiliary data
+ *  factor[in] - REQUIRED: Downsampling factor per (spatial) dimension
+ *  args[in] - REQUIRED: SICLE arguments
+ *  coarse_data[in] - REQUIRED: IFT data of the coarse forest
+ *  data[in/out] - REQUIRED: IFT data with the projected seeds
+ */
+void iftSICLE_RunBandIFT
+(iftSICLE *sicle, iftSICLE *coarse, int factor, iftSICLEArgs *args, 
+	iftSICLE_IFTData *coarse_data, iftSICLE_IFTData **data)
+{
+	int *coarse_label;
+	iftBMap *coarse_band;
+	iftAdjRel *B;
+	iftDHeap *heap;
+
+	coarse_label = calloc(coarse->mimg->n, sizeof(int));
+	assert(coarse_label != NULL);
+	coarse_band = iftCreateBMap(coarse->mimg->n);
+	// Two coarse spels away from a boundary, for not isolating thin regions
+	if(iftIs3DMImage(coarse->mimg) == true) { B = iftSpheric(2.0); }
+	else { B = iftCircular(2.0); }
+
+	// Out-of-core, every access is registered sequentially
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for if(coarse_data->pager == NULL)
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx c_index = 0; c_index < coarse->mimg->n; ++c_index)
+	{
+		if(coarse_data->pager != NULL) 
+		{ iftSICLE_TouchPager(coarse_data->pager, c_index); }
+		if(iftSICLE_InROI(coarse, c_index))
+		{ coarse_label[c_index] = iftSICLE_GetLabel(coarse_data, c_index); }
+		else { coarse_label[c_index] = IFT_NIL; }
+	}
+
+	for(iftIdx c_index = 0; c_index < coarse->mimg->n; ++c_index)
+	{
+		iftVoxel c_voxel;
+
+		if(coarse_label[c_index] == IFT_NIL) { continue; }
+
+		c_voxel = iftMGetVoxelCoord(coarse->mimg, c_index);
+		for(int j = 1; j < B->n; ++j)
+		{
+			iftVoxel cj_voxel;
+
+			cj_voxel = iftGetAdjacentVoxel(B, c_voxel, j);
+			if(iftMValidVoxel(coarse->mimg, cj_voxel))
+			{
+				iftIdx cj_index;
+
+				cj_index = iftMGetVoxelIndex(coarse->mimg, cj_voxel);
+				if(coarse_label[cj_index] != IFT_NIL &&
+					 coarse_label[cj_index] != coarse_label[c_index])
+				{ iftBMapSet1(coarse_band, c_index); break; }
+			}
+		}
+	}
+
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for if((*data)->pager == NULL)
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		iftIdx c_index;
+
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, v_index); }
+		(*data)->pred_map[v_index] = IFTSICLE_NIL;
+		(*data)->root_map[v_index] = IFTSICLE_NIL;
+		c_index = iftSICLE_GetCoarseIndex(sicle, coarse, factor, v_index);
+
+		if(!iftSICLE_InROI(sicle, v_index)) // Won't be conquered
+		{ (*data)->cost_map[v_index] = IFTSICLE_BKGCOST; }
+		else if(iftBMapValue(coarse_band, c_index) || 
+						coarse_label[c_index] == IFT_NIL)
+		{ (*data)->cost_map[v_index] = IFTSICLE_TMPCOST; } // To be disputed
+		else
+		{ 
+			iftIdx s_index;
+
+			s_index = (*data)->seeds->val[coarse_label[c_index]];
+			(*data)->root_map[v_index] = s_index; // Direct arc from its root
+			(*data)->pred_map[v_index] = s_index;
+		}
+	}
+
+	if((*data)->pager != NULL) // In the chunks' order
+	{ iftSICLE_TabulateSeeds(sicle, *data, (*data)->seeds, NULL, true); }
+	else
+	{
+		for(int s_id = 0; s_id < (*data)->seeds->n; ++s_id)
+		{
+			iftIdx s_index;
+
+			s_index = (*data)->seeds->val[s_id];
+			(*data)->root_map[s_index] = s_index;
+			(*data)->pred_map[s_index] = -(s_id + 1); // 2's complement
+			(*data)->cost_map[s_index] = 0;
+		}
+	}
+
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for if((*data)->pager == NULL)
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		iftIdx v_root;
+
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, v_index); }
+		v_root = (*data)->root_map[v_index];
+		if(v_root != IFTSICLE_NIL && v_root != v_index)
+		{ 
+			(*data)->cost_map[v_index] = iftSICLE_DirectArcCost(sicle, args, *data, 
+																													v_root, v_index);
+		}
+	}
+
+	heap = iftSICLE_CreateHeap(sicle, *data);
+
+	// Fixed spels at the band's frontier, and the seeds, dispute the band
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		bool at_frontier;
+		iftVoxel v_voxel;
+
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, v_index); }
+		if((*data)->root_map[v_index] == IFTSICLE_NIL) { continue; }
+
+		at_frontier = ((*data)->root_map[v_index] == v_index);
+		v_voxel = iftMGetVoxelCoord(sicle->mimg, v_index);
+		for(int j = 1; j < (*data)->A->n && !at_frontier; ++j)
+		{
+			iftVoxel vj_voxel;
+
+			vj_voxel = iftGetAdjacentVoxel((*data)->A, v_voxel, j);
+			if(iftMValidVoxel(sicle->mimg, vj_voxel))
+			{
+				iftIdx vj_index;
+
+				vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+				at_frontier = ((*data)->cost_map[vj_index] == IFTSICLE_TMPCOST);
+			}
+		}
+
+		if(at_frontier == true) { iftSICLE_PushHeap(*data, heap, v_index); }
+	}
+
+	while(!iftEmptyDHeap(heap))
+	{
+		iftIdx vi_index, vi_root;
+		iftVoxel vi_voxel;
+
+		vi_index = iftSICLE_PopHeap(*data, heap);
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, vi_index); }
+		vi_voxel = iftMGetVoxelCoord(sicle->mimg,vi_index);
+		vi_root = (*data)->root_map[vi_index]; 
+
+		for(int j = 1; j < (*data)->A->n; ++j)
+  	{
+  		iftVoxel vj_voxel;
+
+  		vj_voxel = iftGetAdjacentVoxel((*data)->A, vi_voxel, j);
+
+  		if(iftMValidVoxel(sicle->mimg, vj_voxel))
+  		{
+  			iftIdx vj_index, cj_index;
+
+  			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+  			cj_index = iftSICLE_GetCoarseIndex(sicle, coarse, factor, vj_index);
+  			if(heap->color[vj_index] != IFT_BLACK && // Out of the heap and
+  				 (iftBMapValue(coarse_band, cj_index) || // within the band?
+  				  coarse_label[cj_index] == IFT_NIL))
+  			{
+  				double pathcost;
+
+  				pathcost = iftSICLE_ConnFunction(sicle, args, *data, vi_index, vj_index);
+
+					if(pathcost < (*data)->cost_map[vj_index]) // Lesser path-cost?
+					{
+						if(heap->color[vj_index] == IFT_GRAY) // Already within the heap?
+						{ iftSICLE_RemoveHeapElem(*data, heap, vj_index); } // For update
+
+						(*data)->root_map[vj_index] = vi_root; // 
+						(*data)->pred_map[vj_index] = vi_index;// Mark as conquered
+						(*data)->cost_map[vj_index] = pathcost;//
+						iftSICLE_PushHeap(*data, heap, vj_index);
+					}
+  			}
+  		}
+  	}
+	}
+	iftSICLE_DestroyHeap(*data, &heap);
+
+	// Band spels unreachable within the band keep their coarse label
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for if((*data)->pager == NULL)
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		if((*data)->pager != NULL) { iftSICLE_TouchPager((*data)->pager, v_index); }
+		if(iftSICLE_InROI(sicle, v_index) && 
+			 (*data)->root_map[v_index] == IFTSICLE_NIL)
+		{
+			iftIdx c_index;
+			int label;
+
+			c_index = iftSICLE_GetCoarseIndex(sicle, coarse, factor, v_index);
+			label = coarse_label[c_index];
+			if(label != IFT_NIL)
+			{
+				(*data)->root_map[v_index] = (*data)->seeds->val[label];
+				(*data)->pred_map[v_index] = (*data)->seeds->val[label];
+			}
+		}
+	}
+
+	// Those whose coarse block is out of the ROI follow their surroundings. 
+	// Sequential, since each one may take the root of a previous one
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		if(iftSICLE_InROI(sicle, v_index) && 
+			 (*data)->root_map[v_index] == IFTSICLE_NIL)
+		{
+			iftIdx root;
+
+			root = iftSICLE_FindNearestRoot(sicle, *data, v_index);
+			(*data)->root_map[v_index] = root;
+			(*data)->pred_map[v_index] = root;
+		}
+	}
+
+	free(coarse_label);
+	iftDestroyBMap(&coarse_band);
+	iftDestroyAdjRel(&B);
+}
+
+/*
+ * Finds the representative of a connected component, compressing the path 
+ * to it (see iftSICLE_FindSet).
+ *
+ * PARAMETERS:
+ *  parent[in/out] - REQUIRED: Component merged with the respective one
+ *  comp[in] - REQUIRED: Component
+ *
+ * RETURNS: Representative component
+ */
+iftIdx iftSICLE_FindComp
+(iftIdx *parent, iftIdx comp)
+{
+	iftIdx rep;
+
+	rep = comp;
+	while(parent[rep] != rep) { rep = parent[rep]; }
+
+	while(parent[comp] != rep) // Path compression
+	{
+		iftIdx next;
+
+		next = parent[comp];
+		parent[comp] = rep;
+		comp = next;
+	}
+
+	return rep;
+}
+
+/*
+ * Enforces the connectivity of the superspels of a forest whose trees may be
+ * disconnected (i.e., the pyramid's, whose interiors are conquered by direct
+ * arcs). The connected components are computed in two raster passes, and 
+ * each one without its seed is absorbed by the adjacent superspel it touches
+ * the most. It is done in rounds, thus pieces adjacent only to other pieces 
+ * are absorbed once these are. Only pieces isolated by the ROI are kept.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data
+ */
+void iftSICLE_EnforceConn
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data)
+{
+	bool changed;
+	long num_adj, *adj_count;
+	iftIdx num_comps, max_comps, num_arcs, max_arcs;
+	iftIdx *comp, *comp_parent, *target, *arcs, *first_arc, *adj_root;
+
+	if(data->pager != NULL) // Chunked, as the forest
+	{ 
+		iftSICLE_ClearMMap(data->pager->comp_mmap); 
+		comp = data->pager->comp_mmap->addr; 
+	}
+	else 
+	{ 
+		comp = malloc(sicle->mimg->n * sizeof(iftIdx)); 
+		assert(comp != NULL);
+	}
+
+	num_comps = 0; max_comps = iftMax(1, data->seeds->n);
+	comp_parent = malloc(max_comps * sizeof(iftIdx));
+	assert(comp_parent != NULL);
+
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index) // Provisional
+	{
+		iftIdx v_root, c;
+		iftVoxel v_voxel;
+
+		if(data->pager != NULL) { iftSICLE_TouchPager(data->pager, v_index); }
+		v_root = data->root_map[v_index];
+		if(v_root == IFTSICLE_NIL) { comp[v_index] = IFT_NIL; continue; }
+
+		c = IFT_NIL;
+		v_voxel = iftMGetVoxelCoord(sicle->mimg, v_index);
+		for(int j = 1; j < data->A->n; ++j)
+		{
+			iftIdx vj_index, cj;
+			iftVoxel vj_voxel;
+
+			vj_voxel = iftGetAdjacentVoxel(data->A, v_voxel, j);
+			if(!iftMValidVoxel(sicle->mimg, vj_voxel)) { continue; }
+			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+			if(vj_index > v_index || data->root_map[vj_index] != v_root) 
+			{ continue; } // Not yet visited, or of another superspel
+
+			cj = iftSICLE_FindComp(comp_parent, comp[vj_index]);
+			if(c == IFT_NIL) { c = cj; }
+			else if(cj != c) // Keep the lowest representative
+			{
+				if(cj < c) { comp_parent[c] = cj; c = cj; }
+				else { comp_parent[cj] = c; }
+			}
+		}
+
+		if(c == IFT_NIL)
+		{
+			if(num_comps == max_comps)
+			{
+				max_comps *= 2;
+				comp_parent = realloc(comp_parent, max_comps * sizeof(iftIdx));
+				assert(comp_parent != NULL);
+			}
+			c = num_comps++;
+			comp_parent[c] = c;
+		}
+		comp[v_index] = c;
+	}
+
+	// Components holding their seed are kept, and the others are to be 
+	// absorbed (i.e., with no target yet)
+	target = malloc(iftMax(1, num_comps) * sizeof(iftIdx));
+	assert(target != NULL);
+	for(iftIdx c = 0; c < num_comps; ++c) { target[c] = IFT_NIL; }
+	for(long s_id = 0; s_id < data->seeds->n; ++s_id)
+	{
+		iftIdx s_index;
+
+		s_index = data->seeds->val[s_id];
+		if(data->pager != NULL) { iftSICLE_TouchPager(data->pager, s_index); }
+		target[iftSICLE_FindComp(comp_parent, comp[s_index])] = s_index;
+	}
+
+	num_arcs = 0; max_arcs = 1024;
+	arcs = malloc(2 * max_arcs * sizeof(iftIdx));
+	assert(arcs != NULL);
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index) // Final
+	{
+		iftIdx c;
+		iftVoxel v_voxel;
+
+		if(data->pager != NULL) { iftSICLE_TouchPager(data->pager, v_index); }
+		if(comp[v_index] == IFT_NIL) { continue; }
+
+		c = iftSICLE_FindComp(comp_parent, comp[v_index]);
+		comp[v_index] = c;
+		if(target[c] != IFT_NIL) { continue; }
+
+		v_voxel = iftMGetVoxelCoord(sicle->mimg, v_index);
+		for(int j = 1; j < data->A->n; ++j) // Arcs leaving the piece
+		{
+			iftIdx vj_index, cj;
+			iftVoxel vj_voxel;
+
+			vj_voxel = iftGetAdjacentVoxel(data->A, v_voxel, j);
+			if(!iftMValidVoxel(sicle->mimg, vj_voxel)) { continue; }
+			vj_index = iftMGetVoxelIndex(sicle->mimg, vj_voxel);
+			if(comp[vj_index] == IFT_NIL) { continue; }
+
+			cj = iftSICLE_FindComp(comp_parent, comp[vj_index]);
+			if(cj == c) { continue; }
+
+			if(num_arcs == max_arcs)
+			{
+				max_arcs *= 2;
+				arcs = realloc(arcs, 2 * max_arcs * sizeof(iftIdx));
+				assert(arcs != NULL);
+			}
+			arcs[2*num_arcs] = c; arcs[2*num_arcs + 1] = cj;
+			num_arcs++;
+		}
+	}
+	qsort(arcs, num_arcs, 2 * sizeof(iftIdx), iftSICLE_CmpIdxPair);
+
+	first_arc = malloc((iftMax(1, num_comps) + 1) * sizeof(iftIdx));
+	assert(first_arc != NULL);
+	for(iftIdx c = 0, a = 0; c <= num_comps; ++c) // Arcs of each piece
+	{
+		while(a < num_arcs && arcs[2*a] < c) { a++; }
+		first_arc[c] = a;
+	}
+	adj_root = malloc(iftMax(1, num_arcs) * sizeof(iftIdx));
+	adj_count = malloc(iftMax(1, num_arcs) * sizeof(long));
+	assert(adj_root != NULL && adj_count != NULL);
+
+	do // Only the targets set in the previous rounds are considered
+	{
+		iftIdx *new_target;
+
+		changed = false;
+		new_target = malloc(iftMax(1, num_comps) * sizeof(iftIdx));
+		assert(new_target != NULL);
+		memcpy(new_target, target, num_comps * sizeof(iftIdx));
+
+		for(iftIdx c = 0; c < num_comps; ++c)
+		{
+			iftIdx best_root;
+			long best_count;
+
+			if(comp_parent[c] != c || target[c] != IFT_NIL) { continue; }
+
+			num_adj = 0; // Arcs to each adjacent superspel, over all of its pieces
+			for(iftIdx a = first_arc[c]; a < first_arc[c + 1]; ++a)
+			{
+				iftIdx root;
+				long k;
+
+				root = target[arcs[2*a + 1]];
+				if(root == IFT_NIL) { continue; }
+
+				k = 0;
+				while(k < num_adj && adj_root[k] != root) { k++; }
+				if(k == num_adj) { adj_root[k] = root; adj_count[k] = 0; num_adj++; }
+				adj_count[k]++;
+			}
+
+			best_root = IFT_NIL; best_count = 0;
+			for(long k = 0; k < num_adj; ++k)
+			{
+				if(adj_count[k] > best_count || 
+					 (adj_count[k] == best_count && adj_root[k] < best_root))
+				{ best_count = adj_count[k]; best_root = adj_root[k]; }
+			}
+
+			if(best_root != IFT_NIL) { new_target[c] = best_root; changed = true; }
+		}
+
+		free(target);
+		target = new_target;
+	} while(changed == true);
+
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index) // Absorption
+	{
+		iftIdx root;
+
+		if(data->pager != NULL) { iftSICLE_TouchPager(data->pager, v_index); }
+		if(comp[v_index] == IFT_NIL) { continue; }
+
+		root = target[comp[v_index]];
+		if(root != IFT_NIL && root != data->root_map[v_index])
+		{
+			data->root_map[v_index] = root; // Direct arc from its new root
+			data->pred_map[v_index] = root;
+			data->cost_map[v_index] = iftSICLE_DirectArcCost(sicle, args, data, 
+																												root, v_index);
+		}
+	}
+
+	if(data->pager == NULL) { free(comp); }
+	free(comp_parent); free(target); free(arcs); free(first_arc); 
+	free(adj_root); free(adj_count);
+}
+
+/*
+ * Runs the seed removal cascade on a downsampled copy of the image, and then
+ * projects the surviving seeds to the original resolution for computing the
+ * final forest only at the boundary bands.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  seed[in] - REQUIRED: Seed of the random generator for the coarse seeds, or
+ *                       -1 for its current state
+ *
+ * RETURNS: IFT data of the forest with Nf seeds
+ */
+iftSICLE_IFTData *iftSICLE_RunPyramid
+(iftSICLE *sicle, iftSICLEArgs *args, int seed)
+{
+	int factor;
+	iftSICLE *coarse;
+	iftSICLEArgs coarse_args;
+	iftSICLE_IFTData *coarse_data, *data;
+
+	factor = 1 << args->pyr_levels;
+	coarse = iftSICLE_CreateCoarseSICLE(sicle, factor);
+
+	coarse_args = (*args); // Shallow copy
+	coarse_args.pyr_levels = 0;
+	if(seed < 0) { coarse_data = iftSICLE_RunCascade(coarse, &coarse_args); }
+	else
+	{
+		coarse_data = iftSICLE_CreateSeededIFTData(coarse, &coarse_args, seed);
+		iftSICLE_RunSchedule(coarse, &coarse_args, &coarse_data, NULL);
+	}
+
+	data = iftSICLE_AllocIFTData(sicle, args, NULL);
+	data->seeds = iftSICLE_ProjectSeeds(sicle, coarse, factor, coarse_data->seeds);
+	iftSICLE_RunBandIFT(sicle, coarse, factor, args, coarse_data, &data);
+	iftSICLE_EnforceConn(sicle, args, data);
+	data->num_iters = coarse_data->num_iters;
+
+	iftSICLE_DestroyIFTData(&coarse_data);
+	iftDestroySICLE(&coarse);
+
+	return data;
+}
+
+//============================================================================|
+// Tiled
+//============================================================================|
+/*
+ * Parses the header of a binary PNM (P5 or P6) file, verifying whether the 
+ * file holds all of its samples. Unlike iftSICLE_ReadPNMHeader, it does not
+ * abort on a corrupt file.
+ *
+ * PARAMETERS:
+ *  path[in] - REQUIRED: Image path
+ *  pnm[out] - REQUIRED: PNM file header, whose path is set only if valid
+ *  msg[out] - REQUIRED: Error message, if any (IFT_STR_DEFAULT_SIZE chars)
+ *
+ * RETURNS: Whether the header is valid
+ */
+bool iftSICLE_ParsePNMHeader
+(const char *path, iftSICLE_PNM *pnm, char *msg)
+{
+	char type[10];
+	int c;
+	off_t num_bytes;
+	FILE *fp;
+
+	fp = fopen(path, "rb");
+	if(fp == NULL) 
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, MSG_FILE_OPEN_ERROR, path);
+		return false;
+	}
+
+	if(fscanf(fp, "%9s\n", type) != 1) { type[0] = '\0'; }
+	if(iftCompareStrings(type, "P5")) { pnm->is_color = false; }
+	else if(iftCompareStrings(type, "P6")) { pnm->is_color = true; }
+	else
+	{
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Only binary PGM (P5) or PPM (P6) "
+						 "files are supported");
+		fclose(fp);
+		return false;
+	}
+
+	iftSkipComments(fp);
+	if(fscanf(fp, "%d %d\n", &(pnm->xsize), &(pnm->ysize)) != 2 ||
+		 fscanf(fp, "%d", &(pnm->max_val)) != 1)
+	{
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Reading error of %s", path);
+		fclose(fp);
+		return false;
+	}
+	do { c = fgetc(fp); } while(c != '\n' && c != EOF);
+
+	if(pnm->xsize <= 0 || pnm->ysize <= 0 || 
+		 (off_t)pnm->xsize * pnm->ysize > IFT_INFINITY_INT)
+	{
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Invalid dimensions %dx%d of %s", 
+						 pnm->xsize, pnm->ysize, path);
+		fclose(fp);
+		return false;
+	}
+	if(pnm->max_val <= 0 || pnm->max_val > 65535)
+	{
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Invalid maximum value of %s", path);
+		fclose(fp);
+		return false;
+	}
+	pnm->val_bytes = (pnm->max_val < 256) ? 1 : 2;
+	pnm->offset = ftell(fp);
+
+	num_bytes = (off_t)pnm->xsize * pnm->ysize * (pnm->is_color ? 3 : 1) * 
+							pnm->val_bytes;
+	if(c == EOF || fseeko(fp, 0, SEEK_END) != 0 || 
+		 ftello(fp) < pnm->offset + num_bytes)
+	{
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Truncated image file %s", path);
+		fclose(fp);
+		return false;
+	}
+	pnm->path = iftCopyString(path);
+
+	fclose(fp);
+	return true;
+}
+
+/*
+ * Reads the header of a binary PNM (P5 or P6) file, for later reading its 
+ * samples region by region.
+ *
+ * PARAMETERS:
+ *  path[in] - REQUIRED: Image path
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_PNM *iftSICLE_ReadPNMHeader
+(const char *path)
+{
+	char msg[IFT_STR_DEFAULT_SIZE];
+	iftSICLE_PNM *pnm;
+
+	pnm = malloc(sizeof(iftSICLE_PNM));
+	assert(pnm != NULL);
+
+	if(iftSICLE_ParsePNMHeader(path, pnm, msg) == false) 
+	{ iftError("%s", __func__, msg); }
+
+	return pnm;
+}
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		pnm[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyPNM
+(iftSICLE_PNM **pnm)
+{
+	free((*pnm)->path);
+	free(*pnm);
+	(*pnm) = NULL;
+}
+
+/*
+ * Reads a rectangular region of a PNM file, seeking each of its rows, and 
+ * converts it as iftReadImageByExt does. The file is opened by each call, 
+ * permitting concurrent reads.
+ *
+ * PARAMETERS:
+ *  pnm[in] - REQUIRED: PNM file header
+ *  x0, y0[in] - REQUIRED: Top-left pixel of the region
+ *  xsize, ysize[in] - REQUIRED: Region dimensions
+ *
+ * RETURNS: Image of the region
+ */
+iftImage *iftSICLE_ReadPNMRegion
+(iftSICLE_PNM *pnm, int x0, int y0, int xsize, int ysize)
+{
+	int num_chans, rgb_depth, ycbcr_depth;
+	size_t row_bytes;
+	unsigned char *row;
+	FILE *fp;
+	iftImage *img;
+
+	fp = fopen(pnm->path, "rb");
+	if(fp == NULL) { iftError(MSG_FILE_OPEN_ERROR, __func__, pnm->path); }
+
+	img = iftCreateImage(xsize, ysize, 1);
+	img->dz = 0.0;
+	num_chans = 1;
+	if(pnm->is_color == true)
+	{
+		img->Cb = iftAllocUShortArray(img->n);
+		img->Cr = iftAllocUShortArray(img->n);
+		num_chans = 3;
+	}
+
+	rgb_depth = ceil(iftLog(pnm->max_val, 2)); // As in iftReadImageP6
+	if(rgb_depth < 10) { ycbcr_depth = 10; }
+	else if(rgb_depth < 12) { ycbcr_depth = 12; }
+	else { ycbcr_depth = 16; }
+
+	row_bytes = (size_t)xsize * num_chans * pnm->val_bytes;
+	row = malloc(row_bytes);
+	assert(row != NULL);
+
+	for(int y = 0; y < ysize; ++y)
+	{
+		off_t pos;
+
+		pos = pnm->offset + ((off_t)(y0 + y) * pnm->xsize + x0) * num_chans * 
+					pnm->val_bytes;
+		if(fseeko(fp, pos, SEEK_SET) != 0 || fread(row, 1, row_bytes, fp) != row_bytes)
+		{ iftError("Reading error", __func__); }
+
+		for(int x = 0; x < xsize; ++x)
+		{
+			int vals[3];
+			iftIdx p_index;
+
+			for(int c = 0; c < num_chans; ++c)
+			{
+				size_t i;
+
+				i = ((size_t)x * num_chans + c) * pnm->val_bytes;
+				if(pnm->val_bytes == 1) { vals[c] = row[i]; }
+				else { vals[c] = (row[i] << 8) + row[i + 1]; } // Big-endian
+			}
+
+			p_index = (iftIdx)y * xsize + x;
+			if(pnm->is_color == false) { img->val[p_index] = vals[0]; }
+			else
+			{
+				iftColor RGB, YCbCr;
+
+				RGB.val[0] = vals[0]; RGB.val[1] = vals[1]; RGB.val[2] = vals[2];
+				if(pnm->val_bytes == 1) { YCbCr = iftRGBtoYCbCr(RGB, 255); }
+				else { YCbCr = iftRGBtoYCbCrBT2020(RGB, rgb_depth, ycbcr_depth); }
+
+				img->val[p_index] = YCbCr.val[0];
+				img->Cb[p_index] = (ushort)YCbCr.val[1];
+				img->Cr[p_index] = (ushort)YCbCr.val[2];
+			}
+		}
+	}
+
+	free(row);
+	fclose(fp);
+	return img;
+}
+
+/*
+ * Verifies whether an image file may be read by iftReadSICLE without aborting
+ * on a corrupt binary PNM file (e.g., for not stopping a batch or the 
+ * daemon). Other formats are read by iftReadImageByExt, thus they are trusted
+ * once their file exists.
+ *
+ * PARAMETERS:
+ *  path[in] - REQUIRED: Image path
+ *  msg[out] - REQUIRED: Error message, if any (IFT_STR_DEFAULT_SIZE chars)
+ *
+ * RETURNS: Whether the image may be read
+ */
+bool iftSICLE_CanReadImage
+(const char *path, char *msg)
+{
+	char magic[2];
+	FILE *fp;
+	iftSICLE_PNM pnm;
+
+	if(iftFileExists(path) == false || iftIsImageFile(path) == false)
+	{
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Unknown image file %s", path);
+		return false;
+	}
+
+	fp = fopen(path, "rb");
+	if(fp == NULL) 
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, MSG_FILE_OPEN_ERROR, path);
+		return false;
+	}
+	if(fread(magic, 1, 2, fp) != 2) { magic[0] = '\0'; }
+	fclose(fp);
+
+	if(magic[0] != 'P' || (magic[1] != '5' && magic[1] != '6')) { return true; }
+
+	if(iftSICLE_ParsePNMHeader(path, &pnm, msg) == false) { return false; }
+	free(pnm.path);
+
+	return true;
+}
+
+/*
+ * Finds the representative of an element within a disjoint-set forest (e.g.,
+ * of the superspels merged across the seams), compressing the path to it.
+ *
+ * PARAMETERS:
+ *  parent[in/out] - REQUIRED: Element merged with the respective one
+ *  id[in] - REQUIRED: Element
+ *
+ * RETURNS: Representative element
+ */
+int iftSICLE_FindSet
+(int *parent, int id)
+{
+	int root;
+
+	root = id;
+	while(parent[root] != root) { root = parent[root]; }
+
+	while(parent[id] != root) // Path compression
+	{
+		int next;
+
+		next = parent[id];
+		parent[id] = root;
+		id = next;
+	}
+
+	return root;
+}
+
+/*
+ * Merges the superspels of two identifiers, keeping the lowest representative
+ *
+ * PARAMETERS:
+ *  parent[in/out] - REQUIRED: Identifier merged with the respective one
+ *  a, b[in] - REQUIRED: Superspel identifiers
+ */
+void iftSICLE_UnionSet
+(int *parent, int a, int b)
+{
+	int ra, rb;
+
+	ra = iftSICLE_FindSet(parent, a);
+	rb = iftSICLE_FindSet(parent, b);
+	if(ra < rb) { parent[rb] = ra; }
+	else if(rb < ra) { parent[ra] = rb; }
+}
+
+/*
+ * Comparison function for sorting arrays of long integers with qsort
+ *
+ * PARAMETERS:
+ *  a, b[in] - REQUIRED: Pointers to the elements being compared
+ *
+ * RETURNS: Negative, zero or positive if a is lesser, equal or greater than b
+ */
+int iftSICLE_CmpLong
+(const void *a, const void *b)
+{
+	return (*(const long*)a > *(const long*)b) - (*(const long*)a < *(const long*)b);
+}
+
+/*
+ * Counts the occurrences of a value within a sorted array by binary search.
+ *
+ * PARAMETERS:
+ *  arr[in] - REQUIRED: Sorted array
+ *  n[in] - REQUIRED: Array length
+ *  val[in] - REQUIRED: Value to be counted
+ *
+ * RETURNS: Number of occurrences
+ */
+long iftSICLE_CountSorted
+(const long *arr, long n, long val)
+{
+	long lo, hi, first;
+
+	lo = 0; hi = n; // Lower bound
+	while(lo < hi) 
+	{ 
+		long mid = lo + (hi - lo)/2; 
+		if(arr[mid] < val) { lo = mid + 1; } else { hi = mid; } 
+	}
+	first = lo;
+
+	hi = n; // Upper bound
+	while(lo < hi) 
+	{ 
+		long mid = lo + (hi - lo)/2; 
+		if(arr[mid] <= val) { lo = mid + 1; } else { hi = mid; } 
+	}
+
+	return lo - first;
+}
+
+/*
+ * Merges the superspels of a tile with the ones of its (previously stitched)
+ * neighbors, given the overlap band in which both were computed. A pair is 
+ * merged when their intersection over union, within the band, is over 0.5. 
+ * Therefore, each superspel is merged with at most one other per band.
+ *
+ * PARAMETERS:
+ *  ids[in] - REQUIRED: Identifier map of the image, filled within the band
+ *  xsize[in] - REQUIRED: Image width
+ *  band[in] - REQUIRED: Identifiers computed by the tile within the band
+ *  bx0, by0[in] - REQUIRED: Top-left pixel of the band
+ *  bxsize, bysize[in] - REQUIRED: Band dimensions
+ *  parent[in/out] - REQUIRED: Identifier merged with the respective one
+ */
+void iftSICLE_StitchBand
+(const int *ids, int xsize, const int *band, int bx0, int by0, int bxsize, 
+ int bysize, int *parent)
+{
+	long n;
+	long *pairs, *as, *bs;
+
+	n = (long)bxsize * bysize;
+	if(n == 0) { return; }
+
+	pairs = malloc(n * sizeof(long));
+	as = malloc(n * sizeof(long));
+	bs = malloc(n * sizeof(long));
+	assert(pairs != NULL && as != NULL && bs != NULL);
+
+	for(int y = 0; y < bysize; ++y)
+	{
+		for(int x = 0; x < bxsize; ++x)
+		{
+			long i;
+
+			i = (long)y * bxsize + x;
+			as[i] = band[i];
+			bs[i] = ids[(long)(by0 + y) * xsize + bx0 + x];
+			pairs[i] = (as[i] << 32) | bs[i];
+		}
+	}
+	qsort(pairs, n, sizeof(long), iftSICLE_CmpLong);
+	qsort(as, n, sizeof(long), iftSICLE_CmpLong);
+	qsort(bs, n, sizeof(long), iftSICLE_CmpLong);
+
+	for(long i = 0, j; i < n; i = j)
+	{
+		int a, b;
+		long num_ab, num_a, num_b;
+
+		for(j = i; j < n && pairs[j] == pairs[i]; ++j);
+
+		a = pairs[i] >> 32; b = pairs[i] & 0xFFFFFFFFL;
+		num_ab = j - i;
+		num_a = iftSICLE_CountSorted(as, n, a);
+		num_b = iftSICLE_CountSorted(bs, n, b);
+
+		if(3 * num_ab > num_a + num_b) // IoU > 0.5
+		{ iftSICLE_UnionSet(parent, a, b); }
+	}
+
+	free(pairs); free(as); free(bs);
+}
+
+/*
+ * Segments a tile (with its overlap) using a budget of seeds proportional to
+ * its area, and writes the identifiers of its core region, local to the tile
+ * (i.e., within [0,num_labels[). The identifiers within its left and top 
+ * overlap bands are kept for stitching it with the neighbors computed before.
+ * The seeds are drawn from the tile's own random sequence, so the result does
+ * not depend on the order the tiles are run.
+ *
+ * PARAMETERS:
+ *  pnm[in] - REQUIRED: PNM file header
+ *  args[in] - REQUIRED: SICLE arguments for the whole image
+ *  tile[in/out] - REQUIRED: Tile whose regions are set
+ *  ids[out] - REQUIRED: Identifier map of the image
+ */
+void iftSICLE_RunTile
+(iftSICLE_PNM *pnm, iftSICLEArgs *args, iftSICLE_Tile *tile, int *ids)
+{
+	int band_xsize, band_ysize;
+	double ratio;
+	iftSICLEArgs tile_args;
+	iftSICLE *sicle;
+	iftSICLE_IFTData *data;
+	iftImage *img, *segm;
+
+	img = iftSICLE_ReadPNMRegion(pnm, tile->x0, tile->y0, tile->xsize, 
+															 tile->ysize);
+	sicle = iftCreateSICLE(img, NULL, NULL);
+	iftDestroyImage(&img);
+
+	ratio = (double)tile->xsize * tile->ysize / ((double)pnm->xsize * pnm->ysize);
+	tile_args = (*args); // Shallow copy
+	tile_args.user_ni = NULL; // Absolute quantities do not fit the tile
+	tile_args.ooc_path = NULL;
+	tile_args.time_budget = 0; tile_args.cancel = NULL; // Every tile completes
+	tile_args.nf = iftMax(2, iftRound(args->nf * ratio));
+	tile_args.n0 = iftMax(tile_args.nf + 1, iftRound(args->n0 * ratio));
+	tile_args.n0 = iftMin(tile_args.n0, sicle->mimg->n - 1);
+	tile_args.nf = iftMin(tile_args.nf, tile_args.n0 - 1);
+	iftVerifySICLEArgs(sicle, &tile_args);
+
+	if(tile_args.pyr_levels > 0) 
+	{ data = iftSICLE_RunPyramid(sicle, &tile_args, tile->id + 1); }
+	else
+	{
+		data = iftSICLE_CreateSeededIFTData(sicle, &tile_args, tile->id + 1);
+		iftSICLE_RunSchedule(sicle, &tile_args, &data, NULL);
+	}
+	segm = iftSICLE_CreateLabelImage(sicle, data);
+	iftSICLE_DestroyIFTData(&data);
+	iftDestroySICLE(&sicle);
+	tile->num_labels = iftMaximumValue(segm);
+
+	for(int y = tile->cy0; y < tile->cy0 + tile->cysize; ++y)
+	{
+		for(int x = tile->cx0; x < tile->cx0 + tile->cxsize; ++x)
+		{
+			iftIdx p_index;
+
+			p_index = (iftIdx)(y - tile->y0) * tile->xsize + (x - tile->x0);
+			ids[(long)y * pnm->xsize + x] = segm->val[p_index] - 1;
+		}
+	}
+
+	band_xsize = tile->cx0 - tile->x0; // Left band, along the core rows
+	tile->left = malloc(((long)band_xsize * tile->cysize + 1) * sizeof(int));
+	assert(tile->left != NULL);
+	for(int y = 0; y < tile->cysize; ++y)
+	{
+		for(int x = 0; x < band_xsize; ++x)
+		{
+			iftIdx p_index;
+
+			p_index = (iftIdx)(tile->cy0 - tile->y0 + y) * tile->xsize + x;
+			tile->left[y * band_xsize + x] = segm->val[p_index] - 1;
+		}
+	}
+
+	band_ysize = tile->cy0 - tile->y0; // Top band, along the whole width
+	tile->top = malloc(((long)tile->xsize * band_ysize + 1) * sizeof(int));
+	assert(tile->top != NULL);
+	for(int y = 0; y < band_ysize; ++y)
+	{
+		for(int x = 0; x < tile->xsize; ++x)
+		{ 
+			iftIdx p_index;
+
+			p_index = (iftIdx)y * tile->xsize + x;
+			tile->top[p_index] = segm->val[p_index] - 1; 
+		}
+	}
+
+	iftDestroyImage(&segm);
+}
+
+/*
+ * Offsets the local identifiers of a tile by the first identifier assigned to
+ * it, within its core region and its overlap bands.
+ *
+ * PARAMETERS:
+ *  tile[in/out] - REQUIRED: Tile computed by iftSICLE_RunTile
+ *  first_id[in] - REQUIRED: First identifier of the tile
+ *  xsize[in] - REQUIRED: Width of the image
+ *  ids[in/out] - REQUIRED: Identifier map of the image
+ */
+void iftSICLE_OffsetTileIds
+(iftSICLE_Tile *tile, int first_id, int xsize, int *ids)
+{
+	long num_left, num_top;
+
+	for(int y = tile->cy0; y < tile->cy0 + tile->cysize; ++y)
+	{
+		for(int x = tile->cx0; x < tile->cx0 + tile->cxsize; ++x)
+		{ ids[(long)y * xsize + x] += first_id; }
+	}
+
+	num_left = (long)(tile->cx0 - tile->x0) * tile->cysize;
+	for(long i = 0; i < num_left; ++i) { tile->left[i] += first_id; }
+	num_top = (long)tile->xsize * (tile->cy0 - tile->y0);
+	for(long i = 0; i < num_top; ++i) { tile->top[i] += first_id; }
+}
+
+/*
+ * Enforces the connectivity of the stitched superspels. Their connected 
+ * components are computed in two raster passes, and the ones which are not
+ * the largest of their superspel (i.e., pieces cut at the seams) are 
+ * absorbed by the first adjacent largest component found. It is done in 
+ * rounds (i.e., raster passes), thus pieces adjacent only to other pieces 
+ * are absorbed once these are. Then, the identifier map is overwritten by 
+ * the representative identifiers of the resulting superspels.
+ *
+ * PARAMETERS:
+ *  pnm[in] - REQUIRED: PNM file header
+ *  ids_mmap[in/out] - REQUIRED: Mapped identifier map of the image
+ *  parent[in/out] - REQUIRED: Identifier merged with the respective one
+ *  num_ids[in] - REQUIRED: Quantity of identifiers
+ *  use_diag[in] - REQUIRED: Whether diagonal pixels are adjacent
+ *  rows[in] - REQUIRED: Number of rows between evictions of the mapping
+ */
+void iftSICLE_EnforceTiledConn
+(iftSICLE_PNM *pnm, iftSICLE_MMap *ids_mmap, int *parent, int num_ids, 
+ bool use_diag, int rows)
+{
+	const int DX[4] = {-1, -1, 0, 1}, DY[4] = {0, -1, -1, -1};
+	bool changed;
+	int num_comps, max_comps;
+	int *ids, *comp_parent, *comp_id, *best_comp, *adopt, *new_adopt;
+	long *size;
+
+	ids = ids_mmap->addr;
+
+	num_comps = 0; max_comps = iftMax(1, num_ids);
+	comp_parent = malloc(max_comps * sizeof(int));
+	comp_id = malloc(max_comps * sizeof(int));
+	assert(comp_parent != NULL && comp_id != NULL);
+
+	for(int y = 0; y < pnm->ysize; ++y) // Provisional components
+	{
+		for(int x = 0; x < pnm->xsize; ++x)
+		{
+			int id, comp;
+			long p;
+
+			p = (long)y * pnm->xsize + x;
+			id = iftSICLE_FindSet(parent, ids[p]);
+			comp = -1;
+
+			for(int k = 0; k < 4; ++k)
+			{
+				int qx, qy, q_comp;
+
+				if(use_diag == false && (k == 1 || k == 3)) { continue; }
+				qx = x + DX[k]; qy = y + DY[k];
+				if(qx < 0 || qy < 0 || qx >= pnm->xsize) { continue; }
+
+				q_comp = iftSICLE_FindSet(comp_parent, ids[(long)qy*pnm->xsize + qx]);
+				if(comp_id[q_comp] != id) { continue; }
+
+				if(comp < 0) { comp = q_comp; }
+				else if(q_comp != comp) // Keep the lowest representative
+				{
+					if(q_comp < comp) { comp_parent[comp] = q_comp; comp = q_comp; }
+					else { comp_parent[q_comp] = comp; }
+				}
+			}
+
+			if(comp < 0)
+			{
+				if(num_comps == max_comps)
+				{
+					max_comps *= 2;
+					comp_parent = realloc(comp_parent, max_comps * sizeof(int));
+					comp_id = realloc(comp_id, max_comps * sizeof(int));
+					assert(comp_parent != NULL && comp_id != NULL);
+				}
+				comp = num_comps++;
+				comp_parent[comp] = comp; comp_id[comp] = id;
+			}
+			ids[p] = comp;
+		}
+		if((y + 1) % rows == 0 && y + 1 > rows) // Keeps the previous row
+		{ iftSICLE_EvictMMap(ids_mmap, (long)(y - rows) * pnm->xsize, 
+												 (long)rows * pnm->xsize); }
+	}
+
+	size = calloc(num_comps, sizeof(long));
+	best_comp = malloc(iftMax(1, num_ids) * sizeof(int));
+	adopt = malloc(iftMax(1, num_comps) * sizeof(int));
+	new_adopt = malloc(iftMax(1, num_comps) * sizeof(int));
+	assert(size != NULL && best_comp != NULL);
+	assert(adopt != NULL && new_adopt != NULL);
+
+	for(int y = 0; y < pnm->ysize; ++y) // Final components and their sizes
+	{
+		for(int x = 0; x < pnm->xsize; ++x)
+		{
+			long p;
+
+			p = (long)y * pnm->xsize + x;
+			ids[p] = iftSICLE_FindSet(comp_parent, ids[p]);
+			size[ids[p]]++;
+		}
+		if((y + 1) % rows == 0)
+		{ iftSICLE_EvictMMap(ids_mmap, (long)(y + 1 - rows) * pnm->xsize, 
+												 (long)rows * pnm->xsize); }
+	}
+
+	for(int id = 0; id < num_ids; ++id) { best_comp[id] = -1; }
+	for(int c = 0; c < num_comps; ++c) // Largest component of each superspel
+	{
+		if(comp_parent[c] != c) { continue; }
+		if(best_comp[comp_id[c]] < 0 || size[c] > size[best_comp[comp_id[c]]])
+		{ best_comp[comp_id[c]] = c; }
+	}
+	for(int c = 0; c < num_comps; ++c) // Pieces to be absorbed are marked
+	{
+		adopt[c] = (best_comp[comp_id[c]] == c) ? c : -2;
+	}
+
+	do // Only the components absorbed in the previous rounds are considered
+	{
+		int *tmp;
+
+		changed = false;
+		memcpy(new_adopt, adopt, num_comps * sizeof(int));
+		for(int y = 0; y < pnm->ysize; ++y) // First adjacent component kept
+		{
+			for(int x = 0; x < pnm->xsize; ++x)
+			{
+				int comp;
+
+				comp = ids[(long)y * pnm->xsize + x];
+				for(int k = 0; k < 4; ++k)
+				{
+					int qx, qy, q_comp;
+
+					if(use_diag == false && (k == 1 || k == 3)) { continue; }
+					qx = x + DX[k]; qy = y + DY[k];
+					if(qx < 0 || qy < 0 || qx >= pnm->xsize) { continue; }
+
+					q_comp = ids[(long)qy * pnm->xsize + qx];
+					if(new_adopt[comp] == -2 && adopt[q_comp] >= 0)
+					{ new_adopt[comp] = adopt[q_comp]; changed = true; }
+					else if(new_adopt[q_comp] == -2 && adopt[comp] >= 0)
+					{ new_adopt[q_comp] = adopt[comp]; changed = true; }
+				}
+			}
+			if((y + 1) % rows == 0 && y + 1 > rows)
+			{ iftSICLE_EvictMMap(ids_mmap, (long)(y - rows) * pnm->xsize, 
+													 (long)rows * pnm->xsize); }
+		}
+
+		tmp = adopt; adopt = new_adopt; new_adopt = tmp;
+	} while(changed == true);
+
+	for(int y = 0; y < pnm->ysize; ++y) // Identifiers of the superspels
+	{
+		for(int x = 0; x < pnm->xsize; ++x)
+		{
+			int comp;
+			long p;
+
+			p = (long)y * pnm->xsize + x;
+			comp = ids[p];
+			if(adopt[comp] >= 0) { comp = adopt[comp]; } // Else, isolated
+			ids[p] = comp_id[comp];
+		}
+		if((y + 1) % rows == 0)
+		{ iftSICLE_EvictMMap(ids_mmap, (long)(y + 1 - rows) * pnm->xsize, 
+												 (long)rows * pnm->xsize); }
+	}
+
+	free(comp_parent); free(comp_id); free(size); free(best_comp); 
+	free(adopt); free(new_adopt);
+}
+
+/*
+ * Writes the label image of the stitched tiles row by row, relabeling the 
+ * merged identifiers to [1,N] in raster order of first occurrence.
+ *
+ * PARAMETERS:
+ *  pnm[in] - REQUIRED: PNM file header
+ *  ids_mmap[in] - REQUIRED: Mapped identifier map of the image
+ *  parent[in/out] - REQUIRED: Identifier merged with the respective one
+ *  num_ids[in] - REQUIRED: Quantity of identifiers
+ *  rows[in] - REQUIRED: Number of rows between evictions of the mapping
+ *  path[in] - REQUIRED: Output label image path
+ */
+void iftSICLE_WriteTiledLabels
+(iftSICLE_PNM *pnm, iftSICLE_MMap *ids_mmap, int *parent, int num_ids, 
+ int rows, const char *path)
+{
+	bool is_scn;
+	int num_labels, depth;
+	int *ids, *new_label;
+	unsigned char *buffer;
+	FILE *fp;
+
+	ids = ids_mmap->addr;
+	new_label = malloc(num_ids * sizeof(int));
+	assert(new_label != NULL);
+	for(int id = 0; id < num_ids; ++id) { new_label[id] = 0; }
+
+	num_labels = 0;
+	for(int y = 0; y < pnm->ysize; ++y) // Relabel in raster order
+	{
+		for(int x = 0; x < pnm->xsize; ++x)
+		{
+			int root;
+
+			root = iftSICLE_FindSet(parent, ids[(long)y * pnm->xsize + x]);
+			if(new_label[root] == 0) { new_label[root] = ++num_labels; }
+		}
+		if((y + 1) % rows == 0)
+		{ iftSICLE_EvictMMap(ids_mmap, (long)(y + 1 - rows) * pnm->xsize, 
+												 (long)rows * pnm->xsize); }
+	}
+
+	fp = iftSICLE_OpenLabelFile(path, pnm->xsize, pnm->ysize, 1, 1.0, 1.0, 
+															1.0, num_labels, &depth, &is_scn);
+	buffer = malloc((long)pnm->xsize * (depth/8));
+	assert(buffer != NULL);
+
+	for(int y = 0; y < pnm->ysize; ++y)
+	{
+		for(int x = 0; x < pnm->xsize; ++x)
+		{
+			int root;
+
+			root = iftSICLE_FindSet(parent, ids[(long)y * pnm->xsize + x]);
+			iftSICLE_PackLabel(buffer, x, new_label[root], depth, is_scn);
+		}
+
+		if(fwrite(buffer, depth/8, pnm->xsize, fp) != (size_t)pnm->xsize)
+		{ iftError("Could not write to %s", __func__, path); }
+		if((y + 1) % rows == 0)
+		{ iftSICLE_EvictMMap(ids_mmap, (long)(y + 1 - rows) * pnm->xsize, 
+												 (long)rows * pnm->xsize); }
+	}
+
+	free(buffer);
+	free(new_label);
+	fclose(fp);
+}
+
+//============================================================================|
+// Stream
+//============================================================================|
+/*
+ * Copies the features of the SICLE auxiliary data, for comparing them with
+ * the ones of the next frame.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *
+ * RETURNS: Spel features, stored contiguously
+ */
+float *iftSICLE_CopyFeats
+(iftSICLE *sicle)
+{
+	float *feats;
+
+	feats = malloc(sicle->mimg->data->n * sizeof(float));
+	assert(feats != NULL);
+	memcpy(feats, sicle->mimg->data->val, sicle->mimg->data->n * sizeof(float));
+
+	return feats;
+}
+
+/*
+ * Tracks a seed of the previous frame within its neighborhood in the current
+ * one, returning the spel whose patch of features best matches the one 
+ * around the seed previously (i.e., least sum of squared differences).
+ *
+ * PARAMETERS:
+ *  stream[in] - REQUIRED: Stream data of the previous frame
+ *  sicle[in] - REQUIRED: SICLE auxiliary data of the current frame
+ *  s_index[in] - REQUIRED: Seed of the previous frame
+ *  A[in] - REQUIRED: Search window adjacency
+ *  B[in] - REQUIRED: Patch adjacency
+ *
+ * RETURNS: Tracked seed, or IFT_NIL if no candidate is within the ROI
+ */
+iftIdx iftSICLE_TrackSeed
+(iftSICLEStream *stream, iftSICLE *sicle, iftIdx s_index, iftAdjRel *A, 
+ iftAdjRel *B)
+{
+	float best_ssd;
+	iftIdx best_index;
+	iftVoxel s_voxel;
+
+	s_voxel = iftMGetVoxelCoord(sicle->mimg, s_index);
+	best_ssd = IFT_INFINITY_FLT; best_index = IFT_NIL;
+	for(int i = 0; i < A->n; ++i)
+	{
+		float ssd;
+		iftVoxel v_voxel;
+		iftIdx v_index;
+
+		v_voxel = iftGetAdjacentVoxel(A, s_voxel, i);
+		if(!iftMValidVoxel(sicle->mimg, v_voxel)) { continue; }
+		v_index = iftMGetVoxelIndex(sicle->mimg, v_voxel);
+		if(!iftSICLE_InROI(sicle, v_index)) { continue; }
+
+		ssd = 0;
+		for(int j = 0; j < B->n; ++j)
+		{
+			iftVoxel u_voxel, w_voxel;
+			float *prev_feats;
+
+			u_voxel = iftGetAdjacentVoxel(B, s_voxel, j);
+			w_voxel = iftGetAdjacentVoxel(B, v_voxel, j);
+			if(!iftMValidVoxel(sicle->mimg, u_voxel) || 
+				 !iftMValidVoxel(sicle->mimg, w_voxel)) { continue; }
+
+			prev_feats = &(stream->prev_feats[
+				iftMGetVoxelIndex(sicle->mimg, u_voxel) * sicle->mimg->m]);
+			for(int b = 0; b < sicle->mimg->m; ++b)
+			{
+				float diff;
+
+				diff = iftSICLE_GetFeats(sicle, 
+																 iftMGetVoxelIndex(sicle->mimg, w_voxel))[b] - 
+							 prev_feats[b];
+				ssd += diff * diff;
+			}
+		}
+		if(ssd < best_ssd) { best_ssd = ssd; best_index = v_index; }
+	}
+
+	return best_index;
+}
+
+/*
+ * Selects the seeds of the current frame: the ones of the previous frame 
+ * which are within the ROI, plus seeds randomly sampled among the changed 
+ * spels. The latter are proportional to the ratio of changed spels within
+ * the ROI, being N0 - Nf if all of them have changed.
+ *
+ * PARAMETERS:
+ *  stream[in] - REQUIRED: Stream data of the previous frame
+ *  sicle[in] - REQUIRED: SICLE auxiliary data of the current frame
+ *
+ * RETURNS: Seeds of the current frame
+ */
+iftIdxArray *iftSICLE_WarmSeeds
+(iftSICLEStream *stream, iftSICLE *sicle)
+{
+	int num_extra, num_kept;
+	iftIdx num_changed, num_roi;
+	float sq_thr;
+	iftIdx *changed;
+	iftBMap *marked;
+	iftAdjRel *A, *B;
+	iftIdxArray *seeds;
+
+	changed = malloc(sicle->mimg->n * sizeof(iftIdx));
+	assert(changed != NULL);
+
+	sq_thr = stream->change_thr * stream->change_thr;
+	num_changed = 0; num_roi = 0;
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{
+		float dist;
+		float *prev_feats;
+
+		if(!iftSICLE_InROI(sicle, v_index)) { continue; }
+		num_roi++;
+
+		prev_feats = &(stream->prev_feats[v_index * sicle->mimg->m]);
+		dist = 0;
+		for(int b = 0; b < sicle->mimg->m; ++b)
+		{ dist += (iftSICLE_GetFeats(sicle, v_index)[b] - prev_feats[b]) * 
+							(iftSICLE_GetFeats(sicle, v_index)[b] - prev_feats[b]); }
+		if(dist > sq_thr) { changed[num_changed++] = v_index; }
+	}
+
+	num_extra = 0;
+	if(num_roi > 0)
+	{ num_extra = iftRound((stream->args->n0 - stream->args->nf) * 
+												 (num_changed / (double)num_roi)); }
+
+	seeds = iftCreateIdxArray(stream->seeds->n + num_extra);
+	marked = iftCreateBMap(sicle->mimg->n);
+
+	if(iftIs3DMImage(sicle->mimg) == true) 
+	{ A = iftSpheric(IFTSICLE_TRACK_RADIUS); B = iftSpheric(sqrtf(3.0)); }
+	else { A = iftCircular(IFTSICLE_TRACK_RADIUS); B = iftCircular(sqrtf(2.0)); }
+
+	num_kept = 0;
+	for(long i = 0; i < stream->seeds->n; ++i)
+	{
+		iftIdx s_index;
+
+		s_index = iftSICLE_TrackSeed(stream, sicle, stream->seeds->val[i], A, B);
+		if(s_index != IFT_NIL && !iftBMapValue(marked, s_index))
+		{ 
+			stream->seeds->val[i] = s_index; // For carrying its identifier
+			seeds->val[num_kept++] = s_index; 
+			iftBMapSet1(marked, s_index);
+		}
+	}
+	iftDestroyAdjRel(&A); iftDestroyAdjRel(&B);
+
+	for(int i = 0; i < num_extra && num_changed > 0; ++i)
+	{
+		iftIdx j, s_index;
+
+		j = iftSICLE_RandomIdx(0, num_changed - 1); // Partial Fisher-Yates
+		s_index = changed[j]; changed[j] = changed[--num_changed];
+		if(!iftBMapValue(marked, s_index))
+		{
+			seeds->val[num_kept++] = s_index;
+			iftBMapSet1(marked, s_index);
+		}
+	}
+	seeds->n = num_kept;
+
+	iftDestroyBMap(&marked);
+	free(changed);
+
+	return seeds;
+}
+
+/*
+ * Keeps the final seeds of the current frame for the next one, and assigns
+ * their persistent identifiers: a seed keeps the identifier it had in the
+ * previous frame, whereas new ones receive fresh identifiers.
+ *
+ * PARAMETERS:
+ *  stream[in/out] - REQUIRED: Stream data to be updated
+ *  sicle[in] - REQUIRED: SICLE auxiliary data of the current frame
+ *  data[in] - REQUIRED: Final IFT data of the current frame
+ */
+void iftSICLE_UpdateStream
+(iftSICLEStream *stream, iftSICLE *sicle, iftSICLE_IFTData *data)
+{
+	int *id_map;
+	iftIntArray *ids;
+
+	id_map = calloc(sicle->mimg->n, sizeof(int)); // 0 for non-seeds
+	assert(id_map != NULL);
+	if(stream->seeds != NULL)
+	{
+		for(long i = 0; i < stream->seeds->n; ++i)
+		{ id_map[stream->seeds->val[i]] = stream->ids->val[i]; }
+		iftDestroyIdxArray(&(stream->seeds));
+		iftDestroyIntArray(&(stream->ids));
+	}
+
+	ids = iftCreateIntArray(data->seeds->n);
+	for(long i = 0; i < data->seeds->n; ++i)
+	{
+		iftIdx s_index;
+
+		s_index = data->seeds->val[i];
+		if(id_map[s_index] > 0) { ids->val[i] = id_map[s_index]; }
+		else { ids->val[i] = stream->next_id++; }
+	}
+	free(id_map);
+
+	stream->seeds = iftCreateIdxArray(data->seeds->n);
+	memcpy(stream->seeds->val, data->seeds->val, data->seeds->n * sizeof(iftIdx));
+	stream->ids = ids;
+
+	if(stream->prev_feats != NULL) { free(stream->prev_feats); }
+	stream->prev_feats = iftSICLE_CopyFeats(sicle);
+	stream->xsize = sicle->mimg->xsize; 
+	stream->ysize = sicle->mimg->ysize; 
+	stream->zsize = sicle->mimg->zsize;
+}
+
+//============================================================================|
+// Sliding window
+//============================================================================|
+/*
+ * Reads consecutive frames of a video folder as a volume, whose slices are
+ * the frames.
+ *
+ * PARAMETERS:
+ *  files[in] - REQUIRED: Frame files, in temporal order
+ *  first[in] - REQUIRED: First frame to be read
+ *  num_frames[in] - REQUIRED: Number of frames to be read
+ *
+ * RETURNS: Volume of the frames
+ */
+iftImage *iftSICLE_ReadFrames
+(iftFileSet *files, long first, int num_frames)
+{
+	iftImage *vol;
+
+	vol = NULL;
+	for(int z = 0; z < num_frames; ++z)
+	{
+		const char *frame_path;
+		iftImage *frame;
+
+		frame_path = files->files[first + z]->path;
+		frame = iftReadImageByExt(frame_path);
+		if(vol == NULL)
+		{
+			if(iftIsColorImage(frame) == true)
+			{ 
+				vol = iftCreateColorImage(frame->xsize, frame->ysize, num_frames, 
+																	iftImageDepth(frame)); 
+			}
+			else { vol = iftCreateImage(frame->xsize, frame->ysize, num_frames); }
+		}
+		if(frame->xsize != vol->xsize || frame->ysize != vol->ysize || 
+			 frame->zsize != 1 || iftIsColorImage(frame) != iftIsColorImage(vol))
+		{ iftError("Frame %s differs from the first one read", __func__, frame_path); }
+
+		iftPutXYSlice(vol, frame, z);
+		iftDestroyImage(&frame);
+	}
+
+	return vol;
+}
+
+/*
+ * Finds the rank of a value within a sorted array of distinct values by 
+ * binary search.
+ *
+ * PARAMETERS:
+ *  arr[in] - REQUIRED: Sorted array of distinct values
+ *  n[in] - REQUIRED: Array length
+ *  val[in] - REQUIRED: Value within the array
+ *
+ * RETURNS: Index of the value
+ */
+long iftSICLE_RankSorted
+(const long *arr, long n, long val)
+{
+	long lo, hi;
+
+	lo = 0; hi = n;
+	while(lo < hi) 
+	{ 
+		long mid = lo + (hi - lo)/2; 
+		if(arr[mid] < val) { lo = mid + 1; } else { hi = mid; } 
+	}
+
+	return lo;
+}
+
+/*
+ * Maps the labels of the current window to the identifiers of the previous 
+ * one, given the overlapping frames in which both were computed. A label is 
+ * mapped to an identifier when each is the other's most overlapping one.
+ * Therefore, each label is mapped to at most one identifier, and vice-versa.
+ *
+ * PARAMETERS:
+ *  labels[in] - REQUIRED: Labels of the current window within the overlap
+ *  prev_ids[in] - REQUIRED: Identifiers of the previous window in the overlap
+ *  n[in] - REQUIRED: Number of spels within the overlap
+ *  new_id[in/out] - REQUIRED: Identifier of each label (0 if not mapped)
+ */
+void iftSICLE_MatchWindows
+(const int *labels, const int *prev_ids, long n, int *new_id)
+{
+	long num_ids;
+	int *best_label;
+	long *pairs, *ids, *best_num;
+
+	if(n == 0) { return; }
+
+	pairs = malloc(n * sizeof(long));
+	ids = malloc(n * sizeof(long));
+	assert(pairs != NULL && ids != NULL);
+
+	for(long i = 0; i < n; ++i)
+	{
+		ids[i] = prev_ids[i];
+		pairs[i] = ((long)labels[i] << 32) | ids[i];
+	}
+	qsort(pairs, n, sizeof(long), iftSICLE_CmpLong);
+	qsort(ids, n, sizeof(long), iftSICLE_CmpLong);
+
+	num_ids = 0; // Distinct identifiers
+	for(long i = 0; i < n; ++i)
+	{ if(i == 0 || ids[i] != ids[num_ids - 1]) { ids[num_ids++] = ids[i]; } }
+
+	best_num = calloc(num_ids, sizeof(long));
+	best_label = calloc(num_ids, sizeof(int));
+	assert(best_num != NULL && best_label != NULL);
+
+	for(long i = 0, j; i < n; i = j) // Most overlapping label of each id
+	{
+		long rank;
+
+		for(j = i; j < n && pairs[j] == pairs[i]; ++j);
+
+		rank = iftSICLE_RankSorted(ids, num_ids, pairs[i] & 0xFFFFFFFFL);
+		if(j - i > best_num[rank]) 
+		{ best_num[rank] = j - i; best_label[rank] = pairs[i] >> 32; }
+	}
+
+	for(long i = 0, j; i < n; i = j) // Pairs are grouped by label
+	{
+		int label, best_id;
+		long num_best;
+
+		label = pairs[i] >> 32; num_best = 0; best_id = 0;
+		for(j = i; j < n && (pairs[j] >> 32) == label; )
+		{
+			long k;
+
+			for(k = j; k < n && pairs[k] == pairs[j]; ++k);
+			if(k - j > num_best) 
+			{ num_best = k - j; best_id = pairs[j] & 0xFFFFFFFFL; }
+			j = k;
+		}
+
+		if(best_label[iftSICLE_RankSorted(ids, num_ids, best_id)] == label)
+		{ new_id[label] = best_id; } // Mutually most overlapping
+	}
+
+	free(pairs); free(ids); free(best_num); free(best_label);
+}
+
+/*
+ * Segments a window of frames using a budget of seeds proportional to its 
+ * length, and relabels its superspels to the persistent identifiers: the 
+ * ones carried from the previous window, given the overlapping frames, and
+ * fresh ones otherwise.
+ *
+ * PARAMETERS:
+ *  vol[in] - REQUIRED: Volume of the window's frames
+ *  args[in] - REQUIRED: SICLE arguments for a window of full length
+ *  ratio[in] - REQUIRED: Window's length over the full one
+ *  prev_ids[in] - OPTIONAL: Identifiers of the previous window in the overlap
+ *  num_overlap[in] - REQUIRED: Number of overlapping frames (0 if first)
+ *  next_id[in/out] - REQUIRED: Next persistent identifier to be assigned
+ *
+ * RETURNS: Superspel segmentation whose labels are the persistent identifiers
+ */
+iftImage *iftSICLE_RunWindow
+(iftImage *vol, iftSICLEArgs *args, double ratio, const int *prev_ids, 
+ int num_overlap, int *next_id)
+{
+	int num_labels;
+	int *new_id;
+	iftSICLEArgs win_args;
+	iftSICLE *sicle;
+	iftImage *segm;
+
+	sicle = iftCreateSICLE(vol, NULL, NULL);
+
+	win_args = (*args); // Shallow copy
+	if(ratio < 1.0) // Shorter (i.e., last) window
+	{
+		win_args.user_ni = NULL; // Absolute quantities do not fit the window
+		win_args.nf = iftMax(2, iftRound(args->nf * ratio));
+		win_args.n0 = iftMax(win_args.nf + 1, iftRound(args->n0 * ratio));
+	}
+	win_args.n0 = iftMin(win_args.n0, sicle->mimg->n - 1);
+	win_args.nf = iftMin(win_args.nf, win_args.n0 - 1);
+	iftVerifySICLEArgs(sicle, &win_args);
+
+	segm = iftRunSICLE(sicle, &win_args);
+	iftDestroySICLE(&sicle);
+	num_labels = iftMaximumValue(segm);
+
+	new_id = calloc(num_labels + 1, sizeof(int));
+	assert(new_id != NULL);
+	if(prev_ids != NULL)
+	{ 
+		iftSICLE_MatchWindows(segm->val, prev_ids, 
+													(long)num_overlap * vol->xsize * vol->ysize, new_id);
+	}
+	for(int label = 1; label <= num_labels; ++label)
+	{ if(new_id[label] == 0) { new_id[label] = (*next_id)++; } }
+
+	for(iftIdx v_index = 0; v_index < segm->n; ++v_index)
+	{ segm->val[v_index] = new_id[segm->val[v_index]]; }
+	free(new_id);
+
+	return segm;
+}
+
+//============================================================================|
+// Session
+//============================================================================|
+/*
+ * Returns the spel of a voxel to be used as a new seed in the session, which
+ * must be within the image and the ROI, and not be a seed already.
+ *
+ * PARAMETERS:
+ *  session[in] - REQUIRED: Editing session
+ *  v_voxel[in] - REQUIRED: Voxel of the new seed
+ *
+ * RETURNS: Spel of the voxel
+ */
+iftIdx iftSICLE_GetNewSeedIndex
+(iftSICLESession *session, iftVoxel v_voxel)
+{
+	iftIdx v_index;
+
+	if(iftMValidVoxel(session->sicle->mimg, v_voxel) == false)
+	{ iftError("Voxel (%d,%d,%d) is outside the image", __func__, v_voxel.x, 
+						 v_voxel.y, v_voxel.z); }
+
+	v_index = iftMGetVoxelIndex(session->sicle->mimg, v_voxel);
+	if(!iftSICLE_InROI(session->sicle, v_index))
+	{ iftError("Voxel (%d,%d,%d) is outside the mask", __func__, v_voxel.x, 
+						 v_voxel.y, v_voxel.z); }
+	if(session->data->root_map[v_index] == v_index)
+	{ iftError("Voxel (%d,%d,%d) is a seed already", __func__, v_voxel.x, 
+						 v_voxel.y, v_voxel.z); }
+
+	return v_index;
+}
+
+/*
+ * Verifies whether a superspel of the session exists. If not, an error is 
+ * thrown.
+ *
+ * PARAMETERS:
+ *  session[in] - REQUIRED: Editing session
+ *  label[in] - REQUIRED: Superspel label
+ */
+void iftSICLE_VerifySessionLabel
+(iftSICLESession *session, int label)
+{
+	for(long s_id = 0; s_id < session->labels->n; ++s_id)
+	{ if(session->labels->val[s_id] == label) { return; } }
+
+	iftError("Superspel %d does not exist", __func__, label);
+}
+
+/*
+ * Updates a forest differentially by removing the trees of the irrelevant
+ * seeds and by adding the new seeds, whose labels must be already written in
+ * the predecessor map. Only the removed trees, and the spels which the new 
+ * seeds conquer, are recomputed. The queue must be empty, and it is left so
+ * for being reused. The seed array is not modified.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in/out] - REQUIRED: IFT auxiliary data to be modified
+ *  heap[in/out] - REQUIRED: Empty priority queue on the cost map
+ *  irre_seeds[in/out] - OPTIONAL: Irrelevant seeds to be removed
+ *  new_seeds[in/out] - OPTIONAL: New seeds to be added
+ *
+ * RETURNS: Bounding box of the visited spels (empty if none)
+ */
+iftBoundingBox iftSICLE_UpdateForest
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData **data, 
+ iftDHeap **heap, iftSet **irre_seeds, iftSet **new_seeds)
+{
+	iftBoundingBox bb;
+	iftSet *frontier;
+
+	bb.begin.x = bb.begin.y = bb.begin.z = IFT_INFINITY_INT;
+	bb.end.x = bb.end.y = bb.end.z = -1;
+
+	frontier = NULL;
+	if(irre_seeds != NULL && (*irre_seeds) != NULL)
+	{ frontier = iftSICLE_RemoveTrees(sicle, data, irre_seeds); }
+
+	while(new_seeds != NULL && (*new_seeds) != NULL)
+	{
+		iftIdx s_index;
+
+		s_index = iftRemoveSet(new_seeds);
+		(*data)->root_map[s_index] = s_index;
+		(*data)->cost_map[s_index] = 0;
+		iftInsertDHeap(*heap, s_index);
+	}
+
+	while(frontier != NULL)
+	{
+		iftIdx v_index;
+
+		v_index = iftRemoveSet(&frontier);
+		if((*heap)->color[v_index] != IFT_GRAY) 
+		{ iftInsertDHeap(*heap, v_index); }
+	}
+
+	iftSICLE_PropagateDIFT(sicle, args, data, heap, &bb);
+
+	// Only the visited spels are cleared, for reusing the queue
+	for(int z = bb.begin.z; z <= bb.end.z; ++z)
+	{
+		for(int y = bb.begin.y; y <= bb.end.y; ++y)
+		{
+			for(int x = bb.begin.x; x <= bb.end.x; ++x)
+			{
+				iftVoxel v_voxel;
+
+				v_voxel.x = x; v_voxel.y = y; v_voxel.z = z;
+				(*heap)->color[iftMGetVoxelIndex(sicle->mimg, v_voxel)] = IFT_WHITE;
+			}
+		}
+	}
+
+	return bb;
+}
+
+/*
+ * Edits the forest of the session by removing the seeds of a superspel and/or
+ * adding a new seed, and updates the forest differentially. The bounding box 
+ * of the visited spels is returned, containing every spel whose label 
+ * changed.
+ *
+ * PARAMETERS:
+ *  session[in/out] - REQUIRED: Editing session
+ *  rem_label[in] - REQUIRED: Superspel whose seeds are removed (0 if none)
+ *  add_index[in] - REQUIRED: Spel of the new seed (IFT_NIL if none)
+ *  add_label[in] - REQUIRED: Label of the new seed
+ *
+ * RETURNS: Bounding box of the visited spels (empty if none)
+ */
+iftBoundingBox iftSICLE_EditSession
+(iftSICLESession *session, int rem_label, iftIdx add_index, int add_label)
+{
+	long num_kept;
+	iftSet *irre_seeds, *new_seeds;
+	iftSICLE_IFTData *data;
+
+	data = session->data;
+
+	irre_seeds = NULL; num_kept = 0;
+	for(long s_id = 0; s_id < data->seeds->n; ++s_id)
+	{
+		if(rem_label != 0 && session->labels->val[s_id] == rem_label)
+		{ iftInsertSet(&irre_seeds, data->seeds->val[s_id]); }
+		else
+		{
+			data->seeds->val[num_kept] = data->seeds->val[s_id];
+			session->labels->val[num_kept] = session->labels->val[s_id];
+			num_kept++;
+		}
+	}
+	if(num_kept == 0 && add_index == IFT_NIL)
+	{ iftError("The last superspel cannot be removed", __func__); }
+	data->seeds->n = session->labels->n = num_kept;
+
+	new_seeds = NULL;
+	if(add_index != IFT_NIL)
+	{
+		data->seeds->val = realloc(data->seeds->val, 
+															 (num_kept + 1) * sizeof(iftIdx));
+		session->labels->val = realloc(session->labels->val, 
+																	 (num_kept + 1) * sizeof(int));
+		assert(data->seeds->val != NULL && session->labels->val != NULL);
+		data->seeds->val[num_kept] = add_index;
+		session->labels->val[num_kept] = add_label;
+		data->seeds->n = session->labels->n = num_kept + 1;
+
+		data->pred_map[add_index] = -add_label; // 2's complement of label - 1
+		iftInsertSet(&new_seeds, add_index);
+	}
+
+	return iftSICLE_UpdateForest(session->sicle, session->args, &(session->data),
+															 &(session->heap), &irre_seeds, &new_seeds);
+}
+
+/*
+ * Computes the bounding box of a superspel of the session, by traversing it 
+ * from its seeds.
+ *
+ * PARAMETERS:
+ *  session[in] - REQUIRED: Editing session
+ *  label[in] - REQUIRED: Superspel label
+ *
+ * RETURNS: Bounding box of the superspel
+ */
+iftBoundingBox iftSICLE_CalcLabelBBox
+(iftSICLESession *session, int label)
+{
+	iftBoundingBox bb;
+	iftBMap *marked;
+	iftSet *queue;
+	iftSICLE_IFTData *data;
+
+	data = session->data;
+	bb.begin.x = bb.begin.y = bb.begin.z = IFT_INFINITY_INT;
+	bb.end.x = bb.end.y = bb.end.z = -1;
+
+	marked = iftCreateBMap(data->num_vtx);
+	queue = NULL;
+	for(long s_id = 0; s_id < data->seeds->n; ++s_id)
+	{
+		if(session->labels->val[s_id] == label)
+		{ 
+			iftInsertSet(&queue, data->seeds->val[s_id]);
+			iftBMapSet1(marked, data->seeds->val[s_id]);
+		}
+	}
+
+	while(queue != NULL)
+	{
+		iftIdx vi_index;
+		iftVoxel vi_voxel;
+
+		vi_index = iftRemoveSet(&queue);
+		vi_voxel = iftMGetVoxelCoord(session->sicle->mimg, vi_index);
+		iftSICLE_ExpandBBox(&bb, vi_voxel);
+
+		for(int j = 1; j < data->A->n; ++j)
+		{
+			iftVoxel vj_voxel;
+
+			vj_voxel = iftGetAdjacentVoxel(data->A, vi_voxel, j);
+			if(iftMValidVoxel(session->sicle->mimg, vj_voxel))
+			{
+				iftIdx vj_index;
+
+				vj_index = iftMGetVoxelIndex(session->sicle->mimg, vj_voxel);
+				if(!iftBMapValue(marked, vj_index) && 
+					 iftSICLE_InROI(session->sicle, vj_index) &&
+					 iftSICLE_GetRootLabel(data, vj_index) + 1 == label)
+				{ 
+					iftBMapSet1(marked, vj_index);
+					iftInsertSet(&queue, vj_index); 
+				}
+			}
+		}
+	}
+	iftDestroyBMap(&marked);
+
+	return bb;
+}
+
+//============================================================================|
+// Planner
+//============================================================================|
+/*
+ * Creates the synthetic image of the calibration benchmark, with smooth 
+ * regions and texture, which is the same at every call.
+ *
+ * PARAMETERS:
+ *  is_color[in] - REQUIRED: Whether a color image is created
+ *
+ * RETURNS: Benchmark image
+ */
+iftImage *iftSICLE_CreateBenchImage
+(bool is_color)
+{
+	iftImage *img;
+
+	if(is_color == true) 
+	{ img = iftCreateColorImage(IFTSICLE_BENCH_SIZE, IFTSICLE_BENCH_SIZE, 1, 8); }
+	else { img = iftCreateImage(IFTSICLE_BENCH_SIZE, IFTSICLE_BENCH_SIZE, 1); }
+
+	for(int y = 0; y < IFTSICLE_BENCH_SIZE; ++y)
+	{
+		for(int x = 0; x < IFTSICLE_BENCH_SIZE; ++x)
+		{
+			iftIdx v_index;
+			unsigned int hash;
+
+			v_index = x + y * IFTSICLE_BENCH_SIZE;
+			hash = (x * 73856093u) ^ (y * 19349663u); // Deterministic noise
+			img->val[v_index] = 128 + 80 * sin(x / 9.0) * cos(y / 13.0) + 
+													(hash % 17) - 8;
+			if(is_color == true)
+			{
+				img->Cb[v_index] = 128 + 60 * sin((x + y) / 21.0);
+				img->Cr[v_index] = 128 + 60 * cos((x - y) / 17.0);
+			}
+		}
+	}
+
+	return img;
+}
+
+/*
+ * Measures the time of each step of SICLE on the benchmark image, with the
+ * default arguments: the first IFT, the tree statistics and relevance of its
+ * forest, and the differential IFT of the second iteration.
+ *
+ * PARAMETERS:
+ *  is_color[in] - REQUIRED: Whether the benchmark image is colored
+ *  times[out] - REQUIRED: Time (in seconds) of the IFT, the DIFT, the tree
+ *		statistics and the tree relevance, in this order
+ *  num_trees[out] - REQUIRED: Number of initial trees
+ *  dift_frac[out] - REQUIRED: Fraction of the seeds removed for the DIFT
+ */
+void iftSICLE_BenchSteps
+(bool is_color, double times[4], long *num_trees, double *dift_frac)
+{
+	double start;
+	double *prio;
+	iftSet *irre_seeds;
+	iftImage *img;
+	iftIntArray *ni;
+	iftSICLE *sicle;
+	iftSICLEArgs *args;
+	iftSICLE_IFTData *data;
+	iftSICLE_TStats *tstats;
+
+	img = iftSICLE_CreateBenchImage(is_color);
+	sicle = iftCreateSICLE(img, NULL, NULL);
+	iftDestroyImage(&img);
+	args = iftCreateSICLEArgs();
+
+	data = iftSICLE_CreateIFTData(sicle, args);
+	ni = iftSICLE_CreateNiArray(args, data->seeds->n);
+	(*num_trees) = data->seeds->n;
+
+	start = iftSICLE_GetWallTime();
+	iftSICLE_RunSeedIFT(sicle, args, &data);
+	times[0] = iftSICLE_GetWallTime() - start;
+
+	start = iftSICLE_GetWallTime();
+	tstats = iftSICLE_CalcTStats(sicle, args, data);
+	times[2] = iftSICLE_GetWallTime() - start;
+
+	start = iftSICLE_GetWallTime();
+	prio = iftSICLE_CalcTreePrio(sicle, args, tstats);
+	times[3] = iftSICLE_GetWallTime() - start;
+	free(prio);
+	iftSICLE_DestroyTStats(&tstats);
+
+	irre_seeds = NULL;
+	iftSICLE_RemSeeds(sicle, ni->val[1], args, &data, &irre_seeds);
+	start = iftSICLE_GetWallTime();
+	iftSICLE_RunSeedDIFT(sicle, args, &data, &irre_seeds);
+	times[1] = iftSICLE_GetWallTime() - start;
+	(*dift_frac) = (ni->val[0] - ni->val[1]) / (double)ni->val[0];
+
+	iftDestroyIntArray(&ni);
+	iftSICLE_DestroyIFTData(&data);
+	iftDestroySICLEArgs(&args);
+	iftDestroySICLE(&sicle);
+}
+
+/*
+ * Predicts the peak memory of SICLE in-core: the spel features, the forest
+ * maps, and the largest among the priority queue of the IFT, the statistics
+ * of the initial trees, and the output label image.
+ *
+ * PARAMETERS:
+ *  args[in] - REQUIRED: SICLE arguments
+ *  num_vtx[in] - REQUIRED: Number of spels
+ *  num_feats[in] - REQUIRED: Number of features per spel
+ *  num_trees[in] - REQUIRED: Number of initial trees (i.e., N0)
+ *
+ * RETURNS: Peak memory (in bytes)
+ */
+size_t iftSICLE_PredictMemory
+(iftSICLEArgs *args, long num_vtx, int num_feats, long num_trees)
+{
+	size_t feats, maps, heap, tstats, labels;
+
+	feats = num_vtx * (num_feats * sizeof(float) + sizeof(float*) + 
+										 sizeof(iftIdx)); // Matrix and its row tables
+	if(args->alpha > 0 || args->penopt != IFT_SICLE_PEN_NONE) 
+	{ feats += num_vtx * sizeof(float); } // Saliency
+	maps = num_vtx * (2 * sizeof(iftIdx) + sizeof(double));
+	if(args->ooc_path != NULL) // Only the resident chunks
+	{ maps = iftMin(feats + maps, (size_t)args->ooc_budget << 20); feats = 0; }
+
+	heap = num_vtx * (2 * sizeof(iftIdx) + sizeof(char)) + num_vtx / 8;
+	tstats = num_trees * (4 * sizeof(int) + (num_feats + 3) * sizeof(float) + 
+												3 * sizeof(void*) + 8 * sizeof(int)); // Initial lists
+	labels = num_vtx * sizeof(int);
+
+	return feats + maps + iftMax(heap, iftMax(tstats, labels));
+}
+
+/*
+ * Predicts the wall-clock time of SICLE, given the calibration. The IFT is 
+ * proportional to the arcs evaluated times the depth of the priority queue 
+ * (i.e., log2 of the spels), and each differential IFT to the fraction of 
+ * the seeds removed before it. Each seed removal costs the tree statistics 
+ * (proportional to the arcs) and the tree relevance (proportional to the 
+ * number of trees, for each one is compared only to its adjacents).
+ *
+ * PARAMETERS:
+ *  calib[in] - REQUIRED: Machine's calibration
+ *  args[in] - REQUIRED: SICLE arguments
+ *  num_vtx[in] - REQUIRED: Number of spels
+ *  num_adjs[in] - REQUIRED: Number of adjacents per spel
+ *  num_feats[in] - REQUIRED: Number of features per spel
+ *
+ * RETURNS: Time (in seconds)
+ */
+double iftSICLE_PredictTime
+(iftSICLECalib *calib, iftSICLEArgs *args, long num_vtx, int num_adjs, 
+ int num_feats)
+{
+	double time, num_arcs, arc_time;
+	iftIntArray *ni;
+
+	ni = iftSICLE_CreateNiArray(args, iftMin(args->n0, num_vtx - 1));
+	num_arcs = num_vtx * (double)num_adjs;
+	arc_time = (calib->arc_time + calib->feat_time * num_feats) * log2(num_vtx);
+
+	time = 0;
+	for(int it = 0; it < ni->n; ++it)
+	{
+		if(it == 0 || args->use_dift == false) { time += num_arcs * arc_time; }
+		else
+		{
+			double frac;
+
+			frac = (ni->val[it-1] - ni->val[it]) / (double)ni->val[it-1];
+			time += calib->dift_factor * frac * num_arcs * arc_time;
+		}
+
+		if(it < ni->n - 1) // Seed removal
+		{
+			time += num_arcs * calib->stats_time;
+			time += ni->val[it] * calib->pair_time;
+		}
+	}
+	iftDestroyIntArray(&ni);
+
+	return time;
+}
+
+//============================================================================|
+// Sweep
+//============================================================================|
+/*
+ * Checks whether two parametrizations compute the same seeds and first 
+ * forest, i.e., they differ only in their seed removal schedule.
+ *
+ * PARAMETERS:
+ *  args[in] - REQUIRED: SICLE arguments
+ *  other[in] - REQUIRED: Other SICLE arguments
+ *
+ * RETURNS: Whether the first forest may be shared
+ */
+bool iftSICLE_HasSameFirstForest
+(iftSICLEArgs *args, iftSICLEArgs *other)
+{
+	bool same;
+
+	same = args->n0 == other->n0 && args->samplopt == other->samplopt &&
+				 args->connopt == other->connopt && 
+				 iftSICLE_GetAdjOpt(args) == iftSICLE_GetAdjOpt(other) &&
+				 args->engineopt == other->engineopt && args->alpha == other->alpha;
+	if(same == true && args->connopt != IFT_SICLE_CONN_FMAX)
+	{ same = args->irreg == other->irreg && args->adhr == other->adhr; }
+	if(same == true && args->engineopt == IFT_SICLE_ENGINE_RASTER)
+	{ same = args->max_sweeps == other->max_sweeps; }
+
+	return same;
+}
+
+/*
+ * Checks whether the parametrization may start from a shared first forest.
+ * The out-of-core and pyramid runs compute their forests on their own.
+ *
+ * PARAMETERS:
+ *  args[in] - REQUIRED: SICLE arguments
+ *
+ * RETURNS: Whether it may be shared
+ */
+bool iftSICLE_IsShareable
+(iftSICLEArgs *args)
+{
+	return args->ooc_path == NULL && args->pyr_levels == 0;
+}
+
+//============================================================================|
+// Checkpoint
+//============================================================================|
+/*
+ * Computes the 64-bit FNV-1a hash of a buffer, which does not depend on the
+ * machine.
+ *
+ * PARAMETERS:
+ *  hash[in] - REQUIRED: Hash of the preceding bytes (or the FNV offset basis)
+ *  buf[in] - REQUIRED: Buffer of, at least, the given size
+ *  size[in] - REQUIRED: Number of bytes
+ *
+ * RETURNS: Hash up to the buffer's last byte
+ */
+ullong iftSICLE_HashBytes
+(ullong hash, const void *buf, size_t size)
+{
+	const uchar *PTR;
+
+	PTR = (const uchar*)buf;
+	for(size_t i = 0; i < size; ++i)
+	{ hash ^= PTR[i]; hash *= 0x100000001B3ULL; } // FNV prime
+
+	return hash;
+}
+
+/*
+ * Computes the hash of the inputs which define the forest of a prototype (i.e.,
+ * its features, saliency and ROI), for checking a checkpoint against it.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *
+ * RETURNS: Hash of the inputs
+ */
+ullong iftSICLE_HashCkptInputs
+(iftSICLE *sicle)
+{
+	ullong hash;
+
+	hash = iftSICLE_HashBytes(0xCBF29CE484222325ULL, IFTSICLE_CKPT_MAGIC, 8);
+	hash = iftSICLE_HashBytes(hash, sicle->mimg->data->val, sizeof(float) * 
+														(size_t)sicle->mimg->n * sicle->mimg->m);
+	if(sicle->sal != NULL)
+	{ 
+		hash = iftSICLE_HashBytes(hash, sicle->sal, 
+															(size_t)sicle->mimg->n * sizeof(float)); 
+	}
+	if(sicle->roi != NULL)
+	{ hash = iftSICLE_HashBytes(hash, sicle->roi->val, sicle->roi->nbytes); }
+
+	return hash;
+}
+
+/*
+ * Computes the file offsets of the arrays of a checkpoint, each one aligned 
+ * to 8 bytes for being used in place once mapped.
+ *
+ * PARAMETERS:
+ *  header[in] - REQUIRED: Checkpoint header
+ *  offset[out] - REQUIRED: Offsets of the seeds, the root, the predecessor
+ *		and the cost maps, and the file size, in this order
+ */
+void iftSICLE_CalcCkptOffsets
+(iftSICLE_CkptHeader *header, size_t offset[5])
+{
+	offset[0] = sizeof(iftSICLE_CkptHeader);
+	offset[1] = offset[0] + header->num_seeds * header->idx_size;
+	offset[1] = (offset[1] + 7) & ~((size_t)7);
+	offset[2] = offset[1] + header->num_vtx * header->idx_size;
+	offset[3] = offset[2] + header->num_vtx * header->idx_size;
+	offset[3] = (offset[3] + 7) & ~((size_t)7);
+	offset[4] = offset[3] + header->num_vtx * sizeof(double);
+}
+
+/*
+ * Writes the seeds and the forest of an in-core IFT data as a checkpoint, 
+ * along with the hash of the inputs and the arguments which define it.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  num_init[in] - REQUIRED: Number of initial seeds
+ *  path[in] - REQUIRED: Path to the checkpoint file
+ */
+void iftSICLE_WriteCkpt
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_IFTData *data, long num_init,
+ const char *path)
+{
+	size_t offset[5];
+	char zeros[8] = {0};
+	FILE *fp;
+	iftSICLE_CkptHeader header;
+
+	memset(&header, 0, sizeof(iftSICLE_CkptHeader));
+	memcpy(header.magic, IFTSICLE_CKPT_MAGIC, sizeof(header.magic));
+	header.version = IFTSICLE_CKPT_VERSION;
+	header.idx_size = sizeof(iftIdx);
+	header.xsize = sicle->mimg->xsize; header.ysize = sicle->mimg->ysize;
+	header.zsize = sicle->mimg->zsize;
+	header.num_iters = data->num_iters;
+	header.num_vtx = data->num_vtx;
+	header.num_seeds = data->seeds->n;
+	header.num_init = num_init;
+	header.input_hash = iftSICLE_HashCkptInputs(sicle);
+	header.adjopt = iftSICLE_GetAdjOpt(args); header.connopt = args->connopt;
+	header.adhr = args->adhr; 
+	header.irreg = args->irreg; header.alpha = args->alpha;
+	iftSICLE_CalcCkptOffsets(&header, offset);
+
+	fp = fopen(path, "wb");
+	if(fp == NULL) { iftError(MSG_FILE_OPEN_ERROR, __func__, path); }
+
+	fwrite(&header, sizeof(iftSICLE_CkptHeader), 1, fp);
+	fwrite(data->seeds->val, sizeof(iftIdx), data->seeds->n, fp);
+	fwrite(zeros, 1, offset[1] - ftell(fp), fp);
+	fwrite(data->root_map, sizeof(iftIdx), data->num_vtx, fp);
+	fwrite(data->pred_map, sizeof(iftIdx), data->num_vtx, fp);
+	fwrite(zeros, 1, offset[3] - ftell(fp), fp);
+	fwrite(data->cost_map, sizeof(double), data->num_vtx, fp);
+	if(ferror(fp) != 0 || (size_t)ftell(fp) != offset[4])
+	{ iftError("Could not write the checkpoint %s", __func__, path); }
+
+	fclose(fp);
+}
+
+/*
+ * Reads a checkpoint as an IFT data by privately mapping its file, thus its
+ * maps are paged in on demand and copied only where modified. The checkpoint
+ * is rejected if it was computed from other inputs or forest-defining 
+ * arguments, or if any of its seeds, roots or predecessors is out of range.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE auxiliary data
+ *  args[in] - REQUIRED: SICLE arguments
+ *  path[in] - REQUIRED: Path to the checkpoint file
+ *  num_init[out] - REQUIRED: Number of initial seeds
+ *
+ * RETURNS: IFT data of the checkpoint
+ */
+iftSICLE_IFTData *iftSICLE_ReadCkpt
+(iftSICLE *sicle, iftSICLEArgs *args, const char *path, long *num_init)
+{
+	int fd;
+	size_t offset[5];
+	struct stat st;
+	char *addr;
+	iftIdx *seeds, *root_map, *pred_map;
+	iftSICLE_CkptHeader *header;
+	iftSICLE_IFTData *data;
+
+	fd = open(path, O_RDONLY);
+	if(fd < 0) { iftError(MSG_FILE_OPEN_ERROR, __func__, path); }
+	if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(iftSICLE_CkptHeader))
+	{ iftError("Invalid checkpoint %s", __func__, path); }
+
+	addr = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd); // The mapping remains valid
+	if(addr == MAP_FAILED) { iftError("Could not map %s", __func__, path); }
+
+	header = (iftSICLE_CkptHeader*)addr;
+	if(memcmp(header->magic, IFTSICLE_CKPT_MAGIC, sizeof(header->magic)) != 0 ||
+		 header->version != IFTSICLE_CKPT_VERSION)
+	{ iftError("Invalid checkpoint %s", __func__, path); }
+	if(header->idx_size != sizeof(iftIdx))
+	{ iftError("Checkpoint %s uses %d-byte indexes", __func__, path, 
+						 header->idx_size); }
+	if(header->xsize != sicle->mimg->xsize || header->ysize != sicle->mimg->ysize
+		 || header->zsize != sicle->mimg->zsize)
+	{ iftError("Checkpoint %s has a different image domain", __func__, path); }
+	if(header->num_vtx != sicle->mimg->n || header->num_seeds < 1 ||
+		 header->num_seeds > header->num_vtx || header->num_init < 1 ||
+		 header->num_iters < 1)
+	{ iftError("Invalid checkpoint %s", __func__, path); }
+	if(header->adjopt != (int)iftSICLE_GetAdjOpt(args) || 
+		 header->connopt != (int)args->connopt || header->adhr != args->adhr ||
+		 header->irreg != args->irreg || header->alpha != args->alpha)
+	{ 
+		iftError("Checkpoint %s has different connectivity arguments", __func__,
+						 path); 
+	}
+	if(header->input_hash != iftSICLE_HashCkptInputs(sicle))
+	{ 
+		iftError("Checkpoint %s has different features, saliency or mask", 
+						 __func__, path); 
+	}
+	iftSICLE_CalcCkptOffsets(header, offset);
+	if((size_t)st.st_size != offset[4])
+	{ iftError("Truncated checkpoint %s", __func__, path); }
+
+	seeds = (iftIdx*)(addr + offset[0]);
+	root_map = (iftIdx*)(addr + offset[1]); 
+	pred_map = (iftIdx*)(addr + offset[2]);
+	for(long s_id = 0; s_id < header->num_seeds; ++s_id)
+	{ 
+		if(seeds[s_id] < 0 || seeds[s_id] >= header->num_vtx)
+		{ iftError("Checkpoint %s has an invalid seed", __func__, path); }
+	}
+	for(iftIdx v_index = 0; v_index < header->num_vtx; ++v_index)
+	{
+		if((root_map[v_index] != IFTSICLE_NIL && 
+				(root_map[v_index] < 0 || root_map[v_index] >= header->num_vtx)) ||
+			 (pred_map[v_index] != IFTSICLE_NIL && 
+				(pred_map[v_index] < -header->num_seeds || 
+				 pred_map[v_index] >= header->num_vtx)))
+		{ iftError("Checkpoint %s has an invalid forest", __func__, path); }
+	}
+
+	data = malloc(sizeof(iftSICLE_IFTData));
+	assert(data != NULL);
+
+	data->num_vtx = header->num_vtx;
+	data->pager = NULL; data->ws = NULL;
+	data->ckpt_addr = addr; data->ckpt_bytes = st.st_size;
+	data->root_map = root_map; data->pred_map = pred_map;
+	data->cost_map = (double*)(addr + offset[3]);
+	data->A = iftSICLE_CreateAdjRel(args, iftIs3DMImage(sicle->mimg));
+
+	data->seeds = iftCreateIdxArray(header->num_seeds); // Modified by removals
+	memcpy(data->seeds->val, seeds, header->num_seeds*sizeof(iftIdx));
+
+	data->cancelled = false; data->num_iters = header->num_iters; 
+	data->deadline = 0; data->cancel = NULL; data->cancel_data = NULL;
+	(*num_init) = header->num_init;
+
+	return data;
+}
+
+//============================================================================|
+// Batch
+//============================================================================|
+/*
+ * Creates an empty workspace, whose maps are allocated on demand.
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_Workspace *iftSICLE_CreateWorkspace
+()
+{
+	iftSICLE_Workspace *ws;
+
+	ws = malloc(sizeof(iftSICLE_Workspace));
+	assert(ws != NULL);
+
+	ws->capacity = 0;
+	ws->root_map = NULL; ws->pred_map = NULL; ws->cost_map = NULL;
+
+	return ws;
+}
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		ws[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyWorkspace
+(iftSICLE_Workspace **ws)
+{
+	free((*ws)->root_map);
+	free((*ws)->pred_map);
+	free((*ws)->cost_map);
+
+	free(*ws);
+	(*ws) = NULL;
+}
+
+/*
+ * Creates an empty bounded queue, shared by threads. It is closed once every
+ * producer is done.
+ *
+ * PARAMETERS:
+ *  capacity[in] - REQUIRED: Maximum number of queued items
+ *  num_producers[in] - REQUIRED: Number of producer threads
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_Queue *iftSICLE_CreateQueue
+(int capacity, int num_producers)
+{
+	iftSICLE_Queue *queue;
+
+	queue = malloc(sizeof(iftSICLE_Queue));
+	assert(queue != NULL);
+	queue->items = malloc(capacity * sizeof(void*));
+	assert(queue->items != NULL);
+
+	queue->capacity = capacity;
+	queue->head = 0; queue->num_items = 0;
+	queue->num_producers = num_producers;
+	pthread_mutex_init(&(queue->lock), NULL);
+	pthread_cond_init(&(queue->not_empty), NULL);
+	pthread_cond_init(&(queue->not_full), NULL);
+
+	return queue;
+}
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		queue[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyQueue
+(iftSICLE_Queue **queue)
+{
+	pthread_mutex_destroy(&((*queue)->lock));
+	pthread_cond_destroy(&((*queue)->not_empty));
+	pthread_cond_destroy(&((*queue)->not_full));
+	free((*queue)->items);
+
+	free(*queue);
+	(*queue) = NULL;
+}
+
+/*
+ * Pushes an item into the queue, waiting while it is full.
+ *
+ * PARAMETERS:
+ *  queue[in/out] - REQUIRED: Bounded queue
+ *  item[in] - REQUIRED: Item to be pushed
+ */
+void iftSICLE_PushQueue
+(iftSICLE_Queue *queue, void *item)
+{
+	pthread_mutex_lock(&(queue->lock));
+	while(queue->num_items == queue->capacity)
+	{ pthread_cond_wait(&(queue->not_full), &(queue->lock)); }
+
+	queue->items[(queue->head + queue->num_items) % queue->capacity] = item;
+	++queue->num_items;
+	pthread_cond_signal(&(queue->not_empty));
+	pthread_mutex_unlock(&(queue->lock));
+}
+
+/*
+ * Pops the oldest item of the queue, waiting while it is empty and any 
+ * producer may still push.
+ *
+ * PARAMETERS:
+ *  queue[in/out] - REQUIRED: Bounded queue
+ *
+ * RETURNS: Oldest item, or NULL if the queue is empty and closed
+ */
+void *iftSICLE_PopQueue
+(iftSICLE_Queue *queue)
+{
+	void *item;
+
+	pthread_mutex_lock(&(queue->lock));
+	while(queue->num_items == 0 && queue->num_producers > 0)
+	{ pthread_cond_wait(&(queue->not_empty), &(queue->lock)); }
+
+	item = NULL;
+	if(queue->num_items > 0)
+	{
+		item = queue->items[queue->head];
+		queue->head = (queue->head + 1) % queue->capacity;
+		--queue->num_items;
+		pthread_cond_signal(&(queue->not_full));
+	}
+	pthread_mutex_unlock(&(queue->lock));
+
+	return item;
+}
+
+/*
+ * Signals that a producer is done, waking up the consumers once the queue
+ * is closed.
+ *
+ * PARAMETERS:
+ *  queue[in/out] - REQUIRED: Bounded queue
+ */
+void iftSICLE_LeaveQueue
+(iftSICLE_Queue *queue)
+{
+	pthread_mutex_lock(&(queue->lock));
+	--queue->num_producers;
+	if(queue->num_producers == 0) 
+	{ pthread_cond_broadcast(&(queue->not_empty)); }
+	pthread_mutex_unlock(&(queue->lock));
+}
+
+/*
+ * Runs SICLE on the maps of a workspace. The seeds are sampled exclusively,
+ * from the generator's default seed, thus the result is the same as of a 
+ * single run, for any number of threads.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  args[in] - REQUIRED: Verified SICLE arguments
+ *  ws[in/out] - REQUIRED: Workspace of the calling thread
+ *  lock[in/out] - REQUIRED: Lock of the random generator
+ *
+ * RETURNS: Superspel segmentation, or NULL if it was cancelled
+ */
+iftImage *iftSICLE_RunInWorkspace
+(iftSICLE *sicle, iftSICLEArgs *args, iftSICLE_Workspace *ws, 
+ pthread_mutex_t *lock)
+{
+	iftImage *label_img;
+	iftSICLE_IFTData *data;
+
+	data = iftSICLE_AllocIFTData(sicle, args, ws);
+	pthread_mutex_lock(lock);
+	iftRandomSeed(1); // Default of the generator
+	iftSICLE_SampleSeeds(sicle, args, data);
+	pthread_mutex_unlock(lock);
+
+	data->cancel = args->cancel; 
+	data->cancel_data = args->cancel_data;
+	if(args->time_budget > 0) 
+	{ data->deadline = iftSICLE_GetWallTime() + args->time_budget; }
+	iftSICLE_RunSchedule(sicle, args, &data, NULL);
+
+	if(data->cancelled == false) 
+	{ label_img = iftSICLE_CreateLabelImage(sicle, data); }
+	else { label_img = NULL; }
+	iftSICLE_DestroyIFTData(&data);
+
+	return label_img;
+}
+
+/*
+ * Fills the output path of an image of the batch.
+ *
+ * PARAMETERS:
+ *  batch[in] - REQUIRED: Batch data
+ *  file_id[in] - REQUIRED: Index of the image within the batch
+ *  out_path[out] - REQUIRED: Buffer of IFT_STR_DEFAULT_SIZE chars
+ */
+void iftSICLE_GetBatchOutPath
+(const iftSICLE_Batch *batch, long file_id, char *out_path)
+{
+	const char *PATH;
+	char *name;
+
+	PATH = batch->files->files[file_id]->path;
+	name = iftFilename(PATH, iftFileExt(PATH));
+	snprintf(out_path, IFT_STR_DEFAULT_SIZE, batch->out_pattern, name);
+	free(name);
+}
+
+/*
+ * Computes the size and the FNV-1a hash of a file's contents.
+ *
+ * PARAMETERS:
+ *  path[in] - REQUIRED: Path to the file
+ *  num_bytes[out] - REQUIRED: Size (in bytes) of the file
+ *  hash[out] - REQUIRED: Hash of the file's bytes
+ *
+ * RETURNS: Whether the file could be read
+ */
+bool iftSICLE_HashFile
+(const char *path, long *num_bytes, ullong *hash)
+{
+	char buf[IFT_STR_DEFAULT_SIZE];
+	size_t size;
+	FILE *fp;
+
+	fp = fopen(path, "rb");
+	if(fp == NULL) { return false; }
+
+	(*num_bytes) = 0; (*hash) = 0xCBF29CE484222325ULL; // FNV offset basis
+	while((size = fread(buf, 1, IFT_STR_DEFAULT_SIZE, fp)) > 0)
+	{ (*num_bytes) += size; (*hash) = iftSICLE_HashBytes(*hash, buf, size); }
+	fclose(fp);
+
+	return true;
+}
+
+/*
+ * Compares two manifest entries by their outputs, for sorting and searching.
+ *
+ * PARAMETERS:
+ *  a[in] - REQUIRED: First entry
+ *  b[in] - REQUIRED: Second entry
+ *
+ * RETURNS: Negative, zero or positive, as strcmp
+ */
+int iftSICLE_CompareManifestEntries
+(const void *a, const void *b)
+{
+	return strcmp(((const iftSICLE_ManifestEntry*)a)->out_path, 
+								((const iftSICLE_ManifestEntry*)b)->out_path);
+}
+
+/*
+ * Loads the entries of a manifest, sorted by their outputs. Its lines are
+ * "input,output,bytes,hash,time", and incomplete lines (e.g., of a killed 
+ * run) are ignored.
+ *
+ * PARAMETERS:
+ *  path[in] - REQUIRED: Path to the manifest (which may not exist)
+ *  num_entries[out] - REQUIRED: Number of entries
+ *
+ * RETURNS: Array of entries, or NULL if none
+ */
+iftSICLE_ManifestEntry *iftSICLE_LoadManifest
+(const char *path, long *num_entries)
+{
+	char *line;
+	size_t line_size;
+	long capacity;
+	FILE *fp;
+	iftSICLE_ManifestEntry *entries;
+
+	(*num_entries) = 0;
+	fp = fopen(path, "r");
+	if(fp == NULL) { return NULL; }
+
+	capacity = 0; entries = NULL;
+	line = NULL; line_size = 0;
+	while(getline(&line, &line_size, fp) > 0)
+	{
+		char *in_path, *out_path, *bytes, *hash, *time, *end;
+
+		if(strchr(line, '\n') == NULL) { continue; } // Interrupted writing
+		in_path = strtok(line, ","); out_path = strtok(NULL, ",");
+		bytes = strtok(NULL, ","); hash = strtok(NULL, ",");
+		time = strtok(NULL, ",\n");
+		if(in_path == NULL || out_path == NULL || bytes == NULL || 
+			 hash == NULL || time == NULL) { continue; }
+
+		if((*num_entries) == capacity)
+		{
+			capacity = iftMax(64, 2 * capacity);
+			entries = realloc(entries, capacity * sizeof(iftSICLE_ManifestEntry));
+			assert(entries != NULL);
+		}
+		entries[*num_entries].num_bytes = strtol(bytes, &end, 10);
+		if(*end != '\0') { continue; }
+		entries[*num_entries].hash = strtoull(hash, &end, 16);
+		if(*end != '\0') { continue; }
+		entries[*num_entries].out_path = iftCopyString(out_path);
+		++(*num_entries);
+	}
+	free(line);
+	fclose(fp);
+
+	if((*num_entries) > 0)
+	{
+		qsort(entries, *num_entries, sizeof(iftSICLE_ManifestEntry), 
+					iftSICLE_CompareManifestEntries);
+	}
+
+	return entries;
+}
+
+/*
+ * Verifies whether an output was written by a previous run of the batch, 
+ * i.e., whether an entry of its manifest matches the output's current size
+ * and hash. Thus, missing, truncated or modified outputs are recomputed.
+ *
+ * PARAMETERS:
+ *  batch[in] - REQUIRED: Batch data
+ *  out_path[in] - REQUIRED: Path of the output
+ *
+ * RETURNS: Whether the output is valid
+ */
+bool iftSICLE_IsBatchOutputDone
+(const iftSICLE_Batch *batch, const char *out_path)
+{
+	long first, last, num_bytes;
+	ullong hash;
+	iftSICLE_ManifestEntry key, *found;
+
+	if(batch->num_done == 0) { return false; }
+
+	key.out_path = (char*)out_path;
+	found = bsearch(&key, batch->done, batch->num_done, 
+									sizeof(iftSICLE_ManifestEntry), iftSICLE_CompareManifestEntries);
+	if(found == NULL) { return false; }
+	if(iftSICLE_HashFile(out_path, &num_bytes, &hash) == false) { return false; }
+
+	// The output may have been recomputed, thus having many entries
+	first = last = found - batch->done;
+	while(first > 0 && 
+				strcmp(batch->done[first - 1].out_path, out_path) == 0) { --first; }
+	while(last < batch->num_done - 1 && 
+				strcmp(batch->done[last + 1].out_path, out_path) == 0) { ++last; }
+	for(long i = first; i <= last; ++i)
+	{
+		if(batch->done[i].num_bytes == num_bytes && batch->done[i].hash == hash)
+		{ return true; }
+	}
+
+	return false;
+}
+
+/*
+ * First stage of the batch: decodes the images until none is left, each 
+ * thread taking the next one once idle. Images whose outputs were kept from
+ * a previous run are skipped.
+ *
+ * PARAMETERS:
+ *  arg[in/out] - REQUIRED: Batch data
+ *
+ * RETURNS: NULL
+ */
+void *iftSICLE_RunBatchReader
+(void *arg)
+{
+	long file_id;
+	iftSICLE_Batch *batch;
+
+	batch = (iftSICLE_Batch*)arg;
+	do
+	{
+		pthread_mutex_lock(&(batch->lock));
+		file_id = batch->next++;
+		pthread_mutex_unlock(&(batch->lock));
+
+		if(file_id < batch->files->n && batch->num_done > 0)
+		{
+			char out_path[IFT_STR_DEFAULT_SIZE];
+
+			iftSICLE_GetBatchOutPath(batch, file_id, out_path);
+			if(iftSICLE_IsBatchOutputDone(batch, out_path) == true)
+			{ batch->times->val[file_id] = -1; continue; } // Kept from before
+		}
+
+		if(file_id < batch->files->n)
+		{
+			char msg[IFT_STR_DEFAULT_SIZE];
+			const char *path;
+			iftSICLE_BatchJob *job;
+
+			job = malloc(sizeof(iftSICLE_BatchJob));
+			assert(job != NULL);
+			job->file_id = file_id;
+			job->start = iftSICLE_GetWallTime();
+			job->sicle = NULL; job->segm = NULL;
+			path = batch->files->files[file_id]->path;
+			if(iftSICLE_CanReadImage(path, msg) == true)
+			{ job->sicle = iftReadSICLE(path, NULL, NULL); }
+			else { iftWarning("Skipping image: %s", __func__, msg); }
+			iftSICLE_PushQueue(batch->decoded, job);
+		}
+	} while(file_id < batch->files->n);
+	iftSICLE_LeaveQueue(batch->decoded);
+
+	return NULL;
+}
+
+/*
+ * Second stage of the batch: segments the decoded images, reusing the 
+ * thread's own workspace.
+ *
+ * PARAMETERS:
+ *  arg[in/out] - REQUIRED: Batch data
+ *
+ * RETURNS: NULL
+ */
+void *iftSICLE_RunBatchSegmenter
+(void *arg)
+{
+	iftSICLE_Batch *batch;
+	iftSICLE_BatchJob *job;
+	iftSICLE_Workspace *ws;
+
+	batch = (iftSICLE_Batch*)arg;
+	ws = iftSICLE_CreateWorkspace();
+	while((job = iftSICLE_PopQueue(batch->decoded)) != NULL)
+	{
+		char msg[IFT_STR_DEFAULT_SIZE];
+
+		if(job->sicle != NULL) // Otherwise, it failed to be read
+		{
+			if(iftSICLE_FindArgsError(job->sicle, batch->args, msg) == false)
+			{
+				job->segm = iftSICLE_RunInWorkspace(job->sicle, batch->args, ws, 
+																						&(batch->lock));
+			}
+			else
+			{ 
+				iftWarning("Skipping %s: %s", __func__, 
+									 batch->files->files[job->file_id]->path, msg);
+			}
+			iftDestroySICLE(&(job->sicle));
+		}
+		iftSICLE_PushQueue(batch->segmented, job);
+	}
+	iftSICLE_LeaveQueue(batch->segmented);
+	iftSICLE_DestroyWorkspace(&ws);
+
+	return NULL;
+}
+
+/*
+ * Third stage of the batch: encodes and writes the segmentations (if not
+ * cancelled), recording the time of each image and listing the written 
+ * outputs in the manifest.
+ *
+ * PARAMETERS:
+ *  arg[in/out] - REQUIRED: Batch data
+ *
+ * RETURNS: NULL
+ */
+void *iftSICLE_RunBatchWriter
+(void *arg)
+{
+	iftSICLE_Batch *batch;
+	iftSICLE_BatchJob *job;
+
+	batch = (iftSICLE_Batch*)arg;
+	while((job = iftSICLE_PopQueue(batch->segmented)) != NULL)
+	{
+		char out_path[IFT_STR_DEFAULT_SIZE];
+		long num_bytes;
+		ullong hash;
+
+		iftSICLE_GetBatchOutPath(batch, job->file_id, out_path);
+		if(job->segm != NULL)
+		{ 
+			iftWriteImageByExt(job->segm, "%s", out_path); 
+			batch->times->val[job->file_id] = iftSICLE_GetWallTime() - job->start;
+		}
+		else { batch->times->val[job->file_id] = -1; } // Failed or cancelled
+
+		// Listed once fully written (thus, as read back by a resumed run)
+		if(job->segm != NULL && batch->manifest != NULL && 
+			 iftSICLE_HashFile(out_path, &num_bytes, &hash) == true)
+		{
+			pthread_mutex_lock(&(batch->lock));
+			fprintf(batch->manifest, "%s,%s,%ld,%016llx,%.4f\n", 
+							batch->files->files[job->file_id]->path, out_path, num_bytes, 
+							hash, batch->times->val[job->file_id]);
+			fflush(batch->manifest);
+			pthread_mutex_unlock(&(batch->lock));
+		}
+		if(job->segm != NULL) { iftDestroyImage(&(job->segm)); }
+		free(job);
+	}
+
+	return NULL;
+}
+
+//============================================================================|
+// Daemon
+//============================================================================|
+/*
+ * Receives exactly the given number of bytes from a socket.
+ *
+ * PARAMETERS:
+ *  fd[in] - REQUIRED: Connected socket
+ *  buf[out] - REQUIRED: Buffer of, at least, the given size
+ *  size[in] - REQUIRED: Number of bytes
+ *
+ * RETURNS: Whether every byte was received
+ */
+bool iftSICLE_RecvAll
+(int fd, void *buf, size_t size)
+{
+	char *ptr;
+
+	ptr = (char*)buf;
+	while(size > 0)
+	{
+		ssize_t num_bytes;
+
+		num_bytes = recv(fd, ptr, size, 0);
+		if(num_bytes < 0 && errno == EINTR) { continue; }
+		if(num_bytes <= 0) { return false; } // Error or peer closed
+
+		ptr += num_bytes; size -= num_bytes;
+	}
+
+	return true;
+}
+
+/*
+ * Sends exactly the given number of bytes through a socket. A closed peer
+ * is reported, instead of raising SIGPIPE.
+ *
+ * PARAMETERS:
+ *  fd[in] - REQUIRED: Connected socket
+ *  buf[in] - REQUIRED: Buffer of, at least, the given size
+ *  size[in] - REQUIRED: Number of bytes
+ *
+ * RETURNS: Whether every byte was sent
+ */
+bool iftSICLE_SendAll
+(int fd, const void *buf, size_t size)
+{
+	const char *PTR;
+
+	PTR = (const char*)buf;
+	while(size > 0)
+	{
+		ssize_t num_bytes;
+
+		num_bytes = send(fd, PTR, size, MSG_NOSIGNAL);
+		if(num_bytes < 0 && errno == EINTR) { continue; }
+		if(num_bytes <= 0) { return false; }
+
+		PTR += num_bytes; size -= num_bytes;
+	}
+
+	return true;
+}
+
+/*
+ * Fills the address of a Unix domain socket.
+ *
+ * PARAMETERS:
+ *  socket_path[in] - REQUIRED: Path of the socket
+ *  addr[out] - REQUIRED: Socket address
+ *
+ * RETURNS: Whether the path fits in the address
+ */
+bool iftSICLE_SetSocketAddr
+(const char *socket_path, struct sockaddr_un *addr)
+{
+	if(strlen(socket_path) >= sizeof(addr->sun_path)) { return false; }
+
+	memset(addr, 0, sizeof(struct sockaddr_un));
+	addr->sun_family = AF_UNIX;
+	strcpy(addr->sun_path, socket_path);
+
+	return true;
+}
+
+/*
+ * Connects to the daemon's socket.
+ *
+ * PARAMETERS:
+ *  socket_path[in] - REQUIRED: Path of the socket
+ *
+ * RETURNS: Connected socket, or -1 if the daemon is not listening
+ */
+int iftSICLE_ConnectDaemon
+(const char *socket_path)
+{
+	int fd;
+	struct sockaddr_un addr;
+
+	if(iftSICLE_SetSocketAddr(socket_path, &addr) == false) { return -1; }
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0) { return -1; }
+	if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) 
+	{ close(fd); return -1; }
+
+	return fd;
+}
+
+/*
+ * Computes the size of an image within a shared memory object: its Y values
+ * followed, if colored, by its Cb and Cr values.
+ *
+ * PARAMETERS:
+ *  num_spels[in] - REQUIRED: Number of spels
+ *  is_color[in] - REQUIRED: Whether the image is colored
+ *
+ * RETURNS: Size (in bytes) of the object
+ */
+size_t iftSICLE_CalcShmSize
+(iftIdx num_spels, bool is_color)
+{
+	size_t size;
+
+	size = num_spels * sizeof(int);
+	if(is_color == true) { size += 2 * num_spels * sizeof(ushort); }
+
+	return size;
+}
+
+/*
+ * Creates a shared memory object of an unused name and maps it. The name 
+ * has the process' identifier, thus objects left by a crash are easily 
+ * told apart.
+ *
+ * PARAMETERS:
+ *  size[in] - REQUIRED: Size (in bytes) of the object
+ *  name[out] - REQUIRED: Buffer of IFT_STR_DEFAULT_SIZE chars for the name
+ *
+ * RETURNS: Writable mapping of the object, or NULL if it was not created
+ */
+void *iftSICLE_CreateShm
+(size_t size, char *name)
+{
+	static long num_created = 0;
+	int fd;
+	void *addr;
+
+	do
+	{
+		long k;
+
+		k = __atomic_fetch_add(&num_created, 1, __ATOMIC_RELAXED);
+		snprintf(name, IFT_STR_DEFAULT_SIZE, "/sicle_%d_%ld", (int)getpid(), k);
+		fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+	} while(fd < 0 && errno == EEXIST);
+	if(fd < 0) { return NULL; }
+
+	addr = MAP_FAILED;
+	if(ftruncate(fd, iftMax(size, 1)) == 0)
+	{ addr = mmap(NULL, iftMax(size, 1), PROT_WRITE, MAP_SHARED, fd, 0); }
+	close(fd);
+	if(addr == MAP_FAILED) { shm_unlink(name); return NULL; }
+
+	return addr;
+}
+
+/*
+ * Copies an image shared along a request (i.e., the image itself or one of
+ * its priors), whose domain is the request's one.
+ *
+ * PARAMETERS:
+ *  req[in] - REQUIRED: Request
+ *  name[in] - REQUIRED: Name of the shared memory object
+ *  is_color[in] - REQUIRED: Whether the Cb and Cr follow the Y
+ *  msg[out] - REQUIRED: Buffer of IFT_STR_DEFAULT_SIZE chars for the error
+ *
+ * RETURNS: Copy of the image, or NULL if the object is invalid
+ */
+iftImage *iftSICLE_ReadShmImage
+(const iftSICLE_Request *req, const char *name, bool is_color, char *msg)
+{
+	int fd;
+	size_t size;
+	iftIdx num_spels;
+	struct stat st;
+	void *addr;
+	iftImage *img;
+
+	if(req->xsize < 1 || req->ysize < 1 || req->zsize < 1 ||
+		 (long)req->xsize * req->ysize * req->zsize > IFT_INFINITY_INT)
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Invalid image domain\n"); 
+		return NULL; 
+	}
+	num_spels = (iftIdx)req->xsize * req->ysize * req->zsize;
+	size = iftSICLE_CalcShmSize(num_spels, is_color);
+
+	fd = shm_open(name, O_RDONLY, 0);
+	if(fd < 0)
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Could not open the shared image\n"); 
+		return NULL;
+	}
+	if(fstat(fd, &st) != 0 || (size_t)st.st_size < size)
+	{
+		close(fd);
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "The shared image is smaller than "
+						 "its domain\n");
+		return NULL;
+	}
+	addr = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(addr == MAP_FAILED)
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Could not map the shared image\n"); 
+		return NULL;
+	}
+
+	if(is_color == true) 
+	{ img = iftCreateColorImage(req->xsize, req->ysize, req->zsize, 8); }
+	else { img = iftCreateImage(req->xsize, req->ysize, req->zsize); }
+	memcpy(img->val, addr, num_spels * sizeof(int));
+	if(is_color == true)
+	{
+		const ushort *CB;
+
+		CB = (const ushort*)((const char*)addr + num_spels * sizeof(int));
+		memcpy(img->Cb, CB, num_spels * sizeof(ushort));
+		memcpy(img->Cr, CB + num_spels, num_spels * sizeof(ushort));
+	}
+	munmap(addr, size);
+
+	return img;
+}
+
+/*
+ * Shares an image along a request, through a new shared memory object (to be
+ * unlinked by the client once answered).
+ *
+ * PARAMETERS:
+ *  img[in] - REQUIRED: Image (or prior) to be shared
+ *  is_color[in] - REQUIRED: Whether its Cb and Cr are shared as well
+ *  name[out] - REQUIRED: Buffer of IFT_STR_DEFAULT_SIZE chars for the name
+ */
+void iftSICLE_ShareImage
+(const iftImage *img, bool is_color, char *name)
+{
+	size_t shm_size;
+	void *addr;
+
+	shm_size = iftSICLE_CalcShmSize(img->n, is_color);
+	addr = iftSICLE_CreateShm(shm_size, name);
+	if(addr == NULL) 
+	{ iftError("Could not share the image: %s", __func__, strerror(errno)); }
+	memcpy(addr, img->val, img->n * sizeof(int));
+	if(is_color == true)
+	{
+		ushort *cb;
+
+		cb = (ushort*)((char*)addr + img->n * sizeof(int));
+		memcpy(cb, img->Cb, img->n * sizeof(ushort));
+		memcpy(cb + img->n, img->Cr, img->n * sizeof(ushort));
+	}
+	munmap(addr, iftMax(shm_size, 1));
+}
+
+/*
+ * Reads the image file of a request along its priors, if any. Their domain
+ * is verified beforehand, for not aborting on a different one.
+ *
+ * PARAMETERS:
+ *  req[in] - REQUIRED: Request of the path kind, whose file may be read
+ *  objsm[in] - OPTIONAL: Grayscale object saliency map
+ *  mask[in] - OPTIONAL: Binary mask indicating the region of interest
+ *  msg[out] - REQUIRED: Buffer of IFT_STR_DEFAULT_SIZE chars for the error
+ *
+ * RETURNS: SICLE prototype, or NULL if the domains differ
+ */
+iftSICLE *iftSICLE_ReadRequestImage
+(const iftSICLE_Request *req, iftImage *objsm, iftImage *mask, char *msg)
+{
+	bool same_domain;
+	iftSICLE_PNM pnm;
+	iftSICLE *sicle;
+	iftImage *img;
+
+	if(objsm == NULL && mask == NULL) 
+	{ return iftReadSICLE(req->name, NULL, NULL); }
+
+	img = NULL;
+	if(iftSICLE_ParsePNMHeader(req->name, &pnm, msg) == true) 
+	{ 
+		free(pnm.path);
+		same_domain = pnm.xsize == req->xsize && pnm.ysize == req->ysize && 
+									req->zsize == 1;
+	}
+	else // Any other format, decoded as iftReadSICLE does
+	{ 
+		img = iftReadImageByExt(req->name); 
+		same_domain = img->xsize == req->xsize && img->ysize == req->ysize && 
+									img->zsize == req->zsize;
+	}
+
+	sicle = NULL;
+	if(same_domain == false)
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "The image and its mask/saliency have "
+						 "different domains\n"); 
+	}
+	else if(img != NULL) { sicle = iftCreateSICLE(img, objsm, mask); }
+	else { sicle = iftReadSICLE(req->name, objsm, mask); }
+	if(img != NULL) { iftDestroyImage(&img); }
+
+	return sicle;
+}
+
+/*
+ * Segments the image of a request, if valid. Its priors, if any, are shared
+ * by the client with the request's domain, which the image must have.
+ *
+ * PARAMETERS:
+ *  daemon[in/out] - REQUIRED: Daemon data
+ *  ws[in/out] - REQUIRED: Workspace of the calling thread
+ *  req[in/out] - REQUIRED: Request of the path or shared memory kind
+ *  fd[in] - REQUIRED: Connection of the request, with the Ni values to come
+ *  msg[out] - REQUIRED: Buffer of IFT_STR_DEFAULT_SIZE chars for the error
+ *
+ * RETURNS: Superspel segmentation, or NULL if the request is invalid
+ */
+iftImage *iftSICLE_SegmentRequest
+(iftSICLE_Daemon *daemon, iftSICLE_Workspace *ws, iftSICLE_Request *req, 
+ int fd, char *msg)
+{
+	iftSICLEArgs args;
+	iftSICLE *sicle;
+	iftImage *label_img, *objsm, *mask;
+
+	args = req->args;
+	args.ooc_path = NULL; args.cancel = NULL; args.cancel_data = NULL;
+	args.user_ni = NULL;
+	if(req->num_ni > 0)
+	{
+		args.user_ni = iftCreateIntArray(req->num_ni);
+		if(iftSICLE_RecvAll(fd, args.user_ni->val, 
+												req->num_ni * sizeof(int)) == false)
+		{
+			iftDestroyIntArray(&(args.user_ni));
+			snprintf(msg, IFT_STR_DEFAULT_SIZE, "Incomplete list of Ni values\n");
+			return NULL;
+		}
+	}
+
+	sicle = NULL; label_img = objsm = mask = NULL;
+	req->name[IFT_STR_DEFAULT_SIZE - 1] = '\0';
+	req->objsm_name[IFT_STR_DEFAULT_SIZE - 1] = '\0';
+	req->mask_name[IFT_STR_DEFAULT_SIZE - 1] = '\0';
+	if(req->objsm_name[0] != '\0') 
+	{ objsm = iftSICLE_ReadShmImage(req, req->objsm_name, false, msg); }
+	if(req->mask_name[0] != '\0') 
+	{ mask = iftSICLE_ReadShmImage(req, req->mask_name, false, msg); }
+
+	if(args.pyr_levels != 0)
+	{ snprintf(msg, IFT_STR_DEFAULT_SIZE, "Pyramid runs are not supported\n"); }
+	else if((req->objsm_name[0] != '\0' && objsm == NULL) ||
+					(req->mask_name[0] != '\0' && mask == NULL)) 
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Could not read the shared "
+						 "mask/saliency\n"); 
+	}
+	else if(req->kind == IFTSICLE_REQ_SHM) 
+	{
+		iftImage *img;
+
+		img = iftSICLE_ReadShmImage(req, req->name, req->is_color, msg);
+		if(img != NULL) 
+		{ sicle = iftCreateSICLE(img, objsm, mask); iftDestroyImage(&img); }
+	}
+	else if(iftFileExists(req->name) == false || 
+					iftIsImageFile(req->name) == false)
+	{ 
+		snprintf(msg, IFT_STR_DEFAULT_SIZE, "Unknown image file in the daemon's "
+						 "file system\n"); 
+	}
+	else if(iftSICLE_CanReadImage(req->name, msg) == true) 
+	{ sicle = iftSICLE_ReadRequestImage(req, objsm, mask, msg); }
+
+	if(sicle != NULL)
+	{
+		if(iftSICLE_FindArgsError(sicle, &args, msg) == false)
+		{
+			label_img = iftSICLE_RunInWorkspace(sicle, &args, ws, &(daemon->lock));
+			if(label_img == NULL) 
+			{ snprintf(msg, IFT_STR_DEFAULT_SIZE, "The run was cancelled\n"); }
+		}
+		iftDestroySICLE(&sicle);
+	}
+	if(objsm != NULL) { iftDestroyImage(&objsm); }
+	if(mask != NULL) { iftDestroyImage(&mask); }
+	if(args.user_ni != NULL) { iftDestroyIntArray(&(args.user_ni)); }
+
+	return label_img;
+}
+
+/*
+ * Serves a connection: receives its request, and replies with the shared 
+ * memory object of the labels (to be unlinked by the client) or an error.
+ * An invalid request never stops the daemon.
+ *
+ * PARAMETERS:
+ *  daemon[in/out] - REQUIRED: Daemon data
+ *  ws[in/out] - REQUIRED: Workspace of the calling thread
+ *  fd[in] - REQUIRED: Connection, which is closed
+ */
+void iftSICLE_ServeRequest
+(iftSICLE_Daemon *daemon, iftSICLE_Workspace *ws, int fd)
+{
+	iftSICLE_Request *req;
+	iftSICLE_Response *resp;
+
+	req = malloc(sizeof(iftSICLE_Request));
+	resp = calloc(1, sizeof(iftSICLE_Response));
+	assert(req != NULL); assert(resp != NULL);
+
+	if(iftSICLE_RecvAll(fd, req, sizeof(iftSICLE_Request)) == false)
+	{ free(req); free(resp); close(fd); return; } // Nobody to reply to
+
+	resp->ok = false;
+	if(memcmp(req->magic, IFTSICLE_DAEMON_MAGIC, 8) != 0 || 
+		 req->args_size != (int)sizeof(iftSICLEArgs) || req->num_ni < 0)
+	{ 
+		snprintf(resp->name, IFT_STR_DEFAULT_SIZE, "Request of another version "
+						 "of SICLE\n"); 
+	}
+	else if(req->num_ni > IFTSICLE_DAEMON_MAX_NI)
+	{
+		snprintf(resp->name, IFT_STR_DEFAULT_SIZE, "Too many Ni values. There "
+						 "must be at most %d\n", IFTSICLE_DAEMON_MAX_NI);
+	}
+	else if(req->kind == IFTSICLE_REQ_STOP)
+	{
+		pthread_mutex_lock(&(daemon->lock));
+		daemon->stopping = true;
+		shutdown(daemon->listen_fd, SHUT_RDWR); // Wakes up the accepting loop
+		pthread_mutex_unlock(&(daemon->lock));
+		resp->ok = true;
+	}
+	else if(req->kind == IFTSICLE_REQ_PATH || req->kind == IFTSICLE_REQ_SHM)
+	{
+		iftImage *label_img;
+
+		label_img = iftSICLE_SegmentRequest(daemon, ws, req, fd, resp->name);
+		if(label_img != NULL)
+		{
+			int *labels;
+
+			labels = iftSICLE_CreateShm(label_img->n * sizeof(int), resp->name);
+			if(labels != NULL)
+			{
+				memcpy(labels, label_img->val, label_img->n * sizeof(int));
+				munmap(labels, iftMax(label_img->n * sizeof(int), 1));
+				resp->xsize = label_img->xsize; resp->ysize = label_img->ysize;
+				resp->zsize = label_img->zsize; resp->ok = true;
+			}
+			else 
+			{ 
+				snprintf(resp->name, IFT_STR_DEFAULT_SIZE, "Could not share the "
+								 "labels\n"); 
+			}
+			iftDestroyImage(&label_img);
+		}
+	}
+	else 
+	{ snprintf(resp->name, IFT_STR_DEFAULT_SIZE, "Unknown kind of request\n"); }
+
+	// If the client is gone, its labels are not leaked
+	if(iftSICLE_SendAll(fd, resp, sizeof(iftSICLE_Response)) == false &&
+		 resp->ok == true && req->kind != IFTSICLE_REQ_STOP) 
+	{ shm_unlink(resp->name); }
+	close(fd);
+	free(req); free(resp);
+}
+
+/*
+ * Worker of the daemon: serves the accepted connections until the daemon 
+ * stops, reusing the thread's own workspace.
+ *
+ * PARAMETERS:
+ *  arg[in/out] - REQUIRED: Daemon data
+ *
+ * RETURNS: NULL
+ */
+void *iftSICLE_RunDaemonWorker
+(void *arg)
+{
+	int *fd;
+	iftSICLE_Daemon *daemon;
+	iftSICLE_Workspace *ws;
+
+	daemon = (iftSICLE_Daemon*)arg;
+	ws = iftSICLE_CreateWorkspace();
+	while((fd = iftSICLE_PopQueue(daemon->conns)) != NULL)
+	{
+		iftSICLE_ServeRequest(daemon, ws, *fd);
+		free(fd);
+	}
+	iftSICLE_DestroyWorkspace(&ws);
+
+	return NULL;
+}
+
+/*
+ * Sends a request to the daemon and receives its response.
+ *
+ * PARAMETERS:
+ *  socket_path[in] - REQUIRED: Path of the daemon's socket
+ *  req[in] - REQUIRED: Request
+ *  ni[in] - OPTIONAL: Ni values of the request (num_ni of them)
+ *  resp[out] - REQUIRED: Response
+ */
+void iftSICLE_SendRequest
+(const char *socket_path, const iftSICLE_Request *req, const int *ni,
+ iftSICLE_Response *resp)
+{
+	int fd;
+
+	fd = iftSICLE_ConnectDaemon(socket_path);
+	if(fd < 0) 
+	{ iftError("No SICLE daemon is listening at %s", __func__, socket_path); }
+
+	if(iftSICLE_SendAll(fd, req, sizeof(iftSICLE_Request)) == false)
+	{ close(fd); iftError("The SICLE daemon closed the connection", __func__); }
+	// If rejected (e.g., too many), the Ni values are not read by the daemon
+	if(req->num_ni > 0) { iftSICLE_SendAll(fd, ni, req->num_ni * sizeof(int)); }
+	if(iftSICLE_RecvAll(fd, resp, sizeof(iftSICLE_Response)) == false)
+	{ close(fd); iftError("The SICLE daemon closed the connection", __func__); }
+	close(fd);
+
+	resp->name[IFT_STR_DEFAULT_SIZE - 1] = '\0';
+}
+
+//============================================================================|
+// Color
+//============================================================================|
+/*
+ * Creates the tables for converting RGB colors to Lab. For 8-bit colors, the 
+ * white-normalized XYZ contribution of every channel value is tabulated, 
+ * replacing the matrix product by three sums.
+ *
+ * PARAMETERS:
+ *  norm_val[in] - REQUIRED: Maximum channel value (e.g., 255)
+ *
+ * RETURNS: Instance of the object
+ */
+iftSICLE_LabLUT *iftSICLE_CreateLabLUT
+(int norm_val)
+{
+	const double RGB2XYZ[3][3] = { // As in iftRGBtoLab, per white point
+		{0.4123955889674142161 / WHITEPOINT_X, 0.3575834307637148171 / WHITEPOINT_X,
+		 0.1804926473817015735 / WHITEPOINT_X},
+		{0.2125862307855955516 / WHITEPOINT_Y, 0.7151703037034108499 / WHITEPOINT_Y,
+		 0.07220049864333622685 / WHITEPOINT_Y},
+		{0.01929721549174694484 / WHITEPOINT_Z, 0.1191838645808485318 / WHITEPOINT_Z,
+		 0.9504971251315797660 / WHITEPOINT_Z}};
+	iftSICLE_LabLUT *lut;
+
+	lut = malloc(sizeof(iftSICLE_LabLUT));
+	assert(lut != NULL);
+
+	lut->norm_val = norm_val;
+	lut->xyz = NULL;
+	if(norm_val <= 255)
+	{
+		lut->xyz = malloc(3 * (norm_val + 1) * 3 * sizeof(float));
+		assert(lut->xyz != NULL);
+
+		for(int c = 0; c < 3; ++c)
+		{
+			for(int v = 0; v <= norm_val; ++v)
+			{
+				for(int k = 0; k < 3; ++k)
+				{ 
+					lut->xyz[(c * (norm_val + 1) + v) * 3 + k] = 
+						RGB2XYZ[k][c] * v / norm_val; 
+				}
+			}
+		}
+	}
+
+	return lut;
+}
+
+/*
+ * Deallocates the respective object 
+ *
+ * PARAMETERS:
+ *		lut[in/out] - REQUIRED: Pointer to the object to be free'd
+ */
+void iftSICLE_DestroyLabLUT
+(iftSICLE_LabLUT **lut)
+{
+	if((*lut)->xyz != NULL) { free((*lut)->xyz); }
+	free(*lut);
+	(*lut) = NULL;
+}
+
+/*
+ * Computes the Lab non-linearity of iftRGBtoLab (i.e., LABF), replacing the 
+ * cube root by an exponent-based estimate refined by two Newton steps. Its 
+ * relative error is below 1e-6 within [0,1].
+ *
+ * PARAMETERS:
+ *  t[in] - REQUIRED: White-normalized X, Y or Z (i.e., within [0,1])
+ *
+ * RETURNS: Non-linear value
+ */
+static inline float iftSICLE_LabF
+(float t)
+{
+	union { float f; uint32_t i; } cbrt;
+	float y;
+
+	if(t < 8.85645167903563082e-3f) { return (841.0f/108.0f) * t + (4.0f/29.0f); }
+
+	cbrt.f = t;
+	cbrt.i = cbrt.i / 3 + 709921077; // Exponent divided by three
+	y = cbrt.f;
+	y = (2.0f * y + t / (y * y)) / 3.0f;
+	y = (2.0f * y + t / (y * y)) / 3.0f;
+
+	return y;
+}
+
+/*
+ * Converts an RGB color to Lab, as iftRGBtoLab does. The maximum deviation 
+ * from it is below 0.001 (Delta E 1976) for every 8-bit color.
+ *
+ * PARAMETERS:
+ *  lut[in] - REQUIRED: Conversion tables of the color's bit depth
+ *  rgb[in] - REQUIRED: RGB color, within [0,lut->norm_val]
+ *  lab[out] - REQUIRED: L, a and b values
+ */
+static inline void iftSICLE_RGBtoLab
+(const iftSICLE_LabLUT *lut, iftColor rgb, float *lab)
+{
+	float xyz[3];
+
+	if(lut->xyz != NULL)
+	{
+		const float *R, *G, *B;
+
+		R = lut->xyz + rgb.val[0] * 3;
+		G = lut->xyz + (lut->norm_val + 1 + rgb.val[1]) * 3;
+		B = lut->xyz + (2 * (lut->norm_val + 1) + rgb.val[2]) * 3;
+		for(int k = 0; k < 3; ++k) { xyz[k] = R[k] + G[k] + B[k]; }
+	}
+	else
+	{
+		float r, g, b;
+
+		r = rgb.val[0] / (float)lut->norm_val;
+		g = rgb.val[1] / (float)lut->norm_val;
+		b = rgb.val[2] / (float)lut->norm_val;
+		xyz[0] = (0.4123955889674142161f*r + 0.3575834307637148171f*g + 
+							0.1804926473817015735f*b) / (float)WHITEPOINT_X;
+		xyz[1] = (0.2125862307855955516f*r + 0.7151703037034108499f*g + 
+							0.07220049864333622685f*b) / (float)WHITEPOINT_Y;
+		xyz[2] = (0.01929721549174694484f*r + 0.1191838645808485318f*g + 
+							0.9504971251315797660f*b) / (float)WHITEPOINT_Z;
+	}
+
+	for(int k = 0; k < 3; ++k) { xyz[k] = iftSICLE_LabF(xyz[k]); }
+	lab[0] = 116.0f * xyz[1] - 16.0f;
+	lab[1] = 500.0f * (xyz[0] - xyz[1]);
+	lab[2] = 200.0f * (xyz[1] - xyz[2]);
+}
+
+/*
+ * Converts an image to the SICLE spel features (i.e., gray or Lab), as 
+ * iftImageToMImage does, but with the tabulated Lab conversion.
+ *
+ * PARAMETERS:
+ *  img[in] - REQUIRED: Gray or YCbCr image
+ *
+ * RETURNS: Spel features
+ */
+iftMImage *iftSICLE_ImageToFeats
+(iftImage *img)
+{
+	int norm_val;
+	iftMImage *mimg;
+	iftSICLE_LabLUT *lut;
+
+	if(iftIsColorImage(img) == false) { return iftImageToMImage(img, GRAY_CSPACE); }
+
+	norm_val = iftNormalizationValue(iftMaximumValue(img));
+	mimg = iftCreateMImage(img->xsize, img->ysize, img->zsize, 3);
+	lut = iftSICLE_CreateLabLUT(norm_val);
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx v_index = 0; v_index < mimg->n; ++v_index)
+	{
+		iftColor ycbcr;
+
+		ycbcr.val[0] = img->val[v_index];
+		ycbcr.val[1] = img->Cb[v_index];
+		ycbcr.val[2] = img->Cr[v_index];
+		iftSICLE_RGBtoLab(lut, iftYCbCrtoRGB(ycbcr, norm_val), mimg->val[v_index]);
+	}
+	iftSICLE_DestroyLabLUT(&lut);
+
+	return mimg;
+}
+
+//============================================================================|
+// Buffer
+//============================================================================|
+/*
+ * Gets a channel of a buffer's spel, regardless of its alignment.
+ *
+ * PARAMETERS:
+ *  spel[in] - REQUIRED: First channel of the spel
+ *  dtype[in] - REQUIRED: Type of the channels
+ *  channel[in] - REQUIRED: Index of the channel
+ *
+ * RETURNS: Value of the channel
+ */
+float iftSICLE_GetBufferValue
+(const char *spel, iftSICLEDType dtype, int channel)
+{
+	if(dtype == IFT_SICLE_DTYPE_UINT8) { return ((const uchar*)spel)[channel]; }
+	else if(dtype == IFT_SICLE_DTYPE_UINT16)
+	{
+		ushort val;
+
+		memcpy(&val, spel + channel * sizeof(ushort), sizeof(ushort));
+		return val;
+	}
+	else if(dtype == IFT_SICLE_DTYPE_INT32)
+	{
+		int val;
+
+		memcpy(&val, spel + channel * sizeof(int), sizeof(int));
+		return val;
+	}
+	else
+	{
+		float val;
+
+		memcpy(&val, spel + channel * sizeof(float), sizeof(float));
+		return val;
+	}
+}
+
+/*
+ * Creates the SICLE prototype of a buffer, computing the spel features 
+ * straight from it, in parallel by rows.
+ *
+ * PARAMETERS:
+ *  in[in] - REQUIRED: Gray, RGB, BGR or Lab (float only) spels
+ *
+ * RETURNS: SICLE prototype, without mask or saliency
+ */
+iftSICLE *iftSICLE_CreateFromBuffer
+(const iftSICLEBuffer *in)
+{
+	int num_feats, num_rows, norm_val;
+	iftSICLE *sicle;
+	iftSICLE_LabLUT *lut;
+
+	sicle = malloc(sizeof(iftSICLE));
+	assert(sicle != NULL);
+
+	num_feats = (in->cspace == IFT_SICLE_CSPACE_GRAY) ? 1 : 3;
+	sicle->mimg = iftCreateMImage(in->xsize, in->ysize, in->zsize, num_feats);
+	sicle->roi = NULL; sicle->sal = NULL;
+	sicle->feats_mmap = NULL; sicle->sal_mmap = NULL; 
+	sicle->roi_mmap = NULL;
+
+	// Floats are quantized as 16-bit values, as the RGB-to-Lab conversion
+	norm_val = (in->dtype == IFT_SICLE_DTYPE_UINT8) ? 255 : 65535;
+	lut = iftSICLE_CreateLabLUT(norm_val);
+	num_rows = in->ysize * in->zsize;
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(int r = 0; r < num_rows; ++r)
+	{
+		const char *ROW;
+		iftIdx v_index;
+
+		ROW = (const char*)in->data + (r / in->ysize) * in->slice_stride + 
+					(r % in->ysize) * in->row_stride;
+		v_index = (iftIdx)r * in->xsize;
+		for(int x = 0; x < in->xsize; ++x, ++v_index)
+		{
+			const char *SPEL;
+			float *feats;
+
+			SPEL = ROW + x * in->pixel_stride;
+			feats = iftSICLE_GetFeats(sicle, v_index);
+			if(in->cspace == IFT_SICLE_CSPACE_GRAY) // Same as the gray images
+			{ 
+				feats[0] = iftSICLE_GetBufferValue(SPEL, in->dtype, 0);
+				if(in->dtype == IFT_SICLE_DTYPE_FLOAT32) { feats[0] *= 255.0; }
+			}
+			else if(in->cspace == IFT_SICLE_CSPACE_LAB)
+			{
+				for(int c = 0; c < 3; ++c)
+				{ feats[c] = iftSICLE_GetBufferValue(SPEL, in->dtype, c); }
+			}
+			else
+			{
+				iftColor rgb;
+
+				for(int c = 0; c < 3; ++c)
+				{
+					float val;
+
+					val = iftSICLE_GetBufferValue(SPEL, in->dtype, c);
+					if(in->dtype == IFT_SICLE_DTYPE_FLOAT32) 
+					{ val = iftRound(iftMin(iftMax(val, 0.0), 1.0) * norm_val); }
+					// BGR is reversed
+					if(in->cspace == IFT_SICLE_CSPACE_BGR) { rgb.val[2 - c] = val; }
+					else { rgb.val[c] = val; }
+				}
+				iftSICLE_RGBtoLab(lut, rgb, feats);
+			}
+		}
+	}
+	iftSICLE_DestroyLabLUT(&lut);
+
+	return sicle;
+}
+
+/*
+ * Writes the labels of the forest (within [1,N]) straight into a buffer.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype of the buffer's domain
+ *  data[in] - REQUIRED: IFT auxiliary data
+ *  labels[out] - REQUIRED: Gray INT32 or UINT16 buffer
+ */
+void iftSICLE_WriteBufferLabels
+(iftSICLE *sicle, iftSICLE_IFTData *data, iftSICLEBuffer *labels)
+{
+	int num_rows;
+
+	num_rows = labels->ysize * labels->zsize;
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(int r = 0; r < num_rows; ++r)
+	{
+		char *row;
+		iftIdx v_index;
+
+		row = (char*)labels->data + (r / labels->ysize) * labels->slice_stride + 
+					(r % labels->ysize) * labels->row_stride;
+		v_index = (iftIdx)r * labels->xsize;
+		for(int x = 0; x < labels->xsize; ++x, ++v_index)
+		{
+			int label;
+
+			label = iftSICLE_GetRootLabel(data, v_index) + 1;
+			if(labels->dtype == IFT_SICLE_DTYPE_INT32)
+			{ memcpy(row + x * labels->pixel_stride, &label, sizeof(int)); }
+			else
+			{
+				ushort val;
+
+				val = label;
+				memcpy(row + x * labels->pixel_stride, &val, sizeof(ushort));
+			}
+		}
+	}
+}
+
+//============================================================================|
+// Decode
+//============================================================================|
+/*
+ * Verifies if a file is a binary PNM (P5 or P6), whose samples may be decoded
+ * straight into the spel features.
+ *
+ * PARAMETERS:
+ *  path[in] - REQUIRED: Image path
+ *
+ * RETURNS: Whether it is a binary PGM or PPM file
+ */
+bool iftSICLE_IsBinaryPNM
+(const char *path)
+{
+	char magic[2];
+	FILE *fp;
+
+	fp = fopen(path, "rb");
+	if(fp == NULL) { iftError(MSG_FILE_OPEN_ERROR, __func__, path); }
+	if(fread(magic, 1, 2, fp) != 2) { magic[0] = '\0'; }
+	fclose(fp);
+
+	return magic[0] == 'P' && (magic[1] == '5' || magic[1] == '6');
+}
+
+/*
+ * Creates a multiband image whose features are a memory mapped file within 
+ * the given directory, without row tables (see iftSICLE_GetFeats). Thus, 
+ * none of its spel-wise data is resident.
+ *
+ * PARAMETERS:
+ *  xsize, ysize, zsize[in] - REQUIRED: Image dimensions
+ *  num_feats[in] - REQUIRED: Number of features per spel
+ *  dir[in] - REQUIRED: Directory of the backing file
+ *  feats_mmap[out] - REQUIRED: Mapping of the features
+ *
+ * RETURNS: Multiband image, whose features must not be free'd
+ */
+iftMImage *iftSICLE_CreateMappedMImage
+(int xsize, int ysize, int zsize, int num_feats, const char *dir,
+ iftSICLE_MMap **feats_mmap)
+{
+	iftMImage *mimg;
+
+	mimg = iftAlloc(1, sizeof(iftMImage));
+	mimg->data = iftAlloc(1, sizeof(iftMatrix));
+	mimg->tby = iftAlloc(ysize, sizeof(iftIdx));
+	mimg->tbz = iftAlloc(zsize, sizeof(iftIdx));
+	assert(mimg != NULL && mimg->data != NULL);
+	assert(mimg->tby != NULL && mimg->tbz != NULL);
+
+	mimg->xsize = xsize; mimg->ysize = ysize; mimg->zsize = zsize;
+	mimg->dx = mimg->dy = mimg->dz = 1.0;
+	mimg->n = (iftIdx)xsize * ysize * zsize;
+	mimg->m = num_feats;
+	mimg->val = NULL;
+	for(int y = 1; y < ysize; ++y) { mimg->tby[y] = mimg->tby[y-1] + xsize; }
+	for(int z = 1; z < zsize; ++z) 
+	{ mimg->tbz[z] = mimg->tbz[z-1] + (iftIdx)xsize * ysize; }
+
+	(*feats_mmap) = iftSICLE_CreateMMap(dir, (long)mimg->n * num_feats, 
+																			sizeof(float));
+	mimg->data->nrows = mimg->n;
+	mimg->data->ncols = num_feats;
+	mimg->data->n = (long)mimg->n * num_feats;
+	mimg->data->val = (*feats_mmap)->addr;
+	mimg->data->tbrow = NULL;
+	mimg->data->allocated = false; // Must not be free'd by iftDestroyMatrix
+
+	return mimg;
+}
+
+/*
+ * Creates the SICLE prototype of a binary PNM file, decoding its samples 
+ * straight into the spel features (i.e., gray or Lab). The file is read by 
+ * blocks of rows, whose conversion is done in parallel. Unlike 
+ * iftReadImageByExt followed by iftCreateSICLE, the colors are not stored as
+ * YCbCr in-between. If a directory is given, the features are decoded into
+ * a memory mapped file within it, and each block is evicted once decoded.
+ *
+ * PARAMETERS:
+ *  pnm[in] - REQUIRED: PNM file header
+ *  dir[in] - OPTIONAL: Out-of-core directory (NULL = in-core)
+ *
+ * RETURNS: SICLE prototype, without mask or saliency
+ */
+iftSICLE *iftSICLE_DecodePNM
+(iftSICLE_PNM *pnm, const char *dir)
+{
+	int num_chans, norm_val;
+	size_t row_bytes;
+	unsigned char *block;
+	FILE *fp;
+	iftSICLE *sicle;
+	iftSICLE_LabLUT *lut;
+
+	fp = fopen(pnm->path, "rb");
+	if(fp == NULL) { iftError(MSG_FILE_OPEN_ERROR, __func__, pnm->path); }
+	if(fseeko(fp, pnm->offset, SEEK_SET) != 0)
+	{ iftError("Reading error", __func__); }
+
+	sicle = malloc(sizeof(iftSICLE));
+	assert(sicle != NULL);
+
+	num_chans = (pnm->is_color == true) ? 3 : 1;
+	sicle->roi = NULL; sicle->sal = NULL;
+	sicle->feats_mmap = NULL; sicle->sal_mmap = NULL; 
+	sicle->roi_mmap = NULL;
+	if(dir == NULL) 
+	{ sicle->mimg = iftCreateMImage(pnm->xsize, pnm->ysize, 1, num_chans); }
+	else
+	{
+		sicle->mimg = iftSICLE_CreateMappedMImage(pnm->xsize, pnm->ysize, 1, 
+																							num_chans, dir, 
+																							&(sicle->feats_mmap));
+	}
+
+	// The Lab conversion is normalized by the bit depth (e.g., 255 for 8 bits),
+	// and not by the image's maximum value as in iftImageToMImage
+	norm_val = (1 << (int)ceil(iftLog(pnm->max_val, 2))) - 1;
+	if(pnm->val_bytes == 1) { norm_val = 255; }
+	lut = iftSICLE_CreateLabLUT(norm_val);
+
+	row_bytes = (size_t)pnm->xsize * num_chans * pnm->val_bytes;
+	block = malloc(row_bytes * IFTSICLE_DECODE_ROWS);
+	assert(block != NULL);
+
+	for(int y0 = 0; y0 < pnm->ysize; y0 += IFTSICLE_DECODE_ROWS)
+	{
+		int num_rows;
+
+		num_rows = iftMin(IFTSICLE_DECODE_ROWS, pnm->ysize - y0);
+		if(fread(block, row_bytes, num_rows, fp) != (size_t)num_rows)
+		{ iftError("Reading error", __func__); }
+
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for
+		#endif //-----------------------------------------------------------------|
+		for(int r = 0; r < num_rows; ++r)
+		{
+			const unsigned char *ROW;
+			iftIdx v_index;
+
+			ROW = block + r * row_bytes;
+			v_index = (iftIdx)(y0 + r) * pnm->xsize;
+			for(int x = 0; x < pnm->xsize; ++x, ++v_index)
+			{
+				int vals[3];
+				float *feats;
+
+				for(int c = 0; c < num_chans; ++c)
+				{
+					size_t i;
+
+					i = ((size_t)x * num_chans + c) * pnm->val_bytes;
+					if(pnm->val_bytes == 1) { vals[c] = ROW[i]; }
+					else { vals[c] = (ROW[i] << 8) + ROW[i + 1]; } // Big-endian
+				}
+
+				feats = iftSICLE_GetFeats(sicle, v_index);
+				if(pnm->is_color == false) { feats[0] = vals[0]; }
+				else
+				{
+					iftColor rgb;
+
+					rgb.val[0] = vals[0]; rgb.val[1] = vals[1]; rgb.val[2] = vals[2];
+					iftSICLE_RGBtoLab(lut, rgb, feats);
+				}
+			}
+		}
+
+		if(sicle->feats_mmap != NULL) // Out-of-core: only the current block
+		{
+			iftSICLE_EvictMMap(sicle->feats_mmap, (long)y0 * pnm->xsize * num_chans,
+												 (long)num_rows * pnm->xsize * num_chans);
+		}
+	}
+
+	free(block);
+	iftSICLE_DestroyLabLUT(&lut);
+	fclose(fp);
+	return sicle;
+}
+
+/*
+ * Sets the region of interest and the normalized object saliency of a 
+ * prototype, verifying their domains. A saliency already set (e.g., mapped 
+ * from the cache) is kept.
+ *
+ * PARAMETERS:
+ *  sicle[in/out] - REQUIRED: SICLE prototype, without mask
+ *  objsm[in] - OPTIONAL: Grayscale object saliency map
+ *  mask[in] - OPTIONAL: Binary mask indication the region of interest
+ */
+void iftSICLE_SetPriors
+(iftSICLE *sicle, iftImage *objsm, iftImage *mask)
+{
+	iftImage *prior;
+
+	prior = (objsm != NULL) ? objsm : mask;
+	if(prior != NULL && (prior->xsize != sicle->mimg->xsize || 
+											 prior->ysize != sicle->mimg->ysize ||
+											 prior->zsize != sicle->mimg->zsize))
+	{ iftError("The image and its mask/saliency have different domains", __func__); }
+	if(objsm != NULL && mask != NULL) { iftVerifyImageDomains(objsm, mask, __func__); }
+
+	if(mask != NULL) { sicle->roi = iftBinImageToBMap(mask); }
+	else { sicle->roi = NULL; }
+
+	if(objsm != NULL && sicle->sal == NULL)
+	{
+		int max_sal;
+
+		sicle->sal = calloc(sicle->mimg->n, sizeof(float));
+		assert(sicle->sal);
+
+		max_sal = 0;
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for reduction(+:max_sal)
+		#endif //-----------------------------------------------------------------|
+		for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+		{ max_sal = iftMax(max_sal, objsm->val[v_index]); }
+
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for
+		#endif //-----------------------------------------------------------------|
+		for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+		{ sicle->sal[v_index] = (float)objsm->val[v_index]/max_sal; } // Norm [0,1]
+	}
+}
+
+//============================================================================|
+// Cache
+//============================================================================|
+/*
+ * Computes the key of the features of an image within the cache, by hashing 
+ * the contents of its file (or of its video folder's frames) and of its 
+ * saliency map. Any change on them thus leads to a different key.
+ *
+ * PARAMETERS:
+ *  img_path[in] - REQUIRED: Path of the image or video folder
+ *  objsm[in] - OPTIONAL: Grayscale object saliency map
+ *
+ * RETURNS: Key of the features
+ */
+ullong iftSICLE_GetCacheKey
+(const char *img_path, iftImage *objsm)
+{
+	int version;
+	long num_bytes;
+	ullong key, hash;
+	iftFileSet *files;
+
+	version = IFTSICLE_CACHE_VERSION;
+	key = iftSICLE_HashBytes(0xCBF29CE484222325ULL, IFTSICLE_CACHE_MAGIC, 8);
+	key = iftSICLE_HashBytes(key, &version, sizeof(int));
+
+	if(iftDirExists(img_path) == true) // Every frame, in reading order
+	{ files = iftLoadFileSetFromDirOrCSV(img_path, 0, true); }
+	else { files = NULL; }
+
+	for(long i = 0; i < ((files != NULL) ? files->n : 1); ++i)
+	{
+		const char *PATH;
+
+		PATH = (files != NULL) ? files->files[i]->path : img_path;
+		if(iftSICLE_HashFile(PATH, &num_bytes, &hash) == false)
+		{ iftError(MSG_FILE_OPEN_ERROR, __func__, PATH); }
+		key = iftSICLE_HashBytes(key, &hash, sizeof(ullong));
+	}
+	if(files != NULL) { iftDestroyFileSet(&files); }
+
+	if(objsm != NULL)
+	{ key = iftSICLE_HashBytes(key, objsm->val, objsm->n * sizeof(int)); }
+
+	return key;
+}
+
+/*
+ * Writes the features and the saliency of a prototype into the cache, as a 
+ * header followed by the page-aligned arrays, laid out as in memory. The file
+ * is written under a temporary name and then renamed, so concurrent runs never
+ * map a partial file. Failures are only warned, since the cache is optional.
+ *
+ * PARAMETERS:
+ *  sicle[in] - REQUIRED: SICLE prototype
+ *  dir[in] - REQUIRED: Cache directory
+ *  key[in] - REQUIRED: Key of the features
+ */
+void iftSICLE_WriteCache
+(iftSICLE *sicle, const char *dir, ullong key)
+{
+	bool ok;
+	int fd;
+	long page_size, feats_bytes;
+	char *tmp_path, *path;
+	FILE *fp;
+	iftSICLE_CacheHeader header;
+
+	page_size = sysconf(_SC_PAGESIZE);
+	feats_bytes = sicle->mimg->data->n * sizeof(float);
+
+	memset(&header, 0, sizeof(iftSICLE_CacheHeader));
+	memcpy(header.magic, IFTSICLE_CACHE_MAGIC, 8);
+	header.version = IFTSICLE_CACHE_VERSION;
+	header.xsize = sicle->mimg->xsize; 
+	header.ysize = sicle->mimg->ysize; 
+	header.zsize = sicle->mimg->zsize;
+	header.num_feats = sicle->mimg->m;
+	header.has_sal = (sicle->sal != NULL);
+	header.key = key;
+	header.feats_offset = page_size; // The header fits within a page
+	header.sal_offset = (header.feats_offset + feats_bytes + page_size - 1) / 
+											page_size * page_size;
+
+	path = iftCopyString("%s/%016llx.sicle", dir, key);
+	tmp_path = iftCopyString("%s/%016llx_XXXXXX", dir, key);
+	fd = mkstemp(tmp_path);
+	fp = (fd >= 0) ? fdopen(fd, "wb") : NULL;
+	ok = (fp != NULL);
+	if(ok == true)
+	{
+		ok = fwrite(&header, sizeof(iftSICLE_CacheHeader), 1, fp) == 1 &&
+				 fseek(fp, header.feats_offset, SEEK_SET) == 0 &&
+				 fwrite(sicle->mimg->data->val, 1, feats_bytes, fp) == 
+					(size_t)feats_bytes;
+		if(ok == true && header.has_sal == true)
+		{
+			ok = fseek(fp, header.sal_offset, SEEK_SET) == 0 &&
+					 fwrite(sicle->sal, sizeof(float), sicle->mimg->n, fp) == 
+						(size_t)sicle->mimg->n;
+		}
+		ok = (fclose(fp) == 0) && ok;
+	}
+	else if(fd >= 0) { close(fd); }
+
+	if(ok == true) { ok = (rename(tmp_path, path) == 0); }
+	if(ok == false)
+	{
+		if(fd >= 0) { unlink(tmp_path); }
+		iftWarning("Could not write the cache file %s", __func__, path);
+	}
+
+	free(tmp_path);
+	free(path);
+}
+
+/*
+ * Maps privately an array of the cache file. The mapping is writable, but 
+ * changes are never carried to the file.
+ *
+ * PARAMETERS:
+ *  fd[in] - REQUIRED: Descriptor of the cache file (duplicated)
+ *  offset[in] - REQUIRED: Page-aligned offset of the array (in bytes)
+ *  num_elems[in] - REQUIRED: Number of floats of the array
+ *
+ * RETURNS: Instance of the object, or NULL if it could not be mapped
+ */
+iftSICLE_MMap *iftSICLE_MapCache
+(int fd, long offset, long num_elems)
+{
+	iftSICLE_MMap *mmap_data;
+
+	mmap_data = malloc(sizeof(iftSICLE_MMap));
+	assert(mmap_data != NULL);
+
+	mmap_data->elem_size = sizeof(float);
+	mmap_data->bytes = num_elems * sizeof(float);
+	mmap_data->fd = dup(fd);
+	mmap_data->addr = MAP_FAILED;
+	if(mmap_data->fd >= 0)
+	{
+		mmap_data->addr = mmap(NULL, mmap_data->bytes, PROT_READ | PROT_WRITE, 
+													 MAP_PRIVATE, mmap_data->fd, offset);
+	}
+
+	if(mmap_data->addr == MAP_FAILED)
+	{
+		if(mmap_data->fd >= 0) { close(mmap_data->fd); }
+		free(mmap_data);
+		return NULL;
+	}
+
+	return mmap_data;
+}
+
+/*
+ * Loads the prototype of the given key from the cache, mapping its features 
+ * and saliency with no copy. Missing, partial or mismatching files are 
+ * treated as a miss.
+ *
+ * PARAMETERS:
+ *  dir[in] - REQUIRED: Cache directory
+ *  key[in] - REQUIRED: Key of the features
+ *  has_sal[in] - REQUIRED: Whether the saliency is expected
+ *
+ * RETURNS: SICLE prototype, without mask, or NULL on a miss
+ */
+iftSICLE *iftSICLE_LoadCache
+(const char *dir, ullong key, bool has_sal)
+{
+	bool valid;
+	int fd;
+	long page_size;
+	char *path;
+	struct stat st;
+	iftSICLE_CacheHeader header;
+	iftSICLE *sicle;
+	iftMatrix *feats;
+
+	path = iftCopyString("%s/%016llx.sicle", dir, key);
+	fd = open(path, O_RDONLY);
+	free(path);
+	if(fd < 0) { return NULL; }
+
+	page_size = sysconf(_SC_PAGESIZE);
+	valid = read(fd, &header, sizeof(iftSICLE_CacheHeader)) == 
+						(ssize_t)sizeof(iftSICLE_CacheHeader) && fstat(fd, &st) == 0 &&
+					memcmp(header.magic, IFTSICLE_CACHE_MAGIC, 8) == 0 &&
+					header.version == IFTSICLE_CACHE_VERSION && header.key == key &&
+					header.has_sal == has_sal && header.xsize > 0 && 
+					header.ysize > 0 && header.zsize > 0 &&
+					(header.num_feats == 1 || header.num_feats == 3) &&
+					header.feats_offset % page_size == 0 && 
+					header.sal_offset % page_size == 0;
+	if(valid == true) // Not truncated
+	{
+		long n;
+
+		n = (long)header.xsize * header.ysize * header.zsize;
+		valid = st.st_size >= header.feats_offset + 
+													 n * header.num_feats * (long)sizeof(float) &&
+						(has_sal == false || 
+						 st.st_size >= header.sal_offset + n * (long)sizeof(float));
+	}
+	if(valid == false) { close(fd); return NULL; }
+
+	sicle = malloc(sizeof(iftSICLE));
+	assert(sicle != NULL);
+
+	sicle->mimg = iftCreateMImage(header.xsize, header.ysize, header.zsize, 
+																header.num_feats);
+	sicle->roi = NULL; sicle->sal = NULL; sicle->sal_mmap = NULL; 
+	sicle->roi_mmap = NULL;
+	feats = sicle->mimg->data;
+	sicle->feats_mmap = iftSICLE_MapCache(fd, header.feats_offset, feats->n);
+	if(has_sal == true)
+	{ sicle->sal_mmap = iftSICLE_MapCache(fd, header.sal_offset, sicle->mimg->n); }
+	close(fd);
+
+	if(sicle->feats_mmap == NULL || (has_sal == true && sicle->sal_mmap == NULL))
+	{ iftDestroySICLE(&sicle); return NULL; }
+
+	free(feats->val); // As in iftSICLE_MoveToDisk
+	feats->val = sicle->feats_mmap->addr;
+	feats->allocated = false; // Must not be free'd by iftDestroyMatrix
+	for(iftIdx v_index = 0; v_index < sicle->mimg->n; ++v_index)
+	{ sicle->mimg->val[v_index] = iftMatrixRowPointer(feats, v_index); }
+	if(sicle->sal_mmap != NULL) { sicle->sal = sicle->sal_mmap->addr; }
+
+	return sicle;
+}
+
+//############################################################################|
+// 
+//	PUBLIC METHODS
+//
+//############################################################################|
+//============================================================================|
+// iftSICLEArgs
+//============================================================================|
+iftSICLEArgs *iftCreateSICLEArgs()
+{
+	iftSICLEArgs *args;
+
+	args = malloc(sizeof(iftSICLEArgs));
+	assert(args != NULL);
+
+	args->use_diag = true;
+	args->use_dift = true;
+	args->use_rag = false;
+	args->use_refine = true;
+	args->use_fast_finish = true;
+	args->n0 = 3000;
+	args->nf = 200;
+	args->max_iters = 5;
+	args->irreg = 0.12;
+	args->adhr = 12;
+	args->max_sweeps = 2;
+	args->pyr_levels = 0;
+	args->ooc_chunk = 16;
+	args->ooc_budget = 1024;
+	args->ooc_path = NULL;
+	args->alpha = 0.0;
+	args->time_budget = 0.0;
+	args->user_ni = NULL;
+	args->cancel = NULL;
+	args->cancel_data = NULL;
+	args->samplopt = IFT_SICLE_SAMPL_RND;
+	args->connopt = IFT_SICLE_CONN_FMAX;
+	args->critopt = IFT_SICLE_CRIT_MINSC;
+	args->penopt = IFT_SICLE_PEN_NONE;
+	args->engineopt = IFT_SICLE_ENGINE_HEAP;
+	args->adjopt = IFT_SICLE_ADJ_FULL;
+
+	return args;
+}
+
+inline void iftDestroySICLEArgs
+(iftSICLEArgs **args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(args != NULL);
+	#endif //-------------------------------------------------------------------|
+	if((*args) != NULL) 
+	{
+		if((*args)->user_ni != NULL) { iftDestroyIntArray(&((*args)->user_ni)); } 
+		if((*args)->ooc_path != NULL) { free((*args)->ooc_path); }
+		free(*args); 
+		(*args) = NULL; 
+	}
+}
+
+//============================================================================|
+// iftSICLE
+//============================================================================|
+iftSICLE *iftCreateSICLE
+(iftImage *img, iftImage *objsm, iftImage *mask)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(img != NULL);
+	if(objsm != NULL) { iftVerifyImageDomains(img, objsm, __func__); }
+	if(mask != NULL) { iftVerifyImageDomains(img, mask, __func__); }
+	#endif //-------------------------------------------------------------------|
+	iftSICLE *sicle;
+
+	sicle = malloc(sizeof(iftSICLE));
+	assert(sicle != NULL);
+
+	sicle->mimg = iftSICLE_ImageToFeats(img);
+	sicle->sal = NULL;
+	sicle->feats_mmap = NULL; sicle->sal_mmap = NULL; // In-core by default
+	sicle->roi_mmap = NULL;
+	iftSICLE_SetPriors(sicle, objsm, mask);
+
+	return sicle;
+}
+
+iftSICLE *iftReadSICLE
+(const char *img_path, iftImage *objsm, iftImage *mask)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(img_path != NULL);
+	#endif //-------------------------------------------------------------------|
+	iftSICLE *sicle;
+
+	if(iftDirExists(img_path) == false && iftSICLE_IsBinaryPNM(img_path) == true)
+	{
+		iftSICLE_PNM *pnm;
+
+		pnm = iftSICLE_ReadPNMHeader(img_path);
+		sicle = iftSICLE_DecodePNM(pnm, NULL);
+		iftSICLE_DestroyPNM(&pnm);
+		iftSICLE_SetPriors(sicle, objsm, mask);
+	}
+	else // Any other format (or a video folder) goes through the YCbCr image
+	{
+		iftImage *img;
+
+		if(iftDirExists(img_path) == true) 
+		{ img = iftReadImageFolderAsVolume(img_path); }
+		else { img = iftReadImageByExt(img_path); }
+		sicle = iftCreateSICLE(img, objsm, mask);
+		iftDestroyImage(&img);
+	}
+
+	return sicle;
+}
+
+iftSICLE *iftReadOutOfCoreSICLE
+(const char *img_path, iftImage *objsm, iftImage *mask, const char *ooc_path)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(img_path != NULL);
+	assert(ooc_path != NULL);
+	#endif //-------------------------------------------------------------------|
+	iftSICLE *sicle;
+
+	if(iftDirExists(ooc_path) == false)
+	{ iftError("Directory %s does not exist", __func__, ooc_path); }
+
+	if(iftDirExists(img_path) == false && iftSICLE_IsBinaryPNM(img_path) == true)
+	{
+		iftSICLE_PNM *pnm;
+
+		pnm = iftSICLE_ReadPNMHeader(img_path);
+		sicle = iftSICLE_DecodePNM(pnm, ooc_path);
+		iftSICLE_DestroyPNM(&pnm);
+		iftSICLE_SetPriors(sicle, objsm, mask);
+	}
+	else { sicle = iftReadSICLE(img_path, objsm, mask); }
+	iftSICLE_MoveToDisk(sicle, ooc_path); // Saliency, ROI and the others
+
+	return sicle;
+}
+
+iftSICLE *iftReadCachedSICLE
+(const char *img_path, iftImage *objsm, iftImage *mask, const char *cache_dir)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(img_path != NULL);
+	assert(cache_dir != NULL);
+	#endif //-------------------------------------------------------------------|
+	ullong key;
+	iftSICLE *sicle;
+
+	if(iftDirExists(cache_dir) == false)
+	{ iftError("Directory %s does not exist", __func__, cache_dir); }
+
+	key = iftSICLE_GetCacheKey(img_path, objsm);
+	sicle = iftSICLE_LoadCache(cache_dir, key, objsm != NULL);
+	if(sicle != NULL) { iftSICLE_SetPriors(sicle, objsm, mask); } // Mapped sal.
+	else
+	{
+		sicle = iftReadSICLE(img_path, objsm, mask);
+		iftSICLE_WriteCache(sicle, cache_dir, key);
+	}
+
+	return sicle;
+}
+
+void iftDestroySICLE
+(iftSICLE **sicle)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	#endif //-------------------------------------------------------------------|
+	if((*sicle) != NULL)
+	{
+		iftDestroyMImage(&((*sicle)->mimg));
+		if((*sicle)->feats_mmap != NULL) 
+		{ iftSICLE_DestroyMMap(&((*sicle)->feats_mmap)); }
+		if((*sicle)->sal_mmap != NULL) 
+		{ iftSICLE_DestroyMMap(&((*sicle)->sal_mmap)); }
+		else if((*sicle)->sal != NULL) { free((*sicle)->sal); }
+		if((*sicle)->roi_mmap != NULL) 
+		{ 
+			(*sicle)->roi->val = NULL; // Must not be free'd by iftDestroyBMap
+			iftSICLE_DestroyMMap(&((*sicle)->roi_mmap)); 
+		}
+		if((*sicle)->roi != NULL) iftDestroyBMap(&((*sicle)->roi));
+		free(*sicle);
+		(*sicle) = NULL;
+	}
+}
+
+//============================================================================|
+// iftSICLEStream
+//============================================================================|
+iftSICLEStream *iftCreateSICLEStream
+(iftSICLEArgs *args, float change_thr)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(change_thr >= 0);
+	#endif //-------------------------------------------------------------------|
+	iftSICLEStream *stream;
+
+	stream = malloc(sizeof(iftSICLEStream));
+	assert(stream != NULL);
+
+	if(args == NULL) 
+	{ stream->args = iftCreateSICLEArgs(); stream->own_args = true; }
+	else { stream->args = args; stream->own_args = false; }
+	stream->change_thr = change_thr;
+	stream->next_id = 1;
+	stream->xsize = stream->ysize = stream->zsize = 0;
+	stream->prev_feats = NULL;
+	stream->seeds = NULL;
+	stream->ids = NULL;
+
+	return stream;
+}
+
+void iftDestroySICLEStream
+(iftSICLEStream **stream)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(stream != NULL);
+	#endif //-------------------------------------------------------------------|
+	if((*stream) != NULL)
+	{
+		if((*stream)->own_args == true) 
+		{ iftDestroySICLEArgs(&((*stream)->args)); }
+		if((*stream)->prev_feats != NULL) { free((*stream)->prev_feats); }
+		if((*stream)->seeds != NULL) { iftDestroyIdxArray(&((*stream)->seeds)); }
+		if((*stream)->ids != NULL) { iftDestroyIntArray(&((*stream)->ids)); }
+		free(*stream);
+		(*stream) = NULL;
+	}
+}
+
+//============================================================================|
+// iftSICLESession
+//============================================================================|
+iftSICLESession *iftCreateSICLESession
+(iftSICLE *sicle, iftSICLEArgs *args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle, args); }
+	#endif //-------------------------------------------------------------------|
+	iftSICLESession *session;
+
+	session = malloc(sizeof(iftSICLESession));
+	assert(session != NULL);
+
+	if(args == NULL) 
+	{ session->args = iftCreateSICLEArgs(); session->own_args = true; }
+	else { session->args = args; session->own_args = false; }
+	session->sicle = sicle;
+
+	if(session->args->pyr_levels > 0)
+	{ iftError("The pyramid's forest is not optimum for editing", __func__); }
+
+	session->data = iftSICLE_RunCascade(sicle, session->args);
+
+	session->labels = iftCreateIntArray(session->data->seeds->n);
+	for(long s_id = 0; s_id < session->data->seeds->n; ++s_id)
+	{ 
+		session->labels->val[s_id] = 
+			iftSICLE_GetRootLabel(session->data, session->data->seeds->val[s_id]) + 1;
+	}
+	session->next_label = session->data->seeds->n + 1;
+
+	session->heap = iftCreateDHeap(sicle->mimg->n, session->data->cost_map);
+	iftSetRemovalPolicyDHeap(session->heap, MINVALUE);
+
+	return session;
+}
+
+void iftDestroySICLESession
+(iftSICLESession **session)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(session != NULL);
+	#endif //-------------------------------------------------------------------|
+	if((*session) != NULL)
+	{
+		if((*session)->own_args == true) 
+		{ iftDestroySICLEArgs(&((*session)->args)); }
+		iftDestroyIntArray(&((*session)->labels));
+		iftDestroyDHeap(&((*session)->heap));
+		iftSICLE_DestroyIFTData(&((*session)->data));
+		free(*session);
+		(*session) = NULL;
+	}
+}
+
+//============================================================================|
+// iftSICLEHierarchy
+//============================================================================|
+iftSICLEHierarchy *iftCreateSICLEHierarchy
+(iftSICLE *sicle, iftSICLEArgs *args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle, args); }
+	#endif //-------------------------------------------------------------------|
+	long num_seeds;
+	iftSICLEHierarchy *hier;
+
+	hier = malloc(sizeof(iftSICLEHierarchy));
+	assert(hier != NULL);
+
+	if(args == NULL) 
+	{ hier->args = iftCreateSICLEArgs(); hier->own_args = true; }
+	else { hier->args = args; hier->own_args = false; }
+	hier->sicle = sicle;
+
+	if(hier->args->use_rag == true)
+	{ iftError("The merging order is not a relevance ranking", __func__); }
+	if(hier->args->pyr_levels > 0)
+	{ iftError("The pyramid does not keep the removal order", __func__); }
+
+	hier->data = iftSICLE_CreateIFTData(sicle, hier->args);
+	hier->order = iftCreateIdxArray(hier->data->seeds->n);
+	iftSICLE_RunSchedule(sicle, hier->args, &(hier->data), hier->order->val);
+
+	// The i-th seed of the order is labeled as N0 - i
+	num_seeds = hier->order->n;
+	hier->cur_nf = hier->data->seeds->n;
+	for(long i = num_seeds - hier->cur_nf; i < num_seeds; ++i)
+	{ hier->data->pred_map[hier->order->val[i]] = -(num_seeds - i); }
+
+	hier->heap = iftCreateDHeap(sicle->mimg->n, hier->data->cost_map);
+	iftSetRemovalPolicyDHeap(hier->heap, MINVALUE);
+
+	return hier;
+}
+
+void iftDestroySICLEHierarchy
+(iftSICLEHierarchy **hier)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(hier != NULL);
+	#endif //-------------------------------------------------------------------|
+	if((*hier) != NULL)
+	{
+		if((*hier)->own_args == true) 
+		{ iftDestroySICLEArgs(&((*hier)->args)); }
+		iftDestroyIdxArray(&((*hier)->order));
+		iftDestroyDHeap(&((*hier)->heap));
+		iftSICLE_DestroyIFTData(&((*hier)->data));
+		free(*hier);
+		(*hier) = NULL;
+	}
+}
+
+void iftDestroySICLEMultiscale
+(iftSICLEMultiscale **msegm)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(msegm != NULL);
+	#endif //-------------------------------------------------------------------|
+	if((*msegm) != NULL)
+	{
+		for(int s = 0; s < (*msegm)->num_scales - 1; ++s)
+		{ iftDestroyIntArray(&((*msegm)->parent[s])); }
+		free((*msegm)->parent);
+		iftDestroyFloatArray(&((*msegm)->not_nested));
+		iftDestroyImage(&((*msegm)->label_img));
+		free(*msegm);
+		(*msegm) = NULL;
+	}
+}
+
+//============================================================================|
+// Runner
+//============================================================================|
+void iftGetSICLEDomain
+(iftSICLE *sicle, int *xsize, int *ysize, int *zsize, int *num_feats)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	assert(xsize != NULL); assert(ysize != NULL); assert(zsize != NULL);
+	#endif //-------------------------------------------------------------------|
+	(*xsize) = sicle->mimg->xsize;
+	(*ysize) = sicle->mimg->ysize;
+	(*zsize) = sicle->mimg->zsize;
+	if(num_feats != NULL) { (*num_feats) = sicle->mimg->m; }
+}
+
+void iftVerifySICLEArgs
+(iftSICLE *sicle, iftSICLEArgs *args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL); assert(args != NULL);
+	#endif //-------------------------------------------------------------------|
+	char msg[IFT_STR_DEFAULT_SIZE];
+
+	if(iftSICLE_FindArgsError(sicle, args, msg) == true) 
+	{ iftError("%s", __func__, msg); }
+}
+
+iftImage *iftRunSICLE
+(iftSICLE *sicle, iftSICLEArgs *args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	#endif //-------------------------------------------------------------------|
+	return iftRunAnytimeSICLE(sicle, args, NULL);
+}
+
+iftImage *iftRunAnytimeSICLE
+(iftSICLE *sicle, iftSICLEArgs *args, int *num_iters)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	#endif //-------------------------------------------------------------------|
+	bool default_args;
+	double deadline;
+	iftSICLE_IFTData *data;
+	iftImage *segm;
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+
+	if(args->time_budget > 0) 
+	{ deadline = iftSICLE_GetWallTime() + args->time_budget; }
+	else { deadline = 0; }
+
+	if(args->pyr_levels > 0) { data = iftSICLE_RunPyramid(sicle, args, -1); }
+	else 
+	{ 
+		data = iftSICLE_CreateIFTData(sicle, args);
+		data->deadline = deadline;
+		data->cancel = args->cancel; data->cancel_data = args->cancel_data;
+		iftSICLE_RunSchedule(sicle, args, &data, NULL);
+	}
+
+	if(num_iters != NULL) { (*num_iters) = data->num_iters; }
+	if(data->cancelled == true) { segm = NULL; }
+	else { segm = iftSICLE_CreateLabelImage(sicle, data); }
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+	iftSICLE_DestroyIFTData(&data);
+	return segm;
+}
+
+void iftRunSICLEToFile
+(iftSICLE *sicle, iftSICLEArgs *args, const char *path)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL); assert(path != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	#endif //-------------------------------------------------------------------|
+	bool default_args;
+	long chunk_vtx;
+	iftSICLE_IFTData *data;
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+
+	if(args->pyr_levels > 0) { data = iftSICLE_RunPyramid(sicle, args, -1); }
+	else { data = iftSICLE_RunCascade(sicle, args); }
+
+	if(data->pager != NULL) { chunk_vtx = data->pager->chunk_vtx; }
+	else { chunk_vtx = sicle->mimg->n; }
+	iftSICLE_WriteLabelFile(sicle, data, chunk_vtx, path);
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+	iftSICLE_DestroyIFTData(&data);
+}
+
+void iftRunTiledSICLE
+(const char *img_path, iftSICLEArgs *args, int tile_size, int overlap, 
+ const char *path)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(img_path != NULL); assert(path != NULL);
+	#endif //-------------------------------------------------------------------|
+	bool default_args;
+	int tiles_x, tiles_y, num_ids, num_parents, evicted_rows;
+	int *ids, *parent;
+	char *dir;
+	iftSICLE_PNM *pnm;
+	iftSICLE_MMap *ids_mmap;
+	iftSICLE_Tile *tiles;
+
+	if(tile_size < 3) { iftError("Tile size must be at least 3", __func__); }
+	if(overlap < 0) { iftError("Tile overlap must be non-negative", __func__); }
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+
+	pnm = iftSICLE_ReadPNMHeader(img_path);
+	if(args->ooc_path != NULL) { dir = iftCopyString(args->ooc_path); }
+	else { dir = iftParentDir(path); }
+	ids_mmap = iftSICLE_CreateMMap(dir, (long)pnm->xsize * pnm->ysize, 
+																 sizeof(int));
+	ids = ids_mmap->addr;
+	free(dir);
+
+	tiles_x = (pnm->xsize + tile_size - 1) / tile_size;
+	tiles_y = (pnm->ysize + tile_size - 1) / tile_size;
+	tiles = calloc(tiles_x, sizeof(iftSICLE_Tile));
+	assert(tiles != NULL);
+
+	num_ids = num_parents = evicted_rows = 0; parent = NULL;
+	for(int ty = 0; ty < tiles_y; ++ty) // Rows of tiles, from top to bottom
+	{
+		int keep_rows;
+
+		for(int tx = 0; tx < tiles_x; ++tx)
+		{
+			iftSICLE_Tile *tile;
+
+			tile = &(tiles[tx]);
+			tile->id = ty * tiles_x + tx;
+			tile->cx0 = tx * tile_size; tile->cy0 = ty * tile_size;
+			tile->cxsize = iftMin(tile_size, pnm->xsize - tile->cx0);
+			tile->cysize = iftMin(tile_size, pnm->ysize - tile->cy0);
+			tile->x0 = iftMax(0, tile->cx0 - overlap);
+			tile->y0 = iftMax(0, tile->cy0 - overlap);
+			tile->xsize = iftMin(pnm->xsize, tile->cx0 + tile->cxsize + overlap) 
+										- tile->x0;
+			tile->ysize = iftMin(pnm->ysize, tile->cy0 + tile->cysize + overlap) 
+										- tile->y0;
+		}
+
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp parallel for schedule(dynamic)
+		#endif //-----------------------------------------------------------------|
+		for(int tx = 0; tx < tiles_x; ++tx)
+		{ iftSICLE_RunTile(pnm, args, &(tiles[tx]), ids); }
+
+		for(int tx = 0; tx < tiles_x; ++tx) // Identifiers in the tiles' order
+		{ 
+			iftSICLE_OffsetTileIds(&(tiles[tx]), num_ids, pnm->xsize, ids); 
+			num_ids += tiles[tx].num_labels;
+		}
+
+		parent = realloc(parent, iftMax(1, num_ids) * sizeof(int));
+		assert(parent != NULL);
+		for(; num_parents < num_ids; ++num_parents) 
+		{ parent[num_parents] = num_parents; }
+
+		for(int tx = 0; tx < tiles_x; ++tx) // Stitch with the previous tiles
+		{
+			iftSICLE_Tile *tile;
+
+			tile = &(tiles[tx]);
+			iftSICLE_StitchBand(ids, pnm->xsize, tile->left, tile->x0, tile->cy0,
+													tile->cx0 - tile->x0, tile->cysize, parent);
+			iftSICLE_StitchBand(ids, pnm->xsize, tile->top, tile->x0, tile->y0,
+													tile->xsize, tile->cy0 - tile->y0, parent);
+			free(tile->left); free(tile->top);
+		}
+
+		// Only the bottom overlap band is read again, by the next row of tiles
+		keep_rows = iftMax(0, tiles[0].cy0 + tiles[0].cysize - overlap);
+		if(keep_rows > evicted_rows)
+		{
+			iftSICLE_EvictMMap(ids_mmap, (long)evicted_rows * pnm->xsize, 
+												 (long)(keep_rows - evicted_rows) * pnm->xsize);
+			evicted_rows = keep_rows;
+		}
+	}
+
+	iftSICLE_EnforceTiledConn(pnm, ids_mmap, parent, num_ids, 
+														iftSICLE_GetAdjOpt(args) != IFT_SICLE_ADJ_AXIS, 
+														tile_size);
+	iftSICLE_WriteTiledLabels(pnm, ids_mmap, parent, num_ids, tile_size, path);
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+	iftSICLE_DestroyMMap(&ids_mmap);
+	iftSICLE_DestroyPNM(&pnm);
+	free(parent);
+	free(tiles);
+}
+
+iftImage *iftRunSICLEStream
+(iftSICLEStream *stream, iftSICLE *sicle)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(stream != NULL); assert(sicle != NULL);
+	iftVerifySICLEArgs(sicle, stream->args);
+	#endif //-------------------------------------------------------------------|
+	bool is_warm;
+	iftSICLE_IFTData *data;
+	iftImage *segm;
+
+	is_warm = stream->seeds != NULL && stream->xsize == sicle->mimg->xsize &&
+						stream->ysize == sicle->mimg->ysize && 
+						stream->zsize == sicle->mimg->zsize;
+
+	if(is_warm == false) // First frame (or a new domain): full cascade
+	{
+		if(stream->seeds != NULL) // Identifiers are not carried across domains
+		{ 
+			iftDestroyIdxArray(&(stream->seeds)); 
+			iftDestroyIntArray(&(stream->ids)); 
+		}
+		if(stream->args->pyr_levels > 0) 
+		{ data = iftSICLE_RunPyramid(sicle, stream->args, -1); }
+		else { data = iftSICLE_RunCascade(sicle, stream->args); }
+	}
+	else // Warm start: short schedule from the previous seeds
+	{
+		iftSICLEArgs warm_args;
+
+		data = iftSICLE_AllocIFTData(sicle, stream->args, NULL);
+		data->seeds = iftSICLE_WarmSeeds(stream, sicle);
+		if(data->pager != NULL) // Out-of-core: conquer in the chunks' order
+		{ 
+			qsort(data->seeds->val, data->seeds->n, sizeof(iftIdx), 
+						iftSICLE_CmpIndex); 
+		}
+
+		warm_args = *(stream->args); // Shallow copy
+		warm_args.max_iters = 2; // At most one seed removal step
+		warm_args.user_ni = NULL;
+		warm_args.nf = iftMin(warm_args.nf, data->seeds->n);
+		iftSICLE_RunSchedule(sicle, &warm_args, &data, NULL);
+	}
+	iftSICLE_UpdateStream(stream, sicle, data);
+
+	segm = iftSICLE_CreateLabelImage(sicle, data);
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx v_index = 0; v_index < segm->n; ++v_index)
+	{
+		if(segm->val[v_index] > 0) 
+		{ segm->val[v_index] = stream->ids->val[segm->val[v_index] - 1]; }
+	}
+
+	iftSICLE_DestroyIFTData(&data);
+	return segm;
+}
+
+void iftRunSlidingSICLE
+(const char *folder, iftSICLEArgs *args, int window, int overlap, 
+ const char *path)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(folder != NULL); assert(path != NULL);
+	#endif //-------------------------------------------------------------------|
+	bool default_args, is_last;
+	int next_id, num_overlap;
+	long first;
+	int *prev_ids;
+	const char *EXT;
+	char *basename;
+	iftFileSet *files;
+
+	if(window < 2) { iftError("Window length must be at least 2", __func__); }
+	if(overlap < 0 || overlap >= window)
+	{ iftError("Window overlap must be within [0,%d[", __func__, window); }
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+
+	files = iftLoadFileSetFromDirOrCSV(folder, 0, true);
+	EXT = iftFileExt(path);
+	basename = iftRemoveSuffix(path, EXT);
+
+	next_id = 1; num_overlap = 0; prev_ids = NULL;
+	first = 0; is_last = files->n == 0;
+	while(is_last == false)
+	{
+		int num_frames, num_final;
+		long frame_vtx;
+		iftImage *vol, *segm;
+
+		num_frames = iftMin(window, files->n - first);
+		is_last = first + num_frames == files->n;
+
+		vol = iftSICLE_ReadFrames(files, first, num_frames);
+		segm = iftSICLE_RunWindow(vol, args, num_frames / (double)window, 
+															prev_ids, num_overlap, &next_id);
+		frame_vtx = (long)vol->xsize * vol->ysize;
+		iftDestroyImage(&vol);
+
+		// The last frames are finalized by the next window, if any
+		if(is_last == true) { num_final = num_frames; }
+		else { num_final = num_frames - overlap; }
+		for(int z = 0; z < num_final; ++z)
+		{
+			iftImage *frame;
+
+			frame = iftGetXYSlice(segm, z);
+			iftWriteImageByExt(frame, "%s%0*ld%s", basename, 
+												 IFT_VIDEO_FOLDER_FRAME_NZEROES, first + z, EXT);
+			iftDestroyImage(&frame);
+		}
+
+		num_overlap = num_frames - num_final;
+		if(num_overlap > 0) // Kept for carrying the identifiers
+		{
+			prev_ids = realloc(prev_ids, num_overlap * frame_vtx * sizeof(int));
+			assert(prev_ids != NULL);
+			memcpy(prev_ids, &(segm->val[num_final * frame_vtx]), 
+						 num_overlap * frame_vtx * sizeof(int));
+		}
+		iftDestroyImage(&segm);
+		first += num_final;
+	}
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+	if(prev_ids != NULL) { free(prev_ids); }
+	iftDestroyFileSet(&files);
+	free(basename);
+}
+
+iftImage **iftRunMultiscaleSICLE
+(iftSICLE *sicle, iftSICLEArgs *args, int *num_scales)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	#endif //-------------------------------------------------------------------|
+	bool default_args;
+	int tmp;
+	iftImage **segm;
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+
+	segm = NULL;
+	tmp = iftSICLE_RunScales(sicle, args, iftSICLE_StoreScale, &segm);
+	if(num_scales != NULL) { (*num_scales) = tmp; }
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+
+	return segm;
+}
+
+int iftRunMultiscaleSICLEWithCallback
+(iftSICLE *sicle, iftSICLEArgs *args, iftImage *label_img, 
+ iftSICLEScaleCallback callback, void *user)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL); assert(label_img != NULL); assert(callback != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	#endif //-------------------------------------------------------------------|
+	bool default_args;
+	int num_scales;
+	iftSICLE_Callback cb;
+
+	if(label_img->xsize != sicle->mimg->xsize || 
+		 label_img->ysize != sicle->mimg->ysize ||
+		 label_img->zsize != sicle->mimg->zsize)
+	{ iftError("The label image and the prototype's domains differ", __func__); }
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+
+	cb.label_img = label_img; cb.callback = callback; cb.user = user;
+	num_scales = iftSICLE_RunScales(sicle, args, iftSICLE_CallbackScale, &cb);
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+
+	return num_scales;
+}
+
+iftSICLEMultiscale *iftRunCompactMultiscaleSICLE
+(iftSICLE *sicle, iftSICLEArgs *args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	#endif //-------------------------------------------------------------------|
+	bool default_args;
+	iftSICLE_Compact compact;
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+
+	compact.msegm = calloc(1, sizeof(iftSICLEMultiscale));
+	assert(compact.msegm != NULL);
+	compact.nest_label = NULL; compact.prev_seeds = NULL;
+	iftSICLE_RunScales(sicle, args, iftSICLE_CompactScale, &compact);
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+
+	return compact.msegm;
+}
+
+iftImage *iftGetSICLEMultiscaleLabels
+(iftSICLEMultiscale *msegm, int scale)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(msegm != NULL);
+	#endif //-------------------------------------------------------------------|
+	int *lut;
+	iftImage *label_img;
+
+	if(scale < 0 || scale >= msegm->num_scales)
+	{ 
+		iftError("Scale %d is not within [0,%d]", __func__, scale, 
+						 msegm->num_scales - 1); 
+	}
+
+	if(scale == 0) { return iftCopyImage(msegm->label_img); }
+
+	// Composes the parents from the first scale to the given one
+	lut = malloc(msegm->parent[0]->n * sizeof(int));
+	assert(lut != NULL);
+	for(long l = 0; l < msegm->parent[0]->n; ++l)
+	{
+		int label;
+
+		label = l;
+		for(int s = 0; s < scale; ++s) { label = msegm->parent[s]->val[label]; }
+		lut[l] = label;
+	}
+
+	label_img = iftCreateImage(msegm->label_img->xsize, msegm->label_img->ysize,
+														 msegm->label_img->zsize);
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(iftIdx v_index = 0; v_index < label_img->n; ++v_index)
+	{ label_img->val[v_index] = lut[msegm->label_img->val[v_index]]; }
+	free(lut);
+
+	return label_img;
 }
 
-//############################################################################|
-// 
-//	PUBLIC METHODS
-//
-//############################################################################|
 //============================================================================|
-// iftSICLEArgs
+// Session
 //============================================================================|
-iftSICLEArgs *iftCreateSICLEArgs()
+iftImage *iftGetSICLESessionLabels
+(iftSICLESession *session)
 {
-	iftSICLEArgs *args;
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(session != NULL);
+	#endif //-------------------------------------------------------------------|
+	return iftSICLE_CreateLabelImage(session->sicle, session->data);
+}
 
-	args = malloc(sizeof(iftSICLEArgs));
-	assert(args != NULL);
+void iftCopySICLESessionLabels
+(iftSICLESession *session, iftBoundingBox bb, iftImage *label_img)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(session != NULL); assert(label_img != NULL);
+	assert(label_img->n == session->sicle->mimg->n);
+	#endif //-------------------------------------------------------------------|
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for
+	#endif //-------------------------------------------------------------------|
+	for(int z = bb.begin.z; z <= bb.end.z; ++z)
+	{
+		for(int y = bb.begin.y; y <= bb.end.y; ++y)
+		{
+			for(int x = bb.begin.x; x <= bb.end.x; ++x)
+			{
+				iftIdx v_index;
+				iftVoxel v_voxel;
 
-	args->use_diag = true;
-	args->use_dift = true;
-	args->n0 = 3000;
-	args->nf = 200;
-	args->max_iters = 5;
-	args->irreg = 0.12;
-	args->adhr = 12;
-	args->alpha = 0.0;
-	args->user_ni = NULL;
-	args->samplopt = IFT_SICLE_SAMPL_RND;
-	args->connopt = IFT_SICLE_CONN_FMAX;
-	args->critopt = IFT_SICLE_CRIT_MINSC;
-	args->penopt = IFT_SICLE_PEN_NONE;
+				v_voxel.x = x; v_voxel.y = y; v_voxel.z = z;
+				v_index = iftMGetVoxelIndex(session->sicle->mimg, v_voxel);
+				if(iftSICLE_InROI(session->sicle, v_index))
+				{ 
+					label_img->val[v_index] = 
+						iftSICLE_GetRootLabel(session->data, v_index) + 1; 
+				}
+			}
+		}
+	}
+}
 
-	return args;
+int iftAddSICLESeed
+(iftSICLESession *session, iftVoxel v_voxel, iftBoundingBox *changed)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(session != NULL);
+	#endif //-------------------------------------------------------------------|
+	int label;
+	iftIdx v_index;
+	iftBoundingBox bb;
+
+	v_index = iftSICLE_GetNewSeedIndex(session, v_voxel);
+	label = session->next_label++;
+	bb = iftSICLE_EditSession(session, 0, v_index, label);
+	if(changed != NULL) { (*changed) = bb; }
+
+	return label;
 }
 
-inline void iftDestroySICLEArgs
-(iftSICLEArgs **args)
+void iftRemoveSICLESuperspel
+(iftSICLESession *session, int label, iftBoundingBox *changed)
 {
 	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	assert(args != NULL);
+	assert(session != NULL);
 	#endif //-------------------------------------------------------------------|
-	if((*args) != NULL) 
+	iftBoundingBox bb;
+
+	iftSICLE_VerifySessionLabel(session, label);
+	bb = iftSICLE_EditSession(session, label, IFT_NIL, 0);
+	if(changed != NULL) { (*changed) = bb; }
+}
+
+void iftMoveSICLESeed
+(iftSICLESession *session, int label, iftVoxel v_voxel, 
+ iftBoundingBox *changed)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(session != NULL);
+	#endif //-------------------------------------------------------------------|
+	iftIdx v_index;
+	iftBoundingBox bb;
+
+	iftSICLE_VerifySessionLabel(session, label);
+	v_index = IFT_NIL;
+	if(iftMValidVoxel(session->sicle->mimg, v_voxel) == true)
+	{ v_index = iftMGetVoxelIndex(session->sicle->mimg, v_voxel); }
+
+	if(v_index != IFT_NIL && session->data->root_map[v_index] == v_index &&
+		 iftSICLE_GetRootLabel(session->data, v_index) + 1 == label)
+	{ // Already its seed
+		bb.begin.x = bb.begin.y = bb.begin.z = IFT_INFINITY_INT;
+		bb.end.x = bb.end.y = bb.end.z = -1;
+	}
+	else
 	{
-		if((*args)->user_ni != NULL) { iftDestroyIntArray(&((*args)->user_ni)); } 
-		free(*args); 
-		(*args) = NULL; 
+		v_index = iftSICLE_GetNewSeedIndex(session, v_voxel);
+		bb = iftSICLE_EditSession(session, label, v_index, label);
+	}
+	if(changed != NULL) { (*changed) = bb; }
+}
+
+int iftSplitSICLESuperspel
+(iftSICLESession *session, int label, iftVoxel v_voxel, 
+ iftBoundingBox *changed)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(session != NULL);
+	#endif //-------------------------------------------------------------------|
+	int new_label;
+	iftIdx v_index;
+	iftBoundingBox bb;
+
+	v_index = iftSICLE_GetNewSeedIndex(session, v_voxel);
+	if(iftSICLE_GetRootLabel(session->data, v_index) + 1 != label)
+	{ iftError("Voxel (%d,%d,%d) is not within superspel %d", __func__, 
+						 v_voxel.x, v_voxel.y, v_voxel.z, label); }
+
+	new_label = session->next_label++;
+	bb = iftSICLE_EditSession(session, 0, v_index, new_label);
+	if(changed != NULL) { (*changed) = bb; }
+
+	return new_label;
+}
+
+void iftMergeSICLESuperspels
+(iftSICLESession *session, int label, int other, iftBoundingBox *changed)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(session != NULL);
+	#endif //-------------------------------------------------------------------|
+	iftBoundingBox bb;
+
+	iftSICLE_VerifySessionLabel(session, label);
+	iftSICLE_VerifySessionLabel(session, other);
+	if(label == other)
+	{
+		bb.begin.x = bb.begin.y = bb.begin.z = IFT_INFINITY_INT;
+		bb.end.x = bb.end.y = bb.end.z = -1;
+	}
+	else
+	{
+		bb = iftSICLE_CalcLabelBBox(session, other);
+		for(long s_id = 0; s_id < session->labels->n; ++s_id)
+		{
+			if(session->labels->val[s_id] == other)
+			{ 
+				session->labels->val[s_id] = label;
+				session->data->pred_map[session->data->seeds->val[s_id]] = -label;
+			}
+		}
+	}
+	if(changed != NULL) { (*changed) = bb; }
+}
+
+//============================================================================|
+// Hierarchy
+//============================================================================|
+long iftGetSICLEHierarchyMaxNf
+(iftSICLEHierarchy *hier)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(hier != NULL);
+	#endif //-------------------------------------------------------------------|
+	return hier->order->n;
+}
+
+iftImage *iftQuerySICLEHierarchy
+(iftSICLEHierarchy *hier, long nf)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(hier != NULL);
+	#endif //-------------------------------------------------------------------|
+	long num_seeds;
+	iftSet *irre_seeds, *new_seeds;
+	iftSICLE_IFTData *data;
+
+	num_seeds = hier->order->n;
+	if(nf < 1 || nf > num_seeds)
+	{ iftError("Nf = %ld is not within [1,%ld]", __func__, nf, num_seeds); }
+
+	data = hier->data;
+	irre_seeds = new_seeds = NULL;
+	if(nf < hier->cur_nf) // Less relevant seeds are removed
+	{
+		for(long i = num_seeds - hier->cur_nf; i < num_seeds - nf; ++i)
+		{ iftInsertSet(&irre_seeds, hier->order->val[i]); }
+	}
+	else // Previously removed seeds are restored
+	{
+		for(long i = num_seeds - nf; i < num_seeds - hier->cur_nf; ++i)
+		{ 
+			data->pred_map[hier->order->val[i]] = -(num_seeds - i);
+			iftInsertSet(&new_seeds, hier->order->val[i]); 
+		}
+	}
+
+	if(irre_seeds != NULL || new_seeds != NULL)
+	{
+		iftSICLE_UpdateForest(hier->sicle, hier->args, &(hier->data), 
+													&(hier->heap), &irre_seeds, &new_seeds);
+
+		data = hier->data;
+		data->seeds->val = realloc(data->seeds->val, nf * sizeof(iftIdx));
+		assert(data->seeds->val != NULL);
+		memcpy(data->seeds->val, &(hier->order->val[num_seeds - nf]), 
+					 nf * sizeof(iftIdx));
+		data->seeds->n = nf;
+		hier->cur_nf = nf;
+	}
+
+	return iftSICLE_CreateLabelImage(hier->sicle, hier->data);
+}
+
+//============================================================================|
+// Planner
+//============================================================================|
+iftSICLECalib iftCalibrateSICLE
+()
+{
+	long num_trees;
+	double gray[4], color[4], dift_frac, num_arcs;
+	iftSICLECalib calib;
+
+	iftSICLE_BenchSteps(false, gray, &num_trees, &dift_frac);
+	iftSICLE_BenchSteps(true, color, &num_trees, &dift_frac);
+
+	// Gray (1 feature) and Lab (3 features) for splitting the cost per arc
+	num_arcs = IFTSICLE_BENCH_SIZE * IFTSICLE_BENCH_SIZE * 8.0;
+	calib.feat_time = iftMax(0, (color[0] - gray[0]) / (2 * num_arcs));
+	calib.arc_time = iftMax(0, gray[0] / num_arcs - calib.feat_time);
+	calib.arc_time /= log2(IFTSICLE_BENCH_SIZE * IFTSICLE_BENCH_SIZE);
+	calib.feat_time /= log2(IFTSICLE_BENCH_SIZE * IFTSICLE_BENCH_SIZE);
+	calib.dift_factor = color[1] / (dift_frac * color[0]);
+	calib.stats_time = color[2] / num_arcs;
+	calib.pair_time = color[3] / num_trees;
+
+	return calib;
+}
+
+iftSICLECalib iftReadSICLECalib
+(const char *path)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(path != NULL);
+	#endif //-------------------------------------------------------------------|
+	FILE *fp;
+	iftSICLECalib calib;
+
+	fp = fopen(path, "r");
+	if(fp == NULL) { iftError(MSG_FILE_OPEN_ERROR, __func__, path); }
+
+	if(fscanf(fp, "arc_time %lf\n", &(calib.arc_time)) != 1 ||
+		 fscanf(fp, "feat_time %lf\n", &(calib.feat_time)) != 1 ||
+		 fscanf(fp, "dift_factor %lf\n", &(calib.dift_factor)) != 1 ||
+		 fscanf(fp, "stats_time %lf\n", &(calib.stats_time)) != 1 ||
+		 fscanf(fp, "pair_time %lf\n", &(calib.pair_time)) != 1)
+	{ iftError("Invalid calibration file %s", __func__, path); }
+	fclose(fp);
+
+	return calib;
+}
+
+void iftWriteSICLECalib
+(iftSICLECalib *calib, const char *path)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(calib != NULL); assert(path != NULL);
+	#endif //-------------------------------------------------------------------|
+	FILE *fp;
+
+	fp = fopen(path, "w");
+	if(fp == NULL) { iftError(MSG_FILE_OPEN_ERROR, __func__, path); }
+
+	fprintf(fp, "arc_time %.6e\n", calib->arc_time);
+	fprintf(fp, "feat_time %.6e\n", calib->feat_time);
+	fprintf(fp, "dift_factor %.6e\n", calib->dift_factor);
+	fprintf(fp, "stats_time %.6e\n", calib->stats_time);
+	fprintf(fp, "pair_time %.6e\n", calib->pair_time);
+	fclose(fp);
+}
+
+void iftPredictSICLE
+(iftSICLECalib *calib, iftSICLEArgs *args, int xsize, int ysize, int zsize,
+ int num_feats, double *time, size_t *memory)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(calib != NULL); assert(args != NULL);
+	#endif //-------------------------------------------------------------------|
+	long num_vtx;
+	iftAdjRel *A;
+
+	num_vtx = xsize * (long)ysize * zsize;
+	if(num_vtx <= args->nf)
+	{ iftError("The image has fewer spels than Nf", __func__); }
+
+	A = iftSICLE_CreateAdjRel(args, zsize > 1);
+	if(time != NULL) 
+	{ (*time) = iftSICLE_PredictTime(calib, args, num_vtx, A->n - 1, num_feats); }
+	if(memory != NULL)
+	{ 
+		(*memory) = iftSICLE_PredictMemory(args, num_vtx, num_feats, 
+																				iftMin(args->n0, num_vtx - 1)); 
+	}
+	iftDestroyAdjRel(&A);
+}
+
+bool iftPlanSICLE
+(iftSICLECalib *calib, int xsize, int ysize, int zsize, int num_feats, 
+ double max_time, size_t max_memory, iftSICLEArgs *args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(calib != NULL); assert(args != NULL);
+	#endif //-------------------------------------------------------------------|
+	bool found;
+	int best_n0, best_iters;
+	iftSICLEArgs plan_args;
+
+	plan_args = (*args); // Shallow copy
+	plan_args.user_ni = NULL; // The schedule is derived from N0 and the iterations
+
+	found = false; best_n0 = args->n0; best_iters = 2;
+	for(int n0 = args->n0; n0 > args->nf && found == false; n0 = n0 * 0.9)
+	{
+		for(int iters = args->max_iters; iters >= 2 && found == false; --iters)
+		{
+			double time;
+			size_t memory;
+
+			plan_args.n0 = n0; plan_args.max_iters = iters;
+			iftPredictSICLE(calib, &plan_args, xsize, ysize, zsize, num_feats, 
+											&time, &memory);
+			best_n0 = n0; best_iters = iters; // The cheapest so far, otherwise
+			found = (max_time <= 0 || time <= max_time) &&
+							(max_memory == 0 || memory <= max_memory);
+		}
+	}
+
+	args->n0 = best_n0; args->max_iters = best_iters;
+	if(args->user_ni != NULL) { iftDestroyIntArray(&(args->user_ni)); }
+
+	return found;
+}
+
+//============================================================================|
+// Sweep
+//============================================================================|
+iftImage **iftRunSICLESweep
+(iftSICLE *sicle, iftSICLEArgs **args, int num_args)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(sicle != NULL); assert(args != NULL); assert(num_args > 0);
+	for(int i = 0; i < num_args; ++i) { iftVerifySICLEArgs(sicle, args[i]); }
+	#endif //-------------------------------------------------------------------|
+	int *group, *num_refs;
+	iftImage **segms;
+	iftSICLE_IFTData **first;
+
+	segms = calloc(num_args, sizeof(iftImage*));
+	assert(segms != NULL);
+	group = malloc(num_args * sizeof(int));
+	assert(group != NULL);
+	num_refs = calloc(num_args, sizeof(int));
+	assert(num_refs != NULL);
+	first = calloc(num_args, sizeof(iftSICLE_IFTData*));
+	assert(first != NULL);
+
+	// Groups by first forest, led by their first configuration
+	for(int i = 0; i < num_args; ++i)
+	{
+		if(args[i]->ooc_path != NULL)
+		{ iftError("Sweeps do not support out-of-core runs", __func__); }
+
+		group[i] = -1;
+		if(iftSICLE_IsShareable(args[i]) == false) { continue; }
+		for(int j = 0; j < i && group[i] == -1; ++j)
+		{
+			if(group[j] == j && iftSICLE_HasSameFirstForest(args[i], args[j]))
+			{ group[i] = j; }
+		}
+		if(group[i] == -1) { group[i] = i; }
+		++num_refs[group[i]];
+	}
+
+	// From the default seed, as if each one were run on its own
+	for(int i = 0; i < num_args; ++i)
+	{
+		if(group[i] == i) 
+		{ first[i] = iftSICLE_CreateSeededIFTData(sicle, args[i], 1); }
+		else if(group[i] == -1) 
+		{ iftRandomSeed(1); segms[i] = iftRunSICLE(sicle, args[i]); }
+	}
+
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for schedule(dynamic)
+	#endif //-------------------------------------------------------------------|
+	for(int i = 0; i < num_args; ++i)
+	{
+		if(group[i] == i)
+		{
+			iftSet *irre_seeds;
+
+			irre_seeds = NULL;
+			iftSICLE_RunIteration(sicle, args[i], &(first[i]), &irre_seeds, true);
+			first[i]->num_iters = 1;
+		}
+	}
+
+	#ifdef IFT_OMP //-----------------------------------------------------------|
+	#pragma omp parallel for schedule(dynamic)
+	#endif //-------------------------------------------------------------------|
+	for(int i = 0; i < num_args; ++i)
+	{
+		iftSICLE_IFTData *data;
+
+		if(group[i] == -1) { continue; }
+
+		// Copied on demand, and the last branch takes the original forest
+		#ifdef IFT_OMP //---------------------------------------------------------|
+		#pragma omp critical
+		#endif //-----------------------------------------------------------------|
+		{
+			--num_refs[group[i]];
+			if(num_refs[group[i]] == 0) 
+			{ data = first[group[i]]; first[group[i]] = NULL; }
+			else { data = iftSICLE_CopyIFTData(sicle, args[i], first[group[i]]); }
+		}
+
+		if(args[i]->time_budget > 0) 
+		{ data->deadline = iftSICLE_GetWallTime() + args[i]->time_budget; }
+		data->cancel = args[i]->cancel; data->cancel_data = args[i]->cancel_data;
+		iftSICLE_RunSchedule(sicle, args[i], &data, NULL);
+
+		if(data->cancelled == false) 
+		{ segms[i] = iftSICLE_CreateLabelImage(sicle, data); }
+		iftSICLE_DestroyIFTData(&data);
 	}
+
+	free(group);
+	free(num_refs);
+	free(first);
+
+	return segms;
 }
 
 //============================================================================|
-// iftSICLE
+// Checkpoint
 //============================================================================|
-iftSICLE *iftCreateSICLE
-(iftImage *img, iftImage *objsm, iftImage *mask)
+void iftRunSICLEToCheckpoint
+(iftSICLE *sicle, iftSICLEArgs *args, int num_iters, const char *path)
 {
 	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	assert(img != NULL);
-	if(objsm != NULL) { iftVerifyImageDomains(img, objsm, __func__); }
-	if(mask != NULL) { iftVerifyImageDomains(img, mask, __func__); }
+	assert(sicle != NULL); assert(path != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
 	#endif //-------------------------------------------------------------------|
-	iftSICLE *sicle;
+	bool default_args;
+	iftSICLE_IFTData *data;
+	iftIntArray *ni;
 
-	sicle = malloc(sizeof(iftSICLE));
-	assert(sicle != NULL);
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+	if(args->ooc_path != NULL || args->pyr_levels > 0)
+	{ iftError("Checkpoints do not support out-of-core or pyramid runs", 
+						 __func__); }
 
-	if(iftIsColorImage(img)) 
-	{ sicle->mimg = iftImageToMImage(img, LAB_CSPACE); }
-	else { sicle->mimg = iftImageToMImage(img, GRAY_CSPACE); }
-	
-	if(mask != NULL) { sicle->roi = iftBinImageToBMap(mask); }
-	else { sicle->roi = NULL; }
+	data = iftSICLE_CreateIFTData(sicle, args);
+	ni = iftSICLE_CreateNiArray(args, data->seeds->n);
+	if(num_iters < 1 || num_iters > ni->n)
+	{ iftError("The iteration must be within [1,%d]", __func__, ni->n); }
 
-	if(objsm != NULL)
+	if(num_iters == 1) // Only the first forest
 	{
-		int max_sal;
-
-		sicle->sal = calloc(sicle->mimg->n, sizeof(float));
-		assert(sicle->sal);
-
-		max_sal = 0;
-		#ifdef IFT_OMP //---------------------------------------------------------|
-		#pragma omp parallel for reduction(+:max_sal)
-		#endif //-----------------------------------------------------------------|
-		for(int v_index = 0; v_index < sicle->mimg->n; ++v_index)
-		{ max_sal = iftMax(max_sal, objsm->val[v_index]); }
+		iftSet *irre_seeds;
 
-		#ifdef IFT_OMP //---------------------------------------------------------|
-		#pragma omp parallel for
-		#endif //-----------------------------------------------------------------|
-		for(int v_index = 0; v_index < sicle->mimg->n; ++v_index)
-		{ sicle->sal[v_index] = (float)objsm->val[v_index]/max_sal; } // Norm [0,1]
+		irre_seeds = NULL;
+		iftSICLE_RunIteration(sicle, args, &data, &irre_seeds, true);
+		data->num_iters = 1;
+	}
+	else // The same schedule, until the given iteration
+	{
+		iftSICLEArgs part_args;
+
+		part_args = (*args); // Shallow copy
+		part_args.nf = ni->val[num_iters - 1];
+		part_args.max_iters = 2; // If no intermediary one
+		part_args.user_ni = NULL;
+		if(num_iters > 2)
+		{ 
+			part_args.user_ni = iftCreateIntArray(num_iters - 2); 
+			for(int i = 1; i < num_iters - 1; ++i)
+			{ part_args.user_ni->val[i - 1] = ni->val[i]; }
+		}
+		iftSICLE_RunSchedule(sicle, &part_args, &data, NULL);
+		if(part_args.user_ni != NULL) { iftDestroyIntArray(&(part_args.user_ni)); }
 	}
-	else { sicle->sal = NULL; }
+	iftSICLE_WriteCkpt(sicle, args, data, ni->val[0], path);
 
-	return sicle;
+	if(default_args) { iftDestroySICLEArgs(&args); }
+	iftDestroyIntArray(&ni);
+	iftSICLE_DestroyIFTData(&data);
 }
 
-void iftDestroySICLE
-(iftSICLE **sicle)
+iftImage *iftResumeSICLE
+(iftSICLE *sicle, iftSICLEArgs *args, const char *path)
 {
 	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	assert(sicle != NULL);
+	assert(sicle != NULL); assert(path != NULL);
+	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
 	#endif //-------------------------------------------------------------------|
-	if((*sicle) != NULL)
+	bool default_args;
+	int done;
+	long num_init;
+	iftSICLEArgs res_args;
+	iftSICLE_IFTData *data;
+	iftIntArray *ni;
+	iftImage *segm;
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+	if(args->ooc_path != NULL || args->pyr_levels > 0)
+	{ iftError("Checkpoints do not support out-of-core or pyramid runs", 
+						 __func__); }
+
+	data = iftSICLE_ReadCkpt(sicle, args, path, &num_init);
+	if(args->nf > data->seeds->n)
+	{ 
+		iftError("Nf = %d exceeds the %ld seeds of the checkpoint", __func__, 
+						 args->nf, data->seeds->n); 
+	}
+
+	// Continues the schedule of the arguments if it passes by the checkpoint
+	res_args = (*args); // Shallow copy
+	ni = iftSICLE_CreateNiArray(args, num_init);
+	done = data->num_iters;
+	if(done < ni->n && ni->val[done - 1] == data->seeds->n)
 	{
-		iftDestroyMImage(&((*sicle)->mimg));
-		if((*sicle)->sal != NULL) { free((*sicle)->sal); }
-		if((*sicle)->roi != NULL) iftDestroyBMap(&((*sicle)->roi));
-		free(*sicle);
-		(*sicle) = NULL;
+		res_args.max_iters = 2; // If no intermediary one
+		res_args.user_ni = NULL;
+		if(ni->n - 1 - done > 0)
+		{
+			res_args.user_ni = iftCreateIntArray(ni->n - 1 - done);
+			for(int i = done; i < ni->n - 1; ++i)
+			{ res_args.user_ni->val[i - done] = ni->val[i]; }
+		}
 	}
+	iftDestroyIntArray(&ni);
+
+	data->cancel = args->cancel; data->cancel_data = args->cancel_data;
+	if(args->time_budget > 0) 
+	{ data->deadline = iftSICLE_GetWallTime() + args->time_budget; }
+	iftSICLE_RunSchedule(sicle, &res_args, &data, NULL);
+	if(res_args.user_ni != args->user_ni) 
+	{ iftDestroyIntArray(&(res_args.user_ni)); }
+
+	if(data->cancelled == true) { segm = NULL; }
+	else { segm = iftSICLE_CreateLabelImage(sicle, data); }
+
+	if(default_args) { iftDestroySICLEArgs(&args); }
+	iftSICLE_DestroyIFTData(&data);
+	return segm;
 }
 
 //============================================================================|
-// Runner
+// Batch
 //============================================================================|
-void iftVerifySICLEArgs
-(iftSICLE *sicle, iftSICLEArgs *args)
+iftFileSet *iftSelectSICLEShard
+(const iftFileSet *files, int shard, int num_shards)
 {
 	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	assert(sicle != NULL); assert(args != NULL);
+	assert(files != NULL);
 	#endif //-------------------------------------------------------------------|
-	int num_vtx;
+	long num_files;
+	bool *is_selected;
+	iftFileSet *selected;
 
-	if(sicle->roi == NULL) { num_vtx = sicle->mimg->n; }
-	else
-	{
-		num_vtx = 0;
-		#ifdef IFT_OMP //---------------------------------------------------------|
-		#pragma omp parallel for
-		#endif //-----------------------------------------------------------------|
-		for(int v_index = 0; v_index < sicle->mimg->n; ++v_index)
-		{ if(iftBMapValue(sicle->roi, v_index) == true) { num_vtx++; } }
+	if(num_shards < 1 || shard < 0 || shard >= num_shards)
+	{ 
+		iftError("Invalid shard %d of %d. It must be within [0,%d[", __func__, 
+						 shard, num_shards, num_shards); 
 	}
 
-	if(args->n0 >= num_vtx || args->n0 <= 2)
-	{ 
-		iftError("Invalid N0 value of %d. It must be within ]2,%d[\n", __func__,
-							args->n0, num_vtx); 
+	is_selected = calloc(files->n, sizeof(bool));
+	assert(is_selected != NULL);
+
+	num_files = 0;
+	for(long i = 0; i < files->n; ++i)
+	{
+		const char *PATH, *NAME;
+		ullong hash;
+
+		// By name, thus the same for any mount point or new files
+		PATH = files->files[i]->path;
+		NAME = strrchr(PATH, '/');
+		NAME = (NAME == NULL) ? PATH : NAME + 1;
+		hash = iftSICLE_HashBytes(0xCBF29CE484222325ULL, NAME, 
+															strlen(NAME) - strlen(iftFileExt(NAME)));
+		if(hash % num_shards == (ullong)shard) 
+		{ is_selected[i] = true; ++num_files; }
 	}
 
-	if(args->nf >= args->n0)
+	selected = iftCreateFileSet(num_files);
+	num_files = 0;
+	for(long i = 0; i < files->n; ++i)
 	{ 
-		iftError("Invalid Nf value of %d. It must be within [2,%d[\n", __func__,
-							args->nf, args->n0); 
+		if(is_selected[i] == true) 
+		{ selected->files[num_files++] = iftCopyFile(files->files[i]); }
 	}
+	free(is_selected);
 
-	if(args->max_iters < 2)
+	return selected;
+}
+
+iftFloatArray *iftRunSICLEBatch
+(const char *input, iftSICLEArgs *args, const char *out_pattern, 
+ int num_readers, int num_threads, int num_writers, iftFileSet **files)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(input != NULL); assert(out_pattern != NULL);
+	#endif //-------------------------------------------------------------------|
+	return iftRunShardedSICLEBatch(input, args, out_pattern, 0, 1, NULL,
+																 num_readers, num_threads, num_writers, files);
+}
+
+iftFloatArray *iftRunShardedSICLEBatch
+(const char *input, iftSICLEArgs *args, const char *out_pattern, int shard, 
+ int num_shards, const char *manifest, int num_readers, int num_threads, 
+ int num_writers, iftFileSet **files)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(input != NULL); assert(out_pattern != NULL);
+	#endif //-------------------------------------------------------------------|
+	bool default_args;
+	int num_stage[3];
+	const char *conv;
+	void *(*stage_func[3])(void*);
+	pthread_t *threads[3];
+	iftSICLE_Batch batch;
+
+	conv = strchr(out_pattern, '%');
+	if(conv == NULL || conv[1] != 's' || strchr(conv + 2, '%') != NULL)
+	{ iftError("The output pattern must have a single %%s", __func__); }
+
+	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
+	else { default_args = false; }
+	if(args->ooc_path != NULL || args->pyr_levels > 0)
+	{ iftError("Batches do not support out-of-core or pyramid runs", __func__); }
+
+	if(num_threads <= 0) { num_threads = sysconf(_SC_NPROCESSORS_ONLN); }
+	num_stage[0] = iftMax(1, num_readers); 
+	num_stage[1] = iftMax(1, num_threads);
+	num_stage[2] = iftMax(1, num_writers);
+	stage_func[0] = iftSICLE_RunBatchReader;
+	stage_func[1] = iftSICLE_RunBatchSegmenter;
+	stage_func[2] = iftSICLE_RunBatchWriter;
+
+	batch.next = 0;
+	batch.files = iftLoadFileSetFromDirOrCSV(input, 0, true);
+	if(num_shards > 1)
 	{
-		iftError("Invalid quantity of %d iterations. It must be >= 2\n", __func__,
-							args->max_iters); 	
-	}
+		iftFileSet *all;
 
-	if(args->irreg < 0.0)
+		all = batch.files;
+		batch.files = iftSelectSICLEShard(all, shard, num_shards);
+		iftDestroyFileSet(&all);
+	}
+	batch.num_done = 0; batch.done = NULL; batch.manifest = NULL;
+	if(manifest != NULL) // Resumed from the outputs it lists, then appended
 	{
-		iftError("Invalid irregularity value of %f. It must be >= 0\n", __func__,
-							args->irreg); 	
+		batch.done = iftSICLE_LoadManifest(manifest, &(batch.num_done));
+		batch.manifest = fopen(manifest, "a+");
+		if(batch.manifest == NULL) 
+		{ iftError("Could not open %s", __func__, manifest); }
+		// Ends the line of a killed run, which is not an entry
+		if(fseek(batch.manifest, -1, SEEK_END) == 0 && 
+			 fgetc(batch.manifest) != '\n') { fputc('\n', batch.manifest); }
 	}
-
-	if(args->adhr < 0)
+	batch.args = args;
+	batch.out_pattern = out_pattern;
+	batch.times = iftCreateFloatArray(batch.files->n);
+	pthread_mutex_init(&(batch.lock), NULL);
+	// Bounded, for keeping few decoded images and segmentations in memory
+	batch.decoded = iftSICLE_CreateQueue(2 * num_stage[1], num_stage[0]);
+	batch.segmented = iftSICLE_CreateQueue(2 * num_stage[1], num_stage[1]);
+
+	for(int st = 0; st < 3; ++st)
 	{
-		iftError("Invalid boundary adherence value of %f. It must be >= 0\n", 
-							__func__, args->adhr); 	
+		threads[st] = malloc(num_stage[st] * sizeof(pthread_t));
+		assert(threads[st] != NULL);
+		for(int t = 0; t < num_stage[st]; ++t)
+		{ 
+			if(pthread_create(&(threads[st][t]), NULL, stage_func[st], &batch))
+			{ iftError("Could not create a worker thread", __func__); }
+		}
 	}
-
-	if(args->alpha < 0.0)
+	for(int st = 0; st < 3; ++st)
 	{
-		iftError("Invalid boosting factor of %f. It must be within [0,1]\n", 
-							__func__, args->alpha); 	
+		for(int t = 0; t < num_stage[st]; ++t) { pthread_join(threads[st][t], NULL); }
+		free(threads[st]);
 	}
 
-	if(args->user_ni != NULL)
+	iftSICLE_DestroyQueue(&(batch.decoded));
+	iftSICLE_DestroyQueue(&(batch.segmented));
+	pthread_mutex_destroy(&(batch.lock));
+	if(batch.manifest != NULL) { fclose(batch.manifest); }
+	for(long i = 0; i < batch.num_done; ++i) { free(batch.done[i].out_path); }
+	free(batch.done);
+	if(default_args) { iftDestroySICLEArgs(&args); }
+	if(files != NULL) { (*files) = batch.files; }
+	else { iftDestroyFileSet(&(batch.files)); }
+
+	return batch.times;
+}
+
+//============================================================================|
+// Daemon
+//============================================================================|
+void iftRunSICLEDaemon
+(const char *socket_path, int num_threads)
+{
+	#ifdef IFT_DEBUG //---------------------------------------------------------|
+	assert(socket_path != NULL);
+	#endif //-------------------------------------------------------------------|
+	bool is_bound;
+	int fd;
+	mode_t old_mask;
+	struct sockaddr_un addr;
+	pthread_t *threads;
+	iftSICLE_Daemon daemon;
+
+	if(iftSICLE_SetSocketAddr(socket_path, &addr) == false)
+	{ iftError("Socket path %s is too long", __func__, socket_path); }
+
+	fd = iftSICLE_ConnectDaemon(socket_path);
+	if(fd >= 0) 
+	{ 
+		close(fd); 
+		iftError("A daemon is already listening at %s", __func__, socket_path); 
+	}
+	unlink(socket_path); // Left by a daemon which did not stop
+
+	daemon.listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	old_mask = umask(0077); // Only its owner may connect (i.e., mode 0600)
+	is_bound = daemon.listen_fd >= 0 && 
+						 bind(daemon.listen_fd, (struct sockaddr*)&addr, sizeof(addr)) == 0;
+	umask(old_mask);
+	if(is_bound == false || chmod(socket_path, 0600) != 0 ||
+		 listen(daemon.listen_fd, IFTSICLE_DAEMON_BACKLOG) != 0)
+	{ iftError("Could not listen at %s", __func__, socket_path); }
+
+	if(num_threads <= 0) { num_threads = sysconf(_SC_NPROCESSORS_ONLN); }
+	num_threads = iftMax(1, num_threads);
+	daemon.stopping = false;
+	daemon.conns = iftSICLE_CreateQueue(IFTSICLE_DAEMON_BACKLOG, 1);
+	pthread_mutex_init(&(daemon.lock), NULL);
+
+	threads = malloc(num_threads * sizeof(pthread_t));
+	assert(threads != NULL);
+	for(int t = 0; t < num_threads; ++t)
+	{ 
+		if(pthread_create(&(threads[t]), NULL, iftSICLE_RunDaemonWorker, &daemon))
+		{ iftError("Could not create a worker thread", __func__); }
+	}
+
+	while(true)
 	{
-		if(args->user_ni->val[0] >= args->n0 || 
-			args->user_ni->val[args->user_ni->n - 1] <= args->nf)
-		{
-			iftError("intermediary values must be within ]N0,...,Ni,...,Nf[\n",
-							__func__);	
-		}
-		for(long i = 1; i < args->user_ni->n; ++i)
+		bool stopping;
+		int *conn;
+
+		fd = accept(daemon.listen_fd, NULL, NULL);
+		pthread_mutex_lock(&(daemon.lock));
+		stopping = daemon.stopping;
+		pthread_mutex_unlock(&(daemon.lock));
+
+		if(fd < 0)
 		{
-			if(args->user_ni->val[i-1] <= args->user_ni->val[i])
-			{
-				iftError("Ni values must be strictly decreasing\n",__func__); 	
-			}
+			if(stopping == true) { break; }
+			if(errno == EINTR || errno == ECONNABORTED) { continue; }
+			iftWarning("Could not accept a connection: %s", __func__, 
+								 strerror(errno));
+			break;
 		}
+		if(stopping == true) { close(fd); break; }
+
+		conn = malloc(sizeof(int));
+		assert(conn != NULL);
+		(*conn) = fd;
+		iftSICLE_PushQueue(daemon.conns, conn);
 	}
-	if(sicle->sal == NULL && args->penopt != IFT_SICLE_PEN_NONE)
-	{
-		iftError("Penalization cannot be used without a saliency map\n",
-							__func__); 	
-	}
-			
+	iftSICLE_LeaveQueue(daemon.conns); // The pending ones are still served
+
+	for(int t = 0; t < num_threads; ++t) { pthread_join(threads[t], NULL); }
+	free(threads);
+
+	close(daemon.listen_fd);
+	unlink(socket_path);
+	iftSICLE_DestroyQueue(&(daemon.conns));
+	pthread_mutex_destroy(&(daemon.lock));
 }
 
-iftImage *iftRunSICLE
-(iftSICLE *sicle, iftSICLEArgs *args)
+iftImage *iftRequestSICLEDaemon
+(const char *socket_path, const char *img_path, iftImage *img, 
+ iftImage *objsm, iftImage *mask, iftSICLEArgs *args)
 {
 	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	assert(sicle != NULL);
-	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	assert(socket_path != NULL); assert((img_path == NULL) != (img == NULL));
 	#endif //-------------------------------------------------------------------|
 	bool default_args;
-	iftSICLE_IFTData *data;
-	iftSet *irre_seeds;
-	iftIntArray *ni;
-	iftImage *segm;
+	int fd;
+	void *addr;
+	iftImage *label_img, *prior;
+	iftSICLE_Request *req;
+	iftSICLE_Response *resp;
 
 	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
 	else { default_args = false; }
+	if(args->ooc_path != NULL || args->pyr_levels > 0 || args->cancel != NULL)
+	{ 
+		iftError("Daemons do not support out-of-core, pyramid or cancellable "
+						 "runs", __func__); 
+	}
 
-	data = iftSICLE_CreateIFTData(sicle, args);
-	ni = iftSICLE_CreateNiArray(args, data);
+	req = calloc(1, sizeof(iftSICLE_Request)); // No garbage in the padding
+	resp = calloc(1, sizeof(iftSICLE_Response));
+	assert(req != NULL); assert(resp != NULL);
 
-	irre_seeds = NULL;
-  for(int it = 1; it < ni->n; ++it)
-  {
-  	#ifdef IFT_DEBUG //-------------------------------------------------------|
-		fprintf(stderr, "DEBUG (%s): Iteration %d\n", __func__, it);
-		#endif //-----------------------------------------------------------------|	
-		if(args->use_dift == false || it == 1) // Seq or 1st iter?
-		{ iftSICLE_RunSeedIFT(sicle, args, &data); }
-		else 
-		{ iftSICLE_RunSeedDIFT(sicle, args, &data, &irre_seeds); }
+	memcpy(req->magic, IFTSICLE_DAEMON_MAGIC, 8);
+	req->args_size = sizeof(iftSICLEArgs);
+	req->args = (*args);
+	req->num_ni = (args->user_ni == NULL) ? 0 : args->user_ni->n;
 
-		#ifdef IFT_DEBUG //-------------------------------------------------------|
-		iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, data);
-		iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", it, ni->val[it-1]);
-		iftDestroyImage(&seed_img);
-		iftImage *segm_img = iftSICLE_CreateLabelImage(sicle, data);
-		iftWriteImageByExt(segm_img, "debug/segm_%d_%d.pgm", it, ni->val[it-1]);
-		iftDestroyImage(&segm_img);
-		fprintf(stderr, "DEBUG (%s): Ni = %d\n", __func__, ni->val[it]);
-		#endif //-----------------------------------------------------------------|		
-		
-		iftSICLE_RemSeeds(sicle, ni->val[it], args,&data, &irre_seeds);
-  }
+	prior = (objsm != NULL) ? objsm : mask;
+	if(img != NULL && prior != NULL) 
+	{ iftVerifyImageDomains(img, prior, __func__); }
+	if(objsm != NULL && mask != NULL) 
+	{ iftVerifyImageDomains(objsm, mask, __func__); }
+
+	if(img != NULL)
+	{
+		req->kind = IFTSICLE_REQ_SHM;
+		req->xsize = img->xsize; req->ysize = img->ysize; req->zsize = img->zsize;
+		req->is_color = iftIsColorImage(img);
+		iftSICLE_ShareImage(img, req->is_color, req->name);
+	}
+	else
+	{
+		req->kind = IFTSICLE_REQ_PATH;
+		// The daemon may run elsewhere in the file system
+		if(realpath(img_path, req->name) == NULL)
+		{ iftError("Could not find %s", __func__, img_path); }
+	}
+
+	// The priors are always shared, and their domain is the request's one
+	if(prior != NULL)
+	{ 
+		req->xsize = prior->xsize; req->ysize = prior->ysize; 
+		req->zsize = prior->zsize; 
+	}
+	if(objsm != NULL) { iftSICLE_ShareImage(objsm, false, req->objsm_name); }
+	if(mask != NULL) { iftSICLE_ShareImage(mask, false, req->mask_name); }
+
+	iftSICLE_SendRequest(socket_path, req, 
+											 (args->user_ni == NULL) ? NULL : args->user_ni->val, resp);
+	if(req->kind == IFTSICLE_REQ_SHM) { shm_unlink(req->name); }
+	if(objsm != NULL) { shm_unlink(req->objsm_name); }
+	if(mask != NULL) { shm_unlink(req->mask_name); }
+	if(resp->ok == false) { iftError("%s", __func__, resp->name); }
+
+	label_img = iftCreateImage(resp->xsize, resp->ysize, resp->zsize);
+	addr = MAP_FAILED;
+	fd = shm_open(resp->name, O_RDONLY, 0);
+	if(fd >= 0)
+	{ 
+		addr = mmap(NULL, label_img->n * sizeof(int), PROT_READ, MAP_SHARED, fd, 0); 
+		close(fd);
+	}
+	shm_unlink(resp->name);
+	if(addr == MAP_FAILED) 
+	{ iftError("Could not map the labels at %s", __func__, resp->name); }
+	memcpy(label_img->val, addr, label_img->n * sizeof(int));
+	munmap(addr, label_img->n * sizeof(int));
+
+	free(req); free(resp);
+	if(default_args) { iftDestroySICLEArgs(&args); }
+
+	return label_img;
+}
+
+void iftStopSICLEDaemon
+(const char *socket_path)
+{
 	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	fprintf(stderr, "DEBUG (%s): Last iteration\n", __func__);
-	#endif //-------------------------------------------------------------------|	
-	// Segmentation with Nf seeds
-	if(args->use_dift == false) // Seq?
-	{ iftSICLE_RunSeedIFT(sicle, args, &data); }
-	else 
-	{ iftSICLE_RunSeedDIFT(sicle, args, &data, &irre_seeds); }
-	
-  #ifdef IFT_DEBUG //---------------------------------------------------------|
-	iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, data);
-	iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", ni->n, args->nf);
-	iftDestroyImage(&seed_img);
-	iftImage *segm_img = iftSICLE_CreateLabelImage(sicle, data);
-	iftWriteImageByExt(segm_img, "debug/segm_%d_%d.pgm", ni->n, args->nf);
-	iftDestroyImage(&segm_img);
+	assert(socket_path != NULL);
 	#endif //-------------------------------------------------------------------|
+	iftSICLE_Request *req;
+	iftSICLE_Response *resp;
 
-	segm = iftSICLE_CreateLabelImage(sicle, data);
+	req = calloc(1, sizeof(iftSICLE_Request));
+	resp = calloc(1, sizeof(iftSICLE_Response));
+	assert(req != NULL); assert(resp != NULL);
 
-	if(default_args) { iftDestroySICLEArgs(&args); }
-	iftSICLE_DestroyIFTData(&data);
-	iftDestroyIntArray(&ni);
-	return segm;
+	memcpy(req->magic, IFTSICLE_DAEMON_MAGIC, 8);
+	req->kind = IFTSICLE_REQ_STOP;
+	req->args_size = sizeof(iftSICLEArgs);
+
+	iftSICLE_SendRequest(socket_path, req, NULL, resp);
+	if(resp->ok == false) { iftError("%s", __func__, resp->name); }
+
+	free(req); free(resp);
 }
 
-iftImage **iftRunMultiscaleSICLE
-(iftSICLE *sicle, iftSICLEArgs *args, int *num_scales)
+//============================================================================|
+// Buffer
+//============================================================================|
+bool iftRunSICLEOnBuffer
+(const iftSICLEBuffer *in, iftSICLEArgs *args, iftSICLEBuffer *labels, 
+ char *msg)
 {
 	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	assert(sicle != NULL);
-	if(args != NULL) { iftVerifySICLEArgs(sicle,args); }
+	assert(in != NULL); assert(labels != NULL);
 	#endif //-------------------------------------------------------------------|
-	bool default_args;
+	const int SIZE = IFT_STR_DEFAULT_SIZE;
+	bool default_args, cancelled;
+	char err[IFT_STR_DEFAULT_SIZE];
+	iftSICLE *sicle;
 	iftSICLE_IFTData *data;
-	iftSet *irre_seeds;
-	iftIntArray *ni;
-	iftImage **segm;
+
+	err[0] = '\0';
+	if(in->data == NULL || labels->data == NULL)
+	{ snprintf(err, SIZE, "The buffers must not be empty\n"); }
+	else if(in->xsize < 1 || in->ysize < 1 || in->zsize < 1 || 
+					labels->xsize != in->xsize || labels->ysize != in->ysize || 
+					labels->zsize != in->zsize)
+	{ snprintf(err, SIZE, "The buffers must have the same (valid) domain\n"); }
+	else if((int)in->dtype < IFT_SICLE_DTYPE_UINT8 || 
+					(int)in->dtype > IFT_SICLE_DTYPE_FLOAT32 ||
+					(int)in->cspace < IFT_SICLE_CSPACE_GRAY || 
+					(int)in->cspace > IFT_SICLE_CSPACE_LAB ||
+					in->dtype == IFT_SICLE_DTYPE_INT32 || 
+					(in->cspace == IFT_SICLE_CSPACE_LAB && 
+					 in->dtype != IFT_SICLE_DTYPE_FLOAT32))
+	{ snprintf(err, SIZE, "Invalid type of the input buffer\n"); }
+	else if(labels->cspace != IFT_SICLE_CSPACE_GRAY || 
+					(labels->dtype != IFT_SICLE_DTYPE_INT32 && 
+					 labels->dtype != IFT_SICLE_DTYPE_UINT16))
+	{ snprintf(err, SIZE, "Labels must be a gray INT32 or UINT16 buffer\n"); }
+	else if(args != NULL && args->ooc_path != NULL)
+	{ snprintf(err, SIZE, "Buffers do not support out-of-core runs\n"); }
+	if(err[0] != '\0')
+	{ 
+		if(msg != NULL) { strcpy(msg, err); }
+		return false; 
+	}
 
 	if(args == NULL) { args = iftCreateSICLEArgs(); default_args = true;}
 	else { default_args = false; }
 
-	data = iftSICLE_CreateIFTData(sicle, args);
-	ni = iftSICLE_CreateNiArray(args, data);
-	(*num_scales) = ni->n;
-	segm = calloc(ni->n, sizeof(iftImage*));
-
-	irre_seeds = NULL;
-  for(int it = 1; it < ni->n; ++it)
-  {
-  	#ifdef IFT_DEBUG //-------------------------------------------------------|
-		fprintf(stderr, "DEBUG (%s): Iteration %d\n", __func__, it);
-		#endif //-----------------------------------------------------------------|	
-		if(args->use_dift == false || it == 1) // Seq or 1st iter?
-		{ iftSICLE_RunSeedIFT(sicle, args, &data); }
-		else 
-		{ iftSICLE_RunSeedDIFT(sicle, args, &data, &irre_seeds); }
-		segm[it - 1] = iftSICLE_CreateLabelImage(sicle, data);
-
-		#ifdef IFT_DEBUG //-------------------------------------------------------|
-		iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, data);
-		iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", it, ni->val[it-1]);
-		iftDestroyImage(&seed_img);
-		fprintf(stderr, "DEBUG (%s): Ni = %d\n", __func__, ni->val[it]);
-		#endif //-----------------------------------------------------------------|		
-		iftSICLE_RemSeeds(sicle, ni->val[it], args,&data, &irre_seeds);
-  }
+	sicle = iftSICLE_CreateFromBuffer(in);
+	if(iftSICLE_FindArgsError(sicle, args, err) == false && 
+		 labels->dtype == IFT_SICLE_DTYPE_UINT16 && args->n0 > USHRT_MAX)
+	{ snprintf(err, SIZE, "UINT16 labels require N0 <= %d\n", USHRT_MAX); }
+	if(err[0] != '\0')
+	{
+		if(msg != NULL) { strcpy(msg, err); }
+		if(default_args) { iftDestroySICLEArgs(&args); }
+		iftDestroySICLE(&sicle);
+		return false;
+	}
 
-	// Segmentation with Nf seeds
-	#ifdef IFT_DEBUG //---------------------------------------------------------|
-	fprintf(stderr, "DEBUG (%s): Last iteration\n", __func__);
-	#endif //-------------------------------------------------------------------|	
-	if(args->use_dift == false) // Seq?
-	{ iftSICLE_RunSeedIFT(sicle, args, &data); }
+	if(args->pyr_levels > 0) { data = iftSICLE_RunPyramid(sicle, args, -1); }
 	else 
-	{ iftSICLE_RunSeedDIFT(sicle, args, &data, &irre_seeds); }
-	segm[ni->n - 1] = iftSICLE_CreateLabelImage(sicle, data);
+	{ 
+		data = iftSICLE_CreateIFTData(sicle, args);
+		if(args->time_budget > 0) 
+		{ data->deadline = iftSICLE_GetWallTime() + args->time_budget; }
+		data->cancel = args->cancel; data->cancel_data = args->cancel_data;
+		iftSICLE_RunSchedule(sicle, args, &data, NULL);
+	}
 
-  #ifdef IFT_DEBUG //---------------------------------------------------------|
-	iftImage *seed_img = iftSICLE_CreateSeedImage(sicle, data);
-	iftWriteImageByExt(seed_img, "debug/seeds_%d_%d.pgm", ni->n, args->nf);
-	iftDestroyImage(&seed_img);
-	#endif //-------------------------------------------------------------------|
+	cancelled = data->cancelled;
+	if(cancelled == false) { iftSICLE_WriteBufferLabels(sicle, data, labels); }
+	else if(msg != NULL) { snprintf(msg, SIZE, "Cancelled\n"); }
 
 	if(default_args) { iftDestroySICLEArgs(&args); }
 	iftSICLE_DestroyIFTData(&data);
-	iftDestroyIntArray(&ni);
+	iftDestroySICLE(&sicle);
 
-	return segm;
+	return !cancelled;
 }
-